@@ -4,11 +4,11 @@
  * Purpose: Forward declarations of classes in the recls C++ mapping.
  *
  * Created: 23rd November 2011
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2011-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -54,7 +54,7 @@
 # define RECLS_VER_RECLS_CPP_HPP_CLASSFWD_MAJOR     1
 # define RECLS_VER_RECLS_CPP_HPP_CLASSFWD_MINOR     1
 # define RECLS_VER_RECLS_CPP_HPP_CLASSFWD_REVISION  3
-# define RECLS_VER_RECLS_CPP_HPP_CLASSFWD_EDIT      7
+# define RECLS_VER_RECLS_CPP_HPP_CLASSFWD_EDIT      8
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -96,6 +96,9 @@ class ftp_search_sequence;
 /* recls/cpp/root_sequence.hpp : */
 class root_sequence;
 
+/* recls/cpp/search_results.hpp : */
+class search_results;
+
 /* recls/cpp/search_sequence.hpp : */
 template<
     typename C
@@ -125,6 +128,7 @@ struct reclstl_traits<recls_char_w_t>;
 #ifdef RECLS_API_FTP
     using ::recls::cpp::ftp_search_sequence;
 #endif /* RECLS_API_FTP */
+    using ::recls::cpp::search_results;
     using ::recls::cpp::search_sequence;
     using ::recls::cpp::root_sequence;
     using ::recls::cpp::recls_exception;
@@ -0,0 +1,462 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    recls/cpp/search_results.hpp
+ *
+ * Purpose: recls C++ mapping - search_results class.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted provided that the following conditions are
+ * met:
+ *
+ * - Redistributions of source code must retain the above copyright notice,
+ *   this list of conditions and the following disclaimer.
+ * - Redistributions in binary form must reproduce the above copyright
+ *   notice, this list of conditions and the following disclaimer in the
+ *   documentation and/or other materials provided with the distribution.
+ * - Neither the name of the copyright holder nor the names of its
+ *   contributors may be used to endorse or promote products derived from
+ *   this software without specific prior written permission.
+ *
+ * THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS
+ * IS" AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO,
+ * THE IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR
+ * PURPOSE ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT OWNER OR
+ * CONTRIBUTORS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+ * EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+ * PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR
+ * PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF
+ * LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING
+ * NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ * SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/** \file recls/cpp/search_results.hpp
+ *
+ * \brief [C++] recls::search_results class
+ *   for the \ref group__recls__cpp "recls C++ mapping".
+ */
+
+#ifndef RECLS_INCL_RECLS_CPP_HPP_SEARCH_RESULTS
+#define RECLS_INCL_RECLS_CPP_HPP_SEARCH_RESULTS
+
+/* File version */
+#ifndef RECLS_DOCUMENTATION_SKIP_SECTION
+# define RECLS_VER_RECLS_CPP_HPP_SEARCH_RESULTS_MAJOR       1
+# define RECLS_VER_RECLS_CPP_HPP_SEARCH_RESULTS_MINOR       0
+# define RECLS_VER_RECLS_CPP_HPP_SEARCH_RESULTS_REVISION    2
+# define RECLS_VER_RECLS_CPP_HPP_SEARCH_RESULTS_EDIT        2
+#endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/cpp/common.hpp>
+#include <recls/cpp/directory_parts.hpp>
+#include <recls/cpp/exceptions.hpp>
+#include <recls/cpp/traits.hpp>
+#include <recls/cpp/internal/sequence_helper.hpp>
+
+#include <new>
+#include <vector>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace cpp
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+/** This class collects the results of a search into columns - one
+ * contiguous array for each of the sizes, modification times, attributes
+ * and node indexes of the entries, and one contiguous block of the
+ * entries' (nul-terminated) paths - so that aggregations and sorts over
+ * large numbers of results are sequential scans of memory.
+ *
+ * \ingroup group__recls__cpp
+ *
+ * The search is performed, in full, by the constructor, by
+ * Recls_SearchProcess(). The entries themselves are not retained.
+ *
+ * \note The columns contain whatever the search provides, so, for
+ *   example, the sizes are 0 if RECLS_F_DETAILS_LATER is specified, and
+ *   the node indexes are 0 unless RECLS_F_NODE_INDEX is specified.
+ */
+class search_results
+    : protected sequence_helper
+{
+/// \name Types
+/// @{
+public:
+    /// The character type
+    typedef char_t                                          char_type;
+    /// The current parameterisation of the type
+    typedef search_results                                  class_type;
+    /// The size type
+    typedef size_t                                          size_type;
+    /// The string type
+    typedef string_t                                        string_type;
+private:
+    typedef std::vector<recls_filesize_t>                   sizes_type;
+    typedef std::vector<recls_time_t>                       times_type;
+    typedef std::vector<recls_uint32_t>                     attributes_type;
+    typedef std::vector<recls_uint64_t>                     node_indexes_type;
+    typedef std::vector<char_type>                          paths_type;
+    typedef std::vector<size_type>                          offsets_type;
+/// @}
+
+/// \name Construction
+/// @{
+public:
+    /// Collects the results of a search according to the given search
+    /// pattern and flags, relative to \c directory
+    search_results(
+        char_type const*    directory
+    ,   char_type const*    pattern
+    ,   recls_uint32_t      flags
+    );
+#if defined(STLSOFT_CF_MEMBER_TEMPLATE_FUNCTION_SUPPORT)
+
+    /// Collects the results of a search according to the given search
+    /// pattern and flags, relative to \c directory
+    template <typename S1, typename S2>
+    search_results(
+        S1 const&       directory
+    ,   S2 const&       pattern
+    ,   recls_uint32_t  flags
+    )
+        : m_pathOffsets(1, 0)
+    {
+        directory_buffer_type   directory_(1);
+        pattern_buffer_type     pattern_(1);
+
+        collect_(copy_or_null(directory_, directory), copy_or_null(pattern_, pattern), flags);
+    }
+#endif /* STLSOFT_CF_MEMBER_TEMPLATE_FUNCTION_SUPPORT */
+
+    /// Swaps the contents of \c this and \c rhs
+    void swap(class_type& rhs) STLSOFT_NOEXCEPT;
+/// @}
+
+/// \name State
+/// @{
+public:
+    /// The number of entries
+    size_type   size() const STLSOFT_NOEXCEPT;
+    /// Indicates whether there are no entries
+    bool        empty() const STLSOFT_NOEXCEPT;
+/// @}
+
+/// \name Columns
+///
+/// Each column has size() elements, and is invalidated by swap() or by
+/// the destruction of the instance.
+/// @{
+public:
+    /// The sizes of the entries
+    recls_filesize_t const* sizes() const STLSOFT_NOEXCEPT;
+    /// The modification times of the entries
+    recls_time_t const*     modification_times() const STLSOFT_NOEXCEPT;
+    /// The attributes of the entries
+    recls_uint32_t const*   attributes() const STLSOFT_NOEXCEPT;
+    /// The node indexes of the entries
+    recls_uint64_t const*   node_indexes() const STLSOFT_NOEXCEPT;
+    /// The paths of the entries, each nul-terminated, in order
+    char_type const*        paths() const STLSOFT_NOEXCEPT;
+    /// The offsets of the entries' paths within paths(). This has
+    /// <code>1 + size()</code> elements, the last of which is the length
+    /// of paths()
+    size_type const*        path_offsets() const STLSOFT_NOEXCEPT;
+/// @}
+
+/// \name Element access
+/// @{
+public:
+    /// The (nul-terminated) path of the entry at the given index
+    char_type const*        path(size_type index) const;
+    /// The length of the path of the entry at the given index
+    size_type               path_length(size_type index) const;
+/// @}
+
+/// \name Implementation
+/// @{
+private:
+    void collect_(
+        char_type const*    directory
+    ,   char_type const*    pattern
+    ,   recls_uint32_t      flags
+    );
+    void append_(recls_entry_t entry);
+
+    struct process_state_
+    {
+        class_type* results;
+        bool        outOfMemory;
+    };
+
+    static
+    int
+    RECLS_CALLCONV_DEFAULT
+    process_(
+        recls_entry_t               entry
+    ,   recls_process_fn_param_t    param
+    );
+/// @}
+
+/// \name Members
+/// @{
+private:
+    sizes_type          m_sizes;
+    times_type          m_modificationTimes;
+    attributes_type     m_attributes;
+    node_indexes_type   m_nodeIndexes;
+    paths_type          m_paths;
+    offsets_type        m_pathOffsets;
+/// @}
+};
+
+////////////////////////////////////////////////////////////////////////////
+// shims
+
+/// is_empty shim
+/// \ingroup group__recls__cpp
+///
+/// This returns a non-zero value if the given results are empty.
+/// \param r The results whose state is to be tested
+inline
+recls_bool_t
+is_empty(
+    search_results const& r
+)
+{
+    return r.empty();
+}
+
+////////////////////////////////////////////////////////////////////////////
+// implementation
+
+#ifndef RECLS_DOCUMENTATION_SKIP_SECTION
+
+// search_results
+
+// Construction
+inline
+search_results::search_results(
+    char_type const*    directory
+,   char_type const*    pattern
+,   recls_uint32_t      flags
+)
+    : m_pathOffsets(1, 0)
+{
+    collect_(directory, pattern, flags);
+}
+
+inline
+void
+search_results::swap(
+    class_type& rhs
+) STLSOFT_NOEXCEPT
+{
+    m_sizes.swap(rhs.m_sizes);
+    m_modificationTimes.swap(rhs.m_modificationTimes);
+    m_attributes.swap(rhs.m_attributes);
+    m_nodeIndexes.swap(rhs.m_nodeIndexes);
+    m_paths.swap(rhs.m_paths);
+    m_pathOffsets.swap(rhs.m_pathOffsets);
+}
+
+// State
+inline
+search_results::size_type
+search_results::size() const STLSOFT_NOEXCEPT
+{
+    return m_sizes.size();
+}
+
+inline
+bool
+search_results::empty() const STLSOFT_NOEXCEPT
+{
+    return m_sizes.empty();
+}
+
+// Columns
+inline
+recls_filesize_t const*
+search_results::sizes() const STLSOFT_NOEXCEPT
+{
+    return m_sizes.empty() ? ss_nullptr_k : &m_sizes[0];
+}
+
+inline
+recls_time_t const*
+search_results::modification_times() const STLSOFT_NOEXCEPT
+{
+    return m_modificationTimes.empty() ? ss_nullptr_k : &m_modificationTimes[0];
+}
+
+inline
+recls_uint32_t const*
+search_results::attributes() const STLSOFT_NOEXCEPT
+{
+    return m_attributes.empty() ? ss_nullptr_k : &m_attributes[0];
+}
+
+inline
+recls_uint64_t const*
+search_results::node_indexes() const STLSOFT_NOEXCEPT
+{
+    return m_nodeIndexes.empty() ? ss_nullptr_k : &m_nodeIndexes[0];
+}
+
+inline
+search_results::char_type const*
+search_results::paths() const STLSOFT_NOEXCEPT
+{
+    return m_paths.empty() ? ss_nullptr_k : &m_paths[0];
+}
+
+inline
+search_results::size_type const*
+search_results::path_offsets() const STLSOFT_NOEXCEPT
+{
+    return &m_pathOffsets[0];
+}
+
+// Element access
+inline
+search_results::char_type const*
+search_results::path(
+    size_type index
+) const
+{
+    RECLS_ASSERT(index < size());
+
+    return &m_paths[m_pathOffsets[index]];
+}
+
+inline
+search_results::size_type
+search_results::path_length(
+    size_type index
+) const
+{
+    RECLS_ASSERT(index < size());
+
+    return m_pathOffsets[index + 1] - m_pathOffsets[index] - 1;
+}
+
+// Implementation
+inline
+void
+search_results::collect_(
+    char_type const*    directory
+,   char_type const*    pattern
+,   recls_uint32_t      flags
+)
+{
+    // The process function must not throw, since it is called from the
+    // C API, so an allocation failure cancels the search, and is reported
+    // here
+    process_state_  state   =   { this, false };
+    recls_rc_t      rc      =   Recls_SearchProcess(directory, pattern, flags, &class_type::process_, &state);
+
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+
+    if (state.outOfMemory)
+    {
+        throw std::bad_alloc();
+    }
+
+    if (RECLS_FAILED(rc) &&
+        RECLS_RC_NO_MORE_DATA != rc)
+    {
+        throw recls_exception(rc, "failed to search directory", directory, pattern, flags);
+    }
+#else /* ? STLSOFT_CF_EXCEPTION_SUPPORT */
+
+    STLSOFT_SUPPRESS_UNUSED(rc);
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+}
+
+inline
+void
+search_results::append_(
+    recls_entry_t entry
+)
+{
+    // The path is always nul-terminated, so the terminator is copied along
+    // with it
+    m_paths.insert(m_paths.end(), entry->path.begin, entry->path.end + 1);
+    m_pathOffsets.push_back(m_paths.size());
+
+    m_sizes.push_back(entry->size);
+    m_modificationTimes.push_back(entry->modificationTime);
+    m_attributes.push_back(entry->attributes);
+    m_nodeIndexes.push_back(entry->nodeIndex);
+}
+
+inline
+/* static */
+int
+RECLS_CALLCONV_DEFAULT
+search_results::process_(
+    recls_entry_t               entry
+,   recls_process_fn_param_t    param
+)
+{
+    process_state_* const state = static_cast<process_state_*>(param);
+
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+
+    try
+    {
+        state->results->append_(entry);
+
+        return 1;
+    }
+    catch(std::bad_alloc&)
+    {
+        state->outOfMemory = true;
+
+        return 0;
+    }
+#else /* ? STLSOFT_CF_EXCEPTION_SUPPORT */
+
+    state->results->append_(entry);
+
+    return 1;
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+}
+
+#endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace cpp */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* !RECLS_INCL_RECLS_CPP_HPP_SEARCH_RESULTS */
+
+/* ///////////////////////////// end of file //////////////////////////// */
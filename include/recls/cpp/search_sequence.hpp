@@ -4,11 +4,11 @@
  * Purpose: recls C++ mapping - search_sequence class.
  *
  * Created: 10th September 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -53,7 +53,7 @@
 # define RECLS_VER_RECLS_CPP_HPP_SEARCH_SEQUENCE_MAJOR      4
 # define RECLS_VER_RECLS_CPP_HPP_SEARCH_SEQUENCE_MINOR      1
 # define RECLS_VER_RECLS_CPP_HPP_SEARCH_SEQUENCE_REVISION   13
-# define RECLS_VER_RECLS_CPP_HPP_SEARCH_SEQUENCE_EDIT       103
+# define RECLS_VER_RECLS_CPP_HPP_SEARCH_SEQUENCE_EDIT       105
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /** \file recls/cpp/search_sequence.hpp
@@ -117,14 +117,29 @@ class ftp_search_sequence;
 
 struct rss_shared_handle
 {
+    enum
+    {
+        /// The maximum number of entries obtained by each call to
+        /// Recls_GetNextDetailsBatch()
+        prefetchSize    =   32
+    };
+
     hrecls_t        hSrch;
     recls_sint32_t  cRefs;
+    size_t          batchSize;
+    size_t          prefetchIndex;
+    size_t          prefetchCount;
+    recls_rc_t      prefetchRc;
+    recls_entry_t   prefetched[prefetchSize];
 
 public:
-    explicit
-    rss_shared_handle(hrecls_t h)
+    rss_shared_handle(hrecls_t h, size_t n)
         : hSrch(h)
         , cRefs(1)
+        , batchSize(n)
+        , prefetchIndex(0)
+        , prefetchCount(0)
+        , prefetchRc(RECLS_RC_OK)
     {}
     void Release()
     {
@@ -133,6 +148,54 @@ public:
             delete this;
         }
     }
+
+    /// Advances to the next entry, taking it from the prefetched entries
+    /// where available, and otherwise obtaining the next batch of them
+    recls_rc_t Advance()
+    {
+        if (prefetchIndex + 1 < prefetchCount)
+        {
+            ++prefetchIndex;
+
+            return RECLS_RC_OK;
+        }
+
+        ReleasePrefetched_();
+
+        // A short batch stops at the first failure, which is reported only
+        // once the entries before it have been consumed
+        if (RECLS_FAILED(prefetchRc))
+        {
+            return prefetchRc;
+        }
+
+        size_t              n   =   0;
+        recls_rc_t const    rc  =   Recls_GetNextDetailsBatch(hSrch, &prefetched[0], batchSize, &n);
+
+        prefetchCount   =   n;
+        prefetchRc      =   rc;
+
+        return (0 != n) ? RECLS_RC_OK : rc;
+    }
+
+    /// The current entry, or NULL if the current position was not prefetched
+    recls_entry_t Current() const
+    {
+        return (0 != prefetchCount) ? prefetched[prefetchIndex] : static_cast<recls_entry_t>(NULL);
+    }
+
+private:
+    void ReleasePrefetched_() STLSOFT_NOEXCEPT
+    {
+        { for (size_t i = 0; i != prefetchCount; ++i)
+        {
+            Recls_CloseDetails(prefetched[i]);
+        }}
+
+        prefetchIndex   =   0;
+        prefetchCount   =   0;
+    }
+
 #if 0 || \
     defined(STLSOFT_COMPILER_IS_CLANG) || \
     defined(STLSOFT_COMPILER_IS_GCC) || \
@@ -145,6 +208,8 @@ private:
     {
         RECLS_MESSAGE_ASSERT("Shared search handle being destroyed with outstanding references!", 0 == cRefs);
 
+        ReleasePrefetched_();
+
         if (NULL != hSrch)
         {
             Recls_SearchClose(hSrch);
@@ -259,7 +324,11 @@ public:
 #endif /* STLSOFT_CF_MEMBER_TEMPLATE_FUNCTION_SUPPORT */
 #if defined(STLSOFT_CF_MEMBER_TEMPLATE_FUNCTION_SUPPORT)
 
-    /// Commence a search according to the given search pattern and flags, relative to \c directory
+    /// Commence a search according to the given search pattern and flags, relative to \c directory,
+    /// invoking \c pfnProgress before each directory is searched
+    ///
+    /// \note \c pfnProgress may return RECLS_PROGRESS_SKIP_DIRECTORY to
+    ///   exclude a directory, and all its sub-directories, from the search
     template <typename S1, typename S2>
     search_sequence(
         S1 const&                   directory
@@ -365,9 +434,10 @@ private:
 private:
     explicit
     basic_search_sequence_const_iterator(
-        hrecls_t hSrch
+        hrecls_t    hSrch
+    ,   size_t      batchSize = rss_shared_handle::prefetchSize
     )
-        : m_handle(make_handle_(hSrch))
+        : m_handle(make_handle_(hSrch, batchSize))
     {}
 public:
     /// Default constructor
@@ -394,7 +464,7 @@ public:
 
 // Implementation
 private:
-    rss_shared_handle*  make_handle_(hrecls_t hSrch);
+    rss_shared_handle*  make_handle_(hrecls_t hSrch, size_t batchSize);
 
 // Members
 private:
@@ -480,7 +550,11 @@ search_sequence::begin() const
     }
 #endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
 
-    return const_iterator(hSrch);
+    // Entries are not prefetched when progress is reported, since the
+    // search would otherwise run ahead of the iteration, and the function
+    // would be called (and able to cancel) for directories the caller has
+    // not yet reached
+    return const_iterator(hSrch, (ss_nullptr_k != m_pfnProgress) ? size_t(1) : size_t(rss_shared_handle::prefetchSize));
 }
 
 inline
@@ -515,10 +589,11 @@ template<
 inline
 rss_shared_handle*
 basic_search_sequence_const_iterator<C, T, V>::make_handle_(
-    hrecls_t hSrch
+    hrecls_t    hSrch
+,   size_t      batchSize
 )
 {
-    return (NULL != hSrch) ? new rss_shared_handle(hSrch) : static_cast<rss_shared_handle*>(NULL);
+    return (NULL != hSrch) ? new rss_shared_handle(hSrch, batchSize) : static_cast<rss_shared_handle*>(NULL);
 }
 
 template<
@@ -601,7 +676,7 @@ basic_search_sequence_const_iterator<C, T, V>::operator ++()
     RECLS_MESSAGE_ASSERT("Attempting to increment invalid iterator", NULL != m_handle);
 #endif /* compiler */
 
-    recls_rc_t const rc = Recls_GetNext(m_handle->hSrch);
+    recls_rc_t const rc = m_handle->Advance();
 
     if (RECLS_FAILED(rc))
     {
@@ -648,8 +723,11 @@ basic_search_sequence_const_iterator<C, T, V>::operator *() const
     RECLS_MESSAGE_ASSERT("Attempting to dereference invalid iterator", NULL != m_handle->hSrch);
 #endif /* compiler */
 
-    entry_type  e;
-    recls_rc_t  rc = traits_type::GetDetails(m_handle->hSrch, &e);
+    entry_type          e;
+    recls_entry_t const current =   m_handle->Current();
+    recls_rc_t const    rc      =   (NULL != current)
+                                        ? Recls_CopyDetails(current, &e)
+                                        : traits_type::GetDetails(m_handle->hSrch, &e);
 
     if (RECLS_FAILED(rc))
     {
@@ -4,11 +4,11 @@
  * Purpose: Platform discrimination for recls API.
  *
  * Created: 18th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -28,7 +28,7 @@
 # define RECLS_VER_RECLS_INTERNAL_H_PLATFORM_TYPES_MAJOR     3
 # define RECLS_VER_RECLS_INTERNAL_H_PLATFORM_TYPES_MINOR     7
 # define RECLS_VER_RECLS_INTERNAL_H_PLATFORM_TYPES_REVISION  2
-# define RECLS_VER_RECLS_INTERNAL_H_PLATFORM_TYPES_EDIT      39
+# define RECLS_VER_RECLS_INTERNAL_H_PLATFORM_TYPES_EDIT      41
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /** \file recls/internal/platform_types.h
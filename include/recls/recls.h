@@ -4,11 +4,11 @@
  * Purpose: Main header file for recls API.
  *
  * Created: 15th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -53,7 +53,7 @@
 # define RECLS_VER_RECLS_H_RECLS_MAJOR      3
 # define RECLS_VER_RECLS_H_RECLS_MINOR      21
 # define RECLS_VER_RECLS_H_RECLS_REVISION   15
-# define RECLS_VER_RECLS_H_RECLS_EDIT       136
+# define RECLS_VER_RECLS_H_RECLS_EDIT       157
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /** \name recls API Version
@@ -130,11 +130,12 @@
 #define RECLS_VER_1_10_0_ALPHA_3                            0x010a0003
 #define RECLS_VER_1_10_0_ALPHA_4                            0x010a0004
 #define RECLS_VER_1_10_0_ALPHA_5                            0x010a0005
+#define RECLS_VER_1_10_1_ALPHA_1                            0x010a0101
 
 #define RECLS_VER_MAJOR         1
 #define RECLS_VER_MINOR         10
-#define RECLS_VER_REVISION      0
-#define RECLS_VER               RECLS_VER_1_10_0_ALPHA_5
+#define RECLS_VER_REVISION      1
+#define RECLS_VER               RECLS_VER_1_10_1_ALPHA_1
 
 /* /////////////////////////////////////////////////////////////////////////
  * strictness
@@ -224,6 +225,15 @@ namespace recls
 # error Platform not recognised
 #endif /* platform */
 
+/** \def RECLS_DEPTH_UNLIMITED
+ *
+ * The maximum depth that indicates to Recls_SearchDepth() and
+ * Recls_SearchProcessDepth() that the depth of the search is not limited.
+ *
+ * \ingroup group__recls
+ */
+#define RECLS_DEPTH_UNLIMITED                               (~(RECLS_QUAL(recls_uint32_t))0)
+
 /* /////////////////////////////////////////////////////////////////////////
  * function specifications
  */
@@ -419,7 +429,7 @@ enum RECLS_FLAG
     ,   RECLS_F_RECURSIVE                           =   0x00010000  /*!< Searches given directory and all sub-directories */
     ,   RECLS_F_NO_FOLLOW_LINKS                     =   0x00020000  /*!< Does not expand links */
     ,   RECLS_F_DIRECTORY_PARTS                     =   0x00040000  /*!< Fills out the directory parts. Supported from version 1.1.1 onwards */
-    ,   RECLS_F_DETAILS_LATER                       =   0x00080000  /*!< Does not fill out anything other than the path. When specified to Recls_Stat(), and no types (RECLS_F_TYPEMASK) are specified, this will allow some details for a non-existant path to be elicited. */
+    ,   RECLS_F_DETAILS_LATER                       =   0x00080000  /*!< Does not fill out anything other than the path. When specified to Recls_Stat(), and no types (RECLS_F_TYPEMASK) are specified, this will allow some details for a non-existant path to be elicited. When specified to a search that uses the single-pass traversal, entries have only their path and type (and link count and/or node index, if requested), as indicated by Recls_EntryHasDetails(); entries are not stat()-ed where their type is provided by the directory and neither RECLS_F_LINK_COUNT nor RECLS_F_NODE_INDEX is specified. Supported for searches from version 1.10.1 onwards. */
     ,   RECLS_F_PASSIVE_FTP                         =   0x00100000  /*!< Passive mode in FTP. Supported from version 1.5.1 onwards */
     ,   RECLS_F_MARK_DIRS                           =   0x00200000  /*!< Marks the directories with a trailing slash. */
     ,   RECLS_F_ALLOW_REPARSE_DIRS                  =   0x00400000  /*!< Allow Windows reparse point directories to be examined (which can cause infinite loops). */
@@ -430,14 +440,15 @@ enum RECLS_FLAG
 #ifndef RECLS_DOCUMENTATION_SKIP_SECTION
     ,   RECLS_F_CALLBACKS_STDCALL_ON_WIN32          =   RECLS_F_CALLBACKS_STDCALL_ON_WINDOWS
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
+    ,   RECLS_F_RECYCLE_ENTRIES                     =   0x02000000  /*!< Allocates the search's entries from an arena belonging to the search, and recycles each entry's memory once the search has moved past it and no copies of it remain, rather than allocating and freeing each on the heap. Entries obtained by Recls_GetDetails(), Recls_GetNextDetails() and Recls_CopyDetails() remain valid until released by Recls_CloseDetails(), including after the search is closed, and may be released on any thread. Ignored by Recls_SearchParallel(). Supported from version 1.10.1 onwards. */
     ,   RECLS_F_USE_TILDE_ON_NO_SEARCHROOT          =   0x04000000  /*!< Interprets a NULL or empty searchRoot as the home directory, rather than the current directory. Supported from version 1.8.1 onwards. */
-#if 0
-    ,   RECLS_F_DIR_SIZE_IS_NUM_FILES               =   0x02000000  /*!< This causes the size of the directory to be the number of files contained within it, rather than being 0. */
-#endif /* 0 */
     ,   RECLS_F_IGNORE_HIDDEN_ENTRIES_ON_WINDOWS    =   0x08000000  /*!< This causes hidden files to be ignored. Currently supported on Windows only. */
 #ifndef RECLS_DOCUMENTATION_SKIP_SECTION
     ,   RECLS_F_IGNORE_HIDDEN_ENTRIES_ON_WIN32      =   RECLS_F_IGNORE_HIDDEN_ENTRIES_ON_WINDOWS
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
+    ,   RECLS_F_UNSORTED                            =   0x10000000  /*!< Entries are presented in the order in which they are read from each directory, rather than in name order. With the single-pass traversal, entries are presented as each directory is being read, so that the first is available immediately, and memory use does not grow with the number of entries in a directory (only with the number of its sub-directories, when RECLS_F_RECURSIVE is specified). Supported for searches from version 1.10.1 onwards. */
+    ,   RECLS_F_SAME_DEVICE                         =   0x20000000  /*!< Does not descend into sub-directories that are on a different device (file-system) from the search directory, such as mount points of other file-systems; such sub-directories are not listed, although they may themselves be returned as entries. Only meaningful with RECLS_F_RECURSIVE. Currently supported on UNIX only. Supported from version 1.10.1 onwards. */
+    ,   RECLS_F_PORTABLE_TRAVERSAL                  =   0x40000000  /*!< Uses the portable traversal (based on glob() and readdir()) even where the single-pass traversal is available. Only meaningful on Linux. The single-pass traversal does not descend into a directory, reached by a link, within which it already is, where the portable traversal does so until the path can no longer be resolved. Supported from version 1.10.1 onwards. */
 
 #if !defined(FILES)
     ,   FILES = RECLS_F_FILES /*!< RECLS_F_FILES. */
@@ -533,11 +544,21 @@ enum RECLS_FLAG
 # endif /* !IGNORE_HIDDEN_ENTRIES_ON_WIN32 */
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
-#if 0
-#if !defined(RECLS_F_DIR_SIZE_IS_NUM_FILES)
-    ,   DIR_SIZE_IS_NUM_FILES = RECLS_F_DIR_SIZE_IS_NUM_FILES /*!< RECLS_F_DIR_SIZE_IS_NUM_FILES. */
-#endif /* !RECLS_F_DIR_SIZE_IS_NUM_FILES */
-#endif /* 0 */
+#if !defined(SAME_DEVICE)
+    ,   SAME_DEVICE = RECLS_F_SAME_DEVICE /*!< RECLS_F_SAME_DEVICE. */
+#endif /* !SAME_DEVICE */
+
+#if !defined(UNSORTED)
+    ,   UNSORTED = RECLS_F_UNSORTED /*!< RECLS_F_UNSORTED. */
+#endif /* !UNSORTED */
+
+#if !defined(PORTABLE_TRAVERSAL)
+    ,   PORTABLE_TRAVERSAL = RECLS_F_PORTABLE_TRAVERSAL /*!< RECLS_F_PORTABLE_TRAVERSAL. */
+#endif /* !PORTABLE_TRAVERSAL */
+
+#if !defined(RECYCLE_ENTRIES)
+    ,   RECYCLE_ENTRIES = RECLS_F_RECYCLE_ENTRIES /*!< RECLS_F_RECYCLE_ENTRIES. */
+#endif /* !RECYCLE_ENTRIES */
 };
 
 /** Flags that moderate the search behaviour of the Recls_GetSelectedRoots() function.
@@ -580,12 +601,50 @@ enum RECLS_REMDIR_FLAG
         RECLS_REMDIR_F_NO_REMOVE_SUBDIRS    =   0x0001  /*!< By default, empty sub-directories are removed, unless this flag is specified */
     ,   RECLS_REMDIR_F_REMOVE_FILES         =   0x0002  /*!< By default, files are not removed, unless this flag is specified */
     ,   RECLS_REMDIR_F_REMOVE_READONLY      =   0x0004  /*!< By default, read-only files are not removed, unless this flag is specified */
+    ,   RECLS_REMDIR_F_PARALLEL             =   0x0008  /*!< Removes independent sub-directories on a pool of threads. Ignored unless the library is built for multithreading on Linux. Supported from version 1.10.1 onwards. */
+};
+
+/** Flags that moderate the behaviour of Recls_CalcDirectorySizeEx()
+ *
+ * \ingroup group__recls
+ */
+enum RECLS_DIRSIZE_FLAG
+{
+        RECLS_DIRSIZE_F_NO_FOLLOW_LINKS     =   0x0001  /*!< By default, symbolic links are followed (as by a search), so that a link to a file counts the size of the file, and a link to a directory is traversed. When this flag is specified, links are counted as themselves, and not traversed */
+    ,   RECLS_DIRSIZE_F_COUNT_LINKS_ONCE    =   0x0002  /*!< By default, a file with more than one (hard) link is counted once for each link. When this flag is specified, it is counted once only, being identified by its device and node index. Ignored where node indexes are not available */
+    ,   RECLS_DIRSIZE_F_PARALLEL            =   0x0004  /*!< Reads independent sub-directories on a pool of threads. Ignored unless the library is built for multithreading on Linux */
+};
+
+/** Flags that moderate the behaviour of Recls_SearchParallel() and
+ * Recls_SearchProcessParallel()
+ *
+ * \ingroup group__recls
+ */
+enum RECLS_PARALLEL_FLAG
+{
+        RECLS_PARALLEL_F_UNORDERED          =   0x0000  /*!< Entries are presented as their directories are read, so the order of directories varies between searches. The entries of each directory are presented together, in name order */
+    ,   RECLS_PARALLEL_F_DETERMINISTIC      =   0x0001  /*!< Entries are presented in the same order as by Recls_Search(), the directories being read ahead, in parallel, and the results reassembled */
+};
+
+/** Values that may be returned by a progress function (of type
+ * hrecls_progress_fn_t)
+ *
+ * \ingroup group__recls
+ */
+enum RECLS_PROGRESS_RESULT
+{
+        RECLS_PROGRESS_CANCEL               =   0   /*!< Cancels the search */
+    ,   RECLS_PROGRESS_CONTINUE             =   1   /*!< Continues the search, including the directory */
+    ,   RECLS_PROGRESS_SKIP_DIRECTORY       =   2   /*!< Continues the search without the directory, which is neither opened nor listed, so that none of its entries, nor any of its sub-directories, are searched. Supported from version 1.10.1 onwards. */
 };
 
 #if !defined(__cplusplus) && \
     !defined(RECLS_DOCUMENTATION_SKIP_SECTION)
 typedef enum RECLS_FLAG         RECLS_FLAG;
 typedef enum RECLS_ROOTS_FLAG   RECLS_ROOTS_FLAG;
+typedef enum RECLS_DIRSIZE_FLAG RECLS_DIRSIZE_FLAG;
+typedef enum RECLS_PARALLEL_FLAG RECLS_PARALLEL_FLAG;
+typedef enum RECLS_PROGRESS_RESULT RECLS_PROGRESS_RESULT;
 #endif /* !__cplusplus && !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -639,6 +698,24 @@ typedef recls_directoryResults_t                            directoryResults_t;
 typedef struct recls_directoryResults_t                     recls_directoryResults_t;
 # endif /* __cplusplus */
 
+/** Structure used to return the sizes calculated by the
+ * Recls_CalcDirectorySizeEx() function.
+ *
+ */
+struct recls_directorySize_t
+{
+    recls_uint64_t      numFiles;       /*!< Number of files (and other entries that are not directories) in the directory and all its sub-directories. */
+    recls_uint64_t      numDirectories; /*!< Number of sub-directories of the directory, at all depths. */
+    recls_filesize_t    apparentSize;   /*!< Total of the sizes of the files, in bytes. */
+    recls_filesize_t    allocatedSize;  /*!< Total of the storage allocated to the files, in bytes. Where this is not available, it is the same as \c apparentSize. */
+};
+
+# ifndef RECLS_NO_NAMESPACE
+typedef recls_directorySize_t                               directorySize_t;
+# elif !defined(__cplusplus)
+typedef struct recls_directorySize_t                        recls_directorySize_t;
+# endif /* __cplusplus */
+
 #endif /* !RECLS_COMPILER_IS_CH */
 
 #ifndef RECLS_COMPILER_IS_CH
@@ -668,7 +745,9 @@ typedef void*                                               recls_process_fn_par
  *
  * \ingroup group__recls
  *
- * \param hEntry entry info structure
+ * \param hEntry entry info structure. This is valid only for the duration
+ *   of the call, and must not be released; it may be retained beyond that
+ *   by taking a copy with Recls_CopyDetails()
  * \param param the parameter passed to Recls_SearchProcess()
  *
  * \return A status to indicate whether to continue or cancel the processing
@@ -689,9 +768,16 @@ typedef int (RECLS_CALLCONV_DEFAULT *hrecls_process_fn_t)(
  * \param dirLen The number of characters in the \c dir param, not including the nul-terminator
  * \param param the parameter passed to Recls_SearchFeedback()
  *
+ * The function is invoked before the sub-directory is opened, so that it
+ * may be excluded from the search at no cost. Its result is honoured in
+ * the same way when RECLS_F_CALLBACKS_STDCALL_ON_WINDOWS is specified.
+ *
  * \return A status to indicate whether to continue or cancel the processing
- * \retval 0 cancel the processing
- * \retval non-0 continue the processing
+ * \retval 0 (RECLS_PROGRESS_CANCEL) cancel the processing
+ * \retval RECLS_PROGRESS_SKIP_DIRECTORY continue the processing, but do
+ *   not search the sub-directory (or any of its sub-directories). If the
+ *   sub-directory is the search root, the search finds no entries
+ * \retval any-other-value continue the processing
  */
 typedef int (RECLS_CALLCONV_DEFAULT *hrecls_progress_fn_t)(
     /* [in] */ recls_char_t const*      dir
@@ -701,6 +787,38 @@ typedef int (RECLS_CALLCONV_DEFAULT *hrecls_progress_fn_t)(
 ,   /* [in] */ recls_uint32_t           reserved1
 );
 
+/** User-supplied function, used by Recls_CalcDirectorySizes(), which
+ * receives the sizes of each directory
+ *
+ * \ingroup group__recls
+ *
+ * \param dir The nul-terminated C-style string containing the directory's
+ *   path, which, for the directory passed to Recls_CalcDirectorySizes(),
+ *   is as passed
+ * \param dirLen The number of characters in the \c dir param, not
+ *   including the nul-terminator
+ * \param depth The depth of the directory, being 0 for the directory
+ *   passed to Recls_CalcDirectorySizes()
+ * \param size The sizes of the files in the directory and all its
+ *   sub-directories
+ * \param param the parameter passed to Recls_CalcDirectorySizes()
+ *
+ * The function is invoked for a directory once it has been invoked for all
+ * of its sub-directories, so that the last invocation is for the directory
+ * passed to Recls_CalcDirectorySizes().
+ *
+ * \return A status to indicate whether to continue or cancel the processing
+ * \retval 0 cancel the processing
+ * \retval non-0 continue the processing
+ */
+typedef int (RECLS_CALLCONV_DEFAULT *hrecls_directory_size_fn_t)(
+    /* [in] */ recls_char_t const*          dir
+,   /* [in] */ size_t                       dirLen
+,   /* [in] */ size_t                       depth
+,   /* [in] */ recls_directorySize_t const* size
+,   /* [in] */ recls_process_fn_param_t     param
+);
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace typedefs
  */
@@ -944,6 +1062,12 @@ RECLS_API Recls_SearchProcessFeedback(
  *
  * \return A status code indicating success/failure
  *
+ * \note Each entry is allocated individually, so that one kept by \c pfn,
+ *   by Recls_CopyDetails(), holds only its own memory, unless
+ *   RECLS_F_RECYCLE_ENTRIES is specified, in which case the entries are
+ *   recycled, and one that is kept keeps the search's arena alive until it
+ *   is released.
+ *
  * \note Available from version 1.1 of the <b>recls</b> API
  */
 RECLS_API Recls_SearchProcess(
@@ -954,6 +1078,142 @@ RECLS_API Recls_SearchProcess(
 ,   /* [in] */ recls_process_fn_param_t param
 );
 
+/** Searches a given directory for matching files of the given pattern,
+ * reading the directories on a pool of threads
+ *
+ * \ingroup group__recls
+ *
+ * Each directory is a unit of work, which is taken by whichever of the
+ * threads is idle, so that sub-trees of different sizes are balanced among
+ * them. The search handle is used in the same way as one obtained from
+ * Recls_Search(), and must be used by one thread at a time.
+ *
+ * \param searchRoot The directory representing the root of the search
+ * \param pattern The search pattern, e.g. "*.c"
+ * \param flags A combination of 0 or more
+ *   RECLS_FLAG values.
+ * \param numThreads The number of threads, or 0 for the number of online
+ *   processors
+ * \param parallelFlags A combination of 0 or more RECLS_PARALLEL_FLAG
+ *   values, which determine the order in which entries are presented
+ * \param phSrch Address of the search handle. This is set to NULL on failure
+ *
+ * \return A status code indicating success/failure
+ *
+ * \note Parallel searches are supported only on Linux, and only for
+ *   patterns that do not contain directory parts and where
+ *   RECLS_F_PORTABLE_TRAVERSAL is not specified. Otherwise, the search is
+ *   performed as by Recls_Search(), and \c numThreads and
+ *   \c parallelFlags are ignored.
+ */
+RECLS_API Recls_SearchParallel(
+    /* [in] */ recls_char_t const*  searchRoot
+,   /* [in] */ recls_char_t const*  pattern
+,   /* [in] */ recls_uint32_t       flags
+,   /* [in] */ recls_uint32_t       numThreads
+,   /* [in] */ recls_uint32_t       parallelFlags
+,   /* [out] */ hrecls_t*           phSrch
+);
+
+/** Searches a given directory for matching files of the given pattern,
+ * reading the directories on a pool of threads, and processes them
+ * according to the given process function
+ *
+ * \ingroup group__recls
+ *
+ * \param searchRoot The directory representing the root of the search
+ * \param pattern The search pattern, e.g. "*.c"
+ * \param flags A combination of 0 or more
+ *   RECLS_FLAG values.
+ * \param numThreads The number of threads, or 0 for the number of online
+ *   processors
+ * \param parallelFlags A combination of 0 or more RECLS_PARALLEL_FLAG
+ *   values
+ * \param pfn The processing function
+ * \param param A caller-supplied parameter that is passed through to \c pfn on each invocation. The function can cancel the enumeration by returning 0
+ *
+ * \return A status code indicating success/failure
+ *
+ * \warning Unless RECLS_PARALLEL_F_DETERMINISTIC is specified, \c pfn is
+ *   invoked concurrently, from the pool's threads, and must be
+ *   thread-safe. When the search is cancelled, invocations already in
+ *   progress on other threads complete, and no others are made. If
+ *   RECLS_PARALLEL_F_DETERMINISTIC is specified, \c pfn is invoked on the
+ *   calling thread, in the order of Recls_SearchProcess().
+ */
+RECLS_API Recls_SearchProcessParallel(
+    /* [in] */ recls_char_t const*      searchRoot
+,   /* [in] */ recls_char_t const*      pattern
+,   /* [in] */ recls_uint32_t           flags
+,   /* [in] */ recls_uint32_t           numThreads
+,   /* [in] */ recls_uint32_t           parallelFlags
+,   /* [in] */ hrecls_process_fn_t      pfn
+,   /* [in] */ recls_process_fn_param_t param
+);
+
+/** Searches a given directory for matching files of the given pattern,
+ * limiting the depth of the entries found
+ *
+ * \ingroup group__recls
+ *
+ * The depth of an entry is the number of directories between it and the
+ * search directory, so that the entries of the search directory have depth
+ * 0, those of its sub-directories depth 1, and so on. The limits are
+ * applied during the traversal: no directory whose entries would be deeper
+ * than \c maxDepth is opened, and no entry shallower than \c minDepth is
+ * created.
+ *
+ * \param searchRoot The directory representing the root of the search
+ * \param pattern The search pattern, e.g. "*.c"
+ * \param flags A combination of 0 or more
+ *   RECLS_FLAG values. The limits are meaningful only if RECLS_F_RECURSIVE
+ *   is specified
+ * \param minDepth The minimum depth of the entries found
+ * \param maxDepth The maximum depth of the entries found, or
+ *   RECLS_DEPTH_UNLIMITED
+ * \param phSrch Address of the search handle. This is set to NULL on failure
+ *
+ * \return A status code indicating success/failure
+ */
+RECLS_API Recls_SearchDepth(
+    /* [in] */ recls_char_t const*  searchRoot
+,   /* [in] */ recls_char_t const*  pattern
+,   /* [in] */ recls_uint32_t       flags
+,   /* [in] */ recls_uint32_t       minDepth
+,   /* [in] */ recls_uint32_t       maxDepth
+,   /* [out] */ hrecls_t*           phSrch
+);
+
+/** Searches a given directory for matching files of the given pattern,
+ * limiting the depth of the entries found, and processes them according to
+ * the given process function
+ *
+ * \ingroup group__recls
+ *
+ * \param searchRoot The directory representing the root of the search
+ * \param pattern The search pattern, e.g. "*.c"
+ * \param flags A combination of 0 or more
+ *   RECLS_FLAG values.
+ * \param minDepth The minimum depth of the entries found
+ * \param maxDepth The maximum depth of the entries found, or
+ *   RECLS_DEPTH_UNLIMITED
+ * \param pfn The processing function
+ * \param param A caller-supplied parameter that is passed through to \c pfn on each invocation. The function can cancel the enumeration by returning 0
+ *
+ * \return A status code indicating success/failure
+ *
+ * \see Recls_SearchDepth()
+ */
+RECLS_API Recls_SearchProcessDepth(
+    /* [in] */ recls_char_t const*      searchRoot
+,   /* [in] */ recls_char_t const*      pattern
+,   /* [in] */ recls_uint32_t           flags
+,   /* [in] */ recls_uint32_t           minDepth
+,   /* [in] */ recls_uint32_t           maxDepth
+,   /* [in] */ hrecls_process_fn_t      pfn
+,   /* [in] */ recls_process_fn_param_t param
+);
+
 /** Closes the given search
  *
  * \ingroup group__recls
@@ -965,6 +1225,43 @@ Recls_SearchClose(
     /* [in] */ hrecls_t hSrch
 );
 
+/** Restarts the given search, optionally with a different search root
+ * and/or pattern, reusing the resources of the search
+ *
+ * \ingroup group__recls
+ *
+ * The search's flags, progress function, and other options, are retained.
+ * Restarting a search avoids the cost of creating another, such as the
+ * allocation of its internal buffers, so is useful when performing many
+ * similar searches. Entries previously obtained from the search remain
+ * valid.
+ *
+ * \param hSrch Handle of the search. May not be NULL.
+ * \param searchRoot The new search root, or NULL to retain the current
+ *   one. It is interpreted as by Recls_Search().
+ * \param pattern The new pattern, or NULL to retain the current one.
+ *
+ * \return Status code
+ * \retval RECLS_RC_OK The search has been restarted, and is positioned on
+ *   its first entry
+ * \retval RECLS_RC_NO_MORE_DATA The search has been restarted, but has no
+ *   entries
+ * \retval RECLS_RC_NOT_IMPLEMENTED The search cannot be restarted, as is
+ *   the case for FTP searches
+ * \retval Any other status code indicates an error
+ *
+ * \note Whatever the result, the search handle remains valid, and must
+ *   be closed by Recls_SearchClose(). Unless the result is RECLS_RC_OK, the
+ *   search may not be enumerated, but it may be restarted again.
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_API Recls_SearchReset(
+    /* [in] */ hrecls_t             hSrch
+,   /* [in] */ recls_char_t const*  searchRoot
+,   /* [in] */ recls_char_t const*  pattern
+);
+
 #if 0
 /* New Recls1 API. */
 RECLS_API Recls1_FileSystem_CloseSearch(
@@ -1077,6 +1374,45 @@ RECLS_API Recls_GetNextDetails(
 ,   /* [out] */ recls_entry_t*  phEntry
 );
 
+/** Advances the search up to \c max positions, retrieving the information
+ * for each new position
+ *
+ * \ingroup group__recls
+ *
+ * The effect is that of up to \c max calls to Recls_GetNextDetails(),
+ * stopping at the first that fails, but without the per-call overhead;
+ * each entry written into \c entries must be released, by
+ * Recls_CloseDetails(), by the caller. The search handle is left at the
+ * position of the last entry retrieved.
+ *
+ * A batch is short only when a call fails, and the status code of that
+ * call is returned, along with the entries retrieved before it: a failure
+ * status code does not mean that \c *count is 0, and the entries must be
+ * processed (and released) before the status code is acted upon.
+ *
+ * \param hSrch Handle of the search. May not be NULL.
+ * \param entries Array of at least \c max elements to receive the entry
+ *   info structures. May be NULL only if \c max is 0.
+ * \param max The maximum number of entries to retrieve.
+ * \param count Pointer to receive the number of entries retrieved. May
+ *   not be NULL.
+ *
+ * \return Status code
+ * \retval RECLS_RC_OK \c max entries were retrieved (none, if \c max is 0)
+ * \retval RECLS_RC_NO_MORE_DATA The search was exhausted after \c *count
+ *   entries were retrieved
+ * \retval Any other status code indicates an error, which occurred after
+ *   \c *count entries were retrieved
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_API Recls_GetNextDetailsBatch(
+    /* [in] */ hrecls_t         hSrch
+,   /* [out] */ recls_entry_t*  entries
+,   /* [in] */ size_t           max
+,   /* [out] */ size_t*         count
+);
+
 /** @} */
 
 /***************************************
@@ -1424,6 +1760,24 @@ Recls_EntryExists(
     /* [in] */ recls_entry_t hEntry
 );
 
+/** Indicates whether the entry's details - its times, size, and attributes
+ * other than its type - were loaded when the entry was elicited.
+ *
+ * \ingroup group__recls
+ *
+ * \param hEntry The file entry info structure to test. May not be NULL
+ * \retval true The entry's details were loaded
+ * \retval false Only the entry's path and type are available. The details
+ *   may be obtained by passing the entry's path to Recls_Stat()
+ *
+ * \note Entries will only be without details when RECLS_F_DETAILS_LATER is
+ *   specified to a search.
+ */
+RECLS_FNDECL(recls_bool_t)
+Recls_EntryHasDetails(
+    /* [in] */ recls_entry_t hEntry
+);
+
 /** Returns non-zero if the file entry is read-only.
  *
  * \ingroup group__recls
@@ -1556,6 +1910,54 @@ Recls_GetLastStatusChangeTime(
     /* [in] */ recls_entry_t hEntry
 );
 
+/** Returns the nanosecond part of the time the file was last modified.
+ *
+ * \ingroup group__recls
+ *
+ * \param hEntry The file entry info structure to test. May not be NULL
+ *
+ * \return The nanoseconds (in the range [0, 1000000000)), or 0 if they are
+ *   not available, as is always the case on Windows, where
+ *   recls_time_t has a resolution of 100ns
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_FNDECL(recls_uint32_t)
+Recls_GetModificationTimeNsec(
+    /* [in] */ recls_entry_t hEntry
+);
+
+/** Returns the nanosecond part of the time the file was last accessed.
+ *
+ * \ingroup group__recls
+ *
+ * \param hEntry The file entry info structure to test. May not be NULL
+ *
+ * \return The nanoseconds, or 0 if they are not available
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_FNDECL(recls_uint32_t)
+Recls_GetLastAccessTimeNsec(
+    /* [in] */ recls_entry_t hEntry
+);
+
+/** Returns the nanosecond part of the time the file status was last
+ * changed.
+ *
+ * \ingroup group__recls
+ *
+ * \param hEntry The file entry info structure to test. May not be NULL
+ *
+ * \return The nanoseconds, or 0 if they are not available
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_FNDECL(recls_uint32_t)
+Recls_GetLastStatusChangeTimeNsec(
+    /* [in] */ recls_entry_t hEntry
+);
+
 #if 0
 /** Returns the checksum value of the file.
  *
@@ -1806,6 +2208,92 @@ Recls_SetApiLogFunction(
 
 /** @} */
 
+/***************************************
+ * Memory
+ */
+
+/** \name Memory functions
+ *
+ * \ingroup group__recls
+ */
+/** @{ */
+
+/** Allocation function pointer
+ *
+ * \param cb The number of bytes required
+ * \param context The \c context member of the recls_allocator_t
+ *
+ * \return A pointer to a block of at least \c cb bytes, aligned suitably
+ *   for any type, or NULL if it cannot be allocated
+ */
+typedef void* (RECLS_CALLCONV_DEFAULT* recls_alloc_pfn_t)(
+    size_t              cb
+,   void*               context
+);
+
+/** Deallocation function pointer
+ *
+ * \param pv The block to be released, which was obtained from the
+ *   allocation function of the same recls_allocator_t. It is never NULL
+ * \param context The \c context member of the recls_allocator_t
+ */
+typedef void (RECLS_CALLCONV_DEFAULT* recls_free_pfn_t)(
+    void*               pv
+,   void*               context
+);
+
+/** Structure specifying the functions by which the library allocates
+ * memory
+ *
+ * \see Recls_SetAllocator
+ */
+struct recls_allocator_t
+{
+    /** The allocation function. May not be NULL */
+    recls_alloc_pfn_t   pfnAlloc;
+    /** The deallocation function. May not be NULL */
+    recls_free_pfn_t    pfnFree;
+    /** A user-defined context, passed to each function */
+    void*               context;
+};
+
+#ifndef RECLS_DOCUMENTATION_SKIP_SECTION
+# ifndef RECLS_NO_NAMESPACE
+typedef recls_allocator_t               allocator_t;
+# elif !defined(__cplusplus)
+typedef struct recls_allocator_t        recls_allocator_t;
+# endif /* __cplusplus */
+#endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
+
+/** Sets the allocator used for all the memory allocated by the library,
+ * including that of searches, their traversal state, and their entries
+ *
+ * \ingroup group__recls
+ *
+ * \param allocator Pointer to the allocator, which is copied. Specify NULL
+ *   to restore the default, which uses malloc() and free().
+ *
+ * \pre (NULL == allocator) || (NULL != allocator->pfnAlloc && NULL != allocator->pfnFree)
+ *
+ * \note The allocator is process-wide, and is not synchronised. It should
+ *   be set before the library is otherwise used (and before any threads
+ *   use it), and must not be changed while any search, entry or other
+ *   memory obtained from the library remains, since each is released by
+ *   the allocator current at the time.
+ *
+ * \note Memory allocated by the operating system or the C library on the
+ *   library's behalf (such as by glob(), opendir(), or FindFirstFile()) is
+ *   not obtained from the allocator.
+ *
+ * \note Supported from version 1.10.1 onwards
+ */
+RECLS_FNDECL(void)
+Recls_SetAllocator(
+    struct recls_allocator_t const* allocator
+);
+
+/** @} */
+
 /***************************************
  * Extended API functions
  */
@@ -1821,12 +2309,46 @@ Recls_SetApiLogFunction(
  * \ingroup group__recls
  *
  * \param dir The directory to assess
+ *
+ * \return Non-zero if the directory contains no entries that would be
+ *   matched by a search for Recls_GetWildcardsAll(), or if the directory
+ *   does not exist, or cannot be read; zero otherwise
+ *
+ * \note On UNIX, including Linux, entries whose names begin with '.' are
+ *   not counted, since they are not matched by the wildcard, so a
+ *   directory containing only such entries is reported as empty
+ *
+ * \note On Linux, the directory is read only until a counted entry is
+ *   found
  */
 RECLS_FNDECL(recls_bool_t)
 Recls_IsDirectoryEmpty(
     /* [in] */ recls_char_t const* dir
 );
 
+/** Determines whether each of the given directories is empty
+ *
+ * \ingroup group__recls
+ *
+ * \param dirs The directories to assess
+ * \param numDirs The number of elements in \c dirs
+ * \param results The array, of at least \c numDirs elements, to receive
+ *   the result of Recls_IsDirectoryEmpty() for each directory
+ *
+ * \return The number of the directories that are empty
+ *
+ * \note Supported from version 1.10.1 onwards
+ *
+ * \pre 0 == numDirs || NULL != dirs
+ * \pre 0 == numDirs || NULL != results
+ */
+RECLS_FNDECL(size_t)
+Recls_AreDirectoriesEmpty(
+    /* [in] */ recls_char_t const* const*   dirs
+,   /* [in] */ size_t                       numDirs
+,   /* [out] */ recls_bool_t*               results
+);
+
 /** Determines whether the given directory entry is empty
  *
  * \ingroup group__recls
@@ -1883,6 +2405,77 @@ Recls_CalcDirectorySizeFeedback(
 ,   /* [in] */ recls_process_fn_param_t param
 );
 
+/** Calculates the number, and the apparent and allocated sizes, of the
+ *   files in the given directory and all its sub-directories.
+ *
+ * \ingroup group__recls
+ *
+ * \param dir The directory to assess
+ * \param flags A combination of zero or more flags from the
+ *   \c recls::RECLS_DIRSIZE_FLAG enumeration
+ * \param size Pointer to an instance of \c recls_directorySize_t to
+ *   receive the sizes
+ *
+ * \return A status code indicating success/failure
+ *
+ * \note Sub-directories to which access is denied are not counted. Other
+ *   failures to read a sub-directory (e.g. the exhaustion of file
+ *   descriptors) fail the calculation
+ *
+ * \note As for a search of the wildcard (see Recls_GetWildcardsAll()), on
+ *   UNIX, files and directories whose names begin with '.' are not
+ *   counted, although the contents of such directories are
+ *
+ * \note When links are followed, a link to a directory that contains it
+ *   is not traversed, nor counted, where the single-pass traversal is
+ *   available
+ *
+ * \note Supported from version 1.10.1 onwards
+ *
+ * \pre NULL != dir
+ * \pre NULL != size
+ */
+RECLS_API Recls_CalcDirectorySizeEx(
+    /* [in] */ recls_char_t const*      dir
+,   /* [in] */ recls_uint32_t           flags
+,   /* [out] */ recls_directorySize_t*  size
+);
+
+/** Calculates the number, and the apparent and allocated sizes, of the
+ *   files in each of the given directory and all its sub-directories, in
+ *   a single traversal, invoking the given function with the sizes of
+ *   each.
+ *
+ * \ingroup group__recls
+ *
+ * \param dir The directory to assess
+ * \param flags A combination of zero or more flags from the
+ *   \c recls::RECLS_DIRSIZE_FLAG enumeration
+ * \param pfn The function that will be invoked for each directory, with
+ *   its sizes, once it has been invoked for each of its sub-directories.
+ *   When RECLS_DIRSIZE_F_PARALLEL is specified, the function may be
+ *   invoked on any thread, but is never invoked concurrently, and the
+ *   order of directories in different sub-trees varies between calls
+ * \param param The caller-defined parameter that is passed to \c pfn
+ *
+ * \return A status code indicating success/failure
+ * \retval RECLS_RC_SEARCH_CANCELLED \c pfn returned 0
+ *
+ * \note The sizes of a directory are those of Recls_CalcDirectorySizeEx(),
+ *   but the directory tree is traversed only once
+ *
+ * \note Supported from version 1.10.1 onwards
+ *
+ * \pre NULL != dir
+ * \pre NULL != pfn
+ */
+RECLS_API Recls_CalcDirectorySizes(
+    /* [in] */ recls_char_t const*          dir
+,   /* [in] */ recls_uint32_t               flags
+,   /* [in] */ hrecls_directory_size_fn_t   pfn
+,   /* [in] */ recls_process_fn_param_t     param
+);
+
 /** @} */
 
 /***************************************
@@ -2013,6 +2606,43 @@ RECLS_API Recls_CreateDirectory(
 ,   /* [out] */ recls_directoryResults_t*   results /* = NULL */
 );
 
+/** Creates a number of directories, including all intermediate
+ * directories of each
+ *
+ * \ingroup group__recls
+ *
+ * \param paths The paths to create, each of which, if not absolute, is
+ *   assumed relative to the current directory
+ * \param numPaths The number of elements in \c paths
+ * \param results Pointer to an array of \c numPaths instances of
+ *   \c recls_directoryResults_t in which information regarding the changes
+ *   effected for each path will be recorded. May be \c NULL
+ * \param numCompleted Pointer to a variable that receives the number of
+ *   paths, from the first, that were created, or already existed. May be
+ *   \c NULL
+ *
+ * \return The status of the first path that could not be created, if any,
+ *   in which case the remaining paths are not attempted; otherwise
+ *   \c RECLS_RC_OK
+ *
+ * \note The effect is that of calling Recls_CreateDirectory() for each
+ *   path, but where the paths share ancestors - such as when creating many
+ *   sibling directories - the work of locating those ancestors is shared.
+ *   This is most effective when the paths are ordered such that siblings
+ *   are adjacent
+ *
+ * \note Supported from version 1.10.1 onwards
+ *
+ * \pre 0 == numPaths || NULL != paths
+ * \pre NULL != paths[i], for each i in [0, numPaths)
+ */
+RECLS_API Recls_CreateDirectories(
+    /* [in] */ recls_char_t const* const*   paths
+,   /* [in] */ size_t                       numPaths
+,   /* [out] */ recls_directoryResults_t*   results         /* = NULL */
+,   /* [out] */ size_t*                     numCompleted    /* = NULL */
+);
+
 /** Removes a directory, including any sub-directories
  *
  * \ingroup group__recls
@@ -4,11 +4,11 @@
  * Purpose: recls C++ mapping.
  *
  * Created: 5th January 2010
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2010-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -48,7 +48,7 @@
 # define RECLS_VER_RECLS_HPP_RECLS_MAJOR    1
 # define RECLS_VER_RECLS_HPP_RECLS_MINOR    2
 # define RECLS_VER_RECLS_HPP_RECLS_REVISION 4
-# define RECLS_VER_RECLS_HPP_RECLS_EDIT     9
+# define RECLS_VER_RECLS_HPP_RECLS_EDIT     10
 #endif /* !RECLS_DOCUMENTATION_SKIP_SECTION */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -63,6 +63,8 @@
 
 #include <recls/cpp/root_sequence.hpp>
 
+#include <recls/cpp/search_results.hpp>
+
 #include <recls/cpp/search_sequence.hpp>
 
 #ifdef RECLS_API_FTP
@@ -99,6 +101,7 @@ namespace recls
 #ifdef RECLS_API_FTP
     using ::recls::cpp::ftp_search_sequence;
 #endif /* RECLS_API_FTP */
+    using ::recls::cpp::search_results;
     using ::recls::cpp::search_sequence;
     using ::recls::cpp::root_sequence;
     using ::recls::cpp::recls_exception;
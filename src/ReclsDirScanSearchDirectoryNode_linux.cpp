@@ -0,0 +1,937 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/ReclsDirScanSearchDirectoryNode_linux.cpp
+ *
+ * Purpose: Implementation of the ReclsDirScanSearchDirectoryNode class.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+#include "impl.types.hpp"
+#include "impl.string.hpp"
+#include "impl.util.h"
+#include "impl.entryfunctions.h"
+#include "impl.entryinfo.hpp"
+#include "impl.dirscan.linux.hpp"
+
+#include "ReclsDirScanSearchDirectoryNode_linux.hpp"
+
+#include "impl.trace.h"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsDirScanSearchDirectoryNode::frame_type
+ */
+
+ReclsDirScanSearchDirectoryNode::frame_type::frame_type()
+    : fd(-1)
+    , dev(0)
+    , ino(0)
+    , dirLen(0)
+    , depth(0)
+    , streaming(false)
+    , names()
+    , entries()
+    , entriesIndex(0)
+    , directories()
+    , directoriesIndex(0)
+{}
+
+void
+ReclsDirScanSearchDirectoryNode::frame_type::clear()
+{
+    if (fd >= 0)
+    {
+        ::close(fd);
+
+        fd = -1;
+    }
+
+    // The containers are cleared, rather than released, so that their
+    // storage is available to the next directory at this depth
+    dev                 =   0;
+    ino                 =   0;
+    dirLen              =   0;
+    depth               =   0;
+    streaming           =   false;
+    names.clear();
+    entries.clear();
+    entriesIndex        =   0;
+    directories.clear();
+    directoriesIndex    =   0;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsDirScanSearchDirectoryNode::item_less_
+ */
+
+struct ReclsDirScanSearchDirectoryNode::item_less_
+{
+public:
+    explicit
+    item_less_(
+        recls_char_t const* names
+    )
+        : m_names(names)
+    {}
+
+public:
+    bool operator ()(item_type const& lhs, item_type const& rhs) const
+    {
+        return ::strcmp(m_names + lhs.nameOffset, m_names + rhs.nameOffset) < 0;
+    }
+
+private:
+    recls_char_t const* m_names;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsDirScanSearchDirectoryNode
+ */
+
+/* static */ bool
+ReclsDirScanSearchDirectoryNode::IsApplicable(
+    recls_uint32_t          flags
+,   recls_char_t const*     pattern
+,   size_t                  patternLen
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::IsApplicable");
+
+    if (0 != (flags & RECLS_F_PORTABLE_TRAVERSAL))
+    {
+        return false;
+    }
+
+    // Patterns that contain directory parts must be resolved by glob()
+    recls_char_t const* const end = pattern + patternLen;
+
+    return end == std::find(pattern, end, types::traits_type::path_name_separator());
+}
+
+/* static */ ReclsSearchDirectoryNode*
+ReclsDirScanSearchDirectoryNode::FindAndCreate(
+    recls_uint32_t              flags
+,   recls_char_t const*         searchDir
+,   size_t                      searchDirLen
+,   recls_char_t const*         pattern
+,   size_t                      patternLen
+,   recls_uint32_t              minDepth
+,   recls_uint32_t              maxDepth
+,   entry_arena_t*              arena
+,   hrecls_progress_fn_t        pfn
+,   recls_process_fn_param_t    param
+,   recls_rc_t*                 prc
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::FindAndCreate");
+
+    RECLS_ASSERT(ss_nullptr_k != searchDir);
+    RECLS_ASSERT(searchDirLen == types::traits_type::str_len(searchDir));
+    RECLS_ASSERT(types::traits_type::has_dir_end(searchDir, searchDirLen));
+    RECLS_ASSERT(ss_nullptr_k != pattern);
+    RECLS_ASSERT(patternLen == types::traits_type::str_len(pattern));
+    RECLS_ASSERT(ss_nullptr_k != prc);
+
+    class_type* node    =   ss_nullptr_k;
+    recls_rc_t  rc      =   RECLS_RC_OUT_OF_MEMORY;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        node = new class_type(flags, searchDirLen, minDepth, maxDepth, arena, pfn, param);
+
+        if (ss_nullptr_k != node)
+        {
+            rc = node->Initialise(searchDir, searchDirLen, pattern, patternLen);
+        }
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        rc = RECLS_RC_OUT_OF_MEMORY;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+    if (RECLS_FAILED(rc))
+    {
+        delete node;
+
+        node = ss_nullptr_k;
+    }
+
+    *prc = rc;
+
+    RECLS_ASSERT(ss_nullptr_k == node || node->is_valid());
+
+    return node;
+}
+
+ReclsDirScanSearchDirectoryNode::ReclsDirScanSearchDirectoryNode(
+    recls_uint32_t              flags
+,   size_t                      rootDirLen
+,   recls_uint32_t              minDepth
+,   recls_uint32_t              maxDepth
+,   entry_arena_t*              arena
+,   hrecls_progress_fn_t        pfn
+,   recls_process_fn_param_t    param
+)
+    : m_flags(flags)
+    , m_rootDirLen(rootDirLen)
+    , m_minDepth(minDepth)
+    , m_maxDepth(maxDepth)
+    , m_arena(arena)
+    , m_sharedDir(ss_nullptr_k)
+    , m_pfn(pfn)
+    , m_param(param)
+    , m_matcher()
+    , m_scanBuffer(dirscan_alloc_buffer(RECLS_DIRSCAN_BUFFER_SIZE))
+    , m_reader(m_scanBuffer, RECLS_DIRSCAN_BUFFER_SIZE)
+    , m_path(1)
+    , m_frames()
+    , m_depth(0)
+    , m_rootDevice(0)
+    , m_current(ss_nullptr_k)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::ReclsDirScanSearchDirectoryNode");
+}
+
+ReclsDirScanSearchDirectoryNode::~ReclsDirScanSearchDirectoryNode()
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::~ReclsDirScanSearchDirectoryNode");
+
+    Entry_ReleaseOwned(m_current);
+
+    for (; 0 != m_depth; )
+    {
+        PopFrame_();
+    }
+
+    dirscan_free_buffer(m_scanBuffer);
+
+    Entry_ReleaseSharedDirectory(m_sharedDir);
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::Initialise(
+    recls_char_t const*     searchDir
+,   size_t                  searchDirLen
+,   recls_char_t const*     pattern
+,   size_t                  patternLen
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::Initialise");
+
+    RECLS_ASSERT(ss_nullptr_k == m_current);
+    RECLS_ASSERT(0 == m_depth);
+
+    if (ss_nullptr_k == m_scanBuffer)
+    {
+        return RECLS_RC_OUT_OF_MEMORY;
+    }
+
+    // Split the pattern(s) once, rather than for each directory
+    m_matcher.init(pattern, patternLen);
+
+    if (!m_path.resize(1 + searchDirLen))
+    {
+        return RECLS_RC_OUT_OF_MEMORY;
+    }
+
+    types::traits_type::char_copy(&m_path[0], searchDir, searchDirLen);
+    m_path[searchDirLen] = '\0';
+
+    recls_rc_t rc = PushFrame_(AT_FDCWD, searchDir, searchDirLen);
+
+    if (RECLS_SUCCEEDED(rc))
+    {
+        rc = Advance_();
+    }
+
+    if (RECLS_SUCCEEDED(rc))
+    {
+        RECLS_ASSERT(is_valid());
+    }
+
+    return rc;
+}
+
+bool
+ReclsDirScanSearchDirectoryNode::IsRestartable() const
+{
+    return true;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::Restart(
+    recls_char_t const*     searchDir
+,   size_t                  searchDirLen
+,   recls_char_t const*     pattern
+,   size_t                  patternLen
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::Restart");
+
+    RECLS_ASSERT(ss_nullptr_k != searchDir);
+    RECLS_ASSERT(searchDirLen == types::traits_type::str_len(searchDir));
+    RECLS_ASSERT(types::traits_type::has_dir_end(searchDir, searchDirLen));
+    RECLS_ASSERT(ss_nullptr_k != pattern);
+    RECLS_ASSERT(patternLen == types::traits_type::str_len(pattern));
+
+    if (!IsApplicable(m_flags, pattern, patternLen))
+    {
+        return RECLS_RC_NOT_IMPLEMENTED;
+    }
+
+    // The frames, along with their buffers, the path buffer, the scan
+    // buffer and the matcher are all retained, and reused by the new
+    // traversal
+    Entry_ReleaseOwned(m_current);
+    m_current = ss_nullptr_k;
+
+    for (; 0 != m_depth; )
+    {
+        PopFrame_();
+    }
+
+    m_rootDirLen = searchDirLen;
+    m_rootDevice = 0;
+
+    recls_rc_t rc;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        rc = Initialise(searchDir, searchDirLen, pattern, patternLen);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        rc = RECLS_RC_OUT_OF_MEMORY;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+    if (RECLS_FAILED(rc))
+    {
+        // Leave the node empty, so that it may be restarted again
+        Entry_ReleaseOwned(m_current);
+        m_current = ss_nullptr_k;
+
+        for (; 0 != m_depth; )
+        {
+            PopFrame_();
+        }
+    }
+
+    return rc;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::PushFrame_(
+    int                 parentFd
+,   recls_char_t const* name
+,   size_t              dirLen
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::PushFrame_");
+
+    RECLS_ASSERT(dirLen < m_path.size());
+    RECLS_ASSERT(types::traits_type::is_path_name_separator(m_path[dirLen - 1]));
+    RECLS_ASSERT('\0' == m_path[dirLen]);
+
+    // The progress function is invoked before the directory is opened, so
+    // that a skipped directory costs nothing
+    if (ss_nullptr_k != m_pfn)
+    {
+        switch ((*m_pfn)(m_path.data(), dirLen, m_param, ss_nullptr_k, 0))
+        {
+            case RECLS_PROGRESS_CANCEL:
+                return RECLS_RC_USER_CANCELLED_SEARCH;
+            case RECLS_PROGRESS_SKIP_DIRECTORY:
+                recls_debug2_trace_printf_(RECLS_LITERAL("skipping directory '%s'"), m_path.data());
+                return RECLS_RC_NO_MORE_DATA;
+            default:
+                break;
+        }
+    }
+
+    recls_uint32_t  flags = m_flags;
+
+    // Links are not followed below the search root, but the root itself
+    // is always followed
+    if (AT_FDCWD == parentFd)
+    {
+        flags &= ~recls_uint32_t(RECLS_F_NO_FOLLOW_LINKS);
+    }
+
+    int const e = m_reader.open(parentFd, name, flags);
+
+    if (0 != e)
+    {
+        recls_debug1_trace_printf_(RECLS_LITERAL("could not open directory '%s'"), m_path.data());
+
+        return dirscan_rc_from_errno(e);
+    }
+
+    // The identity of the directory is required to confine the search to
+    // the device of the root, and, when links are followed, to detect a
+    // link to one of its ancestors
+    bool const  followsLinks    =   0 == (RECLS_F_NO_FOLLOW_LINKS & m_flags);
+    struct stat st;
+
+    if (followsLinks ||
+        0 != (RECLS_F_SAME_DEVICE & m_flags))
+    {
+        if (0 != ::fstat(m_reader.get_fd(), &st))
+        {
+            int const statError = errno;
+
+            m_reader.close();
+
+            return dirscan_rc_from_errno(statError);
+        }
+
+        // A sub-directory on another device is closed before it is read
+        if (0 != (RECLS_F_SAME_DEVICE & m_flags))
+        {
+            if (AT_FDCWD == parentFd)
+            {
+                m_rootDevice = st.st_dev;
+            }
+            else if (m_rootDevice != st.st_dev)
+            {
+                recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is on another device"), m_path.data());
+
+                m_reader.close();
+
+                return RECLS_RC_NO_MORE_DATA;
+            }
+        }
+
+        // A sub-directory that is one of its own ancestors, reached by a
+        // link, is not searched again, since the search would not end
+        if (followsLinks &&
+            IsAncestor_(st.st_dev, st.st_ino))
+        {
+            recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is an ancestor"), m_path.data());
+
+            m_reader.close();
+
+            return RECLS_RC_NO_MORE_DATA;
+        }
+    }
+
+    if (m_frames.size() == m_depth)
+    {
+        m_frames.push_back(frame_type());
+    }
+
+    frame_type& frame = m_frames[m_depth];
+
+    RECLS_ASSERT(frame.fd < 0);
+    RECLS_ASSERT(frame.names.empty());
+
+    frame.dirLen    =   dirLen;
+    frame.depth     =   m_depth;
+
+    if (followsLinks)
+    {
+        frame.dev   =   st.st_dev;
+        frame.ino   =   st.st_ino;
+    }
+
+    if (0 != (RECLS_F_UNSORTED & m_flags))
+    {
+        // The directory is read as its entries are presented, by
+        // StreamCurrent_()
+        frame.streaming = true;
+
+        ++m_depth;
+
+        return RECLS_RC_OK;
+    }
+
+    recls_rc_t rc = ReadDirectory_(frame);
+
+    if (RECLS_FAILED(rc))
+    {
+        m_reader.close();
+
+        frame.clear();
+    }
+    else
+    {
+        frame.fd = m_reader.detach();
+
+        ++m_depth;
+    }
+
+    return rc;
+}
+
+void
+ReclsDirScanSearchDirectoryNode::PopFrame_()
+{
+    RECLS_ASSERT(0 != m_depth);
+
+    frame_type& frame = m_frames[--m_depth];
+
+    if (frame.streaming)
+    {
+        m_reader.close();
+    }
+
+    frame.clear();
+}
+
+bool
+ReclsDirScanSearchDirectoryNode::IsAncestor_(
+    dev_t   dev
+,   ino_t   ino
+) const
+{
+    for (size_t i = 0; i != m_depth; ++i)
+    {
+        frame_type const& frame = m_frames[i];
+
+        if (frame.ino == ino &&
+            frame.dev == dev)
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+bool
+ReclsDirScanSearchDirectoryNode::ClassifyEntry_(
+    frame_type&             frame
+,   dirscan_entry_t const&  de
+,   unsigned char*          type
+)
+{
+    // Entries above the minimum depth are not matched, and directories
+    // beyond the maximum depth are not recorded
+    recls_uint32_t const    flags       =   m_flags;
+    bool const              recursive   =   0 != (RECLS_F_RECURSIVE & flags) && frame.depth < m_maxDepth;
+    bool const              isMatch     =   frame.depth >= m_minDepth && m_matcher.match(de.name, de.nameLen);
+
+    if (!isMatch &&
+        !recursive)
+    {
+        return false;
+    }
+
+    bool const isDirectory  =   dirscan_is_directory(m_reader.get_fd(), de, flags, type);
+    bool const isEntry      =   isMatch && 0 != (flags & (isDirectory ? RECLS_F_DIRECTORIES : RECLS_F_FILES));
+
+    if (isDirectory &&
+        recursive)
+    {
+        item_type item;
+
+        item.nameOffset =   frame.names.size();
+        item.nameLen    =   de.nameLen;
+        item.type       =   *type;
+
+        frame.names.insert(frame.names.end(), de.name, de.name + (1 + de.nameLen));
+        frame.directories.push_back(item);
+    }
+
+    return isEntry;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::ReadDirectory_(
+    frame_type& frame
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::ReadDirectory_");
+
+    dirscan_entry_t de;
+    int             r;
+
+    for (; 1 == (r = m_reader.read(&de)); )
+    {
+        unsigned char type;
+
+        if (!ClassifyEntry_(frame, de, &type))
+        {
+            continue;
+        }
+
+        item_type item;
+
+        item.nameOffset =   frame.names.size();
+        item.nameLen    =   de.nameLen;
+        item.type       =   type;
+
+        frame.names.insert(frame.names.end(), de.name, de.name + (1 + de.nameLen));
+        frame.entries.push_back(item);
+    }
+
+    if (r < 0)
+    {
+        int const e = errno;
+
+        recls_error_trace_printf_(RECLS_LITERAL("could not read directory '%s': %d"), m_path.data(), e);
+
+        return dirscan_rc_from_errno(e);
+    }
+
+    // Entries are presented in name order, as they are by glob()
+    if (!frame.entries.empty())
+    {
+        std::sort(frame.entries.begin(), frame.entries.end(), item_less_(&frame.names[0]));
+    }
+
+    return RECLS_RC_OK;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::Advance_()
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::Advance_");
+
+    RECLS_ASSERT(ss_nullptr_k == m_current);
+
+    for (; 0 != m_depth; )
+    {
+        frame_type& frame   =   m_frames[m_depth - 1];
+        recls_rc_t  rc      =   frame.streaming ? StreamCurrent_(frame) : CreateCurrent_(frame);
+
+        if (RECLS_RC_NO_MORE_DATA != rc)
+        {
+            return rc;
+        }
+
+        if (frame.directoriesIndex == frame.directories.size())
+        {
+            // This directory is exhausted
+            PopFrame_();
+
+            continue;
+        }
+
+        // Descend into the next sub-directory, whose path is formed in the
+        // shared path buffer after that of this directory
+        item_type const&    item    =   frame.directories[frame.directoriesIndex++];
+        recls_char_t const* name    =   &frame.names[item.nameOffset];
+        size_t const        dirLen  =   frame.dirLen + item.nameLen + 1;
+
+        if (!m_path.resize(1 + dirLen))
+        {
+            return RECLS_RC_OUT_OF_MEMORY;
+        }
+
+        types::traits_type::char_copy(&m_path[frame.dirLen], name, item.nameLen);
+        m_path[dirLen - 1] = types::traits_type::path_name_separator();
+        m_path[dirLen] = '\0';
+
+        // NOTE: frame (and name) may not be used after this call, since
+        // m_frames may grow
+        rc = PushFrame_(frame.fd, name, dirLen);
+
+        if (RECLS_SUCCEEDED(rc))
+        {
+            continue;
+        }
+
+        // The sub-directory has been skipped by the progress function, is
+        // on another device, or is an ancestor
+        if (RECLS_RC_NO_MORE_DATA == rc)
+        {
+            continue;
+        }
+
+        if (RECLS_RC_DIRECTORY_NOT_FOUND == rc ||
+            RECLS_RC_PATH_IS_NOT_DIRECTORY == rc)
+        {
+            // The sub-directory has been removed, or replaced, since the
+            // directory was read
+            continue;
+        }
+
+        if (RECLS_RC_ACCESS_DENIED == rc &&
+            0 == (RECLS_F_STOP_ON_ACCESS_FAILURE & m_flags))
+        {
+            continue;
+        }
+
+        return rc;
+    }
+
+    return RECLS_RC_NO_MORE_DATA;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::CreateCurrent_(
+    frame_type& frame
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::CreateCurrent_");
+
+    RECLS_ASSERT(ss_nullptr_k == m_current);
+
+    for (; frame.entriesIndex != frame.entries.size(); ++frame.entriesIndex)
+    {
+        item_type const&    item    =   frame.entries[frame.entriesIndex];
+        recls_char_t const* name    =   &frame.names[item.nameOffset];
+
+        // The entry's path is formed in the shared path buffer, after that
+        // of its directory
+        size_t const        pathLen =   frame.dirLen + item.nameLen;
+
+        if (!m_path.resize(1 + pathLen))
+        {
+            return RECLS_RC_OUT_OF_MEMORY;
+        }
+
+        types::traits_type::char_copy(&m_path[frame.dirLen], name, 1 + item.nameLen);
+
+        recls_rc_t const rc = dirscan_create_entry(frame.fd, m_rootDirLen, m_path.data(), frame.dirLen, item.nameLen, item.type, m_flags, m_arena, &m_sharedDir, &m_current);
+
+        // The entry has been removed since the directory was read
+        if (RECLS_RC_NO_MORE_DATA == rc)
+        {
+            continue;
+        }
+
+        return rc;
+    }
+
+    return RECLS_RC_NO_MORE_DATA;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::StreamCurrent_(
+    frame_type& frame
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::StreamCurrent_");
+
+    RECLS_ASSERT(ss_nullptr_k == m_current);
+    RECLS_ASSERT(frame.streaming);
+
+    dirscan_entry_t de;
+    int             r;
+
+    for (; 1 == (r = m_reader.read(&de)); )
+    {
+        unsigned char type;
+
+        if (!ClassifyEntry_(frame, de, &type))
+        {
+            continue;
+        }
+
+        size_t const pathLen = frame.dirLen + de.nameLen;
+
+        if (!m_path.resize(1 + pathLen))
+        {
+            return RECLS_RC_OUT_OF_MEMORY;
+        }
+
+        types::traits_type::char_copy(&m_path[frame.dirLen], de.name, 1 + de.nameLen);
+
+        recls_rc_t const rc = dirscan_create_entry(m_reader.get_fd(), m_rootDirLen, m_path.data(), frame.dirLen, de.nameLen, type, m_flags, m_arena, &m_sharedDir, &m_current);
+
+        // The entry has been removed since it was read
+        if (RECLS_RC_NO_MORE_DATA == rc)
+        {
+            continue;
+        }
+
+        return rc;
+    }
+
+    if (r < 0)
+    {
+        int const e = errno;
+
+        recls_error_trace_printf_(RECLS_LITERAL("could not read directory '%s': %d"), m_path.data(), e);
+
+        return dirscan_rc_from_errno(e);
+    }
+
+    // The directory is exhausted, and its descriptor is retained for the
+    // opening of its sub-directories
+    frame.fd        =   m_reader.detach();
+    frame.streaming =   false;
+
+    return RECLS_RC_NO_MORE_DATA;
+}
+
+#ifdef RECLS_ENFORCING_CONTRACTS
+recls_bool_t
+ReclsDirScanSearchDirectoryNode::is_valid() const
+{
+    // (i) There can be a current entry only if there is a current directory
+    if (ss_nullptr_k != m_current &&
+        0 == m_depth)
+    {
+        return false;
+    }
+
+    // (ii) The depth cannot exceed the number of frames
+    if (m_depth > m_frames.size())
+    {
+        return false;
+    }
+
+    return true;
+}
+#endif /* RECLS_ENFORCING_CONTRACTS */
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::GetNext()
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::GetNext");
+
+    RECLS_ASSERT(is_valid());
+
+    if (ss_nullptr_k == m_current)
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+
+    Entry_ReleaseOwned(m_current);
+
+    m_current = ss_nullptr_k;
+
+    frame_type& frame = m_frames[m_depth - 1];
+
+    // A streamed directory has no collected entries
+    if (!frame.streaming)
+    {
+        ++frame.entriesIndex;
+    }
+
+    recls_rc_t rc = Advance_();
+
+    RECLS_ASSERT(is_valid());
+
+    return rc;
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::GetDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::GetDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    if (ss_nullptr_k != m_current)
+    {
+        return Entry_Copy(m_current, pinfo);
+    }
+    else
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::BorrowDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::BorrowDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    if (ss_nullptr_k != m_current)
+    {
+        *pinfo = m_current;
+
+        return RECLS_RC_OK;
+    }
+    else
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+}
+
+recls_rc_t
+ReclsDirScanSearchDirectoryNode::GetNextDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsDirScanSearchDirectoryNode::GetNextDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    recls_rc_t rc = GetNext();
+
+    if (RECLS_SUCCEEDED(rc))
+    {
+        rc = GetDetails(pinfo);
+    }
+
+    return rc;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,233 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/ReclsDirScanSearchDirectoryNode_linux.hpp
+ *
+ * Purpose: ReclsDirScanSearchDirectoryNode class.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+// recls includes
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.types.hpp"
+#include "impl.util.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include "impl.dirscan.linux.hpp"
+
+#include "ReclsSearch.hpp"
+
+// Standard includes
+#include <vector>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class ReclsDirScanSearchDirectoryNode
+/// Search node that traverses an entire directory tree, reading each
+/// directory exactly once, via getdents64(), and splitting the results into
+/// matching entries and sub-directories in memory.
+///
+/// Rather than a chain of nodes, one per directory level, the traversal is
+/// held in a single stack of compact frames, which are reused as the
+/// traversal ascends and descends, and which share a single path buffer.
+/// Sub-directories are opened, and entries stat()-ed, relative to the
+/// descriptor of their parent directory.
+///
+/// When RECLS_F_UNSORTED is specified, the entries of a directory are not
+/// collected and sorted, but are instead presented as the directory is
+/// read, only the names of its sub-directories being retained.
+class ReclsDirScanSearchDirectoryNode
+    : public ReclsSearchDirectoryNode
+{
+public:
+    typedef ReclsDirScanSearchDirectoryNode                 class_type;
+    typedef types::buffer_type                              buffer_type;
+    typedef types::string_type                              string_type;
+private:
+    /// Describes a name held in a frame's name buffer
+    struct item_type
+    {
+        size_t          nameOffset;
+        size_t          nameLen;
+        unsigned char   type;       // DT_*, resolved if stat()-ed during the read
+    };
+    typedef std::vector<item_type, stl_allocator<item_type> > items_type;
+    typedef std::vector<char, stl_allocator<char> >         names_type;
+
+    /// The traversal state of a single directory
+    ///
+    /// \note Frames are retained when the traversal ascends, so that their
+    ///   buffers may be reused by subsequent directories at the same depth
+    struct frame_type
+    {
+        int         fd;         // -1 while the directory is being streamed
+        dev_t       dev;        // Identifies the directory, when links are followed
+        ino_t       ino;
+        size_t      dirLen;     // Length of the directory's path, including trailing separator
+        size_t      depth;      // Of the entries, below the search directory
+        bool        streaming;  // Whether the directory is being read, by m_reader
+        names_type  names;
+        items_type  entries;
+        size_t      entriesIndex;
+        items_type  directories;
+        size_t      directoriesIndex;
+
+        frame_type();
+
+        void clear();
+    };
+    typedef std::vector<frame_type, stl_allocator<frame_type> > frames_type;
+
+    struct item_less_;
+
+// Construction
+protected: // Not private, or GCC whines
+    ReclsDirScanSearchDirectoryNode(
+        recls_uint32_t              flags
+    ,   size_t                      rootDirLen
+    ,   recls_uint32_t              minDepth
+    ,   recls_uint32_t              maxDepth
+    ,   entry_arena_t*              arena
+    ,   hrecls_progress_fn_t        pfn
+    ,   recls_process_fn_param_t    param
+    );
+public:
+    virtual ~ReclsDirScanSearchDirectoryNode();
+private:
+    ReclsDirScanSearchDirectoryNode(class_type const &);    // copy-construction proscribed
+    void operator =(class_type const &);                    // copy-assignment proscribed
+public:
+
+    /// Indicates whether the single-pass traversal can perform the search
+    /// described by the given flags and pattern(s)
+    static
+    bool
+    IsApplicable(
+        recls_uint32_t          flags
+    ,   recls_char_t const*     pattern
+    ,   size_t                  patternLen
+    );
+
+    /// Creates the node that performs a search
+    ///
+    /// \param minDepth The minimum depth of the entries presented
+    /// \param maxDepth The maximum depth of the entries presented, beyond
+    ///   which directories are not opened
+    /// \param arena The arena from which the entries are allocated, or NULL
+    ///
+    /// \pre nullptr != searchDir
+    /// \pre searchDir is absolute, and has a trailing path-name separator
+    static
+    ReclsSearchDirectoryNode*
+    FindAndCreate(
+        recls_uint32_t              flags
+    ,   recls_char_t const*         searchDir
+    ,   size_t                      searchDirLen
+    ,   recls_char_t const*         pattern
+    ,   size_t                      patternLen
+    ,   recls_uint32_t              minDepth
+    ,   recls_uint32_t              maxDepth
+    ,   entry_arena_t*              arena
+    ,   hrecls_progress_fn_t        pfn
+    ,   recls_process_fn_param_t    param
+    ,   recls_rc_t*                 prc
+    );
+
+// ReclsSearchDirectoryNode methods
+private:
+    /* virtual */ recls_rc_t GetNext();
+    /* virtual */ recls_rc_t GetDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t GetNextDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t BorrowDetails(recls_entry_t* pinfo);
+    /* virtual */ bool       IsRestartable() const;
+    /* virtual */ recls_rc_t Restart(
+        recls_char_t const*     searchDir
+    ,   size_t                  searchDirLen
+    ,   recls_char_t const*     pattern
+    ,   size_t                  patternLen
+    );
+
+// Implementation
+private:
+    recls_rc_t      Initialise(
+        recls_char_t const*     searchDir
+    ,   size_t                  searchDirLen
+    ,   recls_char_t const*     pattern
+    ,   size_t                  patternLen
+    );
+    recls_rc_t      PushFrame_(int parentFd, recls_char_t const* name, size_t dirLen);
+    void            PopFrame_();
+    bool            IsAncestor_(dev_t dev, ino_t ino) const;
+    recls_rc_t      ReadDirectory_(frame_type& frame);
+    bool            ClassifyEntry_(frame_type& frame, dirscan_entry_t const& de, unsigned char* type);
+    recls_rc_t      Advance_();
+    recls_rc_t      CreateCurrent_(frame_type& frame);
+    recls_rc_t      StreamCurrent_(frame_type& frame);
+
+#ifdef RECLS_ENFORCING_CONTRACTS
+    recls_bool_t    is_valid() const;
+#endif /* RECLS_ENFORCING_CONTRACTS */
+
+// Members
+private:
+    recls_uint32_t const            m_flags;
+    size_t                          m_rootDirLen;   // Changed only by Restart()
+    recls_uint32_t const            m_minDepth;
+    recls_uint32_t const            m_maxDepth;
+    entry_arena_t* const            m_arena;
+    entry_shared_directory_t*       m_sharedDir;    // Created on demand, by dirscan_create_entry()
+    hrecls_progress_fn_t const      m_pfn;
+    recls_process_fn_param_t const  m_param;
+    dirscan_matcher                 m_matcher;
+    void*                           m_scanBuffer;
+    dirscan_reader                  m_reader;       // Reads the directory of the deepest frame
+    buffer_type                     m_path;
+    frames_type                     m_frames;
+    size_t                          m_depth;
+    dev_t                           m_rootDevice;   // When RECLS_F_SAME_DEVICE
+    recls_entry_t                   m_current;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -4,11 +4,11 @@
  * Purpose: Implementation of the ReclsFileSearch class for Windows.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -33,6 +33,13 @@
 #include "ReclsSearch.hpp"
 #include "ReclsFileSearch.hpp"
 #include "ReclsFileSearchDirectoryNode.hpp"
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# include "ReclsDirScanSearchDirectoryNode_linux.hpp"
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include "ReclsParallelSearchDirectoryNode_linux.hpp"
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+#include "impl.api.search.h"
 
 #include "impl.trace.h"
 
@@ -71,7 +78,7 @@ inline void* ReclsFileSearch::operator new(size_t cb, size_t cDirParts, size_t c
     cb  +=  (cDirParts) * sizeof(recls_strptrs_t);
     cb  +=  cbRootDir;
 
-    void* pv = malloc(cb);
+    void* pv = recls_malloc_(cb);
 
 #ifdef RECLS_COMPILER_THROWS_ON_NEW_FAIL
     if (ss_nullptr_k == pv)
@@ -91,7 +98,7 @@ inline void ReclsFileSearch::operator delete(void* pv, size_t /* cDirParts */, s
 {
     function_scope_trace("ReclsFileSearch::operator delete");
 
-    free(pv);
+    recls_free_(pv);
 }
 #endif /* RECLS_COMPILER_REQUIRES_MATCHING_PLACEMENT_DELETE */
 
@@ -99,7 +106,7 @@ inline void ReclsFileSearch::operator delete(void* pv)
 {
     function_scope_trace("ReclsFileSearch::operator delete");
 
-    free(pv);
+    recls_free_(pv);
 }
 
 /* static */ recls_rc_t
@@ -111,6 +118,7 @@ ReclsFileSearch::FindAndCreate(
 ,   recls_uint32_t              flags
 ,   hrecls_progress_fn_t        pfn
 ,   recls_process_fn_param_t    param
+,   search_options_t const*     options
 ,   ReclsFileSearch**           ppsi
 )
 {
@@ -139,7 +147,7 @@ ReclsFileSearch::FindAndCreate(
     ,   param
     );
 
-    return FindAndCreate_(searchDir, searchDirLen, pattern, patternLen, flags, pfn, param, ppsi);
+    return FindAndCreate_(searchDir, searchDirLen, pattern, patternLen, flags, pfn, param, options, ppsi);
 }
 
 /* static */ recls_rc_t
@@ -151,6 +159,7 @@ ReclsFileSearch::FindAndCreate_(
 ,   recls_uint32_t              flags
 ,   hrecls_progress_fn_t        pfn
 ,   recls_process_fn_param_t    param
+,   search_options_t const*     options
 ,   class_type**                ppsi
 )
 {
@@ -209,7 +218,7 @@ ReclsFileSearch::FindAndCreate_(
         try
         {
 #endif /* RECLS_COMPILER_THROWS_ON_NEW_FAIL */
-            si = new(cDirParts, sizeof(recls_char_t) * (1 + searchDirLen)) ReclsFileSearch(cDirParts, searchDir, searchDirLen, pattern, patternLen, pfn, param, flags, &rc);
+            si = new(cDirParts, sizeof(recls_char_t) * (1 + searchDirLen)) ReclsFileSearch(cDirParts, searchDir, searchDirLen, pattern, patternLen, pfn, param, flags, options, &rc);
 #ifdef RECLS_COMPILER_THROWS_ON_NEW_FAIL
         }
         catch(std::bad_alloc&)
@@ -251,7 +260,7 @@ ReclsFileSearch::FindAndCreate_(
     return rc;
 }
 
-recls_char_t const*
+recls_char_t*
 ReclsFileSearch::calc_rootDir_(
     size_t              cDirParts
 ,   recls_char_t const* searchDir
@@ -278,13 +287,19 @@ ReclsFileSearch::ReclsFileSearch(
 ,   hrecls_progress_fn_t        pfn
 ,   recls_process_fn_param_t    param
 ,   recls_uint32_t              flags
+,   search_options_t const*     options
 ,   recls_rc_t*                 prc
 )
     : m_flags(flags)
-    , m_searchDir(calc_rootDir_(cDirParts, searchDir, searchDirLen))
+    , m_rootDir(calc_rootDir_(cDirParts, searchDir, searchDirLen))
+    , m_rootDirCapacity(searchDirLen)
+    , m_searchDir(m_rootDir)
     , m_searchDirLen(searchDirLen)
     , m_pfn(pfn)
     , m_param(param)
+    , m_options()
+    , m_pattern(1)
+    , m_rootDirBuffer(1)
 {
     function_scope_trace("ReclsFileSearch::ReclsFileSearch");
 
@@ -309,8 +324,244 @@ ReclsFileSearch::ReclsFileSearch(
 # error Platform not recognised
 #endif /* platform*/
 
+    // The options and pattern are retained, for Restart()
+    if (ss_nullptr_k != options)
+    {
+        m_options = *options;
+    }
+    else
+    {
+        m_options.maxDepth = RECLS_DEPTH_UNLIMITED;
+    }
+    m_options.restart = ss_nullptr_k;
+
+    if (!m_pattern.resize(1 + patternLen))
+    {
+        *prc = RECLS_RC_OUT_OF_MEMORY;
+
+        return;
+    }
+
+    types::traits_type::char_copy(&m_pattern[0], pattern, patternLen);
+    m_pattern[patternLen] = '\0';
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    bool const              parallel    =   m_options.parallel &&
+                                            ReclsDirScanSearchDirectoryNode::IsApplicable(m_flags, pattern, patternLen);
+#else /* ? RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+    bool const              parallel    =   false;
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    // The entries of a parallel search are created by its worker threads,
+    // so are not allocated from an arena. If the arena cannot be created,
+    // the entries are allocated from the heap.
+    if (!parallel &&
+        0 != (RECLS_F_RECYCLE_ENTRIES & m_flags))
+    {
+        m_arena = Entry_CreateArena(m_options.localEntries ? RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_ : 0);
+    }
+
     // Now start the search
-    m_dnode = ReclsFileSearchDirectoryNode::FindAndCreate(m_flags, searchDir, m_searchDirLen, pattern, patternLen, pfn, param, prc);
+    CreateNode_(patternLen, prc);
+}
+
+void
+ReclsFileSearch::CreateNode_(
+    size_t      patternLen
+,   recls_rc_t* prc
+)
+{
+    function_scope_trace("ReclsFileSearch::CreateNode_");
+
+    RECLS_ASSERT(ss_nullptr_k == m_dnode);
+
+    recls_char_t const* const   pattern     =   m_pattern.data();
+    recls_uint32_t const        minDepth    =   m_options.minDepth;
+    recls_uint32_t const        maxDepth    =   m_options.maxDepth;
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    if (m_options.parallel &&
+        ReclsDirScanSearchDirectoryNode::IsApplicable(m_flags, pattern, patternLen))
+    {
+        m_dnode = ReclsParallelSearchDirectoryNode::FindAndCreate(m_flags, m_searchDir, m_searchDirLen, pattern, patternLen, m_options, prc);
+    }
+    else
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+    if (ReclsDirScanSearchDirectoryNode::IsApplicable(m_flags, pattern, patternLen))
+    {
+        m_dnode = ReclsDirScanSearchDirectoryNode::FindAndCreate(m_flags, m_searchDir, m_searchDirLen, pattern, patternLen, minDepth, maxDepth, m_arena, m_pfn, m_param, prc);
+    }
+    else
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+    {
+        m_dnode = ReclsFileSearchDirectoryNode::FindAndCreate(m_flags, m_searchDir, m_searchDirLen, pattern, patternLen, 0, minDepth, maxDepth, 0, m_arena, m_pfn, m_param, prc);
+    }
+}
+
+recls_rc_t
+ReclsFileSearch::Restart(
+    recls_char_t const* searchDir
+,   size_t              searchDirLen
+,   recls_char_t const* pattern
+,   size_t              patternLen
+,   recls_uint32_t      flags
+)
+{
+    function_scope_trace("ReclsFileSearch::Restart");
+
+    RECLS_ASSERT(ss_nullptr_k != searchDir);
+    RECLS_ASSERT(searchDirLen == types::traits_type::str_len(searchDir));
+    RECLS_ASSERT(types::traits_type::is_path_absolute(searchDir, searchDirLen));
+    RECLS_ASSERT(types::traits_type::has_dir_end(searchDir, searchDirLen));
+
+    RECLS_ASSERT(ss_nullptr_k != pattern);
+    RECLS_ASSERT(patternLen == types::traits_type::str_len(pattern));
+
+    recls_debug1_trace_printf_(
+        RECLS_LITERAL("ReclsFileSearch::Restart(%.*s, %.*s, 0x%08x)")
+    ,   int(searchDirLen), searchDir
+    ,   int(patternLen), pattern
+    ,   flags
+    );
+
+    // Any current enumeration is abandoned, its node being retained for
+    // reuse if it can be restarted. If the search cannot be restarted it
+    // is left at its end.
+    if (ss_nullptr_k != m_dnode)
+    {
+        EndSearch_();
+    }
+
+    recls_rc_t rc = RECLS_RC_OK;
+
+    if (!types::traits_type::file_exists(searchDir))
+    {
+        rc = RECLS_RC_DIRECTORY_NOT_FOUND;
+    }
+    else if (!types::traits_type::is_directory(searchDir))
+    {
+        rc = RECLS_RC_PATH_IS_NOT_DIRECTORY;
+    }
+    else
+    {
+        // The search directory and pattern are not copied if they are those
+        // already held, as they are when they are not changed by the reset
+        if (searchDir != m_searchDir)
+        {
+            recls_char_t* s = m_rootDir;
+
+            if (searchDirLen > m_rootDirCapacity)
+            {
+                if (!m_rootDirBuffer.resize(1 + searchDirLen))
+                {
+                    return (m_lastError = RECLS_RC_OUT_OF_MEMORY);
+                }
+
+                s = &m_rootDirBuffer[0];
+            }
+
+            types::traits_type::char_copy(s, searchDir, searchDirLen);
+            s[searchDirLen] = '\0';
+
+            m_searchDir     =   s;
+            m_searchDirLen  =   searchDirLen;
+        }
+
+        if (pattern != m_pattern.data())
+        {
+            if (!m_pattern.resize(1 + patternLen))
+            {
+                return (m_lastError = RECLS_RC_OUT_OF_MEMORY);
+            }
+
+            types::traits_type::char_copy(&m_pattern[0], pattern, patternLen);
+            m_pattern[patternLen] = '\0';
+        }
+
+        // A node's flags are fixed, so it cannot be reused if they change
+        if (flags != m_flags)
+        {
+            m_flags = flags;
+
+            delete m_idleNode;
+
+            m_idleNode = ss_nullptr_k;
+        }
+
+        rc = RECLS_RC_NOT_IMPLEMENTED;
+
+        if (ss_nullptr_k != m_idleNode)
+        {
+            rc = m_idleNode->Restart(m_searchDir, m_searchDirLen, m_pattern.data(), patternLen);
+
+            if (RECLS_RC_OK == rc)
+            {
+                m_dnode     =   m_idleNode;
+                m_idleNode  =   ss_nullptr_k;
+            }
+        }
+
+        if (RECLS_RC_NOT_IMPLEMENTED == rc)
+        {
+            delete m_idleNode;
+
+            m_idleNode = ss_nullptr_k;
+
+            rc = RECLS_RC_OK;
+
+            CreateNode_(patternLen, &rc);
+
+            if (ss_nullptr_k != m_dnode)
+            {
+                rc = RECLS_RC_OK;
+            }
+            else if (RECLS_SUCCEEDED(rc))
+            {
+                rc = RECLS_RC_NO_MORE_DATA;
+            }
+        }
+    }
+
+    RECLS_ASSERT(RECLS_RC_OK == rc || ss_nullptr_k == m_dnode);
+
+    return (m_lastError = rc);
+}
+
+recls_rc_t
+ReclsFileSearch::Reset(
+    recls_char_t const* searchRoot
+,   recls_char_t const* pattern
+)
+{
+    function_scope_trace("ReclsFileSearch::Reset");
+
+    search_options_t    options =   m_options;
+    hrecls_t            hSrch;
+
+    options.restart = this;
+
+    // Any current enumeration is ended here, rather than by Restart(), as
+    // the new search root and pattern may be rejected before it is called
+    if (ss_nullptr_k != m_dnode)
+    {
+        EndSearch_();
+    }
+
+    // The new search root and pattern are processed exactly as are those
+    // of a new search, before being passed to Restart()
+    recls_rc_t const rc = Recls_SearchFeedback_(
+        "Recls_SearchReset"
+    ,   (ss_nullptr_k != searchRoot) ? searchRoot : m_searchDir
+    ,   (ss_nullptr_k != pattern) ? pattern : m_pattern.data()
+    ,   m_flags
+    ,   m_pfn
+    ,   m_param
+    ,   &options
+    ,   &hSrch
+    );
+
+    return (m_lastError = rc);
 }
 
 ReclsFileSearch::~ReclsFileSearch() STLSOFT_NOEXCEPT
@@ -4,11 +4,11 @@
  * Purpose: Definition of the ReclsFileSearch class.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -25,6 +25,8 @@
  */
 
 #include <recls/recls.h>
+#include "impl.types.hpp"
+#include "impl.api.search.h"
 #include "ReclsSearch.hpp"
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -78,6 +80,7 @@ protected:
     ,   hrecls_progress_fn_t        pfn
     ,   recls_process_fn_param_t    param
     ,   recls_uint32_t              flags
+    ,   search_options_t const*     options
     ,   recls_rc_t*                 prc
     );
     ~ReclsFileSearch() STLSOFT_NOEXCEPT;
@@ -91,6 +94,7 @@ public:
     // \param flags Flags to control the search
     // \param pfn Progress callback function
     // \param param Progress callback function parameter
+    // \param options Additional options, or nullptr
     // \param ppsi Out-parameter to receive the instance obtained upon success
     //
     // \pre nullptr != searchDir
@@ -109,6 +113,7 @@ public:
     ,   recls_uint32_t              flags
     ,   hrecls_progress_fn_t        pfn
     ,   recls_process_fn_param_t    param
+    ,   search_options_t const*     options
     ,   class_type**                ppsi
     );
 private:
@@ -116,14 +121,44 @@ private:
     void operator =(class_type const &);    // copy-assignment proscribed
 public:
 
+    // Restarts the search from the given search directory, with the given
+    // pattern and flags, reusing the search's node where possible
+    //
+    // \pre nullptr != searchDir
+    // \pre types::traits_type::is_path_absolute(searchDir, searchDirLen)
+    // \pre types::traits_type::has_dir_end(searchDir, searchDirLen)
+    //
+    // \retval RECLS_RC_OK The search has been restarted, and is positioned
+    //   on its first entry
+    // \retval RECLS_RC_NO_MORE_DATA The search has been restarted, but has
+    //   no entries
+    recls_rc_t
+    Restart(
+        recls_char_t const*         searchDir
+    ,   size_t                      searchDirLen
+    ,   recls_char_t const*         pattern
+    ,   size_t                      patternLen
+    ,   recls_uint32_t              flags
+    );
+
+// ReclsSearch methods
+public:
+    /* virtual */ recls_rc_t Reset(recls_char_t const* searchRoot, recls_char_t const* pattern);
+
 private: // implementation
-    recls_char_t const*
+    recls_char_t*
     calc_rootDir_(
         size_t              cDirParts
     ,   recls_char_t const* searchDir
     ,   size_t              searchDirLen
     );
 
+    void
+    CreateNode_(
+        size_t              patternLen
+    ,   recls_rc_t*         prc
+    );
+
     static
     recls_rc_t
     FindAndCreate_(
@@ -134,15 +169,21 @@ private: // implementation
     ,   recls_uint32_t              flags
     ,   hrecls_progress_fn_t        pfn
     ,   recls_process_fn_param_t    param
+    ,   search_options_t const*     options
     ,   class_type**                ppsi
     );
 
 private: // fields
     recls_uint32_t                  m_flags;
-    recls_char_t const* const       m_searchDir;
-    size_t const                    m_searchDirLen;
+    recls_char_t* const             m_rootDir;      // Storage for search directories no longer than the original
+    size_t const                    m_rootDirCapacity;
+    recls_char_t const*             m_searchDir;    // In m_rootDir, or in m_rootDirBuffer
+    size_t                          m_searchDirLen;
     hrecls_progress_fn_t const      m_pfn;
     recls_process_fn_param_t const  m_param;
+    search_options_t                m_options;
+    types::buffer_type              m_pattern;
+    types::buffer_type              m_rootDirBuffer;
 
     /** The opaque data of the search */
     recls_byte_t                    data[1];
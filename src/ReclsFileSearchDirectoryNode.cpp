@@ -4,11 +4,11 @@
  * Purpose: Implementation of the ReclsFileSearchDirectoryNode class.
  *
  * Created: 31st May 2004
- * Updated: 20th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -32,6 +32,9 @@
 #include "impl.util.h"
 #include "impl.entryfunctions.h"
 #include "impl.entryinfo.hpp"
+#if defined(RECLS_PLATFORM_IS_UNIX)
+# include "impl.statx.linux.hpp"
+#endif /* RECLS_PLATFORM_IS_UNIX */
 
 #include "ReclsFileSearchDirectoryNode.hpp"
 
@@ -83,6 +86,13 @@ ReclsFileSearchDirectoryNode::essFlags_from_reclsFlags_(
         ssFlags |= sequence_t::directories;
     }
 
+    if (0 != (flags & RECLS_F_UNSORTED))
+    {
+#if defined(RECLS_PLATFORM_IS_UNIX)
+        ssFlags |= sequence_t::noSort;
+#endif /* platform */
+    }
+
     if (0 != (flags & RECLS_F_STOP_ON_ACCESS_FAILURE))
     {
 #if defined(_WINSTL_VER) && \
@@ -167,6 +177,39 @@ ReclsFileSearchDirectoryNode::select_iter_if_(
     }
 }
 
+/* static */ int
+ReclsFileSearchDirectoryNode::InvokeProgress_(
+    recls_uint32_t              flags
+,   hrecls_progress_fn_t        pfn
+,   recls_process_fn_param_t    param
+,   recls_char_t const*         dir
+,   size_t                      dirLen
+)
+{
+    function_scope_trace("ReclsFileSearchDirectoryNode::InvokeProgress_");
+
+    RECLS_ASSERT(ss_nullptr_k != pfn);
+
+#if defined(RECLS_PLATFORM_IS_WINDOWS)
+    if (flags & RECLS_F_CALLBACKS_STDCALL_ON_WINDOWS)
+    {
+        typedef int (RECLS_CALLCONV_STDDECL *stdcall_progress_fn_t)(recls_char_t const*
+                                                                ,   size_t
+                                                                ,   recls_process_fn_param_t
+                                                                ,   void*
+                                                                ,   recls_uint32_t);
+
+        stdcall_progress_fn_t   pfn_stdcall =   (stdcall_progress_fn_t)pfn;
+
+        return (*pfn_stdcall)(dir, dirLen, param, ss_nullptr_k, 0);
+    }
+#else /* ? RECLS_PLATFORM_IS_WINDOWS */
+    STLSOFT_SUPPRESS_UNUSED(flags);
+#endif /* RECLS_PLATFORM_IS_WINDOWS */
+
+    return (*pfn)(dir, dirLen, param, ss_nullptr_k, 0);
+}
+
 /* static */ ReclsFileSearchDirectoryNode::path_buffer_type
 ReclsFileSearchDirectoryNode::prepare_searchDir_(
     recls_char_t const*     searchDir
@@ -196,23 +239,33 @@ ReclsFileSearchDirectoryNode::CreateEntryInfo(
 ,   size_t                                                              searchDirLen
 ,   recls_uint32_t                                                      flags
 ,   ReclsFileSearchDirectoryNode::entry_sequence_type::const_iterator   it
+,   entry_arena_t*                                                      arena
+,   entry_shared_directory_t**                                          psharedDir
 )
 {
     function_scope_trace("ReclsFileSearchDirectoryNode::CreateEntryInfo");
 
 #if defined(RECLS_PLATFORM_IS_UNIX)
 
+    struct stat         st;
+    recls_char_t const* entryPath = *it;
+
+# if defined(RECLS_USE_STATX_)
+    int const           atFlags =   (RECLS_F_LINKS == (flags & RECLS_F_LINKS)) ? AT_SYMLINK_NOFOLLOW : 0;
+
+    // This traversal does not defer details, so all are requested
+    if (0 != statx_stat(AT_FDCWD, entryPath, atFlags, flags & ~recls_uint32_t(RECLS_F_DETAILS_LATER), &st))
+# else /* ? RECLS_USE_STATX_ */
     typedef int (*PfnStat)(char const*, struct stat*);
 
-# if defined(RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS)
+#  if defined(RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS)
     PfnStat             pfn =   ::stat;
-# else /* ? RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS */
+#  else /* ? RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS */
     PfnStat             pfn =   (RECLS_F_LINKS == (flags & RECLS_F_LINKS)) ? ::lstat : ::stat;
-# endif /* RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS */
-    struct stat         st;
-    recls_char_t const* entryPath = *it;
+#  endif /* RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS */
 
     if (0 != (*pfn)(entryPath, &st))
+# endif /* RECLS_USE_STATX_ */
     {
         // This will cause RECLS_F_OUT_OF_MEMORY.
         // TODO: Fix it!
@@ -226,7 +279,7 @@ ReclsFileSearchDirectoryNode::CreateEntryInfo(
         size_t const        entryFileLen    =   entryPathLen - (entryFile - entryPath);
         RECLS_ASSERT(entryFileLen == types::traits_type::str_len(entryFile));
 
-        return create_entryinfo(rootDirLen, searchDir, searchDirLen, entryPath, entryPathLen, entryFile, entryFileLen, flags, &st);
+        return create_entryinfo(rootDirLen, searchDir, searchDirLen, entryPath, entryPathLen, entryFile, entryFileLen, flags, &st, arena, psharedDir);
     }
 #elif defined(RECLS_PLATFORM_IS_WINDOWS)
     // In this case:
@@ -247,7 +300,7 @@ ReclsFileSearchDirectoryNode::CreateEntryInfo(
     size_t const        entryFileLen    =   entryPathLen - (entryFile - entryPath);
     RECLS_ASSERT(entryFileLen == types::traits_type::str_len(entryFile));
 
-    return create_entryinfo(rootDirLen, searchDir, searchDirLen, entryPath, entryPathLen, entryFile, entryFileLen, flags, &value.get_find_data());
+    return create_entryinfo(rootDirLen, searchDir, searchDirLen, entryPath, entryPathLen, entryFile, entryFileLen, flags, &value.get_find_data(), arena, psharedDir);
 #else /* ? platform */
 # error Platform not discriminated
 #endif /* platform */
@@ -259,6 +312,11 @@ ReclsFileSearchDirectoryNode::ReclsFileSearchDirectoryNode(
 ,   size_t                      rootDirLen
 ,   recls_char_t const*         pattern
 ,   size_t                      patternLen
+,   recls_uint32_t              depth
+,   recls_uint32_t              minDepth
+,   recls_uint32_t              maxDepth
+,   recls_uint64_t              device
+,   entry_arena_t*              arena
 ,   hrecls_progress_fn_t        pfn
 ,   recls_process_fn_param_t    param
 )
@@ -269,6 +327,12 @@ ReclsFileSearchDirectoryNode::ReclsFileSearchDirectoryNode(
     , m_searchDir(prepare_searchDir_(searchDir))
     , m_pattern(pattern)
     , m_patternLen(patternLen)
+    , m_depth(depth)
+    , m_minDepth(minDepth)
+    , m_maxDepth(maxDepth)
+    , m_device(device)
+    , m_arena(arena)
+    , m_sharedDir(ss_nullptr_k)
     , m_directories(
             searchDir
 #if defined(RECLS_PLATFORM_IS_WINDOWS)    // Windows uses findfile_sequence, which takes wildcards
@@ -276,7 +340,7 @@ ReclsFileSearchDirectoryNode::ReclsFileSearchDirectoryNode(
 #endif /* platform */
         ,   dssFlags_from_reclsFlags_(flags)
         )
-    , m_directoriesBegin(select_iter_if_((flags & RECLS_F_RECURSIVE), m_directories.begin(), m_directories.end()))
+    , m_directoriesBegin(select_iter_if_((flags & RECLS_F_RECURSIVE) && depth < maxDepth, m_directories.begin(), m_directories.end()))
     , m_entries(
             searchDir
         ,   pattern
@@ -295,6 +359,12 @@ ReclsFileSearchDirectoryNode::ReclsFileSearchDirectoryNode(
     RECLS_ASSERT(types::traits_type::str_len(m_searchDir.data()) == m_searchDir.size());
     RECLS_ASSERT(types::traits_type::is_path_name_separator(m_searchDir.back()));
 
+    // Entries above the minimum depth are not presented
+    if (depth < minDepth)
+    {
+        m_entriesBegin = m_entries.end();
+    }
+
     RECLS_ASSERT(STLSOFT_RAW_OFFSETOF(ReclsFileSearchDirectoryNode, m_entries) < STLSOFT_RAW_OFFSETOF(ReclsFileSearchDirectoryNode, m_entriesBegin));
     RECLS_ASSERT(STLSOFT_RAW_OFFSETOF(ReclsFileSearchDirectoryNode, m_directories) < STLSOFT_RAW_OFFSETOF(ReclsFileSearchDirectoryNode, m_directoriesBegin));
 
@@ -311,6 +381,11 @@ ReclsFileSearchDirectoryNode::FindAndCreate(
 ,   size_t                      rootDirLen
 ,   recls_char_t const*         pattern
 ,   size_t                      patternLen
+,   recls_uint32_t              depth
+,   recls_uint32_t              minDepth
+,   recls_uint32_t              maxDepth
+,   recls_uint64_t              device
+,   entry_arena_t*              arena
 ,   hrecls_progress_fn_t        pfn
 ,   recls_process_fn_param_t    param
 ,   recls_rc_t*                 prc
@@ -334,7 +409,51 @@ ReclsFileSearchDirectoryNode::FindAndCreate(
     try
     {
 #endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
-        node = new ReclsFileSearchDirectoryNode(flags, searchDir, rootDirLen, pattern, patternLen, pfn, param);
+#if defined(RECLS_PLATFORM_IS_UNIX)
+        // A sub-directory on another device is not listed
+        if (0 != (RECLS_F_SAME_DEVICE & flags))
+        {
+            struct stat st;
+
+            if (0 == ::stat(searchDir, &st))
+            {
+                if (0 == depth)
+                {
+                    device = static_cast<recls_uint64_t>(st.st_dev);
+                }
+                else if (device != static_cast<recls_uint64_t>(st.st_dev))
+                {
+                    recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is on another device"), searchDir);
+
+                    *prc = RECLS_RC_NO_MORE_DATA;
+
+                    return ss_nullptr_k;
+                }
+            }
+        }
+#endif /* RECLS_PLATFORM_IS_UNIX */
+
+        // The progress function is invoked before the directory is listed,
+        // so that a skipped directory costs nothing
+        if (ss_nullptr_k != pfn)
+        {
+            path_buffer_type const dir = prepare_searchDir_(searchDir);
+
+            switch (InvokeProgress_(flags, pfn, param, dir.data(), dir.size()))
+            {
+                case RECLS_PROGRESS_CANCEL:
+                    *prc = RECLS_RC_USER_CANCELLED_SEARCH;
+                    return ss_nullptr_k;
+                case RECLS_PROGRESS_SKIP_DIRECTORY:
+                    recls_debug2_trace_printf_(RECLS_LITERAL("skipping directory '%s'"), dir.data());
+                    *prc = RECLS_RC_NO_MORE_DATA;
+                    return ss_nullptr_k;
+                default:
+                    break;
+            }
+        }
+
+        node = new ReclsFileSearchDirectoryNode(flags, searchDir, rootDirLen, pattern, patternLen, depth, minDepth, maxDepth, device, arena, pfn, param);
 #ifdef STLSOFT_CF_EXCEPTION_SUPPORT
     }
 # if _STLSOFT_VER >= 0x01097bff
@@ -463,7 +582,13 @@ ReclsFileSearchDirectoryNode::Stat(
     types::traits_type::stat_data_type  st;
     types::traits_type::stat_data_type* pst = &st;
 
+#if defined(RECLS_USE_STATX_)
+    // RECLS_F_DETAILS_LATER here only allows for non-existent paths, so it
+    // does not limit the details requested
+    if (0 != statx_stat(AT_FDCWD, path, 0, flags & ~recls_uint32_t(RECLS_F_DETAILS_LATER), &st))
+#else /* ? RECLS_USE_STATX_ */
     if (!types::traits_type::stat(path, &st))
+#endif /* RECLS_USE_STATX_ */
     {
         recls_log_printf_(
           (flags & RECLS_F_DETAILS_LATER) ? RECLS_SEVIX_INFO : RECLS_SEVIX_WARN
@@ -488,7 +613,7 @@ ReclsFileSearchDirectoryNode::Stat(
         size_t const        entryFileLen    =   pathLen2 - entryDirLen;
         RECLS_ASSERT(entryFileLen == types::traits_type::str_len(entryFile));
 
-        *phEntry = create_entryinfo(pathLen2, path, entryDirLen, path, pathLen2, entryFile, entryFileLen, flags, pst);
+        *phEntry = create_entryinfo(pathLen2, path, entryDirLen, path, pathLen2, entryFile, entryFileLen, flags, pst, ss_nullptr_k, ss_nullptr_k);
 
         return (ss_nullptr_k == *phEntry) ? RECLS_RC_OUT_OF_MEMORY : RECLS_RC_OK;
     }
@@ -504,9 +629,11 @@ ReclsFileSearchDirectoryNode::~ReclsFileSearchDirectoryNode()
 {
     function_scope_trace("ReclsFileSearchDirectoryNode::~ReclsFileSearchDirectoryNode");
 
-    Entry_Release(m_current);
+    Entry_ReleaseOwned(m_current);
 
     delete m_dnode;
+
+    Entry_ReleaseSharedDirectory(m_sharedDir);
 }
 
 recls_rc_t ReclsFileSearchDirectoryNode::Initialise()
@@ -518,37 +645,12 @@ recls_rc_t ReclsFileSearchDirectoryNode::Initialise()
     RECLS_ASSERT(ss_nullptr_k == m_current);
     RECLS_ASSERT(ss_nullptr_k == m_dnode);
 
-    if (ss_nullptr_k != m_pfn)
-    {
-#if defined(RECLS_PLATFORM_IS_WINDOWS)
-        if (m_flags & RECLS_F_CALLBACKS_STDCALL_ON_WINDOWS)
-        {
-            typedef int (RECLS_CALLCONV_STDDECL *stdcall_progress_fn_t)(recls_char_t const*
-                                                                    ,   size_t
-                                                                    ,   recls_process_fn_param_t
-                                                                    ,   void*
-                                                                    ,   recls_uint32_t);
-
-            stdcall_progress_fn_t   pfn_stdcall =   (stdcall_progress_fn_t)m_pfn;
-
-            (*pfn_stdcall)(m_searchDir.data(), m_searchDir.size(), m_param, ss_nullptr_k, 0);
-        }
-        else
-#endif /* RECLS_PLATFORM_IS_WINDOWS */
-        {
-            if (0 == (*m_pfn)(m_searchDir.data(), m_searchDir.size(), m_param, ss_nullptr_k, 0))
-            {
-                return RECLS_RC_USER_CANCELLED_SEARCH;
-            }
-        }
-    }
-
     if (m_entriesBegin != m_entries.end())
     {
         recls_debug2_trace_printf_(RECLS_LITERAL("Next entry in %s"), static_cast<recls_char_t const*>(m_searchDir.data()));
 
         // (i) Try getting a file first,
-        m_current = CreateEntryInfo(m_rootDirLen, m_searchDir.data(), m_searchDir.size(), m_flags, m_entriesBegin);
+        m_current = CreateEntryInfo(m_rootDirLen, m_searchDir.data(), m_searchDir.size(), m_flags, m_entriesBegin, m_arena, &m_sharedDir);
 
         if (ss_nullptr_k == m_current)
         {
@@ -587,12 +689,19 @@ recls_rc_t ReclsFileSearchDirectoryNode::Initialise()
                 ,   m_rootDirLen
                 ,   stlsoft::c_str_ptr(m_pattern)
                 ,   m_patternLen
+                ,   1 + m_depth
+                ,   m_minDepth
+                ,   m_maxDepth
+                ,   m_device
+                ,   m_arena
                 ,   m_pfn
                 ,   m_param
                 ,   &rc
                 );
 
-            } while (ss_nullptr_k == m_dnode && ++m_directoriesBegin != m_directories.end());
+            } while (ss_nullptr_k == m_dnode &&
+                    RECLS_RC_USER_CANCELLED_SEARCH != rc &&
+                    ++m_directoriesBegin != m_directories.end());
 
             if (RECLS_SUCCEEDED(rc))
             {
@@ -674,11 +783,11 @@ ReclsFileSearchDirectoryNode::GetNext()
         // Advance, and check for end of sequence
         ++m_entriesBegin;
 
-        Entry_Release(m_current);
+        Entry_ReleaseOwned(m_current);
         if (m_entriesBegin != m_entries.end())
         {
             // Still enumerating, so just update m_current
-            m_current = CreateEntryInfo(m_rootDirLen, m_searchDir.data(), m_searchDir.size(), m_flags, m_entriesBegin);
+            m_current = CreateEntryInfo(m_rootDirLen, m_searchDir.data(), m_searchDir.size(), m_flags, m_entriesBegin, m_arena, &m_sharedDir);
 
             rc = RECLS_RC_OK;
         }
@@ -734,6 +843,11 @@ ReclsFileSearchDirectoryNode::GetNext()
                     ,   m_rootDirLen
                     ,   stlsoft::c_str_ptr(m_pattern)
                     ,   m_patternLen
+                    ,   1 + m_depth
+                    ,   m_minDepth
+                    ,   m_maxDepth
+                    ,   m_device
+                    ,   m_arena
                     ,   m_pfn
                     ,   m_param
                     ,   &rc
@@ -743,6 +857,12 @@ ReclsFileSearchDirectoryNode::GetNext()
                     {
                         rc = RECLS_RC_OK;
                     }
+                    else if (RECLS_RC_USER_CANCELLED_SEARCH == rc)
+                    {
+                        // A cancellation from the progress function ends
+                        // the search, rather than only the sub-directory
+                        break;
+                    }
                     else
                     {
                         ++m_directoriesBegin;
@@ -798,6 +918,39 @@ ReclsFileSearchDirectoryNode::GetDetails(
     return rc;
 }
 
+recls_rc_t
+ReclsFileSearchDirectoryNode::BorrowDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsFileSearchDirectoryNode::BorrowDetails");
+
+    RECLS_ASSERT(is_valid());
+
+    recls_rc_t  rc;
+
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+    RECLS_ASSERT(ss_nullptr_k == m_current || ss_nullptr_k == m_dnode);
+
+    if (ss_nullptr_k != m_current)
+    {
+        *pinfo = m_current;
+
+        rc = RECLS_RC_OK;
+    }
+    else if (ss_nullptr_k != m_dnode)
+    {
+        rc = m_dnode->BorrowDetails(pinfo);
+    }
+    else
+    {
+        // Enumeration has completed
+        rc = RECLS_RC_NO_MORE_DATA;
+    }
+
+    return rc;
+}
+
 recls_rc_t
 ReclsFileSearchDirectoryNode::GetNextDetails(
     recls_entry_t* pinfo
@@ -4,11 +4,11 @@
  * Purpose: ReclsFileSearchDirectoryNode class.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -29,6 +29,7 @@
 #include "impl.root.h"
 #include "impl.types.hpp"
 #include "impl.util.h"
+#include "impl.entryfunctions.h"
 
 // Platform-specific includes
 #include <platformstl/platformstl.h>
@@ -118,6 +119,11 @@ protected: // Not private, or GCC whines
     ,   size_t                      rootDirLen
     ,   recls_char_t const*         pattern
     ,   size_t                      patternLen
+    ,   recls_uint32_t              depth
+    ,   recls_uint32_t              minDepth
+    ,   recls_uint32_t              maxDepth
+    ,   recls_uint64_t              device
+    ,   entry_arena_t*              arena
     ,   hrecls_progress_fn_t        pfn
     ,   recls_process_fn_param_t    param
     );
@@ -128,6 +134,16 @@ private:
     void operator =(class_type const &);                // copy-assignment proscribed
 public:
 
+    /// Creates the node that searches the given directory, whose entries
+    /// are at the given depth below the search directory
+    ///
+    /// \param depth The depth of the directory's entries
+    /// \param minDepth The minimum depth of the entries presented
+    /// \param maxDepth The maximum depth of the entries presented, beyond
+    ///   which directories are not opened
+    /// \param device The device of the search directory, when
+    ///   RECLS_F_SAME_DEVICE is specified and depth is not 0
+    /// \param arena The arena from which the entries are allocated, or NULL
     static
     class_type*
     FindAndCreate(
@@ -136,6 +152,11 @@ public:
     ,   size_t                      rootDirLen
     ,   recls_char_t const*         pattern
     ,   size_t                      patternLen
+    ,   recls_uint32_t              depth
+    ,   recls_uint32_t              minDepth
+    ,   recls_uint32_t              maxDepth
+    ,   recls_uint64_t              device
+    ,   entry_arena_t*              arena
     ,   hrecls_progress_fn_t        pfn
     ,   recls_process_fn_param_t    param
     ,   recls_rc_t*                 prc
@@ -161,6 +182,7 @@ private:
     /* virtual */ recls_rc_t GetNext();
     /* virtual */ recls_rc_t GetDetails(recls_entry_t* pinfo);
     /* virtual */ recls_rc_t GetNextDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t BorrowDetails(recls_entry_t* pinfo);
 
 // Implementation
 private:
@@ -194,6 +216,17 @@ private:
     ,   directory_sequence_type::const_iterator falseVal
     );
 
+    /// Invokes the progress function for the given directory, returning
+    /// its result
+    static
+    int
+    InvokeProgress_(
+        recls_uint32_t              flags
+    ,   hrecls_progress_fn_t        pfn
+    ,   recls_process_fn_param_t    param
+    ,   recls_char_t const*         dir
+    ,   size_t                      dirLen
+    );
     /// Creates a path-buffer from the given search directory, ensuring that
     /// it has a trailing path-name separator
     static
@@ -210,6 +243,8 @@ private:
     ,   size_t                              searchDirLen
     ,   recls_uint32_t                      flags
     ,   entry_sequence_type::const_iterator it
+    ,   entry_arena_t*                      arena
+    ,   entry_shared_directory_t**          psharedDir
     );
 
 // Members
@@ -221,6 +256,12 @@ private:
     path_buffer_type const                  m_searchDir;
     string_type const                       m_pattern;
     size_t const                            m_patternLen;
+    recls_uint32_t const                    m_depth;
+    recls_uint32_t const                    m_minDepth;
+    recls_uint32_t const                    m_maxDepth;
+    recls_uint64_t const                    m_device;
+    entry_arena_t* const                    m_arena;
+    entry_shared_directory_t*               m_sharedDir;    // Created on demand, by CreateEntryInfo()
     directory_sequence_type                 m_directories;
     directory_sequence_type::const_iterator m_directoriesBegin;
     entry_sequence_type                     m_entries;
@@ -5,11 +5,11 @@
  *          Windows.
  *
  * Created: 1st June 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -674,6 +674,39 @@ ReclsFtpSearchDirectoryNode::GetDetails(
     return rc;
 }
 
+recls_rc_t
+ReclsFtpSearchDirectoryNode::BorrowDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsFtpSearchDirectoryNode::BorrowDetails");
+
+    RECLS_ASSERT(is_valid());
+
+    recls_rc_t  rc;
+
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+    RECLS_ASSERT(ss_nullptr_k == m_current || ss_nullptr_k == m_dnode);
+
+    if (ss_nullptr_k != m_current)
+    {
+        *pinfo = m_current;
+
+        rc = RECLS_RC_OK;
+    }
+    else if (ss_nullptr_k != m_dnode)
+    {
+        rc = m_dnode->BorrowDetails(pinfo);
+    }
+    else
+    {
+        // Enumeration has completed
+        rc = RECLS_RC_NO_MORE_DATA;
+    }
+
+    return rc;
+}
+
 recls_rc_t
 ReclsFtpSearchDirectoryNode::GetNextDetails(
     recls_entry_t* pinfo
@@ -4,11 +4,11 @@
  * Purpose: ReclsFtpSearchDirectoryNode class, for Windows.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -118,6 +118,7 @@ public:
     /* virtual */ recls_rc_t GetNext();
     /* virtual */ recls_rc_t GetDetails(recls_entry_t* pinfo);
     /* virtual */ recls_rc_t GetNextDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t BorrowDetails(recls_entry_t* pinfo);
 
 // Implementation
 private:
@@ -4,11 +4,11 @@
  * Purpose: Implementation of the ReclsFtpSearch class for Windows.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -69,7 +69,7 @@ inline void* ReclsFtpSearch::operator new(size_t cb, size_t cDirParts, size_t cb
        + (cDirParts) * sizeof(recls_strptrs_t)
        + cbRootDir;
 
-    void* const pv = malloc(cb);
+    void* const pv = recls_malloc_(cb);
 
 #ifdef RECLS_COMPILER_THROWS_ON_NEW_FAIL
     if (ss_nullptr_k == pv)
@@ -88,7 +88,7 @@ void ReclsFtpSearch::operator delete(void* pv, size_t /* cDirParts */, size_t /*
 {
     function_scope_trace("ReclsFtpSearch::operator delete");
 
-    free(pv);
+    recls_free_(pv);
 }
 #endif /* RECLS_COMPILER_REQUIRES_MATCHING_PLACEMENT_DELETE */
 
@@ -96,7 +96,7 @@ void ReclsFtpSearch::operator delete(void* pv)
 {
     function_scope_trace("ReclsFtpSearch::operator delete");
 
-    free(pv);
+    recls_free_(pv);
 }
 
 /* static */ recls_rc_t
@@ -0,0 +1,1158 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/ReclsParallelSearchDirectoryNode_linux.cpp
+ *
+ * Purpose: ReclsParallelSearchDirectoryNode class.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+#include "impl.types.hpp"
+#include "impl.string.hpp"
+#include "impl.util.h"
+#include "impl.entryfunctions.h"
+#include "impl.dirscan.linux.hpp"
+
+#include "ReclsParallelSearchDirectoryNode_linux.hpp"
+
+#include "impl.trace.h"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <string.h>
+#include <sys/stat.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsParallelSearchDirectoryNode::dir_task
+ */
+
+/// The reading, and the results, of a single directory
+struct ReclsParallelSearchDirectoryNode::dir_task
+    : public work_pool::task
+    , public allocated_object
+{
+public:
+    typedef std::vector<recls_entry_t, stl_allocator<recls_entry_t> > entries_type;
+
+public:
+    dir_task(
+        class_type*         node
+    ,   recls_char_t const* dir
+    ,   size_t              dirLen
+    ,   size_t              depth
+    )
+        : node(node)
+        , dir(dir, dirLen)
+        , depth(depth)
+        , isRoot(0 == depth)
+        , entries()
+        , children()
+        , rc(RECLS_RC_OK)
+        , done(false)
+        , submitted(false)
+        , prev(ss_nullptr_k)
+        , next(ss_nullptr_k)
+        , nextDone(ss_nullptr_k)
+        , prevDeferred(ss_nullptr_k)
+        , nextDeferred(ss_nullptr_k)
+        , entriesIndex(0)
+        , childrenIndex(0)
+    {}
+    ~dir_task()
+    {
+        entries_type::iterator b = entries.begin();
+        entries_type::iterator e = entries.end();
+
+        for (; b != e; ++b)
+        {
+            if (ss_nullptr_k != *b)
+            {
+                Entry_Release(*b);
+            }
+        }
+    }
+private:
+    dir_task(dir_task const&);              // copy-construction proscribed
+    void operator =(dir_task const&);       // copy-assignment proscribed
+
+public: // work_pool::task
+    virtual void run(work_pool& /* pool */, size_t workerIndex)
+    {
+        node->Scan_(*this, workerIndex);
+    }
+
+public:
+    // Set on creation
+    class_type* const   node;
+    string_type const   dir;            // Including trailing separator
+    size_t const        depth;          // Of the entries, below the search directory
+    bool const          isRoot;
+
+    // Written by the worker, and read by the owner once done
+    entries_type        entries;
+    tasks_type          children;       // When ordered, in the order read
+    recls_rc_t          rc;
+
+    // Under the node's mutex
+    bool                done;
+    bool                submitted;
+    dir_task*           prev;
+    dir_task*           next;
+    dir_task*           nextDone;
+    dir_task*           prevDeferred;
+    dir_task*           nextDeferred;
+
+    // Used only by the owner
+    size_t              entriesIndex;
+    size_t              childrenIndex;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsParallelSearchDirectoryNode::worker_state
+ */
+
+/// Resources used by a single worker, which are reused for each directory
+/// it reads
+struct ReclsParallelSearchDirectoryNode::worker_state
+    : public allocated_object
+{
+public:
+    /// Describes a name held in the names buffer
+    struct item_type
+    {
+        size_t          nameOffset;
+        size_t          nameLen;
+        unsigned char   type;
+    };
+    typedef std::vector<item_type, stl_allocator<item_type> > items_type;
+    typedef std::vector<char, stl_allocator<char> >         names_type;
+
+    struct item_less
+    {
+    public:
+        explicit
+        item_less(
+            recls_char_t const* names
+        )
+            : m_names(names)
+        {}
+
+    public:
+        bool operator ()(item_type const& lhs, item_type const& rhs) const
+        {
+            return ::strcmp(m_names + lhs.nameOffset, m_names + rhs.nameOffset) < 0;
+        }
+
+    private:
+        recls_char_t const* m_names;
+    };
+
+public:
+    worker_state()
+        : buffer(dirscan_alloc_buffer(RECLS_DIRSCAN_BUFFER_SIZE))
+        , names()
+        , items()
+        , path()
+        , sharedDir(ss_nullptr_k)
+    {}
+    ~worker_state()
+    {
+        Entry_ReleaseSharedDirectory(sharedDir);
+
+        dirscan_free_buffer(buffer);
+    }
+private:
+    worker_state(worker_state const&);      // copy-construction proscribed
+    void operator =(worker_state const&);   // copy-assignment proscribed
+
+public:
+    void* const                 buffer;
+    names_type                  names;
+    items_type                  items;
+    string_type                 path;
+    entry_shared_directory_t*   sharedDir;  // That of the entries of the directory last read
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * ReclsParallelSearchDirectoryNode
+ */
+
+/* static */ ReclsSearchDirectoryNode*
+ReclsParallelSearchDirectoryNode::FindAndCreate(
+    recls_uint32_t              flags
+,   recls_char_t const*         searchDir
+,   size_t                      searchDirLen
+,   recls_char_t const*         pattern
+,   size_t                      patternLen
+,   search_options_t const&     options
+,   recls_rc_t*                 prc
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::FindAndCreate");
+
+    RECLS_ASSERT(ss_nullptr_k != searchDir);
+    RECLS_ASSERT(searchDirLen == types::traits_type::str_len(searchDir));
+    RECLS_ASSERT(types::traits_type::has_dir_end(searchDir, searchDirLen));
+    RECLS_ASSERT(ss_nullptr_k != pattern);
+    RECLS_ASSERT(patternLen == types::traits_type::str_len(pattern));
+    RECLS_ASSERT(options.parallel);
+    RECLS_ASSERT(ss_nullptr_k != prc);
+
+    size_t const    numThreads  =   (0 != options.numThreads) ? options.numThreads : work_pool::default_thread_count();
+    class_type*     node        =   ss_nullptr_k;
+    recls_rc_t      rc          =   RECLS_RC_OUT_OF_MEMORY;
+
+    recls_debug1_trace_printf_(RECLS_LITERAL("parallel search of '%s' on %u threads"), searchDir, unsigned(numThreads));
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        node = new class_type(flags, searchDirLen, options);
+
+        if (ss_nullptr_k != node)
+        {
+            rc = node->Initialise(searchDir, searchDirLen, pattern, patternLen, numThreads);
+        }
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        rc = RECLS_RC_OUT_OF_MEMORY;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+    if (RECLS_FAILED(rc))
+    {
+        delete node;
+
+        node = ss_nullptr_k;
+    }
+
+    *prc = rc;
+
+    RECLS_ASSERT(ss_nullptr_k == node || node->is_valid());
+
+    return node;
+}
+
+ReclsParallelSearchDirectoryNode::ReclsParallelSearchDirectoryNode(
+    recls_uint32_t              flags
+,   size_t                      rootDirLen
+,   search_options_t const&     options
+)
+    : m_flags(flags)
+    , m_rootDirLen(rootDirLen)
+    , m_ordered(0 != (RECLS_PARALLEL_F_DETERMINISTIC & options.parallelFlags) && ss_nullptr_k == options.pfnProcess)
+    , m_pfnProcess(options.pfnProcess)
+    , m_paramProcess(options.paramProcess)
+    , m_minDepth(options.minDepth)
+    , m_maxDepth(options.maxDepth)
+    , m_rootDevice(0)
+    , m_matcher()
+    , m_workerStates()
+    , m_pool()
+    , m_live(ss_nullptr_k)
+    , m_outstanding(0)
+    , m_maxHeld(RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES)
+    , m_numHeld(0)
+    , m_deferredHead(ss_nullptr_k)
+    , m_deferredTail(ss_nullptr_k)
+    , m_doneHead(ss_nullptr_k)
+    , m_doneTail(ss_nullptr_k)
+    , m_failure(RECLS_RC_OK)
+    , m_cancelled(0)
+    , m_stack()
+    , m_task(ss_nullptr_k)
+    , m_current(ss_nullptr_k)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::ReclsParallelSearchDirectoryNode");
+
+    ::pthread_mutex_init(&m_mx, ss_nullptr_k);
+    ::pthread_cond_init(&m_cv, ss_nullptr_k);
+}
+
+ReclsParallelSearchDirectoryNode::~ReclsParallelSearchDirectoryNode()
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::~ReclsParallelSearchDirectoryNode");
+
+    // The workers are stopped before any of the state they use is released
+    __atomic_store_n(&m_cancelled, 1, __ATOMIC_RELEASE);
+
+    m_pool.stop();
+    m_pool.join();
+
+    // m_current refers to an entry held by its task
+    for (; ss_nullptr_k != m_live; )
+    {
+        dir_task* const task = m_live;
+
+        m_live = task->next;
+
+        delete task;
+    }
+
+    worker_states_type::iterator b = m_workerStates.begin();
+    worker_states_type::iterator e = m_workerStates.end();
+
+    for (; b != e; ++b)
+    {
+        delete *b;
+    }
+
+    ::pthread_cond_destroy(&m_cv);
+    ::pthread_mutex_destroy(&m_mx);
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::Initialise(
+    recls_char_t const*     searchDir
+,   size_t                  searchDirLen
+,   recls_char_t const*     pattern
+,   size_t                  patternLen
+,   size_t                  numThreads
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::Initialise");
+
+    RECLS_ASSERT(0 != numThreads);
+
+    m_matcher.init(pattern, patternLen);
+
+    if (m_maxHeld < 2 * numThreads)
+    {
+        m_maxHeld = 2 * numThreads;
+    }
+
+    m_workerStates.reserve(numThreads);
+
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        worker_state* const state = new worker_state();
+
+        m_workerStates.push_back(state);
+
+        if (ss_nullptr_k == state->buffer)
+        {
+            return RECLS_RC_OUT_OF_MEMORY;
+        }
+    }
+
+    // The root task is registered before the workers start, so needs no
+    // synchronisation
+    dir_task* const root = new dir_task(this, searchDir, searchDirLen, 0);
+
+    root->submitted =   true;
+
+    m_live          =   root;
+    m_outstanding   =   1;
+    m_numHeld       =   1;
+
+    if (m_ordered)
+    {
+        m_stack.push_back(root);
+    }
+
+    int const e = m_pool.start(numThreads);
+
+    if (0 != e)
+    {
+        return (ENOMEM == e) ? RECLS_RC_OUT_OF_MEMORY : RECLS_RC_UNEXPECTED;
+    }
+
+    m_pool.submit(root, numThreads);
+
+    if (ss_nullptr_k != m_pfnProcess)
+    {
+        return WaitForAll_();
+    }
+    else
+    {
+        return Advance_();
+    }
+}
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+void
+ReclsParallelSearchDirectoryNode::Scan_(
+    dir_task&   task
+,   size_t      workerIndex
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::Scan_");
+
+    recls_rc_t rc = RECLS_RC_OK;
+
+    if (!IsCancelled_())
+    {
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        try
+        {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+            rc = ReadDirectory_(task, *m_workerStates[workerIndex], workerIndex);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        }
+        catch(std::bad_alloc&)
+        {
+            recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+            rc = RECLS_RC_OUT_OF_MEMORY;
+        }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+    }
+
+    // NOTE: task may not be used after this call
+    Complete_(task, rc);
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::ReadDirectory_(
+    dir_task&       task
+,   worker_state&   state
+,   size_t          workerIndex
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::ReadDirectory_");
+
+    recls_char_t const      sep         =   types::traits_type::path_name_separator();
+    recls_uint32_t          flags       =   m_flags;
+    bool const              recursive   =   0 != (RECLS_F_RECURSIVE & flags) && task.depth < m_maxDepth;
+    bool const              present     =   task.depth >= m_minDepth;
+
+    // Links are not followed below the search root, but the root itself
+    // is always followed
+    if (task.isRoot)
+    {
+        flags &= ~recls_uint32_t(RECLS_F_NO_FOLLOW_LINKS);
+    }
+
+    dirscan_reader  reader(state.buffer, RECLS_DIRSCAN_BUFFER_SIZE);
+    int const       openError = reader.open(AT_FDCWD, task.dir.c_str(), flags);
+
+    if (0 != openError)
+    {
+        recls_rc_t const rc = dirscan_rc_from_errno(openError);
+
+        recls_debug1_trace_printf_(RECLS_LITERAL("could not open directory '%s'"), task.dir.c_str());
+
+        if (!task.isRoot)
+        {
+            // The sub-directory has been removed, or replaced, since its
+            // parent was read
+            if (RECLS_RC_DIRECTORY_NOT_FOUND == rc ||
+                RECLS_RC_PATH_IS_NOT_DIRECTORY == rc)
+            {
+                return RECLS_RC_OK;
+            }
+
+            if (RECLS_RC_ACCESS_DENIED == rc &&
+                0 == (RECLS_F_STOP_ON_ACCESS_FAILURE & m_flags))
+            {
+                return RECLS_RC_OK;
+            }
+        }
+
+        return rc;
+    }
+
+    // A sub-directory on another device is closed before it is read. The
+    // device of the root is recorded before any sub-directory is submitted
+    if (0 != (RECLS_F_SAME_DEVICE & m_flags))
+    {
+        struct stat st;
+
+        if (0 != ::fstat(reader.get_fd(), &st))
+        {
+            return dirscan_rc_from_errno(errno);
+        }
+
+        if (task.isRoot)
+        {
+            m_rootDevice = st.st_dev;
+        }
+        else if (m_rootDevice != st.st_dev)
+        {
+            recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is on another device"), task.dir.c_str());
+
+            return RECLS_RC_OK;
+        }
+    }
+
+    state.names.clear();
+    state.items.clear();
+
+    dirscan_entry_t de;
+    int             r;
+
+    for (; 1 == (r = reader.read(&de)); )
+    {
+        if (IsCancelled_())
+        {
+            return RECLS_RC_OK;
+        }
+
+        bool const isMatch = present && m_matcher.match(de.name, de.nameLen);
+
+        if (!isMatch &&
+            !recursive)
+        {
+            continue;
+        }
+
+        unsigned char   type;
+        bool const      isDirectory =   dirscan_is_directory(reader.get_fd(), de, flags, &type);
+        bool const      isEntry     =   isMatch && 0 != (m_flags & (isDirectory ? RECLS_F_DIRECTORIES : RECLS_F_FILES));
+        bool const      isSubdir    =   isDirectory && recursive;
+
+        // Sub-directories are submitted as soon as they are found, so that
+        // idle workers may take them while this directory is still being
+        // read
+        if (isSubdir)
+        {
+            state.path.assign(task.dir);
+            state.path.append(de.name, de.nameLen);
+            state.path.append(&sep, 1);
+
+            Submit_(task, state.path, workerIndex);
+        }
+
+        if (isEntry)
+        {
+            worker_state::item_type item;
+
+            item.nameOffset =   state.names.size();
+            item.nameLen    =   de.nameLen;
+            item.type       =   type;
+
+            state.names.insert(state.names.end(), de.name, de.name + (1 + de.nameLen));
+            state.items.push_back(item);
+        }
+    }
+
+    if (r < 0)
+    {
+        int const e = errno;
+
+        recls_error_trace_printf_(RECLS_LITERAL("could not read directory '%s': %d"), task.dir.c_str(), e);
+
+        return dirscan_rc_from_errno(e);
+    }
+
+    if (state.items.empty())
+    {
+        return RECLS_RC_OK;
+    }
+
+    // Entries that are presented via the search handle are in name order,
+    // as they are from a single-threaded search, unless RECLS_F_UNSORTED
+    if (ss_nullptr_k == m_pfnProcess)
+    {
+        if (0 == (RECLS_F_UNSORTED & m_flags))
+        {
+            std::sort(state.items.begin(), state.items.end(), worker_state::item_less(&state.names[0]));
+        }
+
+        task.entries.reserve(state.items.size());
+    }
+
+    size_t const dirLen = task.dir.size();
+
+    for (size_t i = 0; i != state.items.size(); ++i)
+    {
+        worker_state::item_type const&  item    =   state.items[i];
+        recls_entry_t                   entry;
+
+        state.path.assign(task.dir);
+        state.path.append(&state.names[item.nameOffset], item.nameLen);
+
+        recls_rc_t const rc = dirscan_create_entry(reader.get_fd(), m_rootDirLen, state.path.c_str(), dirLen, item.nameLen, item.type, m_flags, ss_nullptr_k, &state.sharedDir, &entry);
+
+        if (RECLS_RC_NO_MORE_DATA == rc)
+        {
+            // The entry has been removed since the directory was read
+            continue;
+        }
+
+        if (RECLS_FAILED(rc))
+        {
+            return rc;
+        }
+
+        if (ss_nullptr_k != m_pfnProcess)
+        {
+            if (IsCancelled_())
+            {
+                Entry_Release(entry);
+
+                break;
+            }
+
+            int const res = (*m_pfnProcess)(entry, m_paramProcess);
+
+            Entry_Release(entry);
+
+            if (0 == res)
+            {
+                return RECLS_RC_SEARCH_CANCELLED;
+            }
+        }
+        else
+        {
+            // Cannot throw, since the capacity is reserved
+            task.entries.push_back(entry);
+        }
+    }
+
+    return RECLS_RC_OK;
+}
+
+void
+ReclsParallelSearchDirectoryNode::Submit_(
+    dir_task&           parent
+,   string_type const&  dir
+,   size_t              workerIndex
+)
+{
+    dir_task* const child = new dir_task(this, dir.data(), dir.size(), 1 + parent.depth);
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        if (m_ordered)
+        {
+            parent.children.push_back(child);
+        }
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(...)
+    {
+        delete child;
+
+        throw;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+    ::pthread_mutex_lock(&m_mx);
+    child->next = m_live;
+    if (ss_nullptr_k != m_live)
+    {
+        m_live->prev = child;
+    }
+    m_live = child;
+    ++m_outstanding;
+
+    // When the entries are presented, a sub-directory found once as many
+    // directories as are allowed are held is deferred, to be submitted by
+    // the owner as presentation releases them. (The results of a process
+    // function are not held, so need no bound.)
+    bool const deferred = ss_nullptr_k == m_pfnProcess && m_numHeld >= m_maxHeld;
+
+    if (deferred)
+    {
+        child->prevDeferred = m_deferredTail;
+        if (ss_nullptr_k != m_deferredTail)
+        {
+            m_deferredTail->nextDeferred = child;
+        }
+        else
+        {
+            m_deferredHead = child;
+        }
+        m_deferredTail = child;
+    }
+    else
+    {
+        child->submitted = true;
+        ++m_numHeld;
+    }
+    ::pthread_mutex_unlock(&m_mx);
+
+    if (deferred)
+    {
+        return;
+    }
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        m_pool.submit(child, workerIndex);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(...)
+    {
+        ::pthread_mutex_lock(&m_mx);
+        --m_outstanding;
+        ::pthread_mutex_unlock(&m_mx);
+
+        if (m_ordered)
+        {
+            parent.children.pop_back();
+        }
+
+        Release_(child);
+
+        throw;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+}
+
+void
+ReclsParallelSearchDirectoryNode::Complete_(
+    dir_task&   task
+,   recls_rc_t  rc
+)
+{
+    ::pthread_mutex_lock(&m_mx);
+    CompleteLocked_(task, rc);
+    ::pthread_mutex_unlock(&m_mx);
+}
+
+void
+ReclsParallelSearchDirectoryNode::CompleteLocked_(
+    dir_task&   task
+,   recls_rc_t  rc
+)
+{
+    // A task that was abandoned, or cut short, because the search has been
+    // cancelled reports the reason
+    if (RECLS_SUCCEEDED(rc) &&
+        IsCancelled_())
+    {
+        rc = m_failure;
+    }
+
+    if (RECLS_FAILED(rc) &&
+        RECLS_SUCCEEDED(m_failure))
+    {
+        m_failure = rc;
+
+        __atomic_store_n(&m_cancelled, 1, __ATOMIC_RELEASE);
+    }
+
+    task.rc     =   rc;
+    task.done   =   true;
+
+    --m_outstanding;
+
+    if (ss_nullptr_k != m_pfnProcess)
+    {
+        // The results have already been processed
+        --m_numHeld;
+
+        if (ss_nullptr_k != task.prev)
+        {
+            task.prev->next = task.next;
+        }
+        else
+        {
+            m_live = task.next;
+        }
+        if (ss_nullptr_k != task.next)
+        {
+            task.next->prev = task.prev;
+        }
+
+        delete &task;
+    }
+    else if (!m_ordered)
+    {
+        if (ss_nullptr_k != m_doneTail)
+        {
+            m_doneTail->nextDone = &task;
+        }
+        else
+        {
+            m_doneHead = &task;
+        }
+        m_doneTail = &task;
+    }
+
+    ::pthread_cond_broadcast(&m_cv);
+}
+
+bool
+ReclsParallelSearchDirectoryNode::IsCancelled_() const
+{
+    return 0 != __atomic_load_n(&m_cancelled, __ATOMIC_ACQUIRE);
+}
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::Advance_()
+{
+    RECLS_ASSERT(ss_nullptr_k == m_current);
+
+    return m_ordered ? AdvanceOrdered_() : AdvanceUnordered_();
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::AdvanceOrdered_()
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::AdvanceOrdered_");
+
+    // The tasks are visited in the order of the single-pass traversal: the
+    // entries of a directory, followed by each of its sub-directories in
+    // turn, waiting for each to be read as necessary. A task that has been
+    // deferred is submitted regardless of the bound, since it is the one
+    // that presentation requires
+    for (; !m_stack.empty(); )
+    {
+        dir_task* const task = m_stack.back();
+
+        ::pthread_mutex_lock(&m_mx);
+        SubmitDeferredLocked_(task);
+        for (; !task->done; )
+        {
+            ::pthread_cond_wait(&m_cv, &m_mx);
+        }
+        ::pthread_mutex_unlock(&m_mx);
+
+        if (RECLS_FAILED(task->rc))
+        {
+            return task->rc;
+        }
+
+        if (task->entriesIndex != task->entries.size())
+        {
+            m_current = task->entries[task->entriesIndex];
+
+            return RECLS_RC_OK;
+        }
+
+        if (task->childrenIndex != task->children.size())
+        {
+            m_stack.push_back(task->children[task->childrenIndex++]);
+
+            continue;
+        }
+
+        m_stack.pop_back();
+
+        Release_(task);
+    }
+
+    return RECLS_RC_NO_MORE_DATA;
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::AdvanceUnordered_()
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::AdvanceUnordered_");
+
+    for (;;)
+    {
+        if (ss_nullptr_k != m_task)
+        {
+            if (m_task->entriesIndex != m_task->entries.size())
+            {
+                m_current = m_task->entries[m_task->entriesIndex];
+
+                return RECLS_RC_OK;
+            }
+
+            Release_(m_task);
+
+            m_task = ss_nullptr_k;
+        }
+
+        dir_task* task;
+
+        ::pthread_mutex_lock(&m_mx);
+        for (; ss_nullptr_k == m_doneHead && 0 != m_outstanding; )
+        {
+            ::pthread_cond_wait(&m_cv, &m_mx);
+        }
+        task = m_doneHead;
+        if (ss_nullptr_k != task)
+        {
+            m_doneHead = task->nextDone;
+            if (ss_nullptr_k == m_doneHead)
+            {
+                m_doneTail = ss_nullptr_k;
+            }
+        }
+        ::pthread_mutex_unlock(&m_mx);
+
+        if (ss_nullptr_k == task)
+        {
+            return RECLS_RC_NO_MORE_DATA;
+        }
+
+        m_task = task;
+
+        if (RECLS_FAILED(task->rc))
+        {
+            return task->rc;
+        }
+    }
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::WaitForAll_()
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::WaitForAll_");
+
+    recls_rc_t rc;
+
+    ::pthread_mutex_lock(&m_mx);
+    for (; 0 != m_outstanding; )
+    {
+        ::pthread_cond_wait(&m_cv, &m_mx);
+    }
+    rc = m_failure;
+    ::pthread_mutex_unlock(&m_mx);
+
+    return RECLS_SUCCEEDED(rc) ? RECLS_RC_NO_MORE_DATA : rc;
+}
+
+void
+ReclsParallelSearchDirectoryNode::Release_(
+    dir_task* task
+)
+{
+    ::pthread_mutex_lock(&m_mx);
+    if (ss_nullptr_k != task->prev)
+    {
+        task->prev->next = task->next;
+    }
+    else
+    {
+        m_live = task->next;
+    }
+    if (ss_nullptr_k != task->next)
+    {
+        task->next->prev = task->prev;
+    }
+    if (task->submitted)
+    {
+        --m_numHeld;
+    }
+    SubmitDeferredLocked_(ss_nullptr_k);
+    ::pthread_mutex_unlock(&m_mx);
+
+    delete task;
+}
+
+void
+ReclsParallelSearchDirectoryNode::SubmitDeferredLocked_(
+    dir_task* required
+)
+{
+    // Submits the given task, if it is deferred, and then as many of the
+    // deferred tasks, in the order found, as the bound allows
+    if (ss_nullptr_k != required &&
+        !required->submitted)
+    {
+        DispatchLocked_(required);
+    }
+
+    for (; ss_nullptr_k != m_deferredHead && m_numHeld < m_maxHeld; )
+    {
+        DispatchLocked_(m_deferredHead);
+    }
+}
+
+void
+ReclsParallelSearchDirectoryNode::DispatchLocked_(
+    dir_task* task
+)
+{
+    RECLS_ASSERT(!task->submitted);
+
+    if (ss_nullptr_k != task->prevDeferred)
+    {
+        task->prevDeferred->nextDeferred = task->nextDeferred;
+    }
+    else
+    {
+        m_deferredHead = task->nextDeferred;
+    }
+    if (ss_nullptr_k != task->nextDeferred)
+    {
+        task->nextDeferred->prevDeferred = task->prevDeferred;
+    }
+    else
+    {
+        m_deferredTail = task->prevDeferred;
+    }
+
+    task->submitted = true;
+    ++m_numHeld;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        // The owner is not a worker, so the pool chooses the queue
+        m_pool.submit(task, m_workerStates.size());
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        // The task fails, and so fails the search, as if it had been read
+        CompleteLocked_(*task, RECLS_RC_OUT_OF_MEMORY);
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+}
+
+#ifdef RECLS_ENFORCING_CONTRACTS
+recls_bool_t
+ReclsParallelSearchDirectoryNode::is_valid() const
+{
+    // (i) There can be a current entry only if there is a current task
+    if (ss_nullptr_k != m_current &&
+        (m_ordered ? m_stack.empty() : ss_nullptr_k == m_task))
+    {
+        return false;
+    }
+
+    return true;
+}
+#endif /* RECLS_ENFORCING_CONTRACTS */
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::GetNext()
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::GetNext");
+
+    RECLS_ASSERT(is_valid());
+
+    if (ss_nullptr_k == m_current)
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+
+    // The entry is released as soon as it has been presented, so that the
+    // results of a large directory are not retained
+    dir_task* const task = m_ordered ? m_stack.back() : m_task;
+
+    RECLS_ASSERT(m_current == task->entries[task->entriesIndex]);
+
+    Entry_Release(m_current);
+
+    m_current = ss_nullptr_k;
+    task->entries[task->entriesIndex++] = ss_nullptr_k;
+
+    recls_rc_t rc = Advance_();
+
+    RECLS_ASSERT(is_valid());
+
+    return rc;
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::GetDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::GetDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    if (ss_nullptr_k != m_current)
+    {
+        return Entry_Copy(m_current, pinfo);
+    }
+    else
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::BorrowDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::BorrowDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    if (ss_nullptr_k != m_current)
+    {
+        *pinfo = m_current;
+
+        return RECLS_RC_OK;
+    }
+    else
+    {
+        return RECLS_RC_NO_MORE_DATA;
+    }
+}
+
+recls_rc_t
+ReclsParallelSearchDirectoryNode::GetNextDetails(
+    recls_entry_t* pinfo
+)
+{
+    function_scope_trace("ReclsParallelSearchDirectoryNode::GetNextDetails");
+
+    RECLS_ASSERT(is_valid());
+    RECLS_ASSERT(ss_nullptr_k != pinfo);
+
+    recls_rc_t rc = GetNext();
+
+    if (RECLS_SUCCEEDED(rc))
+    {
+        rc = GetDetails(pinfo);
+    }
+
+    return rc;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,228 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/ReclsParallelSearchDirectoryNode_linux.hpp
+ *
+ * Purpose: ReclsParallelSearchDirectoryNode class.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+// recls includes
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.types.hpp"
+#include "impl.util.h"
+
+#ifndef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# error This file can only be included when RECLS_SUPPORTS_PARALLEL_SEARCH_ is defined
+#endif /* !RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+#include "impl.api.search.h"
+#include "impl.dirscan.linux.hpp"
+#include "impl.workpool.linux.hpp"
+
+#include "ReclsSearch.hpp"
+
+// Standard includes
+#include <string>
+#include <vector>
+
+#include <pthread.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * compatibility
+ */
+
+/** \def RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES The number of
+ * directories, of a search whose entries are presented via its handle,
+ * that may be being read, or read but not yet presented, at one time.
+ * Sub-directories found beyond it are submitted only as presentation
+ * catches up, so that a caller that consumes the entries more slowly than
+ * the workers produce them does not cause the whole tree to be retained.
+ * It is raised, if necessary, to twice the number of threads.
+ */
+
+#ifndef RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES
+# define RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES         (256)
+#endif /* !RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class ReclsParallelSearchDirectoryNode
+/// Search node that traverses an entire directory tree on a work-stealing
+/// pool of threads, each directory being read, via getdents64(), by a
+/// single task.
+///
+/// The entries of each directory are created by the task that reads it,
+/// and are then either presented, by the thread that owns the search, in
+/// the order of completion (unordered) or in the order of the single-pass
+/// traversal (deterministic), or are passed directly to a process function
+/// on the worker threads.
+///
+/// When presented, the number of directories read, or being read, ahead of
+/// the presentation is bounded by RECLS_PARALLEL_SEARCH_MAX_HELD_DIRECTORIES
+/// (exceeded only by the directory that presentation next requires), the
+/// submission of further sub-directories being deferred.
+class ReclsParallelSearchDirectoryNode
+    : public ReclsSearchDirectoryNode
+{
+public:
+    typedef ReclsParallelSearchDirectoryNode                class_type;
+    typedef std::basic_string<
+        recls_char_t
+    ,   std::char_traits<recls_char_t>
+    ,   stl_allocator<recls_char_t>
+    >                                                       string_type;
+private:
+    struct dir_task;
+    struct worker_state;
+    typedef std::vector<dir_task*, stl_allocator<dir_task*> > tasks_type;
+    typedef std::vector<worker_state*, stl_allocator<worker_state*> > worker_states_type;
+
+// Construction
+protected: // Not private, or GCC whines
+    ReclsParallelSearchDirectoryNode(
+        recls_uint32_t              flags
+    ,   size_t                      rootDirLen
+    ,   search_options_t const&     options
+    );
+public:
+    virtual ~ReclsParallelSearchDirectoryNode();
+private:
+    ReclsParallelSearchDirectoryNode(class_type const &);   // copy-construction proscribed
+    void operator =(class_type const &);                    // copy-assignment proscribed
+public:
+
+    /// Creates the node that performs a search
+    ///
+    /// If \c options specifies a process function, the search is performed
+    /// to completion, the entries being passed to the function, and no node
+    /// is returned: \c *prc is RECLS_RC_NO_MORE_DATA if the search
+    /// completed, or the reason it did not.
+    ///
+    /// \pre nullptr != searchDir
+    /// \pre searchDir is absolute, and has a trailing path-name separator
+    /// \pre ReclsDirScanSearchDirectoryNode::IsApplicable(flags, pattern, patternLen)
+    static
+    ReclsSearchDirectoryNode*
+    FindAndCreate(
+        recls_uint32_t              flags
+    ,   recls_char_t const*         searchDir
+    ,   size_t                      searchDirLen
+    ,   recls_char_t const*         pattern
+    ,   size_t                      patternLen
+    ,   search_options_t const&     options
+    ,   recls_rc_t*                 prc
+    );
+
+// ReclsSearchDirectoryNode methods
+private:
+    /* virtual */ recls_rc_t GetNext();
+    /* virtual */ recls_rc_t GetDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t GetNextDetails(recls_entry_t* pinfo);
+    /* virtual */ recls_rc_t BorrowDetails(recls_entry_t* pinfo);
+
+// Implementation
+private:
+    recls_rc_t      Initialise(
+        recls_char_t const*     searchDir
+    ,   size_t                  searchDirLen
+    ,   recls_char_t const*     pattern
+    ,   size_t                  patternLen
+    ,   size_t                  numThreads
+    );
+
+    // Worker-side
+    void            Scan_(dir_task& task, size_t workerIndex);
+    recls_rc_t      ReadDirectory_(dir_task& task, worker_state& state, size_t workerIndex);
+    void            Submit_(dir_task& parent, string_type const& dir, size_t workerIndex);
+    void            Complete_(dir_task& task, recls_rc_t rc);
+    void            CompleteLocked_(dir_task& task, recls_rc_t rc);
+    bool            IsCancelled_() const;
+
+    // Owner-side
+    recls_rc_t      Advance_();
+    recls_rc_t      AdvanceOrdered_();
+    recls_rc_t      AdvanceUnordered_();
+    recls_rc_t      WaitForAll_();
+    void            Release_(dir_task* task);
+    void            SubmitDeferredLocked_(dir_task* required);
+    void            DispatchLocked_(dir_task* task);
+
+#ifdef RECLS_ENFORCING_CONTRACTS
+    recls_bool_t    is_valid() const;
+#endif /* RECLS_ENFORCING_CONTRACTS */
+
+// Members
+private:
+    recls_uint32_t const            m_flags;
+    size_t const                    m_rootDirLen;
+    bool const                      m_ordered;
+    hrecls_process_fn_t const       m_pfnProcess;
+    recls_process_fn_param_t const  m_paramProcess;
+    recls_uint32_t const            m_minDepth;
+    recls_uint32_t const            m_maxDepth;
+    dev_t                           m_rootDevice;   // When RECLS_F_SAME_DEVICE; written before any sub-directory is submitted
+    dirscan_matcher                 m_matcher;
+    worker_states_type              m_workerStates;
+    work_pool                       m_pool;
+
+    // The following are shared with the workers, under m_mx
+    pthread_mutex_t                 m_mx;
+    pthread_cond_t                  m_cv;
+    dir_task*                       m_live;         // All tasks not yet released
+    size_t                          m_outstanding;  // Tasks created but not completed
+    size_t                          m_maxHeld;      // Written before the workers start
+    size_t                          m_numHeld;      // Tasks submitted but not released
+    dir_task*                       m_deferredHead; // Tasks created but not yet submitted
+    dir_task*                       m_deferredTail;
+    dir_task*                       m_doneHead;     // Completed tasks, when unordered
+    dir_task*                       m_doneTail;
+    recls_rc_t                      m_failure;      // The first failure, if any
+    int                             m_cancelled;    // Accessed atomically
+
+    // The following are used only by the owning thread
+    tasks_type                      m_stack;        // The tasks being presented, when ordered
+    dir_task*                       m_task;         // The task being presented, when unordered
+    recls_entry_t                   m_current;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -4,11 +4,11 @@
  * Purpose: Implementation of the ReclsFileSearch class for Windows.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -50,12 +50,17 @@ namespace impl
 
 ReclsSearch::ReclsSearch()
     : m_dnode(ss_nullptr_k)
+    , m_idleNode(ss_nullptr_k)
     , m_lastError(RECLS_RC_OK)
+    , m_arena(ss_nullptr_k)
 {}
 
 ReclsSearch::~ReclsSearch()
 {
     delete m_dnode;
+    delete m_idleNode;
+
+    Entry_ReleaseArena(m_arena);
 }
 
 /* static */ hrecls_t ReclsSearch::ToHandle(ReclsSearch* si)
@@ -80,9 +85,7 @@ recls_rc_t ReclsSearch::GetNext()
 
     if (RECLS_RC_NO_MORE_DATA == m_lastError)
     {
-        delete m_dnode;
-
-        m_dnode = ss_nullptr_k;
+        EndSearch_();
     }
 
     return m_lastError;
@@ -97,6 +100,15 @@ recls_rc_t ReclsSearch::GetDetails(recls_entry_t* pinfo)
     return (m_lastError = m_dnode->GetDetails(pinfo));
 }
 
+recls_rc_t ReclsSearch::BorrowDetails(recls_entry_t* pinfo)
+{
+    function_scope_trace("ReclsSearch::BorrowDetails");
+
+    RECLS_ASSERT(ss_nullptr_k != m_dnode);
+
+    return (m_lastError = m_dnode->BorrowDetails(pinfo));
+}
+
 recls_rc_t ReclsSearch::GetNextDetails(recls_entry_t* pinfo)
 {
     function_scope_trace("ReclsSearch::GetNextDetails");
@@ -107,14 +119,62 @@ recls_rc_t ReclsSearch::GetNextDetails(recls_entry_t* pinfo)
 
     if (RECLS_RC_NO_MORE_DATA == m_lastError)
     {
-        delete m_dnode;
-
-        m_dnode = ss_nullptr_k;
+        EndSearch_();
     }
 
     return m_lastError;
 }
 
+recls_rc_t ReclsSearch::GetNextDetailsBatch(
+    recls_entry_t*  entries
+,   size_t          max
+,   size_t*         pcount
+)
+{
+    function_scope_trace("ReclsSearch::GetNextDetailsBatch");
+
+    RECLS_ASSERT(0 == max || ss_nullptr_k != entries);
+    RECLS_ASSERT(ss_nullptr_k != pcount);
+
+    recls_rc_t  rc = RECLS_RC_OK;
+    size_t      n;
+
+    for (n = 0; n != max; ++n)
+    {
+        // The node is released on reaching the end, so a batch that
+        // exactly exhausts the search is followed by one that gets nothing
+        if (ss_nullptr_k == m_dnode)
+        {
+            rc = m_lastError = RECLS_RC_NO_MORE_DATA;
+
+            break;
+        }
+
+        rc = GetNextDetails(&entries[n]);
+
+        if (RECLS_FAILED(rc))
+        {
+            break;
+        }
+    }
+
+    *pcount = n;
+
+    // A short batch reports the reason it is short, along with the entries
+    // retrieved before it
+    return rc;
+}
+
+recls_rc_t ReclsSearch::Reset(
+    recls_char_t const* /* searchRoot */
+,   recls_char_t const* /* pattern */
+)
+{
+    function_scope_trace("ReclsSearch::Reset");
+
+    return RECLS_RC_NOT_IMPLEMENTED;
+}
+
 // Accessors
 
 recls_rc_t ReclsSearch::GetLastError() const
@@ -124,6 +184,26 @@ recls_rc_t ReclsSearch::GetLastError() const
     return m_lastError;
 }
 
+// Implementation
+
+void ReclsSearch::EndSearch_()
+{
+    RECLS_ASSERT(ss_nullptr_k != m_dnode);
+
+    if (m_dnode->IsRestartable())
+    {
+        delete m_idleNode;
+
+        m_idleNode = m_dnode;
+    }
+    else
+    {
+        delete m_dnode;
+    }
+
+    m_dnode = ss_nullptr_k;
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
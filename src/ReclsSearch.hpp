@@ -4,11 +4,11 @@
  * Purpose: Definition of the ReclsSearch and ReclsSearchDirectoryNode classes.
  *
  * Created: 15th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -32,6 +32,8 @@
 #endif /* __cplusplus */
 
 #include <recls/recls.h>
+#include "impl.allocator.hpp"
+#include "impl.entryfunctions.h"
 
 /* /////////////////////////////////////////////////////////////////////////
  * Compiler / language features
@@ -67,7 +69,10 @@ namespace impl
 /// Interface for directory nodes
 ///
 /// \note It has an ugly name-prefix if need to compile with compiler that does not support namespaces
+///
+/// \note Nodes are allocated by the allocator set by Recls_SetAllocator()
 struct ReclsSearchDirectoryNode
+    : public allocated_object
 {
 // Construction
 public:
@@ -84,11 +89,49 @@ public:
     virtual recls_rc_t GetDetails(recls_entry_t* pinfo) = 0;
 
     virtual recls_rc_t GetNextDetails(recls_entry_t* pinfo) = 0;
+
+    /// Obtains the current entry without adding a reference to it, so
+    /// that it remains valid only until the next call to GetNext() (or
+    /// GetNextDetails()), or the destruction of the node
+    virtual recls_rc_t BorrowDetails(recls_entry_t* pinfo) = 0;
+
+// Restart
+public:
+    /// Indicates whether the node can be restarted by Restart(), and so
+    /// is worth retaining once it has reached the end of its enumeration
+    virtual bool IsRestartable() const;
+
+    /// Restarts the node's enumeration from the given search directory,
+    /// reusing the node's resources, and positions it on the first entry
+    ///
+    /// \retval RECLS_RC_NOT_IMPLEMENTED The node cannot be restarted for
+    ///   the given pattern, and must be replaced
+    virtual recls_rc_t Restart(
+        recls_char_t const* searchDir
+    ,   size_t              searchDirLen
+    ,   recls_char_t const* pattern
+    ,   size_t              patternLen
+    );
 };
 
 inline ReclsSearchDirectoryNode::~ReclsSearchDirectoryNode()
 {}
 
+inline bool ReclsSearchDirectoryNode::IsRestartable() const
+{
+    return false;
+}
+
+inline recls_rc_t ReclsSearchDirectoryNode::Restart(
+    recls_char_t const* /* searchDir */
+,   size_t              /* searchDirLen */
+,   recls_char_t const* /* pattern */
+,   size_t              /* patternLen */
+)
+{
+    return RECLS_RC_NOT_IMPLEMENTED;
+}
+
 // class ReclsSearch
 struct ReclsSearch
 {
@@ -107,6 +150,18 @@ public:
     virtual recls_rc_t GetNext();
     virtual recls_rc_t GetDetails(recls_entry_t* pinfo);
     virtual recls_rc_t GetNextDetails(recls_entry_t* pinfo);
+    /// Obtains the current entry without adding a reference to it
+    ///
+    /// \see ReclsSearchDirectoryNode::BorrowDetails()
+    recls_rc_t         BorrowDetails(recls_entry_t* pinfo);
+    /// Advances the search up to \c max positions, retrieving the details
+    /// of each into \c entries, and the number retrieved into \c *pcount
+    recls_rc_t         GetNextDetailsBatch(recls_entry_t* entries, size_t max, size_t* pcount);
+    /// Restarts the search, optionally with a different search root and/or
+    /// pattern (either of which may be NULL to retain the current one)
+    ///
+    /// \retval RECLS_RC_NOT_IMPLEMENTED The search type cannot be restarted
+    virtual recls_rc_t Reset(recls_char_t const* searchRoot, recls_char_t const* pattern);
 
 // Accessors
 public:
@@ -117,11 +172,19 @@ public:
     static hrecls_t     ToHandle(ReclsSearch* si);
     static ReclsSearch* FromHandle(hrecls_t h);
 
+// Implementation
+protected:
+    /// Disposes of m_dnode at the end of the search, retaining it in
+    /// m_idleNode if it can be restarted
+    void EndSearch_();
+
 // Members
 protected:
     // protected data harmful but necessary, since it enables a drop in code size
     ReclsSearchDirectoryNode*   m_dnode;
+    ReclsSearchDirectoryNode*   m_idleNode;     // Exhausted, but restartable
     recls_rc_t                  m_lastError;
+    entry_arena_t*              m_arena;        // Released after the nodes
 };
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -4,11 +4,11 @@
  * Purpose: recls API functions pertaining to entry info.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -29,6 +29,8 @@
 #include "impl.root.h"
 #include "incl.platformstl.h"
 #include "impl.util.h"
+#include "impl.entryfunctions.h"
+#include "impl.entryinfo.hpp"
 
 #include "impl.trace.h"
 
@@ -44,8 +46,10 @@
 namespace recls
 {
 
+using ::recls::impl::Entry_TimesNsec;
 using ::recls::impl::recls_get_string_property_;
 using ::recls::impl::recls_file_exists_;
+using ::recls::impl::types;
 #endif /* !RECLS_NO_NAMESPACE */
 
 namespace
@@ -62,6 +66,42 @@ always_false_()
 }
 #endif
 
+/* Scans the entry's directory for the given part, for an entry whose
+ * parts were not determined by its search (because RECLS_F_DIRECTORY_PARTS
+ * was not specified), returning the number of parts preceding it (or all
+ * the parts, if not found).
+ */
+static
+size_t
+find_directory_part_(
+    recls_entry_t           fileInfo
+,   int                     part
+,   struct recls_strptrs_t* ptrs
+)
+{
+    recls_char_t const* b   =   fileInfo->directory.begin;
+    size_t              n   =   0;
+
+    { for (recls_char_t const* p = b; p != fileInfo->directory.end; ++p)
+    {
+        if (types::traits_type::is_path_name_separator(*p))
+        {
+            if (part == static_cast<int>(n))
+            {
+                ptrs->begin =   b;
+                ptrs->end   =   p + 1;
+
+                break;
+            }
+
+            ++n;
+            b = p + 1;
+        }
+    }}
+
+    return n;
+}
+
 } /* anonymous namespace */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -235,6 +275,33 @@ RECLS_FNDECL(size_t) Recls_GetDirectoryPartProperty(
 
     size_t  cParts = static_cast<size_t>(fileInfo->directoryParts.end - fileInfo->directoryParts.begin);
 
+    if (0 == cParts)
+    {
+        // The parts are only stored in the entry when requested by the
+        // search, so otherwise they are determined here, as required
+
+        struct recls_strptrs_t  ptrs    =   { ss_nullptr_k, ss_nullptr_k };
+
+        cParts = find_directory_part_(fileInfo, part, &ptrs);
+
+        if (part < 0)
+        {
+            return cParts;
+        }
+        else if (ss_nullptr_k == ptrs.begin)
+        {
+            // part >= the number of parts
+
+            return 0;
+        }
+        else
+        {
+            RECLS_ASSERT(static_cast<size_t>(part) == cParts);
+
+            return recls_get_string_property_(&ptrs, buffer, cchBuffer);
+        }
+    }
+
     if (part < 0)
     {
         return cParts;
@@ -275,6 +342,15 @@ RECLS_FNDECL(recls_bool_t) Recls_EntryExists(recls_entry_t fileInfo)
     return false;
 }
 
+RECLS_FNDECL(recls_bool_t) Recls_EntryHasDetails(recls_entry_t fileInfo)
+{
+    function_scope_trace("Recls_EntryHasDetails");
+
+    RECLS_ASSERT(ss_nullptr_k != fileInfo);
+
+    return 0 == (fileInfo->extendedFlags[0] & RECLS_ENTRYINFO_XF0_DETAILS_NOT_LOADED_);
+}
+
 RECLS_FNDECL(recls_bool_t) Recls_IsFileReadOnly(recls_entry_t fileInfo)
 {
     function_scope_trace("Recls_IsFileReadOnly");
@@ -405,6 +481,33 @@ RECLS_FNDECL(recls_time_t) Recls_GetLastAccessTime(recls_entry_t fileInfo)
     return fileInfo->lastAccessTime;
 }
 
+RECLS_FNDECL(recls_uint32_t) Recls_GetModificationTimeNsec(recls_entry_t fileInfo)
+{
+    function_scope_trace("Recls_GetModificationTimeNsec");
+
+    RECLS_ASSERT(ss_nullptr_k != fileInfo);
+
+    return Entry_TimesNsec(fileInfo)->modificationTime;
+}
+
+RECLS_FNDECL(recls_uint32_t) Recls_GetLastAccessTimeNsec(recls_entry_t fileInfo)
+{
+    function_scope_trace("Recls_GetLastAccessTimeNsec");
+
+    RECLS_ASSERT(ss_nullptr_k != fileInfo);
+
+    return Entry_TimesNsec(fileInfo)->lastAccessTime;
+}
+
+RECLS_FNDECL(recls_uint32_t) Recls_GetLastStatusChangeTimeNsec(recls_entry_t fileInfo)
+{
+    function_scope_trace("Recls_GetLastStatusChangeTimeNsec");
+
+    RECLS_ASSERT(ss_nullptr_k != fileInfo);
+
+    return Entry_TimesNsec(fileInfo)->lastStatusChangeTime;
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
@@ -4,11 +4,11 @@
  * Purpose: recls API extended functions.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -27,11 +27,21 @@
 #include <recls/recls.h>
 #include <recls/assert.h>
 #include "impl.root.h"
+#include "impl.allocator.hpp"
 #include "impl.types.hpp"
 #include "impl.util.h"
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# include "impl.dirscan.linux.hpp"
+# include "impl.dirsize.linux.hpp"
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #include "impl.trace.h"
 
+#include <string>
+#include <vector>
+
+#include <string.h>
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
@@ -41,8 +51,15 @@ namespace recls
 {
 
 using ::recls::impl::types;
+using ::recls::impl::stl_allocator;
 
+using ::recls::impl::recls_error_trace_printf_;
 using ::recls::impl::recls_debug0_trace_printf_;
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+using ::recls::impl::dirscan_entry_t;
+using ::recls::impl::dirscan_reader;
+using ::recls::impl::dirsize_calc;
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #endif /* !RECLS_NO_NAMESPACE */
 
@@ -97,6 +114,47 @@ RECLS_LINKAGE_C recls_char_t const* Recls_GetWildcardsAll()
  * extended API functions
  */
 
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+/** The size of the buffer into which directories are read to determine
+ * whether they are empty, which is large enough that any counted entry is
+ * usually found by the first read
+ */
+# define RECLS_IS_DIRECTORY_EMPTY_BUFFER_SIZE_              (1024)
+
+static
+recls_bool_t
+IsDirectoryEmpty_(
+    recls_char_t const* dir
+,   void*               buffer
+,   size_t              cbBuffer
+)
+{
+    dirscan_reader reader(buffer, cbBuffer);
+
+    // A directory that cannot be read is reported as empty, as it was when
+    // it was searched
+    if (0 != reader.open(AT_FDCWD, dir, 0))
+    {
+        return true;
+    }
+
+    dirscan_entry_t de;
+
+    // The reader skips "." and "..". Those entries whose names begin with
+    // '.' are not counted, since they are not matched by the wildcard
+    // with which the directory is otherwise searched, so it returns as
+    // soon as any other entry is read
+    while (1 == reader.read(&de))
+    {
+        if ('.' != de.name[0])
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 static
 int
 RECLS_CALLCONV_DEFAULT IsDirectoryEmpty_proc(
@@ -106,6 +164,7 @@ RECLS_CALLCONV_DEFAULT IsDirectoryEmpty_proc(
 {
     return 0; // Cancel on any entry
 }
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 RECLS_FNDECL(recls_bool_t) Recls_IsDirectoryEmpty(recls_char_t const* dir)
 {
@@ -113,9 +172,59 @@ RECLS_FNDECL(recls_bool_t) Recls_IsDirectoryEmpty(recls_char_t const* dir)
 
     recls_debug0_trace_printf_(RECLS_LITERAL("Recls_IsDirectoryEmpty(%s)"), stlsoft::c_str_ptr(dir));
 
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+    recls_uint64_t buffer[RECLS_IS_DIRECTORY_EMPTY_BUFFER_SIZE_ / sizeof(recls_uint64_t)];
+
+    if (ss_nullptr_k == dir ||
+        '\0' == 0[dir])
+    {
+        dir = RECLS_LITERAL(".");
+    }
+
+    return IsDirectoryEmpty_(dir, buffer, sizeof(buffer));
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
     recls_rc_t rc = Recls_SearchProcess(dir, Recls_GetWildcardsAll(), RECLS_F_TYPEMASK, IsDirectoryEmpty_proc, 0);
 
     return RECLS_RC_SEARCH_CANCELLED != rc;
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+}
+
+RECLS_FNDECL(size_t) Recls_AreDirectoriesEmpty(
+    recls_char_t const* const*  dirs
+,   size_t                      numDirs
+,   recls_bool_t*               results
+)
+{
+    function_scope_trace("Recls_AreDirectoriesEmpty");
+
+    recls_debug0_trace_printf_(RECLS_LITERAL("Recls_AreDirectoriesEmpty(%p, %lu, %p)"), dirs, static_cast<unsigned long>(numDirs), results);
+
+    RECLS_ASSERT(0 == numDirs || ss_nullptr_k != dirs);
+    RECLS_ASSERT(0 == numDirs || ss_nullptr_k != results);
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+    // The buffer is shared by all the directories
+    recls_uint64_t buffer[RECLS_IS_DIRECTORY_EMPTY_BUFFER_SIZE_ / sizeof(recls_uint64_t)];
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+    size_t numEmpty = 0;
+
+    { for (size_t i = 0; i != numDirs; ++i)
+    {
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+        recls_char_t const* const dir = (ss_nullptr_k == dirs[i] || '\0' == 0[dirs[i]]) ? RECLS_LITERAL(".") : dirs[i];
+
+        results[i] = IsDirectoryEmpty_(dir, buffer, sizeof(buffer));
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+        results[i] = Recls_IsDirectoryEmpty(dirs[i]);
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+        if (results[i])
+        {
+            ++numEmpty;
+        }
+    }}
+
+    return numEmpty;
 }
 
 RECLS_FNDECL(recls_bool_t) Recls_IsDirectoryEntryEmpty(recls_entry_t hEntry)
@@ -151,12 +260,20 @@ RECLS_FNDECL(recls_filesize_t) Recls_CalcDirectorySize(recls_char_t const* dir)
 
     recls_debug0_trace_printf_(RECLS_LITERAL("Recls_CalcDirectorySize(%s)"), stlsoft::c_str_ptr(dir));
 
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+    recls_directorySize_t size;
+
+    Recls_CalcDirectorySizeEx(dir, 0, &size);
+
+    return size.apparentSize;
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
     static recls_filesize_t zero;
     recls_filesize_t        total = zero;
 
     Recls_SearchProcess(dir, Recls_GetWildcardsAll(), RECLS_F_FILES | RECLS_F_RECURSIVE, CalcDirectorySize_proc, static_cast<recls_process_fn_param_t>(&total));
 
     return total;
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 }
 
 RECLS_FNDECL(recls_filesize_t) Recls_CalcDirectoryEntrySize(recls_entry_t hEntry)
@@ -194,6 +311,268 @@ RECLS_FNDECL(recls_filesize_t) Recls_CalcDirectorySizeFeedback(
     return total;
 }
 
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+static
+int
+RECLS_CALLCONV_DEFAULT CalcDirectorySizeEx_proc(
+    recls_entry_t               hEntry
+,   recls_process_fn_param_t    param
+)
+{
+    recls_directorySize_t& size = *static_cast<recls_directorySize_t*>(param);
+
+    if (Recls_IsFileDirectory(hEntry))
+    {
+        ++size.numDirectories;
+    }
+    else
+    {
+        recls_filesize_t const fileSize = Recls_GetSizeProperty(hEntry);
+
+        ++size.numFiles;
+        size.apparentSize   +=  fileSize;
+        size.allocatedSize  +=  fileSize;
+    }
+
+    return 1; // Never cancel
+}
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+RECLS_API Recls_CalcDirectorySizeEx(
+    recls_char_t const*     dir
+,   recls_uint32_t          flags
+,   recls_directorySize_t*  size
+)
+{
+    function_scope_trace("Recls_CalcDirectorySizeEx");
+
+    recls_debug0_trace_printf_(RECLS_LITERAL("Recls_CalcDirectorySizeEx(%s, %08x, ...)"), stlsoft::c_str_ptr(dir), flags);
+
+    RECLS_ASSERT(ss_nullptr_k != size);
+
+    if (ss_nullptr_k == dir ||
+        '\0' == 0[dir])
+    {
+        dir = RECLS_LITERAL(".");
+    }
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+# endif /* RECLS_EXCEPTION_SUPPORT_ */
+        return dirsize_calc(dir, flags, ss_nullptr_k, ss_nullptr_k, size);
+# ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        return RECLS_RC_OUT_OF_MEMORY;
+    }
+# endif /* RECLS_EXCEPTION_SUPPORT_ */
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+    // Neither allocated sizes nor node indexes are available
+    recls_uint32_t searchFlags = RECLS_F_FILES | RECLS_F_DIRECTORIES | RECLS_F_RECURSIVE;
+
+    if (RECLS_DIRSIZE_F_NO_FOLLOW_LINKS & flags)
+    {
+        searchFlags |= RECLS_F_NO_FOLLOW_LINKS;
+    }
+
+    ::memset(size, 0, sizeof(*size));
+
+    return Recls_SearchProcess(dir, Recls_GetWildcardsAll(), searchFlags, CalcDirectorySizeEx_proc, size);
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+}
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+namespace
+{
+    typedef std::basic_string<
+        recls_char_t
+    ,   std::char_traits<recls_char_t>
+    ,   stl_allocator<recls_char_t>
+    >                                               string_t;
+
+    struct directory_t
+    {
+        string_t    path;
+        bool        counted;    // false if its name begins with '.', on UNIX
+    };
+    typedef std::vector<
+        directory_t
+    ,   stl_allocator<directory_t>
+    >                                               directories_t;
+
+#if defined(RECLS_PLATFORM_IS_UNIX)
+    /* Directories whose names begin with '.' are searched, as they are by a
+     * recursive search of the wildcard, although neither they nor files
+     * whose names begin with '.' are counted
+     */
+    static recls_char_t const s_directorySizesPattern[] = { RAPI_WILDCARDSALL, RAPI_PATHSEP, '.', RAPI_WILDCARDSALL, '\0' };
+#endif /* RECLS_PLATFORM_IS_UNIX */
+
+    struct directory_sizes_info_t_
+    {
+        recls_directorySize_t   size;
+        directories_t           directories;
+    };
+
+    int RECLS_CALLCONV_DEFAULT CalcDirectorySizes_proc(
+        recls_entry_t               hEntry
+    ,   recls_process_fn_param_t    param
+    )
+    {
+        directory_sizes_info_t_&    info    =   *static_cast<directory_sizes_info_t_*>(param);
+        recls_char_t const* const   name    =   hEntry->fileName.begin;
+        size_t const                nameLen =   static_cast<size_t>(hEntry->fileName.end - name);
+#if defined(RECLS_PLATFORM_IS_UNIX)
+        bool const                  counted =   '.' != name[0];
+#else /* ? RECLS_PLATFORM_IS_UNIX */
+        bool const                  counted =   true;
+#endif /* RECLS_PLATFORM_IS_UNIX */
+
+        if (Recls_IsFileDirectory(hEntry))
+        {
+            // "." and "..", should they be matched, are not sub-directories
+            if (!counted &&
+                (   1 == nameLen ||
+                    (   2 == nameLen &&
+                        '.' == name[1])))
+            {
+                return 1;
+            }
+
+            directory_t directory;
+
+            directory.path.assign(hEntry->path.begin, hEntry->path.end);
+            directory.counted = counted;
+
+            info.directories.push_back(directory);
+        }
+        else if (counted)
+        {
+            recls_filesize_t const fileSize = Recls_GetSizeProperty(hEntry);
+
+            ++info.size.numFiles;
+            info.size.apparentSize  +=  fileSize;
+            info.size.allocatedSize +=  fileSize;
+        }
+
+        return 1; // Never cancel
+    }
+
+    // Searches each directory once, without recursion, in post-order
+    recls_rc_t
+    CalcDirectorySizes_(
+        recls_char_t const*         dir
+    ,   size_t                      depth
+    ,   recls_uint32_t              searchFlags
+    ,   hrecls_directory_size_fn_t  pfn
+    ,   recls_process_fn_param_t    param
+    ,   recls_directorySize_t*      size
+    )
+    {
+        directory_sizes_info_t_ info;
+
+        ::memset(&info.size, 0, sizeof(info.size));
+
+#if defined(RECLS_PLATFORM_IS_UNIX)
+        recls_char_t const* const pattern = s_directorySizesPattern;
+#else /* ? RECLS_PLATFORM_IS_UNIX */
+        recls_char_t const* const pattern = Recls_GetWildcardsAll();
+#endif /* RECLS_PLATFORM_IS_UNIX */
+
+        recls_rc_t rc = Recls_SearchProcess(dir, pattern, searchFlags, CalcDirectorySizes_proc, &info);
+
+        if (RECLS_FAILED(rc))
+        {
+            return rc;
+        }
+
+        { for (directories_t::const_iterator b = info.directories.begin(); b != info.directories.end(); ++b)
+        {
+            recls_directorySize_t subdirSize;
+
+            rc = CalcDirectorySizes_((*b).path.c_str(), 1 + depth, searchFlags, pfn, param, &subdirSize);
+
+            if (RECLS_RC_ACCESS_DENIED == rc)
+            {
+                continue;
+            }
+            if (RECLS_FAILED(rc))
+            {
+                return rc;
+            }
+
+            info.size.numFiles          +=  subdirSize.numFiles;
+            info.size.numDirectories    +=  ((*b).counted ? 1 : 0) + subdirSize.numDirectories;
+            info.size.apparentSize      +=  subdirSize.apparentSize;
+            info.size.allocatedSize     +=  subdirSize.allocatedSize;
+        }}
+
+        if (0 == (*pfn)(dir, types::traits_type::str_len(dir), depth, &info.size, param))
+        {
+            return RECLS_RC_SEARCH_CANCELLED;
+        }
+
+        *size = info.size;
+
+        return RECLS_RC_OK;
+    }
+
+} /* anonymous namespace */
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+RECLS_API Recls_CalcDirectorySizes(
+    recls_char_t const*         dir
+,   recls_uint32_t              flags
+,   hrecls_directory_size_fn_t  pfn
+,   recls_process_fn_param_t    param
+)
+{
+    function_scope_trace("Recls_CalcDirectorySizes");
+
+    recls_debug0_trace_printf_(RECLS_LITERAL("Recls_CalcDirectorySizes(%s, %08x, ..., %p)"), stlsoft::c_str_ptr(dir), flags, param);
+
+    RECLS_ASSERT(ss_nullptr_k != pfn);
+
+    if (ss_nullptr_k == dir ||
+        '\0' == 0[dir])
+    {
+        dir = RECLS_LITERAL(".");
+    }
+
+    recls_directorySize_t size;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+        return dirsize_calc(dir, flags, pfn, param, &size);
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+        recls_uint32_t searchFlags = RECLS_F_FILES | RECLS_F_DIRECTORIES;
+
+        if (RECLS_DIRSIZE_F_NO_FOLLOW_LINKS & flags)
+        {
+            searchFlags |= RECLS_F_NO_FOLLOW_LINKS;
+        }
+
+        return CalcDirectorySizes_(dir, 0, searchFlags, pfn, param, &size);
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        return RECLS_RC_OUT_OF_MEMORY;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
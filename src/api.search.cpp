@@ -4,11 +4,11 @@
  * Purpose: Main (platform-independent) implementation file for the recls API.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -57,6 +57,7 @@ namespace impl
 
 using ::recls::impl::Recls_SearchFeedback_;
 using ::recls::impl::Recls_SearchProcessFeedback_;
+using ::recls::impl::search_options_t;
 
 using ::recls::impl::ReclsSearch;
 using ::recls::impl::constants;
@@ -113,6 +114,7 @@ RECLS_API Recls_Search(
     ,   flags
     ,   ss_nullptr_k
     ,   ss_nullptr_k
+    ,   ss_nullptr_k
     ,   phSrch
     );
 }
@@ -143,6 +145,7 @@ RECLS_API Recls_SearchFeedback(
     ,   flags
     ,   pfn
     ,   param
+    ,   ss_nullptr_k
     ,   phSrch
     );
 }
@@ -161,6 +164,28 @@ RECLS_FNDECL(void) Recls_SearchClose(hrecls_t hSrch)
     delete si;
 }
 
+RECLS_API Recls_SearchReset(
+    hrecls_t            hSrch
+,   recls_char_t const* searchRoot
+,   recls_char_t const* pattern
+)
+{
+    function_scope_trace("Recls_SearchReset");
+
+    recls_debug0_trace_printf_(
+        RECLS_LITERAL("Recls_SearchReset(%p, %s, %s)")
+    ,   hSrch
+    ,   stlsoft::c_str_ptr(searchRoot)
+    ,   stlsoft::c_str_ptr(pattern)
+    );
+
+    ReclsSearch* const si = ReclsSearch::FromHandle(hSrch);
+
+    RECLS_MESSAGE_ASSERT("Search handle is null!", ss_nullptr_k != si);
+
+    return si->Reset(searchRoot, pattern);
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * search enumeration
  */
@@ -195,6 +220,7 @@ RECLS_API Recls_SearchProcessFeedback(
     ,   param
     ,   pfnProgress
     ,   paramProgress
+    ,   ss_nullptr_k
     );
 }
 
@@ -225,6 +251,149 @@ RECLS_API Recls_SearchProcess(
     ,   param
     ,   ss_nullptr_k
     ,   ss_nullptr_k
+    ,   ss_nullptr_k
+    );
+}
+
+RECLS_API Recls_SearchParallel(
+    recls_char_t const* searchRoot
+,   recls_char_t const* pattern
+,   recls_uint32_t      flags
+,   recls_uint32_t      numThreads
+,   recls_uint32_t      parallelFlags
+,   hrecls_t*           phSrch
+)
+{
+    function_scope_trace("Recls_SearchParallel");
+
+    recls_debug0_trace_printf_(
+        RECLS_LITERAL("Recls_SearchParallel(%s, %s, 0x%04x, %u, 0x%04x, ...)")
+    ,   stlsoft::c_str_ptr(searchRoot)
+    ,   stlsoft::c_str_ptr(pattern)
+    ,   flags
+    ,   numThreads
+    ,   parallelFlags
+    );
+
+    search_options_t options = { true, numThreads, parallelFlags, ss_nullptr_k, ss_nullptr_k, 0, RECLS_DEPTH_UNLIMITED, false, ss_nullptr_k };
+
+    return Recls_SearchFeedback_(
+        "Recls_SearchParallel"
+    ,   searchRoot
+    ,   pattern
+    ,   flags
+    ,   ss_nullptr_k
+    ,   ss_nullptr_k
+    ,   &options
+    ,   phSrch
+    );
+}
+
+RECLS_API Recls_SearchProcessParallel(
+    recls_char_t const*         searchRoot
+,   recls_char_t const*         pattern
+,   recls_uint32_t              flags
+,   recls_uint32_t              numThreads
+,   recls_uint32_t              parallelFlags
+,   hrecls_process_fn_t         pfn
+,   recls_process_fn_param_t    param
+)
+{
+    function_scope_trace("Recls_SearchProcessParallel");
+
+    recls_debug0_trace_printf_(
+        RECLS_LITERAL("Recls_SearchProcessParallel(%s, %s, 0x%04x, %u, 0x%04x, ..., %p)")
+    ,   stlsoft::c_str_ptr(searchRoot)
+    ,   stlsoft::c_str_ptr(pattern)
+    ,   flags
+    ,   numThreads
+    ,   parallelFlags
+    ,   param
+    );
+
+    search_options_t options = { true, numThreads, parallelFlags, ss_nullptr_k, ss_nullptr_k, 0, RECLS_DEPTH_UNLIMITED, false, ss_nullptr_k };
+
+    return Recls_SearchProcessFeedback_(
+        "Recls_SearchProcessParallel"
+    ,   searchRoot
+    ,   pattern
+    ,   flags
+    ,   pfn
+    ,   param
+    ,   ss_nullptr_k
+    ,   ss_nullptr_k
+    ,   &options
+    );
+}
+
+RECLS_API Recls_SearchDepth(
+    recls_char_t const* searchRoot
+,   recls_char_t const* pattern
+,   recls_uint32_t      flags
+,   recls_uint32_t      minDepth
+,   recls_uint32_t      maxDepth
+,   hrecls_t*           phSrch
+)
+{
+    function_scope_trace("Recls_SearchDepth");
+
+    recls_debug0_trace_printf_(
+        RECLS_LITERAL("Recls_SearchDepth(%s, %s, 0x%04x, %u, %u, ...)")
+    ,   stlsoft::c_str_ptr(searchRoot)
+    ,   stlsoft::c_str_ptr(pattern)
+    ,   flags
+    ,   minDepth
+    ,   maxDepth
+    );
+
+    search_options_t options = { false, 0, 0, ss_nullptr_k, ss_nullptr_k, minDepth, maxDepth, false, ss_nullptr_k };
+
+    return Recls_SearchFeedback_(
+        "Recls_SearchDepth"
+    ,   searchRoot
+    ,   pattern
+    ,   flags
+    ,   ss_nullptr_k
+    ,   ss_nullptr_k
+    ,   &options
+    ,   phSrch
+    );
+}
+
+RECLS_API Recls_SearchProcessDepth(
+    recls_char_t const*         searchRoot
+,   recls_char_t const*         pattern
+,   recls_uint32_t              flags
+,   recls_uint32_t              minDepth
+,   recls_uint32_t              maxDepth
+,   hrecls_process_fn_t         pfn
+,   recls_process_fn_param_t    param
+)
+{
+    function_scope_trace("Recls_SearchProcessDepth");
+
+    recls_debug0_trace_printf_(
+        RECLS_LITERAL("Recls_SearchProcessDepth(%s, %s, 0x%04x, %u, %u, ..., %p)")
+    ,   stlsoft::c_str_ptr(searchRoot)
+    ,   stlsoft::c_str_ptr(pattern)
+    ,   flags
+    ,   minDepth
+    ,   maxDepth
+    ,   param
+    );
+
+    search_options_t options = { false, 0, 0, ss_nullptr_k, ss_nullptr_k, minDepth, maxDepth, false, ss_nullptr_k };
+
+    return Recls_SearchProcessFeedback_(
+        "Recls_SearchProcessDepth"
+    ,   searchRoot
+    ,   pattern
+    ,   flags
+    ,   pfn
+    ,   param
+    ,   ss_nullptr_k
+    ,   ss_nullptr_k
+    ,   &options
     );
 }
 
@@ -268,6 +437,23 @@ RECLS_API Recls_GetNextDetails(
     return si->GetNextDetails(pinfo);
 }
 
+RECLS_API Recls_GetNextDetailsBatch(
+    hrecls_t        hSrch
+,   recls_entry_t*  entries
+,   size_t          max
+,   size_t*         count
+)
+{
+    function_scope_trace("Recls_GetNextDetailsBatch");
+
+    ReclsSearch* const si = ReclsSearch::FromHandle(hSrch);
+
+    RECLS_MESSAGE_ASSERT("Search handle is null!", ss_nullptr_k != si);
+    RECLS_ASSERT(ss_nullptr_k != count);
+
+    return si->GetNextDetailsBatch(entries, max, count);
+}
+
 /***************************************
  * File entry info structure
  */
@@ -4,11 +4,11 @@
  * Purpose: more recls API extended functions.
  *
  * Created: 30th January 2009
- * Updated: 20th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2009-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -30,6 +30,9 @@
 #include "impl.string.hpp"
 #include "impl.types.hpp"
 #include "impl.util.h"
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# include "impl.mkdir.linux.hpp"
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #include "impl.trace.h"
 
@@ -65,6 +68,9 @@ using ::recls::impl::recls_fatal_trace_printf_;
 using ::recls::impl::recls_error_trace_printf_;
 using ::recls::impl::recls_debug0_trace_printf_;
 using ::recls::impl::recls_debug1_trace_printf_;
+# ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+using ::recls::impl::mkdir_creator;
+# endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #endif /* !RECLS_NO_NAMESPACE */
 
@@ -108,6 +114,19 @@ get_exception_status_code(
     return x.status_code();
 }
 
+void
+init_directory_results_(
+    recls_directoryResults_t* results
+)
+{
+    results->numExistingElements    =   0;
+    results->numResultingElements   =   0;
+    results->existingLength         =   0;
+    results->resultingLength        =   0;
+    results->numExistingFiles       =   0;
+    results->numDeletedFiles        =   0;
+}
+
 } /* anonymous namespace */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -117,6 +136,53 @@ get_exception_status_code(
 namespace
 {
 
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+    typedef mkdir_creator                                   directory_creator_t_;
+
+    /* Algorithm:
+     *
+     * - attempt to create the directory
+     * - if an intermediate directory is missing, find the deepest ancestor
+     *   that exists, and create, relative to it, those below it
+     *
+     * See mkdir_creator for details.
+     */
+
+    RECLS_API Recls_CreateDirectory3_(
+        recls_char_t const*         path
+    ,   size_t                      pathLen
+    ,   recls_directoryResults_t*   results
+    ,   directory_creator_t_&       creator
+    )
+    {
+        RECLS_ASSERT(ss_nullptr_k != path);
+        RECLS_ASSERT(0 != pathLen);
+        RECLS_ASSERT('\0' != 0[path]);
+        RECLS_ASSERT(types::traits_type::str_len(path) == pathLen);
+        RECLS_ASSERT(types::traits_type::is_path_absolute(path, pathLen));
+
+        RECLS_ASSERT(ss_nullptr_k != results);
+
+        recls_debug1_trace_printf_(
+            RECLS_LITERAL("Recls_CreateDirectory3_(%.*s, ...)")
+        ,   int(pathLen)
+        ,   stlsoft::c_str_ptr(path)
+        );
+
+        return creator.create(path, pathLen, results);
+    }
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+    /// Placeholder for the state shared between the creation of multiple
+    /// directories, of which there is none
+    struct directory_creator_t_
+    {
+        explicit
+        directory_creator_t_(bool /* shareParents */)
+        {}
+    };
+
     /* Algorithm:
      *
      * - make path absolute
@@ -130,6 +196,7 @@ namespace
         recls_char_t const*         path
     ,   size_t                      pathLen
     ,   recls_directoryResults_t*   results
+    ,   directory_creator_t_&       creator
     )
     {
         RECLS_ASSERT(ss_nullptr_k != path);
@@ -183,7 +250,7 @@ namespace
             }
             else if (path_0.size() != pathLen)
             {
-                recls_rc_t rc = Recls_CreateDirectory3_(path_0.data(), path_0.size(), results);
+                recls_rc_t rc = Recls_CreateDirectory3_(path_0.data(), path_0.size(), results, creator);
 
                 if (RECLS_FAILED(rc))
                 {
@@ -212,11 +279,13 @@ namespace
             }
         }
     }
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
     RECLS_API Recls_CreateDirectory_(
         recls_char_t const*         path
     ,   size_t                      pathLen
     ,   recls_directoryResults_t*   results
+    ,   directory_creator_t_&       creator
     )
     {
         RECLS_ASSERT(ss_nullptr_k != path);
@@ -238,7 +307,7 @@ namespace
 
             fullPath.canonicalise();
 
-            return Recls_CreateDirectory_(fullPath.c_str(), fullPath.size(), results);
+            return Recls_CreateDirectory_(fullPath.c_str(), fullPath.size(), results, creator);
         }
         else
         {
@@ -249,7 +318,7 @@ namespace
             /* results->numExistingFiles; */
             /* results->numDeletedFiles; */
 
-            return Recls_CreateDirectory3_(path, pathLen, results);
+            return Recls_CreateDirectory3_(path, pathLen, results, creator);
         }
     }
 
@@ -337,12 +406,7 @@ Recls_CreateDirectory_X_(
         results = &results_;
     }
 
-    results->numExistingElements    =   0;
-    results->numResultingElements   =   0;
-    results->existingLength         =   0;
-    results->resultingLength        =   0;
-    results->numExistingFiles       =   0;
-    results->numDeletedFiles        =   0;
+    init_directory_results_(results);
 
     if ('\0' == *path)
     {
@@ -350,8 +414,124 @@ Recls_CreateDirectory_X_(
     }
     else
     {
-        return Recls_CreateDirectory_(path, types::traits_type::str_len(path), results);
+        directory_creator_t_ creator(false);
+
+        return Recls_CreateDirectory_(path, types::traits_type::str_len(path), results, creator);
+    }
+}
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+static
+recls_rc_t
+Recls_CreateDirectories_X_(
+    recls_char_t const* const*  paths
+,   size_t                      numPaths
+,   recls_directoryResults_t*   results
+,   size_t*                     numCompleted
+);
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+
+RECLS_API
+Recls_CreateDirectories(
+    recls_char_t const* const*  paths
+,   size_t                      numPaths
+,   recls_directoryResults_t*   results         /* = NULL */
+,   size_t*                     numCompleted    /* = NULL */
+)
+#ifdef RECLS_EXCEPTION_SUPPORT_
+{
+    try
+    {
+        return Recls_CreateDirectories_X_(paths, numPaths, results, numCompleted);
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        return RECLS_RC_OUT_OF_MEMORY;
+    }
+    catch(platformstl::platform_exception& x)
+    {
+        recls_fatal_trace_printf_(RECLS_LITERAL("Exception in Recls_CreateDirectories(): %s"), x.what());
+
+# if defined(PLATFORMSTL_OS_IS_UNIX)
+        if (ENOENT == get_exception_status_code(x))
+# elif defined(PLATFORMSTL_OS_IS_WINDOWS)
+        if (ERROR_INVALID_NAME == get_exception_status_code(x))
+# else /* ? OS */
+#  error Platform not discriminated
+# endif /* OS */
+        {
+            return RECLS_RC_INVALID_NAME;
+        }
+
+        return RECLS_RC_UNEXPECTED;
+    }
+    catch(std::exception& x)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("Exception in Recls_CreateDirectories(): %s"), x.what());
+
+        return RECLS_RC_UNEXPECTED;
+    }
+}
+
+static
+recls_rc_t
+Recls_CreateDirectories_X_(
+    recls_char_t const* const*  paths
+,   size_t                      numPaths
+,   recls_directoryResults_t*   results
+,   size_t*                     numCompleted
+)
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+{
+    function_scope_trace("Recls_CreateDirectories");
+
+    recls_debug0_trace_printf_(RECLS_LITERAL("Recls_CreateDirectories(%p, %lu, ...)"), paths, static_cast<unsigned long>(numPaths));
+
+    RECLS_ASSERT(0 == numPaths || ss_nullptr_k != paths);
+
+    size_t numCompleted_;
+
+    if (ss_nullptr_k == numCompleted)
+    {
+        numCompleted = &numCompleted_;
     }
+
+    *numCompleted = 0;
+
+    // The creator is shared between the paths, so that those with the same
+    // parent as their predecessor need not locate it
+
+    directory_creator_t_ creator(true);
+
+    { for (size_t i = 0; i != numPaths; ++i)
+    {
+        recls_char_t const* const   path        =   paths[i];
+        recls_directoryResults_t    results_;
+        recls_directoryResults_t*   pathResults =   (ss_nullptr_k != results) ? &results[i] : &results_;
+
+        RECLS_ASSERT(ss_nullptr_k != path);
+
+        init_directory_results_(pathResults);
+
+        if ('\0' == *path)
+        {
+            return RECLS_RC_INVALID_NAME;
+        }
+
+        recls_rc_t rc = Recls_CreateDirectory_(path, types::traits_type::str_len(path), pathResults, creator);
+
+        if (RECLS_FAILED(rc))
+        {
+            return rc;
+        }
+
+        ++*numCompleted;
+    }}
+
+    return RECLS_RC_OK;
 }
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -4,11 +4,11 @@
  * Purpose: more recls API extended functions.
  *
  * Created: 30th January 2009
- * Updated: 20th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2009-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -27,14 +27,19 @@
 #include <recls/recls.h>
 #include <recls/assert.h>
 #include "impl.root.h"
+#include "impl.allocator.hpp"
 #include "impl.string.hpp"
 #include "impl.types.hpp"
 #include "impl.util.h"
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# include "impl.remdir.linux.hpp"
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #include "impl.trace.h"
 
 #include <platformstl/exception/platformstl_exception.hpp>
 
+#include <string>
 #include <vector>
 
 #if defined(RECLS_PLATFORM_IS_UNIX)
@@ -63,6 +68,12 @@ using ::recls::impl::types;
 using ::recls::impl::recls_fatal_trace_printf_;
 using ::recls::impl::recls_error_trace_printf_;
 using ::recls::impl::recls_debug0_trace_printf_;
+using ::recls::impl::stl_allocator;
+using ::recls::impl::recls_find_directory_0_;
+# ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+using ::recls::impl::remdir_results_t;
+using ::recls::impl::remdir_remove_tree;
+# endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
 #endif /* !RECLS_NO_NAMESPACE */
 
@@ -175,8 +186,15 @@ namespace
         return 1;
     }
 
-    typedef RECLS_STRING_TEMPLATE_1(recls_char_t)   directory_t;
-    typedef std::vector<directory_t>                directories_t;
+    typedef std::basic_string<
+        recls_char_t
+    ,   std::char_traits<recls_char_t>
+    ,   stl_allocator<recls_char_t>
+    >                                               directory_t;
+    typedef std::vector<
+        directory_t
+    ,   stl_allocator<directory_t>
+    >                                               directories_t;
 
     struct directory_removal_info_t_
     {
@@ -229,7 +247,7 @@ namespace
 
     RECLS_API Recls_RemoveDirectory4_(
         recls_char_t const*             path
-    ,   size_t                       /* pathLen */
+    ,   size_t                          pathLen
     ,   int                             flags
     ,   recls_directoryResults_t*       results
     )
@@ -250,6 +268,40 @@ namespace
         }
         else
         {
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+            // Remove the files (if requested), the sub-directories (unless
+            // proscribed) and the directory, in a single traversal
+
+            remdir_results_t    removal;
+            recls_rc_t          rc  =   remdir_remove_tree(path, flags, &removal);
+
+            if (RECLS_FAILED(rc))
+            {
+                return rc;
+            }
+
+            if (RECLS_REMDIR_F_REMOVE_FILES & flags)
+            {
+                results->numDeletedFiles    =   removal.numDeletedFiles;
+            }
+
+            if (0 != removal.maxDepth)
+            {
+                // The deepest, and longest, sub-directories removed are
+                // described relative to the directory
+
+                bool const      hasDirEnd   =   types::traits_type::has_dir_end(path, pathLen);
+                size_t const    rootDirLen  =   pathLen + (hasDirEnd ? 0 : 1);
+                size_t const    rootParts   =   types::count_dir_parts(recls_find_directory_0_(path), path + pathLen) + (hasDirEnd ? 0 : 1);
+
+                results->existingLength         =   rootDirLen + removal.maxRelativeLength;
+                results->numExistingElements    =   static_cast<unsigned>(rootParts + removal.maxDepth);
+            }
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+            STLSOFT_SUPPRESS_UNUSED(pathLen);
+
             if (RECLS_REMDIR_F_REMOVE_FILES & flags)
             {
                 // Remove all files
@@ -318,25 +370,24 @@ namespace
             {
                 return RECLS_RC_ACCESS_DENIED;
             }
-            else
-            {
-                types::path_type resultingPath(path);
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
 
-                if (0 == results->existingLength)
-                {
-                    results->existingLength = resultingPath.size();
-                }
+            types::path_type resultingPath(path);
 
-                resultingPath.pop(false);
-                results->numResultingElements = static_cast<unsigned>(types::count_dir_parts(resultingPath.data(), resultingPath.data() + resultingPath.size()));
+            if (0 == results->existingLength)
+            {
+                results->existingLength = resultingPath.size();
+            }
 
-                resultingPath.pop_sep();
-                results->resultingLength = resultingPath.size();
+            resultingPath.pop(false);
+            results->numResultingElements = static_cast<unsigned>(types::count_dir_parts(resultingPath.data(), resultingPath.data() + resultingPath.size()));
 
-                if (0 == results->numExistingElements)
-                {
-                    results->numExistingElements = 1u + results->numResultingElements;
-                }
+            resultingPath.pop_sep();
+            results->resultingLength = resultingPath.size();
+
+            if (0 == results->numExistingElements)
+            {
+                results->numExistingElements = 1u + results->numResultingElements;
             }
 
             return RECLS_RC_OK;
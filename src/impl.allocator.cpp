@@ -0,0 +1,132 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.allocator.cpp
+ *
+ * Purpose: Allocation through the allocator set by Recls_SetAllocator().
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+#include "impl.allocator.hpp"
+
+#include "impl.trace.h"
+
+#include <stdlib.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * globals
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+// The functions are NULL when no allocator is set, in which case malloc()
+// and free() are used
+recls_alloc_pfn_t   s_pfnAlloc  =   ss_nullptr_k;
+recls_free_pfn_t    s_pfnFree   =   ss_nullptr_k;
+void*               s_context   =   ss_nullptr_k;
+
+#if !defined(RECLS_NO_NAMESPACE)
+} // anonymous namespace
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * API functions
+ */
+
+RECLS_FNDECL(void) Recls_SetAllocator(
+    struct recls_allocator_t const* allocator
+)
+{
+    function_scope_trace("Recls_SetAllocator");
+
+    RECLS_ASSERT(ss_nullptr_k == allocator || ss_nullptr_k != allocator->pfnAlloc);
+    RECLS_ASSERT(ss_nullptr_k == allocator || ss_nullptr_k != allocator->pfnFree);
+
+    if (ss_nullptr_k == allocator)
+    {
+        s_pfnAlloc  =   ss_nullptr_k;
+        s_pfnFree   =   ss_nullptr_k;
+        s_context   =   ss_nullptr_k;
+    }
+    else
+    {
+        s_pfnAlloc  =   allocator->pfnAlloc;
+        s_pfnFree   =   allocator->pfnFree;
+        s_context   =   allocator->context;
+    }
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+RECLS_FNDECL(void*) recls_malloc_(size_t cb)
+{
+    return (ss_nullptr_k != s_pfnAlloc) ? (*s_pfnAlloc)(cb, s_context) : ::malloc(cb);
+}
+
+RECLS_FNDECL(void) recls_free_(void* pv)
+{
+    if (ss_nullptr_k != pv)
+    {
+        if (ss_nullptr_k != s_pfnFree)
+        {
+            (*s_pfnFree)(pv, s_context);
+        }
+        else
+        {
+            ::free(pv);
+        }
+    }
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,201 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.allocator.hpp
+ *
+ * Purpose: Allocation through the allocator set by Recls_SetAllocator().
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_ALLOCATOR
+#define RECLS_INCL_SRC_HPP_IMPL_ALLOCATOR
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#include <new>
+#include <stddef.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+/** Allocates a block of at least the given size, from the allocator set
+ * by Recls_SetAllocator() (or by malloc(), if none is set), returning NULL
+ * if it cannot be allocated.
+ */
+RECLS_FNDECL(void*)
+recls_malloc_(
+    size_t cb
+);
+
+/** Releases a block obtained from recls_malloc_(); it may be NULL. */
+RECLS_FNDECL(void)
+recls_free_(
+    void* pv
+);
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class allocated_object
+/// Mixin that allocates instances of the deriving class by recls_malloc_()
+///
+/// \note Classes that have their own operator new (such as those that
+///   allocate additional storage along with each instance) must themselves
+///   use recls_malloc_() and recls_free_()
+class allocated_object
+{
+public:
+    static void* operator new(size_t cb)
+    {
+        void* const pv = recls_malloc_(cb);
+
+#ifdef RECLS_COMPILER_THROWS_ON_NEW_FAIL
+        if (ss_nullptr_k == pv)
+        {
+            throw std::bad_alloc();
+        }
+#endif /* RECLS_COMPILER_THROWS_ON_NEW_FAIL */
+
+        return pv;
+    }
+    static void operator delete(void* pv)
+    {
+        recls_free_(pv);
+    }
+};
+
+// class stl_allocator
+/// Allocator, for the library's standard containers, that allocates by
+/// recls_malloc_()
+template <typename T>
+class stl_allocator
+{
+public:
+    typedef T                                               value_type;
+    typedef stl_allocator<T>                                class_type;
+    typedef T*                                              pointer;
+    typedef T const*                                        const_pointer;
+    typedef T&                                              reference;
+    typedef T const&                                        const_reference;
+    typedef size_t                                          size_type;
+    typedef ptrdiff_t                                       difference_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef stl_allocator<U>                            other;
+    };
+
+public:
+    stl_allocator() STLSOFT_NOEXCEPT
+    {}
+    stl_allocator(class_type const&) STLSOFT_NOEXCEPT
+    {}
+    template <typename U>
+    stl_allocator(stl_allocator<U> const&) STLSOFT_NOEXCEPT
+    {}
+
+public:
+    pointer allocate(size_type n, void const* = ss_nullptr_k)
+    {
+        if (n > max_size())
+        {
+            throw std::bad_alloc();
+        }
+
+        void* const pv = recls_malloc_(n * sizeof(T));
+
+        if (ss_nullptr_k == pv)
+        {
+            throw std::bad_alloc();
+        }
+
+        return static_cast<pointer>(pv);
+    }
+    void deallocate(pointer p, size_type)
+    {
+        recls_free_(p);
+    }
+
+    size_type max_size() const STLSOFT_NOEXCEPT
+    {
+        return static_cast<size_type>(-1) / sizeof(T);
+    }
+
+    pointer address(reference x) const
+    {
+        return &x;
+    }
+    const_pointer address(const_reference x) const
+    {
+        return &x;
+    }
+
+    void construct(pointer p, T const& x)
+    {
+        new(static_cast<void*>(p)) T(x);
+    }
+    void destroy(pointer p)
+    {
+        STLSOFT_SUPPRESS_UNUSED(p);
+
+        p->~T();
+    }
+};
+
+template <typename T, typename U>
+inline bool operator ==(stl_allocator<T> const&, stl_allocator<U> const&) STLSOFT_NOEXCEPT
+{
+    return true;
+}
+
+template <typename T, typename U>
+inline bool operator !=(stl_allocator<T> const&, stl_allocator<U> const&) STLSOFT_NOEXCEPT
+{
+    return false;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_ALLOCATOR */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -4,11 +4,11 @@
  * Purpose: implementation behind API functions.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    http://recls.org/
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -152,6 +152,7 @@ Recls_SearchFeedback_x_(
 ,   /* [in] */ recls_uint32_t               flags
 ,   /* [in] */ hrecls_progress_fn_t         pfn
 ,   /* [in] */ recls_process_fn_param_t     param
+,   /* [in] */ search_options_t const*      options
 ,   /* [out] */ hrecls_t*                   phSrch
 );
 
@@ -173,6 +174,7 @@ Recls_SearchFeedback_(
 ,   /* [in] */ recls_uint32_t               flags
 ,   /* [in] */ hrecls_progress_fn_t         pfn
 ,   /* [in] */ recls_process_fn_param_t     param
+,   /* [in] */ search_options_t const*      options
 ,   /* [out] */ hrecls_t*                   phSrch
 )
 {
@@ -199,6 +201,7 @@ Recls_SearchFeedback_(
         ,   flags
         ,   pfn
         ,   param
+        ,   options
         ,   phSrch
         );
 #ifdef RECLS_EXCEPTION_SUPPORT_
@@ -248,6 +251,7 @@ Recls_SearchFeedback_x_(
 ,   /* [in] */ recls_uint32_t               flags
 ,   /* [in] */ hrecls_progress_fn_t         pfn
 ,   /* [in] */ recls_process_fn_param_t     param
+,   /* [in] */ search_options_t const*      options
 ,   /* [out] */ hrecls_t*                   phSrch
 )
 {
@@ -323,6 +327,7 @@ Recls_SearchFeedback_x_(
                 ,   flags
                 ,   pfn
                 ,   param
+                ,   options
                 ,   phSrch
                 );
             }
@@ -386,6 +391,7 @@ Recls_SearchFeedback_x_(
             ,   flags
             ,   pfn
             ,   param
+            ,   options
             ,   phSrch
             );
         }
@@ -423,6 +429,7 @@ Recls_SearchFeedback_x_(
                 ,   flags
                 ,   pfn
                 ,   param
+                ,   options
                 ,   phSrch
                 );
             }
@@ -476,6 +483,7 @@ Recls_SearchFeedback_x_(
                 ,   flags
                 ,   pfn
                 ,   param
+                ,   options
                 ,   phSrch
                 );
             }
@@ -507,6 +515,7 @@ Recls_SearchFeedback_x_(
             ,   flags
             ,   pfn
             ,   param
+            ,   options
             ,   phSrch
             );
         }
@@ -550,6 +559,7 @@ Recls_SearchFeedback_x_(
             ,   flags
             ,   pfn
             ,   param
+            ,   options
             ,   phSrch
             );
         }
@@ -594,16 +604,33 @@ Recls_SearchFeedback_x_(
             }
         }
 
-        rc = ReclsFileSearch::FindAndCreate(
-            searchRoot
-        ,   searchRootLen
-        ,   patterns
-        ,   patternsLen
-        ,   flags
-        ,   pfn
-        ,   param
-        ,   &si
-        );
+        if (ss_nullptr_k != options &&
+            ss_nullptr_k != options->restart)
+        {
+            si = options->restart;
+
+            rc = si->Restart(
+                searchRoot
+            ,   searchRootLen
+            ,   patterns
+            ,   patternsLen
+            ,   flags
+            );
+        }
+        else
+        {
+            rc = ReclsFileSearch::FindAndCreate(
+                searchRoot
+            ,   searchRootLen
+            ,   patterns
+            ,   patternsLen
+            ,   flags
+            ,   pfn
+            ,   param
+            ,   options
+            ,   &si
+            );
+        }
 
         if (RECLS_SUCCEEDED(rc))
         {
@@ -628,6 +655,7 @@ Recls_SearchProcessFeedback_(
 ,   /* [in] */ recls_process_fn_param_t     param
 ,   /* [in] */ hrecls_progress_fn_t         pfnProgress
 ,   /* [out] */ recls_process_fn_param_t    paramProgress
+,   /* [in] */ search_options_t const*      options
 )
 {
     RECLS_ASSERT(ss_nullptr_k != pfn);
@@ -643,6 +671,37 @@ Recls_SearchProcessFeedback_(
     ,   paramProgress
     );
 
+    search_options_t    processOptions  =   { false, 0, 0, ss_nullptr_k, ss_nullptr_k, 0, RECLS_DEPTH_UNLIMITED, false, ss_nullptr_k };
+
+    if (ss_nullptr_k != options)
+    {
+        processOptions = *options;
+    }
+
+    // An unordered parallel search passes the entries to the process
+    // function from its worker threads, and so completes without a search
+    // handle. (A search that cannot be performed in parallel yields a
+    // handle, which is processed here in the normal way.)
+    if (processOptions.parallel &&
+        0 == (RECLS_PARALLEL_F_DETERMINISTIC & processOptions.parallelFlags))
+    {
+        processOptions.pfnProcess   =   pfn;
+        processOptions.paramProcess =   param;
+    }
+
+    // The process function borrows each entry - as it always has, since
+    // the entry is released on its return. A caller that keeps entries (by
+    // Recls_CopyDetails()) keeps only their own memory, since each is
+    // allocated from the heap, unless it specifies RECLS_F_RECYCLE_ENTRIES,
+    // in which case they are allocated from the search's arena, and a copy
+    // keeps the arena alive.
+    //
+    // When recycled, since the entries are borrowed on this thread, their
+    // reference counts need not be atomic until the process function copies
+    // one, whereupon the copy may be passed to another thread (see
+    // Entry_Copy())
+    processOptions.localEntries = 0 != (RECLS_F_RECYCLE_ENTRIES & flags);
+
     hrecls_t    hSrch;
     recls_rc_t  rc  =   Recls_SearchFeedback_(
                             function
@@ -651,16 +710,19 @@ Recls_SearchProcessFeedback_(
                         ,   flags
                         ,   pfnProgress
                         ,   paramProgress
+                        ,   &processOptions
                         ,   &hSrch
                         );
 
     if (RECLS_SUCCEEDED(rc))
     {
-        recls_entry_t info;
+        ReclsSearch* const  si  =   ReclsSearch::FromHandle(hSrch);
+        recls_entry_t       info;
 
         do
         {
-            rc = Recls_GetDetails(hSrch, &info);
+            // The entry is not copied, and so need not be released
+            rc = si->BorrowDetails(&info);
 
             if (RECLS_FAILED(rc))
             {
@@ -693,8 +755,6 @@ Recls_SearchProcessFeedback_(
                     res = (*pfn)(info, param);
                 }
 
-                Recls_CloseDetails(info);
-
                 if (0 == res)
                 {
                     rc = RECLS_RC_SEARCH_CANCELLED;
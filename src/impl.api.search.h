@@ -4,7 +4,7 @@
  * Purpose: Implementation header.
  *
  * Created: 1st January 2021
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    http://recls.org/
  *
@@ -39,6 +39,43 @@ namespace impl
 {
 #endif /* !RECLS_NO_NAMESPACE */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+class ReclsFileSearch;
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/** Options of a search that are additional to its flags */
+struct search_options_t
+{
+    /** Whether the search is to be performed on a pool of threads */
+    bool                        parallel;
+    /** The number of threads, or 0 for the default */
+    recls_uint32_t              numThreads;
+    /** A combination of 0 or more RECLS_PARALLEL_FLAG values */
+    recls_uint32_t              parallelFlags;
+    /** If not NULL, the entries are passed, concurrently, to this function,
+     * rather than being presented via a search handle */
+    hrecls_process_fn_t         pfnProcess;
+    /** The parameter passed to pfnProcess */
+    recls_process_fn_param_t    paramProcess;
+    /** The minimum depth of the entries found */
+    recls_uint32_t              minDepth;
+    /** The maximum depth of the entries found, or RECLS_DEPTH_UNLIMITED */
+    recls_uint32_t              maxDepth;
+    /** Whether the entries are used only by the thread performing the
+     * search, other than copies of them, so that their reference counts
+     * need not be atomic. Ignored unless the entries are recycled */
+    bool                        localEntries;
+    /** If not NULL, the search that is restarted, by Recls_SearchReset(),
+     * rather than a new search being created */
+    ReclsFileSearch*            restart;
+};
+
 /* /////////////////////////////////////////////////////////////////////////
  * functions
  */
@@ -51,6 +88,7 @@ Recls_SearchFeedback_(
 ,   /* [in] */ recls_uint32_t               flags
 ,   /* [in] */ hrecls_progress_fn_t         pfn
 ,   /* [in] */ recls_process_fn_param_t     param
+,   /* [in] */ search_options_t const*      options
 ,   /* [out] */ hrecls_t*                   phSrch
 );
 
@@ -64,6 +102,7 @@ Recls_SearchProcessFeedback_(
 ,   /* [in] */ recls_process_fn_param_t     param
 ,   /* [in] */ hrecls_progress_fn_t         pfnProgress
 ,   /* [out] */ recls_process_fn_param_t    paramProgress
+,   /* [in] */ search_options_t const*      options
 );
 
 /* /////////////////////////////////////////////////////////////////////////
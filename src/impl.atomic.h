@@ -4,11 +4,11 @@
  * Purpose: Implementation header.
  *
  * Created: 11th March 2005
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2005-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -58,14 +58,17 @@ namespace impl
 
 typedef atomic_t                            rc_atomic_t;
 # define rc_atomic_init(x)                  ATOMIC_INIT(x)
+# define rc_atomic_value(x)                 ((x).counter)
 #elif defined(PLATFORMSTL_HAS_ATOMIC_INTEGER_OPERATIONS)
 
 typedef platformstl_ns_qual(atomic_int_t)   rc_atomic_t;
 # define rc_atomic_init(x)                  x
+# define rc_atomic_value(x)                 (x)
 #else /* ? RECLS_MT && RECLS_UNIX_USE_ATOMIC_OPERATIONS */
 
 typedef int                                 rc_atomic_t;
 # define rc_atomic_init(x)                  x
+# define rc_atomic_value(x)                 (x)
 #endif /* RECLS_MT && RECLS_UNIX_USE_ATOMIC_OPERATIONS */
 
 /* /////////////////////////////////////////////////////////////////////////
@@ -84,6 +87,74 @@ RECLS_FNDECL(rc_atomic_t)   RC_ReadValue(
     rc_atomic_t volatile* p
 );
 
+RECLS_FNDECL(void)          RC_WriteValue(
+    rc_atomic_t volatile* p
+,   int                   value
+);
+
+/** Sets the pointer to the given value, returning its previous value. */
+RECLS_FNDECL(void*)         RC_ExchangePointer(
+    void* volatile* p
+,   void*           value
+);
+
+/** Sets the pointer to the given value if it is equal to the comparand,
+ * returning its previous value.
+ */
+RECLS_FNDECL(void*)         RC_CompareExchangePointer(
+    void* volatile* p
+,   void*           value
+,   void*           comparand
+);
+
+/** Increments a count that is manipulated by only one thread, without
+ * synchronisation.
+ */
+inline void                 RC_IncrementLocal(
+    rc_atomic_t volatile* p
+)
+{
+    ++rc_atomic_value(*p);
+}
+
+/** Decrements a count that is manipulated by only one thread, without
+ * synchronisation, returning the new value.
+ */
+inline rc_atomic_t          RC_PreDecrementLocal(
+    rc_atomic_t volatile* p
+)
+{
+    return --rc_atomic_value(*p);
+}
+
+/** Reads a value, such as a flag, with (at least) acquire semantics, so
+ * that what was written before it was set by RC_WriteValueRelease() is
+ * visible.
+ */
+inline int                  RC_ReadValueAcquire(
+    rc_atomic_t volatile* p
+)
+{
+#if defined(__GNUC__)
+    return __atomic_load_n(&rc_atomic_value(*p), __ATOMIC_ACQUIRE);
+#else /* ? __GNUC__ */
+    return static_cast<int>(rc_atomic_value(RC_ReadValue(p)));
+#endif /* __GNUC__ */
+}
+
+/** Writes a value, such as a flag, with (at least) release semantics. */
+inline void                 RC_WriteValueRelease(
+    rc_atomic_t volatile* p
+,   int                   value
+)
+{
+#if defined(__GNUC__)
+    __atomic_store_n(&rc_atomic_value(*p), value, __ATOMIC_RELEASE);
+#else /* ? __GNUC__ */
+    RC_WriteValue(p, value);
+#endif /* __GNUC__ */
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
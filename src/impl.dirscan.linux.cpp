@@ -0,0 +1,659 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.dirscan.linux.cpp
+ *
+ * Purpose: Single-pass directory scanning, via getdents64(), for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+#include "impl.dirscan.linux.hpp"
+#include "impl.entryinfo.hpp"
+#include "impl.statx.linux.hpp"
+
+#include "impl.trace.h"
+
+#include <algorithm>
+
+#include <errno.h>
+#include <fnmatch.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    /* The record layout written by getdents64(). This is not declared by
+     * all versions of GLIBC, so is declared here.
+     */
+    struct dirscan_dirent64_t_
+    {
+        recls_uint64_t  d_ino;
+        recls_sint64_t  d_off;
+        unsigned short  d_reclen;
+        unsigned char   d_type;
+        char            d_name[1];
+    };
+
+    enum
+    {
+        DIRSCAN_NAME_OFFSET_ = offsetof(dirscan_dirent64_t_, d_name)
+    };
+
+    inline
+    bool
+    is_dots_(
+        char const* name
+    )
+    {
+        return  '.' == name[0] &&
+                (   '\0' == name[1] ||
+                    (   '.' == name[1] &&
+                        '\0' == name[2]));
+    }
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * dirscan_reader
+ */
+
+dirscan_reader::dirscan_reader(
+    void*   buffer
+,   size_t  cbBuffer
+)
+    : m_fd(-1)
+    , m_buffer(static_cast<char*>(buffer))
+    , m_cbBuffer(cbBuffer)
+    , m_pos(0)
+    , m_len(0)
+{
+    RECLS_ASSERT(ss_nullptr_k != buffer);
+    RECLS_ASSERT(cbBuffer > sizeof(dirscan_dirent64_t_));
+}
+
+dirscan_reader::~dirscan_reader() STLSOFT_NOEXCEPT
+{
+    close();
+}
+
+int
+dirscan_reader::open(
+    int             dirFd
+,   char const*     name
+,   recls_uint32_t  flags
+)
+{
+    function_scope_trace("dirscan_reader::open");
+
+    RECLS_ASSERT(ss_nullptr_k != name);
+
+    close();
+
+    int oflags = O_RDONLY | O_DIRECTORY | O_CLOEXEC;
+
+    if (RECLS_F_NO_FOLLOW_LINKS & flags)
+    {
+        oflags |= O_NOFOLLOW;
+    }
+
+    m_fd    =   ::openat(dirFd, name, oflags);
+    m_pos   =   0;
+    m_len   =   0;
+
+    if (m_fd < 0)
+    {
+        int const e = errno;
+
+        recls_debug2_trace_printf_(RECLS_LITERAL("could not open directory '%s': %d"), name, e);
+
+        return e;
+    }
+
+    return 0;
+}
+
+int
+dirscan_reader::read(
+    dirscan_entry_t* entry
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != entry);
+    RECLS_ASSERT(m_fd >= 0);
+
+    for (;;)
+    {
+        if (m_pos == m_len)
+        {
+            long const r = ::syscall(SYS_getdents64, m_fd, m_buffer, m_cbBuffer);
+
+            if (r < 0)
+            {
+                return -1;
+            }
+
+            if (0 == r)
+            {
+                return 0;
+            }
+
+            m_pos   =   0;
+            m_len   =   static_cast<size_t>(r);
+        }
+
+        RECLS_ASSERT(m_pos < m_len);
+
+        dirscan_dirent64_t_ const* const    de      =   reinterpret_cast<dirscan_dirent64_t_ const*>(m_buffer + m_pos);
+        char const* const                   name    =   m_buffer + m_pos + DIRSCAN_NAME_OFFSET_;
+
+        RECLS_ASSERT(0 != de->d_reclen);
+
+        m_pos += de->d_reclen;
+
+        if (is_dots_(name))
+        {
+            continue;
+        }
+
+        entry->name     =   name;
+        entry->nameLen  =   ::strlen(name);
+        entry->ino      =   de->d_ino;
+        entry->type     =   de->d_type;
+
+        return 1;
+    }
+}
+
+void
+dirscan_reader::close() STLSOFT_NOEXCEPT
+{
+    if (m_fd >= 0)
+    {
+        ::close(m_fd);
+
+        m_fd = -1;
+    }
+}
+
+int
+dirscan_reader::detach() STLSOFT_NOEXCEPT
+{
+    int const fd = m_fd;
+
+    m_fd = -1;
+
+    return fd;
+}
+
+int
+dirscan_reader::get_fd() const STLSOFT_NOEXCEPT
+{
+    return m_fd;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * dirscan_matcher
+ */
+
+namespace
+{
+
+    enum
+    {
+            literalKind_    =   1
+        ,   suffixKind_     =   2
+    };
+
+    recls_char_t const s_wildcards[] = RECLS_LITERAL("*?[\\");
+
+    bool
+    has_wildcards_(
+        recls_char_t const* s
+    ,   size_t              len
+    )
+    {
+        recls_char_t const* const end = s + len;
+
+        return end != std::find_first_of(s, end, &s_wildcards[0], &s_wildcards[0] + (STLSOFT_NUM_ELEMENTS(s_wildcards) - 1));
+    }
+
+} /* anonymous namespace */
+
+dirscan_matcher::dirscan_matcher()
+    : m_matchAll(false)
+    , m_chars()
+    , m_slots()
+    , m_numLiterals(0)
+    , m_suffixLengths()
+    , m_patterns()
+{}
+
+void
+dirscan_matcher::init(
+    recls_char_t const* pattern
+,   size_t              patternLen
+)
+{
+    function_scope_trace("dirscan_matcher::init");
+
+    recls_char_t const* const   end =   pattern + patternLen;
+    size_t                      n   =   0;
+
+    m_matchAll = false;
+    m_chars.clear();
+    m_slots.clear();
+    m_numLiterals = 0;
+    m_suffixLengths.clear();
+    m_patterns.clear();
+
+    // The table is sized for all the patterns, so that it is at most half
+    // full
+    for (recls_char_t const* p = pattern; p != end; ++p)
+    {
+        if (types::traits_type::path_separator() == *p)
+        {
+            ++n;
+        }
+    }
+
+    size_t numSlots = 8;
+
+    for (; numSlots < 2 * (1 + n); numSlots *= 2)
+    {}
+
+    m_slots.resize(numSlots);
+
+    for (recls_char_t const* p0 = pattern; p0 != end; )
+    {
+        recls_char_t const* const   p1  =   std::find(p0, end, types::traits_type::path_separator());
+        size_t const                len =   static_cast<size_t>(p1 - p0);
+
+        if (0 == len)
+        {
+            ;
+        }
+        else if (1 == len &&
+                '*' == *p0)
+        {
+            m_matchAll = true;
+        }
+        else if (!has_wildcards_(p0, len))
+        {
+            add_literal_(p0, len, literalKind_);
+        }
+        else if ('*' == *p0 &&
+                !has_wildcards_(p0 + 1, len - 1))
+        {
+            add_literal_(p0 + 1, len - 1, suffixKind_);
+
+            lengths_type::iterator it = std::lower_bound(m_suffixLengths.begin(), m_suffixLengths.end(), len - 1);
+
+            if (m_suffixLengths.end() == it ||
+                len - 1 != *it)
+            {
+                m_suffixLengths.insert(it, len - 1);
+            }
+        }
+        else
+        {
+            m_patterns.push_back(string_type(p0, len));
+        }
+
+        p0 = (end == p1) ? p1 : p1 + 1;
+    }
+
+    recls_debug2_trace_printf_(RECLS_LITERAL("patterns: match-all=%d; literals=%u; suffix-lengths=%u; others=%u"), m_matchAll, unsigned(m_numLiterals), unsigned(m_suffixLengths.size()), unsigned(m_patterns.size()));
+}
+
+bool
+dirscan_matcher::match(
+    recls_char_t const* name
+,   size_t              nameLen
+) const
+{
+    // A leading '*' does not match a leading '.'
+    if ('.' != name[0])
+    {
+        if (m_matchAll)
+        {
+            return true;
+        }
+
+        lengths_type::const_iterator b = m_suffixLengths.begin();
+        lengths_type::const_iterator e = m_suffixLengths.end();
+
+        for (; b != e && *b <= nameLen; ++b)
+        {
+            if (find_literal_(name + (nameLen - *b), *b, suffixKind_))
+            {
+                return true;
+            }
+        }
+    }
+
+    if (0 != m_numLiterals &&
+        find_literal_(name, nameLen, literalKind_))
+    {
+        return true;
+    }
+
+    patterns_type::const_iterator b = m_patterns.begin();
+    patterns_type::const_iterator e = m_patterns.end();
+
+    for (; b != e; ++b)
+    {
+        if (0 == ::fnmatch((*b).c_str(), name, FNM_PERIOD))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+void
+dirscan_matcher::add_literal_(
+    recls_char_t const* s
+,   size_t              len
+,   unsigned            kind
+)
+{
+    if (find_literal_(s, len, kind))
+    {
+        return;
+    }
+
+    size_t const    hash    =   hash_(s, len);
+    size_t const    mask    =   m_slots.size() - 1;
+    size_t          i       =   hash & mask;
+
+    for (; 0 != m_slots[i].kind; i = (i + 1) & mask)
+    {}
+
+    slot_type& slot = m_slots[i];
+
+    slot.hash   =   hash;
+    slot.offset =   m_chars.size();
+    slot.len    =   len;
+    slot.kind   =   kind;
+
+    m_chars.insert(m_chars.end(), s, s + len);
+
+    if (literalKind_ == kind)
+    {
+        ++m_numLiterals;
+    }
+}
+
+bool
+dirscan_matcher::find_literal_(
+    recls_char_t const* s
+,   size_t              len
+,   unsigned            kind
+) const
+{
+    RECLS_ASSERT(!m_slots.empty());
+
+    size_t const    hash    =   hash_(s, len);
+    size_t const    mask    =   m_slots.size() - 1;
+    size_t          i       =   hash & mask;
+
+    for (; 0 != m_slots[i].kind; i = (i + 1) & mask)
+    {
+        slot_type const& slot = m_slots[i];
+
+        if (hash == slot.hash &&
+            len == slot.len &&
+            kind == slot.kind &&
+            0 == ::memcmp(&m_chars[slot.offset], s, len))
+        {
+            return true;
+        }
+    }
+
+    return false;
+}
+
+/* static */ size_t
+dirscan_matcher::hash_(
+    recls_char_t const* s
+,   size_t              len
+)
+{
+    // FNV-1a
+    recls_uint64_t h = 14695981039346656037ull;
+
+    for (size_t i = 0; i != len; ++i)
+    {
+        h ^= static_cast<unsigned char>(s[i]);
+        h *= 1099511628211ull;
+    }
+
+    return static_cast<size_t>(h);
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+int
+dirscan_stat_entry(
+    int                 dirFd
+,   recls_char_t const* name
+,   int                 atFlags
+,   recls_uint32_t      flags
+,   struct stat*        st
+)
+{
+#ifdef RECLS_USE_STATX_
+    return statx_stat(dirFd, name, atFlags, flags, st);
+#else /* ? RECLS_USE_STATX_ */
+    STLSOFT_SUPPRESS_UNUSED(flags);
+
+    return ::fstatat(dirFd, name, st, atFlags);
+#endif /* RECLS_USE_STATX_ */
+}
+
+bool
+dirscan_is_directory(
+    int                     dirFd
+,   dirscan_entry_t const&  entry
+,   recls_uint32_t          flags
+,   unsigned char*          type
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != type);
+
+    *type = entry.type;
+
+    switch (entry.type)
+    {
+        case DT_DIR:
+            return true;
+        case DT_LNK:
+            if (0 != (RECLS_F_NO_FOLLOW_LINKS & flags))
+            {
+                return false;
+            }
+            // fall through
+        case DT_UNKNOWN:
+            {
+                struct stat st;
+                int const   statFlags = (DT_UNKNOWN == entry.type && 0 != (RECLS_F_NO_FOLLOW_LINKS & flags)) ? AT_SYMLINK_NOFOLLOW : 0;
+
+                // Only the type is required
+                if (0 != dirscan_stat_entry(dirFd, entry.name, statFlags, RECLS_F_DETAILS_LATER, &st))
+                {
+                    return false;
+                }
+
+                // Record the resolved type, unless the entry is to describe
+                // the link itself
+                if (0 == (RECLS_F_LINKS & flags))
+                {
+                    *type = dirscan_type_from_mode(st.st_mode);
+                }
+
+                return S_ISDIR(st.st_mode);
+            }
+        default:
+            return false;
+    }
+}
+
+recls_rc_t
+dirscan_create_entry(
+    int                         dirFd
+,   size_t                      rootDirLen
+,   recls_char_t const*         path
+,   size_t                      dirLen
+,   size_t                      nameLen
+,   unsigned char               type
+,   recls_uint32_t              flags
+,   entry_arena_t*              arena
+,   entry_shared_directory_t**  psharedDir
+,   recls_entry_t*              pentry
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != path);
+    RECLS_ASSERT(ss_nullptr_k != pentry);
+
+    int const               statFlags   =   (RECLS_F_LINKS == (flags & RECLS_F_LINKS)) ? AT_SYMLINK_NOFOLLOW : 0;
+    bool const              namesOnly   =   0 != (RECLS_F_DETAILS_LATER & flags);
+    recls_char_t const*     name        =   path + dirLen;
+    size_t const            pathLen     =   dirLen + nameLen;
+    struct stat             st;
+
+    // When the details are not needed, the entry need be stat()-ed only if
+    // its type was not provided by the directory (or is that of a link that
+    // is to be followed), or if its link count or node index is required
+    bool const              noStat      =   namesOnly &&
+                                            0 == ((RECLS_F_LINK_COUNT | RECLS_F_NODE_INDEX) & flags) &&
+                                            DT_UNKNOWN != type &&
+                                            (   DT_LNK != type ||
+                                                0 != statFlags);
+
+    *pentry = ss_nullptr_k;
+
+    if (noStat)
+    {
+        ::memset(&st, 0, sizeof(st));
+
+        st.st_mode = static_cast<mode_t>(dirscan_mode_from_type(type));
+    }
+    else if (0 != dirscan_stat_entry(dirFd, name, statFlags, flags, &st))
+    {
+        recls_debug1_trace_printf_(RECLS_LITERAL("could not stat '%s'"), path);
+
+        return RECLS_RC_NO_MORE_DATA;
+    }
+
+    if (namesOnly)
+    {
+        *pentry = create_entryinfo_without_details(rootDirLen, path, dirLen, path, pathLen, name, nameLen, flags, &st, arena, psharedDir);
+    }
+    else
+    {
+        *pentry = create_entryinfo(rootDirLen, path, dirLen, path, pathLen, name, nameLen, flags, &st, arena, psharedDir);
+    }
+
+    return (ss_nullptr_k == *pentry) ? RECLS_RC_OUT_OF_MEMORY : RECLS_RC_OK;
+}
+
+recls_rc_t
+dirscan_rc_from_errno(
+    int e
+)
+{
+    switch (e)
+    {
+        case 0:
+            return RECLS_RC_OK;
+        case ENOMEM:
+            return RECLS_RC_OUT_OF_MEMORY;
+        case ENOENT:
+            return RECLS_RC_DIRECTORY_NOT_FOUND;
+        case ENOTDIR:
+        case ELOOP:
+            return RECLS_RC_PATH_IS_NOT_DIRECTORY;
+        case ENAMETOOLONG:
+            return RECLS_RC_PATH_LIMIT_EXCEEDED;
+        case EACCES:
+        case EPERM:
+            return RECLS_RC_ACCESS_DENIED;
+        default:
+            // Including the exhaustion of descriptors (EMFILE, ENFILE) and
+            // I/O errors, which are not to be mistaken for (and skipped
+            // as) the denial of access
+            return RECLS_RC_FAIL;
+    }
+}
+
+void*
+dirscan_alloc_buffer(
+    size_t cbBuffer
+)
+{
+    // The allocator provides alignment suitable for any type, which suffices
+    // for the dirent records
+    return recls_malloc_(cbBuffer);
+}
+
+void
+dirscan_free_buffer(
+    void* buffer
+)
+{
+    recls_free_(buffer);
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
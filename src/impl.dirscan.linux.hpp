@@ -0,0 +1,392 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.dirscan.linux.hpp
+ *
+ * Purpose: Single-pass directory scanning, via getdents64(), for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_DIRSCAN_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_DIRSCAN_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.allocator.hpp"
+#include "impl.types.hpp"
+#include "impl.entryfunctions.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include <dirent.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+
+#include <vector>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * compatibility
+ */
+
+/** \def RECLS_DIRSCAN_BUFFER_SIZE The size, in bytes, of the buffer into
+ * which getdents64() reads directory entries. Larger values mean fewer
+ * system calls for large directories.
+ */
+
+#ifndef RECLS_DIRSCAN_BUFFER_SIZE
+# define RECLS_DIRSCAN_BUFFER_SIZE                          (64 * 1024)
+#endif /* !RECLS_DIRSCAN_BUFFER_SIZE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/** A directory entry, as read by dirscan_reader
+ *
+ * \note The name refers into the reader's buffer, and is valid only until
+ *   the next call to dirscan_reader::read()
+ */
+struct dirscan_entry_t
+{
+    char const*     name;       /*!< The (nul-terminated) entry name */
+    size_t          nameLen;    /*!< The length of the entry name */
+    recls_uint64_t  ino;        /*!< The node index of the entry */
+    unsigned char   type;       /*!< The entry type, as one of the DT_* constants */
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class dirscan_reader
+/// Reads the entries of a single directory, via getdents64(), into a
+/// caller-supplied (and reusable) buffer
+///
+/// \note The entries "." and ".." are never returned
+class dirscan_reader
+{
+public:
+    typedef dirscan_reader                                  class_type;
+
+public: // construction
+    dirscan_reader(
+        void*   buffer
+    ,   size_t  cbBuffer
+    );
+    ~dirscan_reader() STLSOFT_NOEXCEPT;
+private:
+    dirscan_reader(class_type const&);      // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Opens the directory \c name, relative to the directory \c dirFd
+    ///
+    /// \param dirFd The descriptor of the directory in which \c name is to
+    ///   be resolved, or AT_FDCWD
+    /// \param name The name, or path, of the directory to open
+    /// \param flags The recls search flags
+    ///
+    /// \retval 0 The directory was opened
+    /// \retval !0 The errno value describing the failure
+    int
+    open(
+        int             dirFd
+    ,   char const*     name
+    ,   recls_uint32_t  flags
+    );
+
+    /// Reads the next entry
+    ///
+    /// \retval 1 An entry was read into \c entry
+    /// \retval 0 There are no more entries
+    /// \retval -1 The read failed, and errno indicates the reason
+    int
+    read(
+        dirscan_entry_t* entry
+    );
+
+    /// Closes the directory, if open
+    void
+    close() STLSOFT_NOEXCEPT;
+
+    /// Relinquishes ownership of the directory descriptor to the caller
+    int
+    detach() STLSOFT_NOEXCEPT;
+
+public: // accessors
+    /// The descriptor of the open directory, or -1
+    int
+    get_fd() const STLSOFT_NOEXCEPT;
+
+private: // fields
+    int             m_fd;
+    char* const     m_buffer;
+    size_t const    m_cbBuffer;
+    size_t          m_pos;
+    size_t          m_len;
+};
+
+// class dirscan_matcher
+/// Matches entry names against the (path-separator-delimited) patterns of a
+/// search, which are compiled once, when the search is created
+///
+/// Patterns are classified as:
+/// - "*", which matches every name not beginning with '.';
+/// - literals (e.g. "makefile"), and suffix patterns comprising a leading
+///   '*' followed by a literal (e.g. "*.cpp"), which are held in a single
+///   hash table, so that matching them costs a lookup for the whole name
+///   and one for each distinct suffix length, regardless of the number of
+///   patterns;
+/// - all others, which are matched, in turn, by fnmatch().
+///
+/// As with fnmatch(FNM_PERIOD), a name beginning with '.' is matched only
+/// by a pattern that begins with '.'.
+class dirscan_matcher
+{
+public:
+    typedef dirscan_matcher                                 class_type;
+    typedef types::string_type                              string_type;
+private:
+    struct slot_type
+    {
+        size_t          hash;
+        size_t          offset;     // Into m_chars
+        size_t          len;
+        unsigned        kind;       // 0 (empty), literal, or suffix
+    };
+    typedef std::vector<slot_type, stl_allocator<slot_type> > slots_type;
+    typedef std::vector<size_t, stl_allocator<size_t> >     lengths_type;
+    typedef std::vector<char, stl_allocator<char> >         chars_type;
+    typedef std::vector<string_type, stl_allocator<string_type> > patterns_type;
+
+public: // construction
+    dirscan_matcher();
+private:
+    dirscan_matcher(class_type const&);     // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Splits, compiles, and records, the given pattern(s)
+    ///
+    /// \note May throw std::bad_alloc
+    void
+    init(
+        recls_char_t const* pattern
+    ,   size_t              patternLen
+    );
+
+    /// Indicates whether \c name, of length \c nameLen, matches any of
+    /// the patterns
+    bool
+    match(
+        recls_char_t const* name
+    ,   size_t              nameLen
+    ) const;
+
+private: // implementation
+    void
+    add_literal_(
+        recls_char_t const* s
+    ,   size_t              len
+    ,   unsigned            kind
+    );
+
+    bool
+    find_literal_(
+        recls_char_t const* s
+    ,   size_t              len
+    ,   unsigned            kind
+    ) const;
+
+    static
+    size_t
+    hash_(
+        recls_char_t const* s
+    ,   size_t              len
+    );
+
+private: // fields
+    bool            m_matchAll;
+    chars_type      m_chars;
+    slots_type      m_slots;            // Open-addressed; size is a power of 2
+    size_t          m_numLiterals;
+    lengths_type    m_suffixLengths;    // Distinct, ascending
+    patterns_type   m_patterns;         // Those requiring fnmatch()
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+/** Translates a directory entry type (DT_*) into the corresponding file
+ * type bits (S_IF*), or 0 if the type is DT_UNKNOWN
+ */
+inline
+recls_uint32_t
+dirscan_mode_from_type(
+    unsigned char type
+)
+{
+#ifdef DTTOIF
+    return static_cast<recls_uint32_t>(DTTOIF(type));
+#else /* ? DTTOIF */
+    return static_cast<recls_uint32_t>(type) << 12;
+#endif /* DTTOIF */
+}
+
+/** Translates file type bits (S_IF*) into the corresponding directory
+ * entry type (DT_*)
+ */
+inline
+unsigned char
+dirscan_type_from_mode(
+    mode_t mode
+)
+{
+#ifdef IFTODT
+    return static_cast<unsigned char>(IFTODT(mode));
+#else /* ? IFTODT */
+    return static_cast<unsigned char>((mode & S_IFMT) >> 12);
+#endif /* IFTODT */
+}
+
+/** Obtains the stat data of the entry \c name in the directory \c dirFd,
+ * requesting only those fields implied by \c flags where statx() is
+ * available
+ *
+ * \retval 0 The stat data was obtained
+ * \retval -1 The stat data could not be obtained, and errno indicates the
+ *   reason
+ */
+int
+dirscan_stat_entry(
+    int                 dirFd
+,   recls_char_t const* name
+,   int                 atFlags
+,   recls_uint32_t      flags
+,   struct stat*        st
+);
+
+/** Determines whether the given entry of the directory \c dirFd is a
+ * directory, using the type provided by the file-system where possible
+ *
+ * \param dirFd The descriptor of the directory containing the entry
+ * \param entry The entry
+ * \param flags The recls search flags
+ * \param type Receives the entry's type, as one of the DT_* constants,
+ *   resolved (if the entry is stat()-ed) unless RECLS_F_LINKS is specified
+ */
+bool
+dirscan_is_directory(
+    int                     dirFd
+,   dirscan_entry_t const&  entry
+,   recls_uint32_t          flags
+,   unsigned char*          type
+);
+
+/** Creates the entry for the directory entry \c path, whose name is at
+ * \c path + \c dirLen, stat()-ing it only if required by \c flags
+ *
+ * \param dirFd The descriptor of the directory containing the entry
+ * \param rootDirLen The length of the search root directory
+ * \param path The full path of the entry
+ * \param dirLen The length of the directory part of \c path, including
+ *   the trailing separator
+ * \param nameLen The length of the name part of \c path
+ * \param type The entry's type, as one of the DT_* constants
+ * \param flags The recls search flags
+ * \param arena The arena from which the entry is allocated, or NULL
+ * \param psharedDir Pointer to the shared directory of the caller's
+ *   previous entry, or NULL; see create_entryinfo()
+ * \param pentry Receives the entry
+ *
+ * \retval RECLS_RC_OK The entry was created
+ * \retval RECLS_RC_NO_MORE_DATA The entry could not be stat()-ed (e.g.
+ *   because it has been removed since the directory was read), and should
+ *   be skipped
+ * \retval RECLS_RC_OUT_OF_MEMORY The entry could not be allocated
+ */
+recls_rc_t
+dirscan_create_entry(
+    int                         dirFd
+,   size_t                      rootDirLen
+,   recls_char_t const*         path
+,   size_t                      dirLen
+,   size_t                      nameLen
+,   unsigned char               type
+,   recls_uint32_t              flags
+,   entry_arena_t*              arena
+,   entry_shared_directory_t**  psharedDir
+,   recls_entry_t*              pentry
+);
+
+/** Translates an errno value arising from opening or reading a directory
+ * into the corresponding recls result code
+ *
+ * \note Only EACCES and EPERM are translated to RECLS_RC_ACCESS_DENIED,
+ *   which callers may skip; other failures are RECLS_RC_FAIL
+ */
+recls_rc_t
+dirscan_rc_from_errno(
+    int e
+);
+
+/** Allocates a buffer suitably aligned for use by dirscan_reader
+ *
+ * \return The buffer, or nullptr on failure. Must be released via
+ *   dirscan_free_buffer()
+ */
+void*
+dirscan_alloc_buffer(
+    size_t cbBuffer
+);
+
+/** Releases a buffer allocated by dirscan_alloc_buffer() */
+void
+dirscan_free_buffer(
+    void* buffer
+);
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_DIRSCAN_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
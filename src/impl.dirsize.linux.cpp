@@ -0,0 +1,627 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.dirsize.linux.cpp
+ *
+ * Purpose: Single-pass calculation of directory tree sizes, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+#include "impl.allocator.hpp"
+#include "impl.dirscan.linux.hpp"
+#include "impl.dirsize.linux.hpp"
+#include "impl.dirwalk.linux.hpp"
+#include "impl.statx.linux.hpp"
+
+#include "impl.trace.h"
+
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <string.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include <pthread.h>
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /// The number of bytes in the unit of st_blocks
+    static recls_filesize_t const DIRSIZE_BLOCK_SIZE_ = 512;
+
+    /// The recls search flags that correspond to the given size flags
+    inline
+    recls_uint32_t
+    dirsize_search_flags_(
+        recls_uint32_t flags
+    )
+    {
+        recls_uint32_t searchFlags = 0;
+
+        if (0 != (RECLS_DIRSIZE_F_NO_FOLLOW_LINKS & flags))
+        {
+            searchFlags |= RECLS_F_NO_FOLLOW_LINKS;
+        }
+
+        return searchFlags;
+    }
+
+    inline
+    void
+    dirsize_add_(
+        recls_directorySize_t&          lhs
+    ,   recls_directorySize_t const&    rhs
+    )
+    {
+        lhs.numFiles        +=  rhs.numFiles;
+        lhs.numDirectories  +=  rhs.numDirectories;
+        lhs.apparentSize    +=  rhs.apparentSize;
+        lhs.allocatedSize   +=  rhs.allocatedSize;
+    }
+
+    /* Obtains the size, and (if required) the link count and node index,
+     * of the entry \c name in the directory \c dirFd
+     */
+    int
+    dirsize_stat_(
+        int             dirFd
+    ,   char const*     name
+    ,   int             atFlags
+    ,   bool            requireNode
+    ,   struct stat*    st
+    )
+    {
+#ifdef RECLS_USE_STATX_
+        unsigned int mask = STATX_TYPE | STATX_MODE | STATX_SIZE | STATX_BLOCKS;
+
+        if (requireNode)
+        {
+            mask |= STATX_NLINK | STATX_INO;
+        }
+
+        return statx_stat_mask(dirFd, name, atFlags, mask, st);
+#else /* ? RECLS_USE_STATX_ */
+        STLSOFT_SUPPRESS_UNUSED(requireNode);
+
+        return ::fstatat(dirFd, name, st, atFlags);
+#endif /* RECLS_USE_STATX_ */
+    }
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+namespace
+{
+
+// class dirsize_node_set_
+/// The set of files, identified by device and node index, that have more
+/// than one link and have already been counted
+///
+/// \note Only files with more than one link are added, so the set is
+///   empty, and allocates nothing, for most trees
+class dirsize_node_set_
+{
+public:
+    typedef dirsize_node_set_                               class_type;
+private:
+    struct slot_type
+    {
+        recls_uint64_t  dev;
+        recls_uint64_t  ino;
+        bool            used;
+    };
+    typedef std::vector<slot_type, stl_allocator<slot_type> > slots_type;
+
+public: // construction
+    dirsize_node_set_()
+        : m_slots()
+        , m_size(0)
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_init(&m_mx, ss_nullptr_k);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+    }
+    ~dirsize_node_set_() STLSOFT_NOEXCEPT
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_destroy(&m_mx);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+    }
+private:
+    dirsize_node_set_(class_type const&);   // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Adds the given node, returning false if it was already present
+    ///
+    /// \note May be called from any thread
+    bool
+    insert(
+        recls_uint64_t  dev
+    ,   recls_uint64_t  ino
+    )
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_lock(&m_mx);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+        bool inserted;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        try
+        {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+            inserted = Insert_(dev, ino);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        }
+        catch(...)
+        {
+# ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+            ::pthread_mutex_unlock(&m_mx);
+# endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+            throw;
+        }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_unlock(&m_mx);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+        return inserted;
+    }
+
+private: // implementation
+    bool
+    Insert_(
+        recls_uint64_t  dev
+    ,   recls_uint64_t  ino
+    )
+    {
+        // The table is kept no more than half full
+        if (2 * (1 + m_size) > m_slots.size())
+        {
+            Grow_();
+        }
+
+        slot_type* const slot = Find_(m_slots, dev, ino);
+
+        if (slot->used)
+        {
+            return false;
+        }
+
+        slot->dev   =   dev;
+        slot->ino   =   ino;
+        slot->used  =   true;
+
+        ++m_size;
+
+        return true;
+    }
+
+    void
+    Grow_()
+    {
+        slot_type   empty = { 0, 0, false };
+        slots_type  slots((0 == m_slots.size()) ? 64 : 2 * m_slots.size(), empty);
+
+        slots_type::const_iterator b = m_slots.begin();
+        slots_type::const_iterator e = m_slots.end();
+
+        for (; b != e; ++b)
+        {
+            if (b->used)
+            {
+                *Find_(slots, b->dev, b->ino) = *b;
+            }
+        }
+
+        m_slots.swap(slots);
+    }
+
+    static
+    slot_type*
+    Find_(
+        slots_type&     slots
+    ,   recls_uint64_t  dev
+    ,   recls_uint64_t  ino
+    )
+    {
+        RECLS_ASSERT(0 == (slots.size() & (slots.size() - 1)));
+
+        size_t const    mask    =   slots.size() - 1;
+        size_t          index   =   static_cast<size_t>((ino ^ (dev << 32) ^ (dev >> 32)) * 0x9e3779b97f4a7c15ull >> 16) & mask;
+
+        for (;; index = (index + 1) & mask)
+        {
+            slot_type& slot = slots[index];
+
+            if (!slot.used ||
+                (   slot.ino == ino &&
+                    slot.dev == dev))
+            {
+                return &slot;
+            }
+        }
+    }
+
+private: // fields
+    slots_type          m_slots;            // Open-addressed; size is a power of 2
+    size_t              m_size;
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    pthread_mutex_t     m_mx;
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+};
+
+/* Indicates whether a failure to open a sub-directory is to be ignored,
+ * the sub-directory not being counted
+ *
+ * \note Other failures, such as the exhaustion of descriptors (which
+ *   dirscan_rc_from_errno() does not report as RECLS_RC_ACCESS_DENIED),
+ *   fail the calculation, rather than leaving it incomplete
+ */
+inline
+bool
+dirsize_is_skippable_(
+    recls_rc_t rc
+)
+{
+    return  RECLS_RC_DIRECTORY_NOT_FOUND == rc ||
+            RECLS_RC_PATH_IS_NOT_DIRECTORY == rc ||
+            RECLS_RC_ACCESS_DENIED == rc;
+}
+
+// class dirsize_visitor_
+/// Accumulates the sizes of each directory visited by the walker: those of
+/// its files as it is read, and those of its sub-directories as each is
+/// complete, reporting them (if required) once they are all complete
+///
+/// \note When the walk is parallel, reports are made under the visitor's
+///   mutex, so that the function is never called concurrently
+class dirsize_visitor_
+{
+public:
+    typedef dirsize_visitor_                                class_type;
+
+    /// The state of each directory
+    struct directory_type
+    {
+        recls_directorySize_t   size;   // Added to atomically by sub-directories, when parallel
+
+        directory_type()
+        {
+            ::memset(&size, 0, sizeof(size));
+        }
+    };
+
+    /// The state of each worker
+    struct worker_type
+    {};
+
+public: // construction
+    dirsize_visitor_(
+        recls_uint32_t              flags
+    ,   dirsize_node_set_*          nodes
+    ,   hrecls_directory_size_fn_t  pfn
+    ,   recls_process_fn_param_t    param
+    ,   recls_directorySize_t*      size
+    )
+        : m_flags(flags)
+        , m_nodes(nodes)
+        , m_pfn(pfn)
+        , m_param(param)
+        , m_size(size)
+        , m_cancelled(false)
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_init(&m_mx, ss_nullptr_k);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+    }
+    ~dirsize_visitor_() STLSOFT_NOEXCEPT
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        ::pthread_mutex_destroy(&m_mx);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+    }
+private:
+    dirsize_visitor_(class_type const&);    // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // visitor
+    recls_uint32_t
+    open_flags() const
+    {
+        return dirsize_search_flags_(m_flags);
+    }
+
+    bool
+    requires_path() const
+    {
+        return ss_nullptr_k != m_pfn;
+    }
+
+    /* Reads the directory open in \c reader, adding the sizes of the
+     * entries that are not directories to those of the directory, and
+     * recording the names of those that are
+     *
+     * As for a search of the wildcard, entries whose names begin with '.'
+     * are not counted, although the contents of such directories are
+     */
+    recls_rc_t
+    read(
+        dirscan_reader&     reader
+    ,   dirwalk_names_t&    names
+    ,   dirwalk_items_t&    items
+    ,   directory_type&     directory
+    ,   worker_type&        /* worker */
+    )
+    {
+        recls_uint32_t const    searchFlags =   dirsize_search_flags_(m_flags);
+        int const               atFlags     =   (RECLS_DIRSIZE_F_NO_FOLLOW_LINKS & m_flags) ? AT_SYMLINK_NOFOLLOW : 0;
+
+        names.clear();
+        items.clear();
+
+        dirscan_entry_t de;
+        int             r;
+
+        for (; 1 == (r = reader.read(&de)); )
+        {
+            unsigned char type;
+
+            if (dirscan_is_directory(reader.get_fd(), de, searchFlags, &type))
+            {
+                dirwalk_item_t item;
+
+                item.nameOffset =   names.size();
+                item.nameLen    =   de.nameLen;
+
+                names.insert(names.end(), de.name, de.name + (1 + de.nameLen));
+                items.push_back(item);
+
+                continue;
+            }
+
+            if ('.' == de.name[0])
+            {
+                continue;
+            }
+
+            struct stat st;
+
+            // The entry has been removed since the directory was read, or
+            // is a link whose target does not exist
+            if (0 != dirsize_stat_(reader.get_fd(), de.name, atFlags, ss_nullptr_k != m_nodes, &st))
+            {
+                continue;
+            }
+
+            // A file with several links is counted only at the first of
+            // them
+            if (ss_nullptr_k != m_nodes &&
+                st.st_nlink > 1 &&
+                !m_nodes->insert(static_cast<recls_uint64_t>(st.st_dev), static_cast<recls_uint64_t>(st.st_ino)))
+            {
+                continue;
+            }
+
+            directory.size.numFiles      +=  1;
+            directory.size.apparentSize  +=  static_cast<recls_filesize_t>(st.st_size);
+            directory.size.allocatedSize +=  static_cast<recls_filesize_t>(st.st_blocks) * DIRSIZE_BLOCK_SIZE_;
+        }
+
+        if (r < 0)
+        {
+            return dirscan_rc_from_errno(errno);
+        }
+
+        return RECLS_RC_OK;
+    }
+
+    bool
+    is_skippable(
+        recls_rc_t rc
+    ) const
+    {
+        return dirsize_is_skippable_(rc);
+    }
+
+    /* Reports the sizes of the directory, which are complete since those
+     * of all its sub-directories have been added, and adds them to those
+     * of its parent
+     */
+    recls_rc_t
+    leave(
+        dirwalk_directory_t<directory_type> const&  dir
+    ,   worker_type&                                /* worker */
+    ,   bool*                                       /* reread */
+    )
+    {
+        recls_directorySize_t const&    size        =   dir.data->size;
+        // As for a search of the wildcard, a sub-directory whose name
+        // begins with '.' is not itself counted
+        recls_uint64_t const            numCounted  =   ('.' == dir.name[0]) ? 0 : 1;
+
+        if (ss_nullptr_k != m_pfn &&
+            !Report_(dir, dir.concurrent))
+        {
+            return RECLS_RC_SEARCH_CANCELLED;
+        }
+
+        if (ss_nullptr_k == dir.parentData)
+        {
+            *m_size = size;
+        }
+        else if (dir.concurrent)
+        {
+            recls_directorySize_t& parentSize = dir.parentData->size;
+
+            __atomic_add_fetch(&parentSize.numFiles, size.numFiles, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parentSize.numDirectories, numCounted + size.numDirectories, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parentSize.apparentSize, size.apparentSize, __ATOMIC_RELAXED);
+            __atomic_add_fetch(&parentSize.allocatedSize, size.allocatedSize, __ATOMIC_RELAXED);
+        }
+        else
+        {
+            dirsize_add_(dir.parentData->size, size);
+            dir.parentData->size.numDirectories += numCounted;
+        }
+
+        return RECLS_RC_OK;
+    }
+
+    void
+    collect(
+        worker_type const& /* worker */
+    )
+    {}
+
+private: // implementation
+    /* Reports the sizes of the directory, returning false if the function
+     * cancels the calculation, or has already done so
+     */
+    bool
+    Report_(
+        dirwalk_directory_t<directory_type> const&  dir
+    ,   bool                                        concurrent
+    )
+    {
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        if (concurrent)
+        {
+            ::pthread_mutex_lock(&m_mx);
+        }
+#else /* ? RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+        STLSOFT_SUPPRESS_UNUSED(concurrent);
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+        if (!m_cancelled &&
+            0 == (*m_pfn)(dir.path, dir.pathLen, dir.depth, &dir.data->size, m_param))
+        {
+            m_cancelled = true;
+        }
+
+        bool const cancelled = m_cancelled;
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+        if (concurrent)
+        {
+            ::pthread_mutex_unlock(&m_mx);
+        }
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+        return !cancelled;
+    }
+
+private: // fields
+    recls_uint32_t const                m_flags;
+    dirsize_node_set_* const            m_nodes;
+    hrecls_directory_size_fn_t const    m_pfn;
+    recls_process_fn_param_t const      m_param;
+    recls_directorySize_t* const        m_size;
+    bool                                m_cancelled;    // Under m_mx, when parallel
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    pthread_mutex_t                     m_mx;           // Held while reporting, when parallel
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+};
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+recls_rc_t
+dirsize_calc(
+    recls_char_t const*         path
+,   recls_uint32_t              flags
+,   hrecls_directory_size_fn_t  pfn
+,   recls_process_fn_param_t    param
+,   recls_directorySize_t*      size
+)
+{
+    function_scope_trace("dirsize_calc");
+
+    RECLS_ASSERT(ss_nullptr_k != path);
+    RECLS_ASSERT(ss_nullptr_k != size);
+
+    ::memset(size, 0, sizeof(*size));
+
+    dirsize_node_set_   nodes;
+    dirsize_node_set_*  pnodes = (RECLS_DIRSIZE_F_COUNT_LINKS_ONCE & flags) ? &nodes : ss_nullptr_k;
+    dirsize_visitor_    visitor(flags, pnodes, pfn, param, size);
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    if (0 != (RECLS_DIRSIZE_F_PARALLEL & flags))
+    {
+        size_t const numThreads = work_pool::default_thread_count();
+
+        recls_debug1_trace_printf_(RECLS_LITERAL("parallel size calculation of '%s' on %u threads"), path, unsigned(numThreads));
+
+        dirwalk_parallel_walker<dirsize_visitor_> walker(path, visitor);
+
+        return walker.walk(numThreads);
+    }
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    dirwalk_walker<dirsize_visitor_> walker(path, visitor);
+
+    return walker.walk();
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
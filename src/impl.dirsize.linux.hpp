@@ -0,0 +1,99 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.dirsize.linux.hpp
+ *
+ * Purpose: Single-pass calculation of directory tree sizes, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_DIRSIZE_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_DIRSIZE_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+/** Calculates the sizes of the files in the directory \c path, and all its
+ * sub-directories, in a single post-order traversal
+ *
+ * Each directory is read once, via getdents64(), and its files stat()-ed
+ * relative to its descriptor, requesting (where statx() is available) only
+ * their sizes, and their link counts and node indexes if
+ * RECLS_DIRSIZE_F_COUNT_LINKS_ONCE is specified. No entries are created.
+ *
+ * \param path The path of the directory
+ * \param flags A combination of RECLS_DIRSIZE_FLAG values. When
+ *   RECLS_DIRSIZE_F_PARALLEL is specified, and parallel searches are
+ *   supported, independent sub-trees are read on a pool of threads
+ * \param pfn The function to receive the sizes of each directory, once
+ *   those of all its sub-directories are complete, or NULL. The paths of
+ *   the directories are formed only if it is specified
+ * \param param The parameter passed to \c pfn
+ * \param size Receives the sizes
+ *
+ * \retval RECLS_RC_OK The sizes were calculated
+ * \retval RECLS_RC_SEARCH_CANCELLED \c pfn returned 0
+ * \retval Any other status code indicates an error
+ *
+ * \note Sub-directories that cannot be opened (e.g. because access is
+ *   denied, or they have been removed since their directory was read) are
+ *   not counted
+ */
+recls_rc_t
+dirsize_calc(
+    recls_char_t const*         path
+,   recls_uint32_t              flags
+,   hrecls_directory_size_fn_t  pfn
+,   recls_process_fn_param_t    param
+,   recls_directorySize_t*      size
+);
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_DIRSIZE_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,1392 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.dirwalk.linux.hpp
+ *
+ * Purpose: Single-pass, post-order traversal of directory trees, on the
+ *          calling thread or on a pool of threads, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_DIRWALK_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_DIRWALK_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include "impl.allocator.hpp"
+#include "impl.types.hpp"
+#include "impl.dirscan.linux.hpp"
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include "impl.workpool.linux.hpp"
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+#include "impl.trace.h"
+
+#include <string>
+#include <vector>
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include <pthread.h>
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * compatibility
+ */
+
+/** \def RECLS_DIRWALK_MAX_OPEN_DIRECTORIES The number of directory
+ * descriptors, in addition to that of the root, that a walk holds open.
+ * Beyond it, the descriptors of the least recently opened directories are
+ * closed, and those directories reopened as the walk returns to them, so
+ * that deep (or, when parallel, wide) trees do not exhaust the process's
+ * descriptors.
+ */
+
+#ifndef RECLS_DIRWALK_MAX_OPEN_DIRECTORIES
+# define RECLS_DIRWALK_MAX_OPEN_DIRECTORIES                 (64)
+#endif /* !RECLS_DIRWALK_MAX_OPEN_DIRECTORIES */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/// Describes a name held in a names buffer
+struct dirwalk_item_t
+{
+    size_t  nameOffset;
+    size_t  nameLen;
+};
+typedef std::vector<dirwalk_item_t, stl_allocator<dirwalk_item_t> > dirwalk_items_t;
+typedef std::vector<char, stl_allocator<char> >             dirwalk_names_t;
+
+/// Describes a directory whose traversal is complete, as passed to the
+/// visitor's leave()
+template <typename D>
+struct dirwalk_directory_t
+{
+    /// The descriptor of the parent directory, or AT_FDCWD for the root
+    int                 parentFd;
+    /// The name of the directory within its parent, or the path of the root
+    recls_char_t const* name;
+    /// The depth of the directory below the root
+    size_t              depth;
+    /// The length of the path of the directory relative to the root
+    size_t              relLen;
+    /// The full path of the directory, or NULL unless the visitor requires
+    /// paths
+    recls_char_t const* path;
+    size_t              pathLen;
+    /// The state of the directory
+    D*                  data;
+    /// The state of the parent directory, or NULL for the root
+    D*                  parentData;
+    /// Whether the state of the parent may be accessed concurrently by
+    /// other workers, requiring that it be updated atomically
+    bool                concurrent;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+/// Identifies a directory whose descriptor has been closed, so that it can
+/// be verified when it is reopened
+struct dirwalk_node_t
+{
+    dev_t   dev;
+    ino_t   ino;
+};
+
+/* Records the identity of the directory open on the given descriptor in
+ * \c *node
+ *
+ * Returns 0, or the errno value describing the failure
+ */
+inline
+int
+dirwalk_identify_(
+    int             fd
+,   dirwalk_node_t* node
+)
+{
+    struct stat st;
+
+    if (0 != ::fstat(fd, &st))
+    {
+        return errno;
+    }
+
+    node->dev   =   st.st_dev;
+    node->ino   =   st.st_ino;
+
+    return 0;
+}
+
+/* Closes the descriptor of a directory, recording its identity in
+ * \c *node
+ *
+ * Returns 0, or the errno value describing the failure, in which case the
+ * descriptor is not closed
+ */
+inline
+int
+dirwalk_close_(
+    int             fd
+,   dirwalk_node_t* node
+)
+{
+    int const e = dirwalk_identify_(fd, node);
+
+    if (0 == e)
+    {
+        ::close(fd);
+    }
+
+    return e;
+}
+
+/* Opens the directory \c name, relative to the directory \c dirFd, and,
+ * if \c node is not NULL, verifies that it is the given directory
+ *
+ * Returns 0, or the errno value describing the failure: ENOENT if the
+ * directory is not the given one
+ */
+inline
+int
+dirwalk_open_(
+    int                     dirFd
+,   char const*             name
+,   recls_uint32_t          flags
+,   dirwalk_node_t const*   node
+,   int*                    fd
+)
+{
+    int const oflags = O_RDONLY | O_DIRECTORY | O_CLOEXEC | ((RECLS_F_NO_FOLLOW_LINKS & flags) ? O_NOFOLLOW : 0);
+
+    *fd = ::openat(dirFd, name, oflags);
+
+    if (*fd < 0)
+    {
+        return errno;
+    }
+
+    if (ss_nullptr_k != node)
+    {
+        struct stat st;
+
+        if (0 != ::fstat(*fd, &st))
+        {
+            int const e = errno;
+
+            ::close(*fd);
+
+            return e;
+        }
+
+        if (st.st_dev != node->dev ||
+            st.st_ino != node->ino)
+        {
+            recls_debug1_trace_printf_(RECLS_LITERAL("directory '%s' has been replaced"), name);
+
+            ::close(*fd);
+
+            return ENOENT;
+        }
+    }
+
+    return 0;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class dirwalk_walker
+/// Traverses a directory tree, in post-order, on the calling thread
+///
+/// The traversal is held in a stack of frames, one for each directory
+/// being visited, which are reused as the traversal ascends and descends.
+/// Each frame holds its directory open, the names of its remaining
+/// sub-directories, and the visitor's state for the directory.
+/// Sub-directories are opened relative to the descriptor of their parent,
+/// and the full path of the current directory is formed only if the
+/// visitor requires it. Only the descriptors of the root and of the
+/// deepest RECLS_DIRWALK_MAX_OPEN_DIRECTORIES frames are held open; the
+/// others are reopened, via "..", as the traversal ascends to them. When
+/// links are followed, a sub-directory that is one of its own ancestors is
+/// not visited.
+///
+/// \param V The visitor type, which must provide:
+///   - directory_type: the (default-constructible, assignable) state of
+///     each directory;
+///   - worker_type: the state of each worker;
+///   - open_flags(): the recls search flags with which sub-directories are
+///     opened;
+///   - requires_path(): whether full paths are to be formed;
+///   - read(reader, names, items, directory, worker): reads the directory
+///     open in the reader, recording the names of its sub-directories;
+///   - is_skippable(rc): whether a failure to open a sub-directory is to be
+///     ignored;
+///   - leave(dir, worker, &reread): completes a directory, once all its
+///     sub-directories are complete, setting reread if it is instead to be
+///     read again;
+///   - collect(worker): gathers the state of a worker once the traversal
+///     is complete.
+template <typename V>
+class dirwalk_walker
+{
+public:
+    typedef dirwalk_walker<V>                               class_type;
+    typedef V                                               visitor_type;
+    typedef typename V::directory_type                      directory_type;
+    typedef typename V::worker_type                         worker_type;
+private:
+    struct frame_type
+    {
+        int                 fd;         // -1 if closed, when the frame is not among the deepest
+        dirwalk_node_t      node;       // Identifies the directory, when closed or when links are followed
+        size_t              relLen;     // Of the directory's path, relative to the root
+        size_t              pathLen;    // Used only if the visitor requires paths
+        dirwalk_names_t     names;
+        dirwalk_items_t     items;      // The sub-directories
+        size_t              itemsIndex;
+        directory_type      data;
+
+        frame_type()
+            : fd(-1)
+            , node()
+            , relLen(0)
+            , pathLen(0)
+            , names()
+            , items()
+            , itemsIndex(0)
+            , data()
+        {}
+
+        void clear()
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+
+                fd = -1;
+            }
+
+            names.clear();
+            items.clear();
+            itemsIndex  =   0;
+            data        =   directory_type();
+        }
+    };
+    typedef std::vector<frame_type, stl_allocator<frame_type> > frames_type;
+    typedef std::vector<recls_char_t, stl_allocator<recls_char_t> > path_type;
+
+public: // construction
+    dirwalk_walker(
+        recls_char_t const* path
+    ,   visitor_type&       visitor
+    )
+        : m_rootPath(path)
+        , m_visitor(visitor)
+        , m_worker()
+        , m_buffer(dirscan_alloc_buffer(RECLS_DIRSCAN_BUFFER_SIZE))
+        , m_reader(m_buffer, RECLS_DIRSCAN_BUFFER_SIZE)
+        , m_frames()
+        , m_depth(0)
+        , m_path()
+    {}
+    ~dirwalk_walker() STLSOFT_NOEXCEPT
+    {
+        for (; 0 != m_depth; )
+        {
+            m_frames[--m_depth].clear();
+        }
+
+        m_reader.close();
+
+        dirscan_free_buffer(m_buffer);
+    }
+private:
+    dirwalk_walker(class_type const&);      // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Traverses the tree, returning the first failure, if any
+    ///
+    /// \note The state of the worker is collected whether or not the
+    ///   traversal succeeds
+    recls_rc_t
+    walk()
+    {
+        function_scope_trace("dirwalk_walker::walk");
+
+        if (ss_nullptr_k == m_buffer)
+        {
+            return RECLS_RC_OUT_OF_MEMORY;
+        }
+
+        recls_rc_t const rc = Walk_();
+
+        m_visitor.collect(m_worker);
+
+        return rc;
+    }
+
+private: // implementation
+    recls_rc_t
+    Walk_()
+    {
+        recls_uint32_t const    openFlags   =   m_visitor.open_flags();
+        bool const              requirePath =   m_visitor.requires_path();
+        size_t const            rootLen     =   types::traits_type::str_len(m_rootPath);
+
+        if (requirePath)
+        {
+            m_path.assign(m_rootPath, m_rootPath + (1 + rootLen));
+        }
+
+        // The root is followed, if it is a link
+        recls_rc_t rc = Push_(AT_FDCWD, m_rootPath, 0, 0, rootLen);
+
+        if (RECLS_FAILED(rc))
+        {
+            return rc;
+        }
+
+        for (; 0 != m_depth; )
+        {
+            frame_type& frame = m_frames[m_depth - 1];
+
+            if (frame.itemsIndex == frame.items.size())
+            {
+                rc = Pop_();
+
+                if (RECLS_FAILED(rc))
+                {
+                    return rc;
+                }
+
+                continue;
+            }
+
+            dirwalk_item_t const&   item    =   frame.items[frame.itemsIndex++];
+            recls_char_t const*     name    =   &frame.names[item.nameOffset];
+            size_t const            relLen  =   (1 == m_depth) ? item.nameLen : (frame.relLen + 1 + item.nameLen);
+            size_t                  pathLen =   0;
+
+            if (requirePath)
+            {
+                // The path is formed after that of this directory
+                bool const hasDirEnd = types::traits_type::has_dir_end(&m_path[0], frame.pathLen);
+
+                pathLen = frame.pathLen + (hasDirEnd ? 0 : 1) + item.nameLen;
+
+                m_path.resize(1 + pathLen);
+
+                if (!hasDirEnd)
+                {
+                    m_path[frame.pathLen] = types::traits_type::path_name_separator();
+                }
+                types::traits_type::char_copy(&m_path[pathLen - item.nameLen], name, item.nameLen);
+                m_path[pathLen] = '\0';
+            }
+
+            // NOTE: frame (and name) may not be used after this call, since
+            // m_frames may grow
+            rc = Push_(frame.fd, name, openFlags, relLen, pathLen);
+
+            if (RECLS_FAILED(rc) &&
+                !m_visitor.is_skippable(rc))
+            {
+                return rc;
+            }
+        }
+
+        return RECLS_RC_OK;
+    }
+
+    recls_rc_t
+    Push_(
+        int                 parentFd
+    ,   recls_char_t const* name
+    ,   recls_uint32_t      openFlags
+    ,   size_t              relLen
+    ,   size_t              pathLen
+    )
+    {
+        int e = m_reader.open(parentFd, name, openFlags);
+
+        if (0 != e)
+        {
+            recls_debug1_trace_printf_(RECLS_LITERAL("could not open directory '%s': %d"), name, e);
+
+            return dirscan_rc_from_errno(e);
+        }
+
+        bool const      followsLinks    =   0 == (RECLS_F_NO_FOLLOW_LINKS & m_visitor.open_flags());
+        dirwalk_node_t  node;
+
+        // When links are followed, a sub-directory that is one of its own
+        // ancestors is not visited, since the traversal would not end
+        if (followsLinks)
+        {
+            if (0 != (e = dirwalk_identify_(m_reader.get_fd(), &node)))
+            {
+                m_reader.close();
+
+                return dirscan_rc_from_errno(e);
+            }
+
+            if (IsAncestor_(node))
+            {
+                recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is an ancestor"), name);
+
+                m_reader.close();
+
+                return RECLS_RC_OK;
+            }
+        }
+
+        if (m_frames.size() == m_depth)
+        {
+            m_frames.push_back(frame_type());
+        }
+
+        frame_type& frame = m_frames[m_depth];
+
+        RECLS_ASSERT(frame.fd < 0);
+
+        if (followsLinks)
+        {
+            frame.node  =   node;
+        }
+        frame.relLen    =   relLen;
+        frame.pathLen   =   pathLen;
+
+        recls_rc_t const rc = m_visitor.read(m_reader, frame.names, frame.items, frame.data, m_worker);
+
+        if (RECLS_FAILED(rc))
+        {
+            m_reader.close();
+
+            frame.clear();
+
+            return rc;
+        }
+
+        frame.fd = m_reader.detach();
+
+        ++m_depth;
+
+        // The descriptor of the least recent frame (other than the root)
+        // held open, if it is not already closed, is closed until the
+        // traversal ascends to it
+        if (m_depth > 1 + RECLS_DIRWALK_MAX_OPEN_DIRECTORIES)
+        {
+            frame_type& oldest = m_frames[m_depth - 1 - RECLS_DIRWALK_MAX_OPEN_DIRECTORIES];
+
+            if (oldest.fd >= 0)
+            {
+                if (0 != (e = dirwalk_close_(oldest.fd, &oldest.node)))
+                {
+                    return dirscan_rc_from_errno(e);
+                }
+
+                oldest.fd = -1;
+            }
+        }
+
+        return rc;
+    }
+
+    /* Indicates whether the given directory is that of any frame in the
+     * traversal
+     */
+    bool
+    IsAncestor_(
+        dirwalk_node_t const& node
+    ) const
+    {
+        for (size_t i = 0; i != m_depth; ++i)
+        {
+            dirwalk_node_t const& ancestor = m_frames[i].node;
+
+            if (ancestor.ino == node.ino &&
+                ancestor.dev == node.dev)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* Reopens the directory of the frame at the given index, whose
+     * descriptor was closed, from that of its sub-directory, which is
+     * open, via "..", or, if that is not it (as when the sub-directory was
+     * reached by a link), by its name from the nearest open ancestor
+     */
+    recls_rc_t
+    Reopen_(
+        size_t index
+    )
+    {
+        RECLS_ASSERT(0 != index);
+        RECLS_ASSERT(index + 1 < m_depth);
+
+        frame_type& frame   =   m_frames[index];
+        int         fd;
+        int         e       =   dirwalk_open_(m_frames[index + 1].fd, "..", 0, &frame.node, &fd);
+
+        if (ENOENT == e)
+        {
+            size_t base = index - 1;
+
+            for (; m_frames[base].fd < 0; --base)
+            {}
+
+            fd  =   m_frames[base].fd;
+            e   =   0;
+
+            for (size_t i = base; 0 == e && i != index; ++i)
+            {
+                frame_type const&   parent  =   m_frames[i];
+                recls_char_t const* name    =   &parent.names[parent.items[parent.itemsIndex - 1].nameOffset];
+                int                 subFd;
+
+                e = dirwalk_open_(fd, name, m_visitor.open_flags(), (i + 1 == index) ? &frame.node : ss_nullptr_k, &subFd);
+
+                if (fd != m_frames[base].fd)
+                {
+                    ::close(fd);
+                }
+
+                fd = subFd;
+            }
+        }
+
+        if (0 != e)
+        {
+            recls_debug1_trace_printf_(RECLS_LITERAL("could not reopen directory: %d"), e);
+
+            return dirscan_rc_from_errno(e);
+        }
+
+        frame.fd = fd;
+
+        return RECLS_RC_OK;
+    }
+
+    recls_rc_t
+    Pop_()
+    {
+        RECLS_ASSERT(0 != m_depth);
+
+        frame_type&                         frame   =   m_frames[m_depth - 1];
+        bool const                          isRoot  =   1 == m_depth;
+        frame_type* const                   parent  =   isRoot ? ss_nullptr_k : &m_frames[m_depth - 2];
+        dirwalk_directory_t<directory_type> dir;
+        bool                                reread  =   false;
+
+        if (!isRoot &&
+            parent->fd < 0)
+        {
+            recls_rc_t const rc = Reopen_(m_depth - 2);
+
+            if (RECLS_FAILED(rc))
+            {
+                return rc;
+            }
+        }
+
+        dir.parentFd    =   isRoot ? AT_FDCWD : parent->fd;
+        dir.name        =   isRoot ? m_rootPath : &parent->names[parent->items[parent->itemsIndex - 1].nameOffset];
+        dir.depth       =   m_depth - 1;
+        dir.relLen      =   frame.relLen;
+        dir.path        =   ss_nullptr_k;
+        dir.pathLen     =   frame.pathLen;
+        dir.data        =   &frame.data;
+        dir.parentData  =   isRoot ? ss_nullptr_k : &parent->data;
+        dir.concurrent  =   false;
+
+        if (!m_path.empty())
+        {
+            m_path[frame.pathLen] = '\0';
+
+            dir.path = &m_path[0];
+        }
+
+        recls_rc_t const rc = m_visitor.leave(dir, m_worker, &reread);
+
+        if (RECLS_FAILED(rc))
+        {
+            return rc;
+        }
+
+        if (reread)
+        {
+            return Reread_(frame);
+        }
+
+        frame.clear();
+
+        --m_depth;
+
+        return RECLS_RC_OK;
+    }
+
+    recls_rc_t
+    Reread_(
+        frame_type& frame
+    )
+    {
+        recls_debug2_trace_printf_(RECLS_LITERAL("reading directory again"));
+
+        int const e = m_reader.open(frame.fd, ".", 0);
+
+        if (0 != e)
+        {
+            return dirscan_rc_from_errno(e);
+        }
+
+        frame.itemsIndex    =   0;
+        frame.data          =   directory_type();
+
+        recls_rc_t const rc = m_visitor.read(m_reader, frame.names, frame.items, frame.data, m_worker);
+
+        m_reader.close();
+
+        return rc;
+    }
+
+private: // fields
+    recls_char_t const* const   m_rootPath;
+    visitor_type&               m_visitor;
+    worker_type                 m_worker;
+    void* const                 m_buffer;
+    dirscan_reader              m_reader;
+    frames_type                 m_frames;
+    size_t                      m_depth;
+    path_type                   m_path;     // Used only if the visitor requires paths
+};
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+// class dirwalk_parallel_walker
+/// Traverses a directory tree, in post-order, on a work-stealing pool of
+/// threads
+///
+/// Each directory is read by a task, which submits a task for each of its
+/// sub-directories. A directory is left by whichever worker completes the
+/// last of its sub-directories; its descriptor is held open until then,
+/// so that its sub-directories can be opened relative to it, unless
+/// RECLS_DIRWALK_MAX_OPEN_DIRECTORIES are already held open, in which case
+/// it is closed once read, and reopened, by name from its nearest open
+/// ancestor, whenever it is needed. When links are followed, a
+/// sub-directory that is one of its own ancestors is not visited.
+///
+/// \param V The visitor type, as described for dirwalk_walker. Its
+///   read() and leave() are called concurrently, each with the state of
+///   the calling worker, and leave() must update the state of the parent
+///   atomically
+template <typename V>
+class dirwalk_parallel_walker
+{
+public:
+    typedef dirwalk_parallel_walker<V>                      class_type;
+    typedef V                                               visitor_type;
+    typedef typename V::directory_type                      directory_type;
+    typedef typename V::worker_type                         worker_type;
+    typedef std::basic_string<
+        recls_char_t
+    ,   std::char_traits<recls_char_t>
+    ,   stl_allocator<recls_char_t>
+    >                                                       string_type;
+private:
+    struct dir_task
+        : public work_pool::task
+        , public allocated_object
+    {
+    public:
+        /// The path of the directory is that of the parent, if given,
+        /// followed by the name
+        dir_task(
+            class_type*         walker
+        ,   dir_task*           parent
+        ,   string_type const*  parentPath
+        ,   recls_char_t const* name
+        ,   size_t              nameLen
+        )
+            : walker(walker)
+            , parent(parent)
+            , path()
+            , nameOffset(0)
+            , depth((ss_nullptr_k == parent) ? 0 : (1 + parent->depth))
+            , relLen((ss_nullptr_k == parent) ? 0 : (ss_nullptr_k == parent->parent) ? nameLen : (parent->relLen + 1 + nameLen))
+            , fd(-1)
+            , node()
+            , opened(false)
+            , pending(1)
+            , data()
+        {
+            if (ss_nullptr_k != parentPath)
+            {
+                path.reserve(parentPath->size() + 1 + nameLen);
+                path.append(*parentPath);
+
+                if (!types::traits_type::has_dir_end(path.data(), path.size()))
+                {
+                    path.append(1, types::traits_type::path_name_separator());
+                }
+
+                nameOffset = path.size();
+            }
+
+            path.append(name, nameLen);
+        }
+        ~dir_task()
+        {
+            if (fd >= 0)
+            {
+                ::close(fd);
+
+                if (ss_nullptr_k != parent)
+                {
+                    __atomic_sub_fetch(&walker->m_numOpen, 1, __ATOMIC_RELAXED);
+                }
+            }
+        }
+    private:
+        dir_task(dir_task const&);              // copy-construction proscribed
+        void operator =(dir_task const&);       // copy-assignment proscribed
+
+    public: // work_pool::task
+        virtual void run(work_pool& /* pool */, size_t workerIndex)
+        {
+            walker->Run_(*this, workerIndex);
+        }
+
+    public: // accessors
+        recls_char_t const* name() const
+        {
+            return path.c_str() + nameOffset;
+        }
+
+    public:
+        class_type* const   walker;
+        dir_task* const     parent;
+        string_type         path;       // Only the name, unless the visitor requires paths
+        size_t              nameOffset;
+        size_t const        depth;
+        size_t const        relLen;
+        int                 fd;         // -1 if not open, or closed once read
+        dirwalk_node_t      node;       // Identifies the directory, when closed or when links are followed
+        bool                opened;     // Whether the directory has been read
+        size_t              pending;    // The read, and each sub-directory; accessed atomically
+        directory_type      data;
+    };
+    typedef std::vector<dir_task const*, stl_allocator<dir_task const*> > dir_tasks_type;
+
+    struct worker_state
+        : public allocated_object
+    {
+    public:
+        worker_state()
+            : buffer(dirscan_alloc_buffer(RECLS_DIRSCAN_BUFFER_SIZE))
+            , names()
+            , items()
+            , worker()
+        {}
+        ~worker_state()
+        {
+            dirscan_free_buffer(buffer);
+        }
+    private:
+        worker_state(worker_state const&);      // copy-construction proscribed
+        void operator =(worker_state const&);   // copy-assignment proscribed
+
+    public:
+        void* const         buffer;
+        dirwalk_names_t     names;
+        dirwalk_items_t     items;
+        worker_type         worker;
+    };
+    typedef std::vector<worker_state*, stl_allocator<worker_state*> > worker_states_type;
+
+public: // construction
+    dirwalk_parallel_walker(
+        recls_char_t const* path
+    ,   visitor_type&       visitor
+    )
+        : m_path(path)
+        , m_visitor(visitor)
+        , m_workerStates()
+        , m_pool()
+        , m_numOpen(0)
+        , m_done(false)
+        , m_failure(RECLS_RC_OK)
+        , m_cancelled(0)
+    {
+        ::pthread_mutex_init(&m_mx, ss_nullptr_k);
+        ::pthread_cond_init(&m_cv, ss_nullptr_k);
+    }
+    ~dirwalk_parallel_walker() STLSOFT_NOEXCEPT
+    {
+        // The workers are stopped before any of the state they use is
+        // released
+        m_pool.stop();
+        m_pool.join();
+
+        typename worker_states_type::iterator b = m_workerStates.begin();
+        typename worker_states_type::iterator e = m_workerStates.end();
+
+        for (; b != e; ++b)
+        {
+            delete *b;
+        }
+
+        ::pthread_cond_destroy(&m_cv);
+        ::pthread_mutex_destroy(&m_mx);
+    }
+private:
+    dirwalk_parallel_walker(class_type const&); // copy-construction proscribed
+    void operator =(class_type const&);         // copy-assignment proscribed
+
+public: // operations
+    /// Traverses the tree on the given number of threads, returning the
+    /// first failure, if any
+    recls_rc_t
+    walk(
+        size_t numThreads
+    )
+    {
+        function_scope_trace("dirwalk_parallel_walker::walk");
+
+        RECLS_ASSERT(0 != numThreads);
+
+        m_workerStates.reserve(numThreads);
+
+        for (size_t i = 0; i != numThreads; ++i)
+        {
+            worker_state* const state = new worker_state();
+
+            m_workerStates.push_back(state);
+
+            if (ss_nullptr_k == state->buffer)
+            {
+                return RECLS_RC_OUT_OF_MEMORY;
+            }
+        }
+
+        dir_task* const root = new dir_task(this, ss_nullptr_k, ss_nullptr_k, m_path, types::traits_type::str_len(m_path));
+
+        int const e = m_pool.start(numThreads);
+
+        if (0 != e)
+        {
+            delete root;
+
+            return (ENOMEM == e) ? RECLS_RC_OUT_OF_MEMORY : RECLS_RC_UNEXPECTED;
+        }
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        try
+        {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+            m_pool.submit(root, numThreads);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+        }
+        catch(std::bad_alloc&)
+        {
+            delete root;
+
+            throw;
+        }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+        ::pthread_mutex_lock(&m_mx);
+        for (; !m_done; )
+        {
+            ::pthread_cond_wait(&m_cv, &m_mx);
+        }
+        ::pthread_mutex_unlock(&m_mx);
+
+        m_pool.stop();
+        m_pool.join();
+
+        typename worker_states_type::const_iterator b = m_workerStates.begin();
+        typename worker_states_type::const_iterator end = m_workerStates.end();
+
+        for (; b != end; ++b)
+        {
+            m_visitor.collect((*b)->worker);
+        }
+
+        return m_failure;
+    }
+
+private: // implementation
+    void
+    Run_(
+        dir_task&   task
+    ,   size_t      workerIndex
+    )
+    {
+        function_scope_trace("dirwalk_parallel_walker::Run_");
+
+        if (!IsCancelled_())
+        {
+            recls_rc_t rc;
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+            try
+            {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+                rc = Read_(task, workerIndex);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+            }
+            catch(std::bad_alloc&)
+            {
+                recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+                rc = RECLS_RC_OUT_OF_MEMORY;
+            }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+            if (RECLS_FAILED(rc))
+            {
+                Fail_(rc);
+            }
+        }
+
+        // NOTE: task may not be used after this call
+        Release_(&task, workerIndex);
+    }
+
+    recls_rc_t
+    Read_(
+        dir_task&   task
+    ,   size_t      workerIndex
+    )
+    {
+        worker_state&   state   =   *m_workerStates[workerIndex];
+        dirscan_reader  reader(state.buffer, RECLS_DIRSCAN_BUFFER_SIZE);
+        int             e;
+
+        if (task.opened)
+        {
+            // The directory is being read again
+            int fd;
+
+            if (0 == (e = Acquire_(task, &fd)))
+            {
+                e = reader.open(fd, ".", 0);
+
+                Unacquire_(task, fd);
+            }
+        }
+        else if (ss_nullptr_k == task.parent)
+        {
+            // The root is followed, if it is a link
+            e = reader.open(AT_FDCWD, task.name(), 0);
+        }
+        else
+        {
+            int parentFd;
+
+            if (0 == (e = Acquire_(*task.parent, &parentFd)))
+            {
+                e = reader.open(parentFd, task.name(), m_visitor.open_flags());
+
+                Unacquire_(*task.parent, parentFd);
+            }
+        }
+
+        if (0 != e)
+        {
+            recls_rc_t const rc = dirscan_rc_from_errno(e);
+
+            recls_debug1_trace_printf_(RECLS_LITERAL("could not open directory '%s': %d"), task.path.c_str(), e);
+
+            if (ss_nullptr_k != task.parent &&
+                m_visitor.is_skippable(rc))
+            {
+                return RECLS_RC_OK;
+            }
+
+            return rc;
+        }
+
+        // When links are followed, a sub-directory that is one of its own
+        // ancestors is not visited, since the traversal would not end. The
+        // identity of each ancestor was recorded before its sub-directories
+        // were submitted
+        if (!task.opened &&
+            0 == (RECLS_F_NO_FOLLOW_LINKS & m_visitor.open_flags()))
+        {
+            if (0 != (e = dirwalk_identify_(reader.get_fd(), &task.node)))
+            {
+                return dirscan_rc_from_errno(e);
+            }
+
+            if (IsAncestor_(task))
+            {
+                recls_debug2_trace_printf_(RECLS_LITERAL("not descending into '%s', which is an ancestor"), task.path.c_str());
+
+                return RECLS_RC_OK;
+            }
+        }
+
+        // No sub-directory task has yet been submitted, so the state of
+        // the directory is not yet shared
+        recls_rc_t const rc = m_visitor.read(reader, state.names, state.items, task.data, state.worker);
+
+        if (!task.opened)
+        {
+            int const fd = reader.detach();
+
+            task.opened = true;
+
+            // The descriptor is held open only if the budget allows
+            if (ss_nullptr_k != task.parent &&
+                __atomic_add_fetch(&m_numOpen, 1, __ATOMIC_RELAXED) > RECLS_DIRWALK_MAX_OPEN_DIRECTORIES &&
+                0 == dirwalk_close_(fd, &task.node))
+            {
+                __atomic_sub_fetch(&m_numOpen, 1, __ATOMIC_RELAXED);
+            }
+            else
+            {
+                task.fd = fd;
+            }
+        }
+
+        if (RECLS_SUCCEEDED(rc))
+        {
+            string_type const* const        parentPath  =   m_visitor.requires_path() ? &task.path : ss_nullptr_k;
+            dirwalk_items_t::const_iterator b           =   state.items.begin();
+            dirwalk_items_t::const_iterator end         =   state.items.end();
+
+            for (; b != end && !IsCancelled_(); ++b)
+            {
+                dirwalk_item_t const&   item    =   *b;
+                dir_task* const         child   =   new dir_task(this, &task, parentPath, &state.names[item.nameOffset], item.nameLen);
+
+                __atomic_add_fetch(&task.pending, 1, __ATOMIC_RELAXED);
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+                try
+                {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+                    m_pool.submit(child, workerIndex);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+                }
+                catch(std::bad_alloc&)
+                {
+                    __atomic_sub_fetch(&task.pending, 1, __ATOMIC_RELAXED);
+
+                    delete child;
+
+                    throw;
+                }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+            }
+        }
+
+        return rc;
+    }
+
+    /* Releases a reference to the task, and, if it is the last, leaves the
+     * directory and releases the reference held by it to its parent, and
+     * so on up the tree
+     */
+    void
+    Release_(
+        dir_task*   task
+    ,   size_t      workerIndex
+    )
+    {
+        for (; ss_nullptr_k != task; )
+        {
+            if (0 != __atomic_sub_fetch(&task->pending, 1, __ATOMIC_ACQ_REL))
+            {
+                return;
+            }
+
+            if (Leave_(*task, workerIndex))
+            {
+                // The task has been submitted to read the directory again
+                return;
+            }
+
+            dir_task* const parent = task->parent;
+
+            delete task;
+
+            if (ss_nullptr_k == parent)
+            {
+                ::pthread_mutex_lock(&m_mx);
+                m_done = true;
+                ::pthread_cond_broadcast(&m_cv);
+                ::pthread_mutex_unlock(&m_mx);
+            }
+
+            task = parent;
+        }
+    }
+
+    /* Leaves the directory of the task, once all its sub-directories are
+     * complete, returning true if it instead is to be read again
+     */
+    bool
+    Leave_(
+        dir_task&   task
+    ,   size_t      workerIndex
+    )
+    {
+        // The directory was not opened, or the traversal has failed
+        if (!task.opened ||
+            IsCancelled_())
+        {
+            return false;
+        }
+
+        bool const                          isRoot      =   ss_nullptr_k == task.parent;
+        int                                 parentFd    =   AT_FDCWD;
+        dirwalk_directory_t<directory_type> dir;
+        bool                                reread      =   false;
+
+        if (!isRoot)
+        {
+            int const e = Acquire_(*task.parent, &parentFd);
+
+            if (0 != e)
+            {
+                Fail_(dirscan_rc_from_errno(e));
+
+                return false;
+            }
+        }
+
+        dir.parentFd    =   parentFd;
+        dir.name        =   task.name();
+        dir.depth       =   task.depth;
+        dir.relLen      =   task.relLen;
+        dir.path        =   m_visitor.requires_path() ? task.path.c_str() : ss_nullptr_k;
+        dir.pathLen     =   task.path.size();
+        dir.data        =   &task.data;
+        dir.parentData  =   isRoot ? ss_nullptr_k : &task.parent->data;
+        dir.concurrent  =   true;
+
+        recls_rc_t const rc = m_visitor.leave(dir, m_workerStates[workerIndex]->worker, &reread);
+
+        if (!isRoot)
+        {
+            Unacquire_(*task.parent, parentFd);
+        }
+
+        if (RECLS_FAILED(rc))
+        {
+            Fail_(rc);
+        }
+        else if (reread)
+        {
+            task.pending    =   1;
+            task.data       =   directory_type();
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+            try
+            {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+                m_pool.submit(&task, workerIndex);
+
+                return true;
+#ifdef RECLS_EXCEPTION_SUPPORT_
+            }
+            catch(std::bad_alloc&)
+            {
+                recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+                Fail_(RECLS_RC_OUT_OF_MEMORY);
+            }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        }
+
+        return false;
+    }
+
+    /* Indicates whether the directory of the given task, whose identity
+     * has been recorded, is that of any of its ancestors
+     */
+    static
+    bool
+    IsAncestor_(
+        dir_task const& task
+    )
+    {
+        for (dir_task const* t = task.parent; ss_nullptr_k != t; t = t->parent)
+        {
+            if (t->node.ino == task.node.ino &&
+                t->node.dev == task.node.dev)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* Obtains a descriptor for the directory of the given (opened) task:
+     * its own, if it is held open, or one reopened, by name from its
+     * nearest open ancestor, which must be released by Unacquire_()
+     *
+     * Returns 0, or the errno value describing the failure
+     */
+    int
+    Acquire_(
+        dir_task const& task
+    ,   int*            fd
+    )
+    {
+        RECLS_ASSERT(task.opened);
+
+        if (task.fd >= 0)
+        {
+            *fd = task.fd;
+
+            return 0;
+        }
+
+        // The root is always held open, so there is an open ancestor
+        dir_tasks_type  chain;
+        dir_task const* t = &task;
+
+        for (; t->fd < 0; t = t->parent)
+        {
+            chain.push_back(t);
+        }
+
+        int e = 0;
+
+        *fd = t->fd;
+
+        for (typename dir_tasks_type::reverse_iterator b = chain.rbegin(); 0 == e && b != chain.rend(); ++b)
+        {
+            int const       dirFd   =   *fd;
+            dir_task const& sub     =   **b;
+
+            e = dirwalk_open_(dirFd, sub.name(), m_visitor.open_flags(), &sub.node, fd);
+
+            if (dirFd != t->fd)
+            {
+                ::close(dirFd);
+            }
+        }
+
+        if (0 != e)
+        {
+            recls_debug1_trace_printf_(RECLS_LITERAL("could not reopen directory '%s': %d"), task.path.c_str(), e);
+        }
+
+        return e;
+    }
+
+    void
+    Unacquire_(
+        dir_task const& task
+    ,   int             fd
+    )
+    {
+        if (fd != task.fd)
+        {
+            ::close(fd);
+        }
+    }
+
+    void
+    Fail_(
+        recls_rc_t rc
+    )
+    {
+        ::pthread_mutex_lock(&m_mx);
+        if (RECLS_SUCCEEDED(m_failure))
+        {
+            m_failure = rc;
+
+            __atomic_store_n(&m_cancelled, 1, __ATOMIC_RELEASE);
+        }
+        ::pthread_mutex_unlock(&m_mx);
+    }
+
+    bool
+    IsCancelled_() const
+    {
+        return 0 != __atomic_load_n(&m_cancelled, __ATOMIC_ACQUIRE);
+    }
+
+private: // fields
+    recls_char_t const* const   m_path;
+    visitor_type&               m_visitor;
+    worker_states_type          m_workerStates;
+    work_pool                   m_pool;
+    size_t                      m_numOpen;      // The descriptors held open, other than the root's; accessed atomically
+
+    // The following are shared with the workers, under m_mx
+    pthread_mutex_t             m_mx;
+    pthread_cond_t              m_cv;
+    bool                        m_done;
+    recls_rc_t                  m_failure;      // The first failure, if any
+    int                         m_cancelled;    // Accessed atomically
+};
+
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_DIRWALK_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -4,11 +4,11 @@
  * Purpose: Utility functions for recls API.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -43,6 +43,68 @@ namespace impl
 {
 #endif /* !RECLS_NO_NAMESPACE */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * typedefs
+ */
+
+/** An arena, belonging to a search, from which the search's entries are
+ * allocated, and to which they are returned for reuse when released by
+ * the search (RECLS_F_RECYCLE_ENTRIES).
+ *
+ * The arena is used only by the thread running the search. Copies of its
+ * entries (as obtained by Entry_Copy()) may be held and released by any
+ * thread, and keep the arena alive until they are released. An entry whose
+ * last reference is that of a copy is returned to the arena when the copy
+ * is released, and is recycled by the search when it next allocates an
+ * entry of the same size.
+ */
+struct entry_arena_t;
+
+/** The directory parts, and the search directory, of the entries of a
+ * directory, shared by reference-counting between them, so that each need
+ * not have its own copy of what is the same for all of them.
+ *
+ * It is released by each entry to which it is attached (by
+ * Entry_AttachSharedDirectory()) when the entry is destroyed, and so may
+ * outlive the search.
+ */
+struct entry_shared_directory_t
+{
+    volatile rc_atomic_t    refs;
+    struct recls_strptrs_t  directory;          /* The copy of the directory, into which the parts point */
+    struct recls_strptrs_t  searchDirectory;    /* The copy of the search directory; empty if it is part of the entries' paths */
+    size_t                  numParts;
+    struct recls_strptrs_t  parts[1];           /* numParts parts, followed by the characters of the copies */
+};
+
+/** The nanosecond parts of an entry's times, which are held with its
+ * reference count, rather than in recls_entryinfo_t, so that the layout
+ * of the latter is unchanged. Each is 0 if not available.
+ */
+struct entry_times_nsec_t
+{
+    recls_uint32_t  modificationTime;
+    recls_uint32_t  lastAccessTime;
+    recls_uint32_t  lastStatusChangeTime;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * constants
+ */
+
+/** Bit in recls_entryinfo_t::extendedFlags[0] that indicates that the
+ * entry's directory parts (and search directory, if not part of its path)
+ * are those of an entry_shared_directory_t
+ */
+#define RECLS_ENTRYINFO_XF0_SHARED_DIRECTORY_               (0x00000002)
+
+/** Flag to Entry_CreateArena() that indicates that the arena, and its
+ * entries, are to be used only by the thread performing the search, so
+ * that their reference counts need not be manipulated atomically until a
+ * copy of one of its entries is made by Entry_Copy()
+ */
+#define RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_                (0x00000001)
+
 /* /////////////////////////////////////////////////////////////////////////
  * functions
  */
@@ -53,20 +115,113 @@ Entry_Allocate(
     size_t cb
 );
 
-/** Releases an entry. */
+/** Allocates an entry of the given size from the given arena, or from the
+ * heap if arena is NULL or the entry is too large to be recycled.
+ */
+RECLS_FNDECL(recls_entry_t)
+Entry_AllocateFromArena(
+    struct entry_arena_t*   arena
+,   size_t                  cb
+);
+
+/** Releases an entry, which may be on any thread. If the entry belongs
+ * to an arena and this is the last reference, it is returned to the arena.
+ */
 RECLS_FNDECL(void)
 Entry_Release(
     recls_entry_t fileInfo
 );
 
-/** Copies an entry. */
+/** Releases an entry on behalf of the search that created it, returning
+ * it to the search's arena, if any, if this is the last reference.
+ *
+ * \note Must only be called by the thread running the search.
+ */
+RECLS_FNDECL(void)
+Entry_ReleaseOwned(
+    recls_entry_t fileInfo
+);
+
+/** Copies an entry.
+ *
+ * \note A copy may be passed to another thread, so the reference counts
+ *   of the entry's arena, and of all its entries, are thereafter
+ *   manipulated atomically, even if it was created with
+ *   RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_. It must therefore be called by
+ *   the thread performing the search, as is the case with the entries
+ *   passed to a process function.
+ */
 RECLS_API
 Entry_Copy(
     recls_entry_t   fileInfo
 ,   recls_entry_t*  pinfo
 );
 
-/** Returns the block count of an entry. */
+/** Creates an entry arena, returning NULL if it cannot be allocated.
+ *
+ * \param flags 0, or RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_
+ *
+ * The arena is released by Entry_ReleaseArena().
+ */
+RECLS_FNDECL(struct entry_arena_t*)
+Entry_CreateArena(
+    recls_uint32_t flags
+);
+
+/** Releases the search's reference to the arena, which is destroyed when
+ * no copies of its entries remain.
+ */
+RECLS_FNDECL(void)
+Entry_ReleaseArena(
+    struct entry_arena_t* arena
+);
+
+/** Creates a shared directory, with one reference, holding copies of the
+ * directory and of the search directory (which may be empty), returning
+ * NULL if it cannot be allocated.
+ *
+ * \note The \c numParts parts are to be set, to point into the copy of
+ *   the directory, by the caller.
+ */
+RECLS_FNDECL(struct entry_shared_directory_t*)
+Entry_CreateSharedDirectory(
+    recls_char_t const* dir
+,   size_t              dirLen
+,   size_t              numParts
+,   recls_char_t const* searchDir
+,   size_t              searchDirLen
+);
+
+/** Releases a reference to a shared directory, which may be NULL. */
+RECLS_FNDECL(void)
+Entry_ReleaseSharedDirectory(
+    struct entry_shared_directory_t* sd
+);
+
+/** Attaches the shared directory to the entry, as its directory parts
+ * and, if the shared directory has one, its search directory, adding a
+ * reference to it that is released when the entry is destroyed.
+ *
+ * \note The entry must not have been allocated from an arena.
+ */
+RECLS_FNDECL(void)
+Entry_AttachSharedDirectory(
+    recls_entry_t                       fileInfo
+,   struct entry_shared_directory_t*    sd
+);
+
+/** Returns the nanosecond parts of the entry's times, which are 0 when
+ * the entry is allocated.
+ */
+RECLS_FNDECL(struct entry_times_nsec_t*)
+Entry_TimesNsec(
+    recls_entry_t fileInfo
+);
+
+/** Returns the numbers of created and shared entry blocks, which are
+ * counted only when RECLS_COUNTING_ENTRY_BLOCKS is defined; otherwise,
+ * both are 0.
+ */
 RECLS_FNDECL(void)
 Entry_BlockCount(
     rc_atomic_t*    pcCreated
@@ -4,11 +4,11 @@
  * Purpose: Implementation of the create_entryinfo() function.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -72,6 +72,82 @@ namespace impl
 {
 #endif /* !RECLS_NO_NAMESPACE */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * helper functions
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* Returns the shared directory held by the caller if it is of the given
+ * directory, and otherwise a new one, which replaces it; returns NULL if
+ * a new one cannot be allocated, in which case each entry has its own
+ * copies
+ */
+entry_shared_directory_t*
+obtain_shared_directory_(
+    entry_shared_directory_t**  psharedDir
+,   recls_char_t const*         dir
+,   size_t                      dirLen
+,   size_t                      numParts
+,   recls_char_t const*         searchDir
+,   size_t                      searchDirLen
+)
+{
+    entry_shared_directory_t* sd = *psharedDir;
+
+    if (ss_nullptr_k != sd &&
+        numParts == sd->numParts &&
+        dirLen == static_cast<size_t>(sd->directory.end - sd->directory.begin) &&
+        searchDirLen == static_cast<size_t>(sd->searchDirectory.end - sd->searchDirectory.begin) &&
+        0 == types::traits_type::str_n_compare(dir, sd->directory.begin, dirLen) &&
+        (   0 == searchDirLen ||
+            0 == types::traits_type::str_n_compare(searchDir, sd->searchDirectory.begin, searchDirLen)))
+    {
+        return sd;
+    }
+
+    sd = Entry_CreateSharedDirectory(dir, dirLen, numParts, searchDir, searchDirLen);
+
+    if (ss_nullptr_k != sd)
+    {
+        recls_char_t const*     p       =   sd->directory.begin;
+        recls_char_t const*     l       =   sd->directory.end;
+        struct recls_strptrs_t* begin   =   &sd->parts[0];
+        struct recls_strptrs_t* end     =   &sd->parts[0] + numParts;
+
+        if (begin != end)
+        {
+            begin->begin = p;
+
+            for (; p != l; ++p)
+            {
+                if (*p == types::traits_type::path_name_separator())
+                {
+                    begin->end = p + 1;
+
+                    if (++begin != end)
+                    {
+                        begin->begin = p + 1;
+                    }
+                }
+            }
+        }
+
+        Entry_ReleaseSharedDirectory(*psharedDir);
+
+        *psharedDir = sd;
+    }
+
+    return sd;
+}
+
+#if !defined(RECLS_NO_NAMESPACE)
+} // anonymous namespace
+#endif /* !RECLS_NO_NAMESPACE */
+
 /* /////////////////////////////////////////////////////////////////////////
  * utility functions
  */
@@ -87,6 +163,8 @@ create_entryinfo(
 ,   size_t                          entryFileLen
 ,   recls_uint32_t                  flags
 ,   types::stat_data_type const*    st
+,   entry_arena_t*                  arena
+,   entry_shared_directory_t**      psharedDir
 )
 {
     function_scope_trace("create_entryinfo");
@@ -126,17 +204,32 @@ create_entryinfo(
     // size of structure is:
     //
     //    offsetof(struct recls_entryinfo_t, data)
-    //  + directory parts
+    //  + directory parts, if not shared
     //  + full path (+ null)
     //  + short name (+ null)
     //  + 1 in case we need to MARK_DIRS
-    //  [+ 1 + searchDirLen if searchDir and entryPath do not overlap]
+    //  [+ 1 + searchDirLen if searchDir and entryPath do not overlap, and searchDir is not shared]
 
     recls_char_t const* const   dir0    =   recls_find_directory_0_(entryPath);
     recls_char_t const* const   end     =   entryPath + (entryPathLen - entryFileLen);
 
     size_t const    cchFileName =   entryFileLen;
     size_t const    cDirParts   =   (RECLS_F_DIRECTORY_PARTS == (flags & RECLS_F_DIRECTORY_PARTS)) ? types::count_dir_parts(dir0, end) : 0;
+
+    // The entries of a directory share its directory parts, and the search
+    // directory where it is not part of their paths, if the caller allows,
+    // unless they are to be recycled by an arena, which does not release
+    // them individually
+    entry_shared_directory_t*   sharedDir   =   ss_nullptr_k;
+
+    if ((0 != cDirParts || !bSearchDirOverlap) &&
+        ss_nullptr_k != psharedDir &&
+        ss_nullptr_k == arena)
+    {
+        sharedDir = obtain_shared_directory_(psharedDir, dir0, static_cast<size_t>(end - dir0), cDirParts, searchDir, bSearchDirOverlap ? 0 : searchDirLen);
+    }
+
+    size_t const    cOwnDirParts    =   (ss_nullptr_k != sharedDir) ? 0 : cDirParts;
     size_t const    cbPath      =   recls_align_up_size_(sizeof(recls_char_t) * (1 + entryPathLen));
 #if defined(RECLS_PLATFORM_IS_UNIX)
     size_t const    cbAlt       =   0;  // UNIX doesn't have alt paths
@@ -146,20 +239,20 @@ create_entryinfo(
 # error Platform not discriminated
 #endif /* platform */
     size_t const    cb          =   offsetof(struct recls_entryinfo_t, data)
-                                +   cDirParts * sizeof(recls_strptrs_t)
+                                +   cOwnDirParts * sizeof(recls_strptrs_t)
                                 +   cbPath
                                 +   cbAlt
                                 +   1 // In case we need to expand for MARK_DIRS
-                                +   (bSearchDirOverlap ? 0 : (sizeof(recls_char_t) * (1 + searchDirLen + 1)))
+                                +   ((bSearchDirOverlap || ss_nullptr_k != sharedDir) ? 0 : (sizeof(recls_char_t) * (1 + searchDirLen + 1)))
                                 ;
 
-    struct recls_entryinfo_t* info = const_cast<struct recls_entryinfo_t*>(Entry_Allocate(cb));
+    struct recls_entryinfo_t* info = const_cast<struct recls_entryinfo_t*>(Entry_AllocateFromArena(arena, cb));
 
     if (ss_nullptr_k != info)
     {
         recls_byte_t* const     pData       =   &info->data[0];
         recls_byte_t* const     pParts      =   pData + 0;
-        recls_byte_t* const     pPath       =   pParts + (cDirParts * sizeof(recls_strptrs_t));
+        recls_byte_t* const     pPath       =   pParts + (cOwnDirParts * sizeof(recls_strptrs_t));
 #if defined(RECLS_PLATFORM_IS_WINDOWS)
         recls_byte_t* const     pAltName    =   pPath + cbPath;
 #endif /* platform */
@@ -170,9 +263,9 @@ create_entryinfo(
         recls_char_t*           altName     =   ::stlsoft::sap_cast<recls_char_t*>(pAltName);
 #endif /* platform */
 
-        RECLS_ASSERT(::stlsoft::sap_cast<recls_char_t*>(pData + (cDirParts * sizeof(recls_strptrs_t))) == fullPath);
+        RECLS_ASSERT(::stlsoft::sap_cast<recls_char_t*>(pData + (cOwnDirParts * sizeof(recls_strptrs_t))) == fullPath);
 #if defined(RECLS_PLATFORM_IS_WINDOWS)
-        RECLS_ASSERT(::stlsoft::sap_cast<recls_char_t*>(pData + (cDirParts * sizeof(recls_strptrs_t) + cbPath)) == altName);
+        RECLS_ASSERT(::stlsoft::sap_cast<recls_char_t*>(pData + (cOwnDirParts * sizeof(recls_strptrs_t) + cbPath)) == altName);
 #endif /* platform */
 
         info->checkSum                      =   0;
@@ -196,8 +289,9 @@ create_entryinfo(
             info->searchRelativePath.end    =   info->path.end;
         }
 
-        // Number of relative directory parts
-        info->numRelativeDirectoryParts     =   (RECLS_F_DIRECTORY_PARTS == (flags & RECLS_F_DIRECTORY_PARTS)) ? types::count_dir_parts(info->searchRelativePath.begin, info->searchRelativePath.end) : 0;
+        // Number of relative directory parts (counted along with the
+        // directory parts, below)
+        info->numRelativeDirectoryParts     =   0;
 
         // Number of (hard) links; node index & device Id
         if (0 != ((RECLS_F_LINK_COUNT|RECLS_F_NODE_INDEX) & flags) &&
@@ -293,12 +387,19 @@ create_entryinfo(
         info->directoryParts.begin          =   begin;
         info->directoryParts.end            =   begin + cDirParts;
 
+        if (ss_nullptr_k != sharedDir)
+        {
+            Entry_AttachSharedDirectory(info, sharedDir);
+        }
+
+        // (Where it is not part of the path, the search directory is that
+        // of the shared directory, if any)
         if (bSearchDirOverlap)
         {
             info->searchDirectory.begin     =   info->path.begin;
             info->searchDirectory.end       =   info->searchDirectory.begin + rootDirLen;
         }
-        else
+        else if (ss_nullptr_k == sharedDir)
         {
             recls_char_t*   searchCopy      =   ::stlsoft::sap_cast<recls_char_t*>(pSearchCopy);
             info->searchDirectory.begin     =   searchCopy;
@@ -307,24 +408,47 @@ create_entryinfo(
             searchCopy[searchDirLen] = '\0';
         }
 
-        if (info->directoryParts.begin != info->directoryParts.end)
+        if (RECLS_F_DIRECTORY_PARTS == (flags & RECLS_F_DIRECTORY_PARTS))
         {
-            RECLS_ASSERT((flags & RECLS_F_DIRECTORY_PARTS) == RECLS_F_DIRECTORY_PARTS);
-
-            begin->begin = p;
-
-            for (; p != l; ++p)
+            // The file name has no separators, so the relative parts are
+            // those separators in the relative path that precede the
+            // directory, if any, and those in the directory from the start
+            // of the relative path
+            recls_char_t const* const   relBegin    =   info->searchRelativePath.begin;
+            size_t                      cRelParts   =   (relBegin < p) ? types::count_dir_parts(relBegin, p) : 0;
+
+            // The parts of a shared directory are already determined, so
+            // only the relative parts are counted
+            if (info->directoryParts.begin != info->directoryParts.end)
             {
-                if (*p == types::traits_type::path_name_separator())
+                if (ss_nullptr_k == sharedDir)
                 {
-                    begin->end = p + 1;
+                    begin->begin = p;
+                }
 
-                    if (++begin != info->directoryParts.end)
+                for (; p != l; ++p)
+                {
+                    if (*p == types::traits_type::path_name_separator())
                     {
-                        begin->begin = p + 1;
+                        if (p >= relBegin)
+                        {
+                            ++cRelParts;
+                        }
+
+                        if (ss_nullptr_k == sharedDir)
+                        {
+                            begin->end = p + 1;
+
+                            if (++begin != info->directoryParts.end)
+                            {
+                                begin->begin = p + 1;
+                            }
+                        }
                     }
                 }
             }
+
+            info->numRelativeDirectoryParts = cRelParts;
         }
 
         if (ss_nullptr_k == st)
@@ -384,6 +508,15 @@ create_entryinfo(
             info->lastStatusChangeTime  =   st->st_ctime;
             info->modificationTime      =   st->st_mtime;
             info->lastAccessTime        =   st->st_atime;
+# ifdef RECLS_STAT_HAS_NANOSECOND_TIMES_
+            {
+                struct entry_times_nsec_t* const timesNsec = Entry_TimesNsec(info);
+
+                timesNsec->modificationTime     =   static_cast<recls_uint32_t>(st->st_mtim.tv_nsec);
+                timesNsec->lastAccessTime       =   static_cast<recls_uint32_t>(st->st_atim.tv_nsec);
+                timesNsec->lastStatusChangeTime =   static_cast<recls_uint32_t>(st->st_ctim.tv_nsec);
+            }
+# endif /* RECLS_STAT_HAS_NANOSECOND_TIMES_ */
             info->size                  =   stlsoft::to_uint64(*st);
 #elif defined(RECLS_PLATFORM_IS_WINDOWS)
             info->creationTime          =   st->ftCreationTime;
@@ -426,6 +559,49 @@ create_entryinfo(
     return info;
 }
 
+#if defined(RECLS_PLATFORM_IS_UNIX)
+recls_entry_t
+create_entryinfo_without_details(
+    size_t                          rootDirLen
+,   recls_char_t const*             searchDir
+,   size_t                          searchDirLen
+,   recls_char_t const*             entryPath
+,   size_t                          entryPathLen
+,   recls_char_t const*             entryFile
+,   size_t                          entryFileLen
+,   recls_uint32_t                  flags
+,   types::stat_data_type const*    st
+,   entry_arena_t*                  arena
+,   entry_shared_directory_t**      psharedDir
+)
+{
+    function_scope_trace("create_entryinfo_without_details");
+
+    RECLS_ASSERT(ss_nullptr_k != st);
+
+    // Only the type (and the link count and node index, if requested) is
+    // known, so all other details are left as 0, and the type alone is
+    // used to determine the attributes (and any MARK_DIRS handling)
+    types::stat_data_type st2;
+
+    memset(&st2, 0, sizeof(st2));
+
+    st2.st_mode     =   st->st_mode & S_IFMT;
+    st2.st_nlink    =   st->st_nlink;
+    st2.st_ino      =   st->st_ino;
+    st2.st_dev      =   st->st_dev;
+
+    recls_entry_t const entry = create_entryinfo(rootDirLen, searchDir, searchDirLen, entryPath, entryPathLen, entryFile, entryFileLen, flags, &st2, arena, psharedDir);
+
+    if (ss_nullptr_k != entry)
+    {
+        const_cast<struct recls_entryinfo_t*>(entry)->extendedFlags[0] |= RECLS_ENTRYINFO_XF0_DETAILS_NOT_LOADED_;
+    }
+
+    return entry;
+}
+#endif /* RECLS_PLATFORM_IS_UNIX */
+
 recls_entry_t
 create_drive_entryinfo(
     recls_char_t const*             entryPath
@@ -589,6 +765,15 @@ create_drive_entryinfo(
             info->lastStatusChangeTime  =   st->st_ctime;
             info->modificationTime      =   st->st_mtime;
             info->lastAccessTime        =   st->st_atime;
+# ifdef RECLS_STAT_HAS_NANOSECOND_TIMES_
+            {
+                struct entry_times_nsec_t* const timesNsec = Entry_TimesNsec(info);
+
+                timesNsec->modificationTime     =   static_cast<recls_uint32_t>(st->st_mtim.tv_nsec);
+                timesNsec->lastAccessTime       =   static_cast<recls_uint32_t>(st->st_atim.tv_nsec);
+                timesNsec->lastStatusChangeTime =   static_cast<recls_uint32_t>(st->st_ctim.tv_nsec);
+            }
+# endif /* RECLS_STAT_HAS_NANOSECOND_TIMES_ */
             info->size                  =   stlsoft::to_uint64(*st);
 #elif defined(RECLS_PLATFORM_IS_WINDOWS)
             info->creationTime          =   st->ftCreationTime;
@@ -4,11 +4,11 @@
  * Purpose: Definition of the create_entryinfo() function.
  *
  * Created: 31st May 2004
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2004-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -29,6 +29,7 @@
 
 #include <recls/recls.h>
 #include "impl.types.hpp"
+#include "impl.entryfunctions.h"
 
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
@@ -41,6 +42,16 @@ namespace impl
 {
 #endif /* !RECLS_NO_NAMESPACE */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * constants
+ */
+
+/** Bit in recls_entryinfo_t::extendedFlags[0] that indicates that the
+ * entry's details - times, size, and attributes other than its type - were
+ * not loaded when it was created
+ */
+#define RECLS_ENTRYINFO_XF0_DETAILS_NOT_LOADED_             (0x00000001)
+
 /* /////////////////////////////////////////////////////////////////////////
  * utility functions
  */
@@ -48,6 +59,15 @@ namespace impl
 extern "C"
 {
 
+/** Creates an entry.
+ *
+ * \param arena The arena from which the entry is allocated, or NULL
+ * \param psharedDir Pointer to the shared directory of the caller's
+ *   previous entry, or NULL. If not NULL, an entry that is not allocated
+ *   from an arena shares it, if it is of the same directory, or otherwise
+ *   a new one, which replaces it. The caller releases the last, by
+ *   Entry_ReleaseSharedDirectory().
+ */
 recls_entry_t
 create_entryinfo(
     size_t                          rootDirLen
@@ -59,7 +79,32 @@ create_entryinfo(
 ,   size_t                          entryFileLen
 ,   recls_uint32_t                  flags
 ,   types::stat_data_type const*    st
+,   entry_arena_t*                  arena
+,   entry_shared_directory_t**      psharedDir
+);
+
+#if defined(RECLS_PLATFORM_IS_UNIX)
+/** Creates an entry whose details are not loaded.
+ *
+ * \param st The stat data of the entry, of which only the type (S_IFMT)
+ *   is used, along with the link count and/or node index when
+ *   RECLS_F_LINK_COUNT and/or RECLS_F_NODE_INDEX are specified
+ */
+recls_entry_t
+create_entryinfo_without_details(
+    size_t                          rootDirLen
+,   recls_char_t const*             searchDir
+,   size_t                          searchDirLen
+,   recls_char_t const*             entryPath
+,   size_t                          entryPathLen
+,   recls_char_t const*             entryFile
+,   size_t                          entryFileLen
+,   recls_uint32_t                  flags
+,   types::stat_data_type const*    st
+,   entry_arena_t*                  arena
+,   entry_shared_directory_t**      psharedDir
 );
+#endif /* RECLS_PLATFORM_IS_UNIX */
 
 recls_entry_t
 create_drive_entryinfo(
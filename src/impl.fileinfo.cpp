@@ -4,11 +4,11 @@
  * Purpose: Main (platform-independent) implementation file for recls API.
  *
  * Created: 16th August 2003
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2003-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -26,11 +26,14 @@
 
 #include <recls/recls.h>
 #include <recls/assert.h>
+#include "impl.allocator.hpp"
 #include "impl.atomic.h"
 #include "impl.entryfunctions.h"
 
 #include "impl.trace.h"
 
+#include <string.h>
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
@@ -49,10 +52,40 @@ namespace impl
 struct counted_recls_info_t
 {
     volatile rc_atomic_t        rc;
-    recls_uint32_t              _;
+    recls_uint32_t              sizeClass;  // Index of the arena free-list; unused when arena is NULL
+    union
+    {
+        entry_arena_t*          arena;      // NULL when allocated from the heap
+        counted_recls_info_t*   next;       // When on an arena free-list
+    }                           u;
+    struct entry_times_nsec_t   timesNsec;
     struct recls_entryinfo_t    info;
 };
 
+// Entries are allocated from an arena in size classes of 256, 512, ...,
+// 8192 bytes, each of which has its own free-list. Larger entries (which
+// are rare) are allocated from the heap.
+#define RECLS_ENTRY_ARENA_MIN_CLASS_SIZE_           (256)
+#define RECLS_ENTRY_ARENA_NUM_CLASSES_              (6)
+#define RECLS_ENTRY_ARENA_CHUNK_SIZE_               (64 * 1024)
+#define RECLS_ENTRY_ARENA_CHUNK_HEADER_SIZE_        (64)
+
+struct entry_arena_chunk_t
+{
+    entry_arena_chunk_t*        next;
+};
+
+struct entry_arena_t
+{
+    volatile rc_atomic_t        refs;       // The search, plus each outstanding copy of an entry
+    volatile rc_atomic_t        local;      // Non-zero until a copy of an entry is made; see arena_is_local()
+    entry_arena_chunk_t*        chunks;
+    recls_byte_t*               next;       // Unused part of the current chunk
+    recls_byte_t*               end;
+    counted_recls_info_t*       freeLists[RECLS_ENTRY_ARENA_NUM_CLASSES_];
+    void* volatile              returned;   // Entries whose last reference was that of a copy; see entry_arena_return_()
+};
+
 /* /////////////////////////////////////////////////////////////////////////
  * globals
  */
@@ -62,8 +95,10 @@ namespace
 {
 #endif /* !RECLS_NO_NAMESPACE */
 
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
 volatile rc_atomic_t s_createdInfoBlocks =   rc_atomic_init(0);
 volatile rc_atomic_t s_sharedInfoBlocks  =   rc_atomic_init(0);
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
 
 #if !defined(RECLS_NO_NAMESPACE)
 } // anonymous namespace
@@ -91,6 +126,314 @@ inline recls_entry_t info_from_counted_info(struct counted_recls_info_t* ci)
     return &ci->info;
 }
 
+// The block counts are shared by all threads, so are maintained only when
+// RECLS_COUNTING_ENTRY_BLOCKS is defined
+
+inline void count_block_created()
+{
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
+    RC_Increment(&s_createdInfoBlocks);
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
+}
+
+inline void count_block_destroyed()
+{
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
+    RC_PreDecrement(&s_createdInfoBlocks);
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
+}
+
+inline void count_block_shared()
+{
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
+    RC_Increment(&s_sharedInfoBlocks);
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
+}
+
+inline void count_block_unshared()
+{
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
+    RC_PreDecrement(&s_sharedInfoBlocks);
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
+}
+
+// The counts of a local arena, and of its entries, are manipulated only
+// by the thread performing the search until a copy of one of its entries
+// is made, and so are not synchronised. The flag is cleared, by the search
+// thread, before the copy can be passed to another thread, and is read
+// with acquire semantics, so that a thread that has been passed a copy
+// sees the counts as they were when it was cleared
+
+inline bool arena_is_local(
+    entry_arena_t const* arena
+)
+{
+    return 0 != RC_ReadValueAcquire(const_cast<rc_atomic_t volatile*>(&arena->local));
+}
+
+inline void arena_count_increment(
+    entry_arena_t const*    arena
+,   rc_atomic_t volatile*   p
+)
+{
+    if (arena_is_local(arena))
+    {
+        RC_IncrementLocal(p);
+    }
+    else
+    {
+        RC_Increment(p);
+    }
+}
+
+inline rc_atomic_t arena_count_predecrement(
+    entry_arena_t const*    arena
+,   rc_atomic_t volatile*   p
+)
+{
+    return arena_is_local(arena) ? RC_PreDecrementLocal(p) : RC_PreDecrement(p);
+}
+
+inline size_t counted_info_size(size_t cb)
+{
+    return cb - sizeof(struct recls_entryinfo_t) + sizeof(struct counted_recls_info_t);
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * shared directory functions
+ */
+
+RECLS_FNDECL(entry_shared_directory_t*) Entry_CreateSharedDirectory(
+    recls_char_t const* dir
+,   size_t              dirLen
+,   size_t              numParts
+,   recls_char_t const* searchDir
+,   size_t              searchDirLen
+)
+{
+    size_t const                    cbParts =   offsetof(entry_shared_directory_t, parts) + sizeof(struct recls_strptrs_t) * numParts;
+    size_t const                    cb      =   cbParts + sizeof(recls_char_t) * (1 + dirLen + 1 + searchDirLen);
+    entry_shared_directory_t* const sd      =   static_cast<entry_shared_directory_t*>(recls_malloc_(cb));
+
+    if (ss_nullptr_k != sd)
+    {
+        rc_atomic_t     initial =   rc_atomic_init(1);
+        recls_char_t*   chars   =   reinterpret_cast<recls_char_t*>(reinterpret_cast<recls_byte_t*>(sd) + cbParts);
+
+        sd->refs                    =   initial;
+        sd->numParts                =   numParts;
+
+        memcpy(chars, dir, sizeof(recls_char_t) * dirLen);
+        chars[dirLen] = '\0';
+        sd->directory.begin         =   chars;
+        sd->directory.end           =   chars + dirLen;
+
+        chars += 1 + dirLen;
+
+        if (0 != searchDirLen)
+        {
+            memcpy(chars, searchDir, sizeof(recls_char_t) * searchDirLen);
+        }
+        chars[searchDirLen] = '\0';
+        sd->searchDirectory.begin   =   chars;
+        sd->searchDirectory.end     =   chars + searchDirLen;
+    }
+
+    return sd;
+}
+
+RECLS_FNDECL(void) Entry_ReleaseSharedDirectory(entry_shared_directory_t* sd)
+{
+    if (ss_nullptr_k != sd &&
+        0 == RC_PreDecrement(&sd->refs))
+    {
+        recls_free_(sd);
+    }
+}
+
+RECLS_FNDECL(void) Entry_AttachSharedDirectory(
+    recls_entry_t               fileInfo
+,   entry_shared_directory_t*   sd
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != fileInfo);
+    RECLS_ASSERT(ss_nullptr_k != sd);
+    RECLS_ASSERT(ss_nullptr_k == counted_info_from_info(fileInfo)->u.arena);
+    RECLS_ASSERT(0 == (fileInfo->extendedFlags[0] & RECLS_ENTRYINFO_XF0_SHARED_DIRECTORY_));
+
+    struct recls_entryinfo_t* const info = const_cast<struct recls_entryinfo_t*>(fileInfo);
+
+    RC_Increment(&sd->refs);
+
+    info->directoryParts.begin      =   &sd->parts[0];
+    info->directoryParts.end        =   &sd->parts[0] + sd->numParts;
+    if (sd->searchDirectory.begin != sd->searchDirectory.end)
+    {
+        info->searchDirectory       =   sd->searchDirectory;
+    }
+    info->extendedFlags[0]          |=  RECLS_ENTRYINFO_XF0_SHARED_DIRECTORY_;
+}
+
+// The entry holds no pointer to the shared directory as such, since it is
+// found from the directory parts, which are its own (even if empty)
+static void entry_release_shared_directory_(struct recls_entryinfo_t const* info)
+{
+    if (0 != (info->extendedFlags[0] & RECLS_ENTRYINFO_XF0_SHARED_DIRECTORY_))
+    {
+        recls_byte_t const* const parts = reinterpret_cast<recls_byte_t const*>(info->directoryParts.begin);
+
+        Entry_ReleaseSharedDirectory(reinterpret_cast<entry_shared_directory_t*>(const_cast<recls_byte_t*>(parts - offsetof(entry_shared_directory_t, parts))));
+    }
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * arena functions
+ */
+
+static void entry_arena_destroy_(entry_arena_t* arena)
+{
+    for (entry_arena_chunk_t* chunk = arena->chunks; ss_nullptr_k != chunk; )
+    {
+        entry_arena_chunk_t* const next = chunk->next;
+
+        recls_free_(chunk);
+
+        chunk = next;
+    }
+
+    recls_free_(arena);
+}
+
+// An entry whose last reference is released by a copy, which may be on
+// any thread, is pushed onto the arena's list of returned entries, from
+// which the search (the only thread that takes from it, and which takes it
+// whole) moves them to the free-lists when it next finds one empty
+
+static void entry_arena_return_(
+    entry_arena_t*          arena
+,   counted_recls_info_t*   ci
+)
+{
+    // The head is not read directly, but is obtained from the exchange,
+    // the first attempt at which presumes the list to be empty
+    for (void* head = ss_nullptr_k;; )
+    {
+        ci->u.next = static_cast<counted_recls_info_t*>(head);
+
+        void* const previous = RC_CompareExchangePointer(&arena->returned, ci, head);
+
+        if (previous == head)
+        {
+            break;
+        }
+
+        head = previous;
+    }
+}
+
+static void entry_arena_reclaim_(entry_arena_t* arena)
+{
+    counted_recls_info_t* ci = static_cast<counted_recls_info_t*>(RC_ExchangePointer(&arena->returned, ss_nullptr_k));
+
+    for (; ss_nullptr_k != ci; )
+    {
+        counted_recls_info_t* const next = ci->u.next;
+
+        ci->u.next                      =   arena->freeLists[ci->sizeClass];
+        arena->freeLists[ci->sizeClass] =   ci;
+
+        ci = next;
+    }
+}
+
+static counted_recls_info_t* entry_arena_allocate_(
+    entry_arena_t*  arena
+,   recls_uint32_t  sizeClass
+)
+{
+    counted_recls_info_t* ci = arena->freeLists[sizeClass];
+
+    // Entries can be returned only once a copy has been made, since which
+    // the arena is not local
+    if (ss_nullptr_k == ci &&
+        !arena_is_local(arena))
+    {
+        entry_arena_reclaim_(arena);
+
+        ci = arena->freeLists[sizeClass];
+    }
+
+    if (ss_nullptr_k != ci)
+    {
+        arena->freeLists[sizeClass] = ci->u.next;
+    }
+    else
+    {
+        size_t const classSize = size_t(RECLS_ENTRY_ARENA_MIN_CLASS_SIZE_) << sizeClass;
+
+        if (static_cast<size_t>(arena->end - arena->next) < classSize)
+        {
+            // The remainder of the current chunk, if any, is abandoned
+            entry_arena_chunk_t* const chunk = static_cast<entry_arena_chunk_t*>(recls_malloc_(RECLS_ENTRY_ARENA_CHUNK_SIZE_));
+
+            if (ss_nullptr_k == chunk)
+            {
+                return ss_nullptr_k;
+            }
+
+            chunk->next     =   arena->chunks;
+            arena->chunks   =   chunk;
+            arena->next     =   reinterpret_cast<recls_byte_t*>(chunk) + RECLS_ENTRY_ARENA_CHUNK_HEADER_SIZE_;
+            arena->end      =   reinterpret_cast<recls_byte_t*>(chunk) + RECLS_ENTRY_ARENA_CHUNK_SIZE_;
+        }
+
+        ci          =   reinterpret_cast<counted_recls_info_t*>(arena->next);
+        arena->next +=  classSize;
+    }
+
+    return ci;
+}
+
+static void entry_arena_release_ref_(entry_arena_t* arena)
+{
+    if (0 == arena_count_predecrement(arena, &arena->refs))
+    {
+        entry_arena_destroy_(arena);
+    }
+}
+
+RECLS_FNDECL(entry_arena_t*) Entry_CreateArena(recls_uint32_t flags)
+{
+    entry_arena_t* const arena = static_cast<entry_arena_t*>(recls_malloc_(sizeof(entry_arena_t)));
+
+    if (ss_nullptr_k != arena)
+    {
+        rc_atomic_t initial = rc_atomic_init(1);
+
+        arena->refs     =   initial; // The search's reference
+        RC_WriteValueRelease(&arena->local, 0 != (RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_ & flags));
+        arena->chunks   =   ss_nullptr_k;
+        arena->next     =   ss_nullptr_k;
+        arena->end      =   ss_nullptr_k;
+        arena->returned =   ss_nullptr_k;
+
+        for (size_t i = 0; i != RECLS_ENTRY_ARENA_NUM_CLASSES_; ++i)
+        {
+            arena->freeLists[i] = ss_nullptr_k;
+        }
+    }
+
+    return arena;
+}
+
+RECLS_FNDECL(void) Entry_ReleaseArena(entry_arena_t* arena)
+{
+    if (ss_nullptr_k != arena)
+    {
+        entry_arena_release_ref_(arena);
+    }
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * file info functions
  */
@@ -98,7 +441,7 @@ inline recls_entry_t info_from_counted_info(struct counted_recls_info_t* ci)
 RECLS_FNDECL(recls_entry_t) Entry_Allocate(size_t cb)
 {
     // Simply allocate a lock-count prior to the main memory (but do it on an 8-byte block)
-    counted_recls_info_t*   ci  =   static_cast<counted_recls_info_t*>(malloc(cb - sizeof(struct recls_entryinfo_t) + sizeof(struct counted_recls_info_t)));
+    counted_recls_info_t*   ci  =   static_cast<counted_recls_info_t*>(recls_malloc_(counted_info_size(cb)));
     recls_entry_t           info;
 
     if (ss_nullptr_k == ci)
@@ -109,30 +452,118 @@ RECLS_FNDECL(recls_entry_t) Entry_Allocate(size_t cb)
     {
         rc_atomic_t initial = rc_atomic_init(1);
 
-        ci->rc  =   initial; // One initial reference
-        info    =   info_from_counted_info(ci);
+        ci->rc          =   initial; // One initial reference
+        ci->sizeClass   =   0;
+        ci->u.arena     =   ss_nullptr_k;
+        info            =   info_from_counted_info(ci);
+
+        memset(&ci->timesNsec, 0, sizeof(ci->timesNsec));
 
-        RC_Increment(&s_createdInfoBlocks);
+        count_block_created();
     }
 
     return info;
 }
 
+RECLS_FNDECL(recls_entry_t) Entry_AllocateFromArena(
+    entry_arena_t*  arena
+,   size_t          cb
+)
+{
+    if (ss_nullptr_k != arena)
+    {
+        size_t const    size        =   counted_info_size(cb);
+        recls_uint32_t  sizeClass   =   0;
+
+        for (; sizeClass != RECLS_ENTRY_ARENA_NUM_CLASSES_; ++sizeClass)
+        {
+            if (size <= (size_t(RECLS_ENTRY_ARENA_MIN_CLASS_SIZE_) << sizeClass))
+            {
+                counted_recls_info_t* const ci = entry_arena_allocate_(arena, sizeClass);
+
+                if (ss_nullptr_k == ci)
+                {
+                    return ss_nullptr_k;
+                }
+                else
+                {
+                    rc_atomic_t initial = rc_atomic_init(1);
+
+                    // Arena entries are not included in the block counts
+                    // unless they are copied, since they are reclaimed
+                    // with the arena
+                    ci->rc          =   initial; // One initial reference
+                    ci->sizeClass   =   sizeClass;
+                    ci->u.arena     =   arena;
+
+                    memset(&ci->timesNsec, 0, sizeof(ci->timesNsec));
+
+                    return info_from_counted_info(ci);
+                }
+            }
+        }
+    }
+
+    return Entry_Allocate(cb);
+}
+
 RECLS_FNDECL(void) Entry_Release(recls_entry_t fileInfo)
 {
     if (ss_nullptr_k != fileInfo)
     {
-        counted_recls_info_t* pci = counted_info_from_info(fileInfo);
+        counted_recls_info_t*   pci     =   counted_info_from_info(fileInfo);
+        entry_arena_t* const    arena   =   pci->u.arena;
+
+        if (ss_nullptr_k != arena)
+        {
+            // This is a copy, which may be released by any thread, so if
+            // it is the last reference the entry is returned to the arena
+            // for the search to recycle
+            if (0 != arena_count_predecrement(arena, &pci->rc))
+            {
+                count_block_unshared();
+            }
+            else
+            {
+                entry_arena_return_(arena, pci);
+            }
+
+            entry_arena_release_ref_(arena);
+        }
+        else if (0 == RC_PreDecrement(&pci->rc))
+        {
+            entry_release_shared_directory_(&pci->info);
 
-        if (0 == RC_PreDecrement(&pci->rc))
+            recls_free_(pci);
+
+            count_block_destroyed();
+        }
+        else
         {
-            free(pci);
+            count_block_unshared();
+        }
+    }
+}
 
-            RC_PreDecrement(&s_createdInfoBlocks);
+RECLS_FNDECL(void) Entry_ReleaseOwned(recls_entry_t fileInfo)
+{
+    if (ss_nullptr_k != fileInfo)
+    {
+        counted_recls_info_t*   pci     =   counted_info_from_info(fileInfo);
+        entry_arena_t* const    arena   =   pci->u.arena;
+
+        if (ss_nullptr_k == arena)
+        {
+            Entry_Release(fileInfo);
+        }
+        else if (0 == arena_count_predecrement(arena, &pci->rc))
+        {
+            pci->u.next                         =   arena->freeLists[pci->sizeClass];
+            arena->freeLists[pci->sizeClass]    =   pci;
         }
         else
         {
-            RC_PreDecrement(&s_sharedInfoBlocks);
+            count_block_unshared();
         }
     }
 }
@@ -146,14 +577,26 @@ RECLS_API Entry_Copy(
 
     if (ss_nullptr_k != fileInfo)
     {
-        counted_recls_info_t* pci = counted_info_from_info(fileInfo);
+        counted_recls_info_t*   pci     =   counted_info_from_info(fileInfo);
+        entry_arena_t* const    arena   =   pci->u.arena;
 
 #if 0
         recls_trace_printf_(RECLS_LITERAL("Entry_Copy(%p): %s"), fileInfo, fileInfo->path.begin);
 #endif /* 0 */
 
+        if (ss_nullptr_k != arena)
+        {
+            // The copy may be passed to another thread
+            if (arena_is_local(arena))
+            {
+                RC_WriteValueRelease(&arena->local, 0);
+            }
+
+            RC_Increment(&arena->refs);
+        }
+
         RC_Increment(&pci->rc);
-        RC_Increment(&s_sharedInfoBlocks);
+        count_block_shared();
     }
 
     *pinfo = fileInfo;
@@ -161,6 +604,11 @@ RECLS_API Entry_Copy(
     return RECLS_RC_OK;
 }
 
+RECLS_FNDECL(struct entry_times_nsec_t*) Entry_TimesNsec(recls_entry_t fileInfo)
+{
+    return &counted_info_from_info(fileInfo)->timesNsec;
+}
+
 RECLS_FNDECL(void) Entry_BlockCount(
     rc_atomic_t* pcCreated
 ,   rc_atomic_t* pcShared
@@ -169,8 +617,13 @@ RECLS_FNDECL(void) Entry_BlockCount(
     RECLS_ASSERT(ss_nullptr_k != pcCreated);
     RECLS_ASSERT(ss_nullptr_k != pcShared);
 
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
     *pcCreated  =   RC_ReadValue(&s_createdInfoBlocks);
     *pcShared   =   RC_ReadValue(&s_sharedInfoBlocks);
+#else /* ? RECLS_COUNTING_ENTRY_BLOCKS */
+    *pcCreated  =   0;
+    *pcShared   =   0;
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
 }
 
 /* /////////////////////////////////////////////////////////////////////////
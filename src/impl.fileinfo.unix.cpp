@@ -123,6 +123,57 @@ RECLS_FNDECL(rc_atomic_t) RC_ReadValue(rc_atomic_t volatile* p)
 #endif /* !RECLS_UNIX_USE_ATOMIC_OPERATIONS */
 }
 
+RECLS_FNDECL(void) RC_WriteValue(rc_atomic_t volatile* p, int value)
+{
+#if defined(RECLS_UNIX_USE_ATOMIC_OPERATIONS)
+    __atomic_store_n(&rc_atomic_value(*p), value, __ATOMIC_SEQ_CST);
+#else /* ? RECLS_UNIX_USE_ATOMIC_OPERATIONS */
+    ::stlsoft::lock_scope<mutex_t>        lock(s_mx);
+
+    *p = value;
+#endif /* !RECLS_UNIX_USE_ATOMIC_OPERATIONS */
+}
+
+// The kernel's atomic operations are only for integers, so pointers are
+// exchanged by the compiler's, where available
+
+RECLS_FNDECL(void*) RC_ExchangePointer(void* volatile* p, void* value)
+{
+#if defined(__GNUC__) || \
+    defined(RECLS_UNIX_USE_ATOMIC_OPERATIONS)
+    return __atomic_exchange_n(p, value, __ATOMIC_ACQ_REL);
+#else /* ? __GNUC__ */
+    ::stlsoft::lock_scope<mutex_t>        lock(s_mx);
+
+    void* const previous = *p;
+
+    *p = value;
+
+    return previous;
+#endif /* __GNUC__ */
+}
+
+RECLS_FNDECL(void*) RC_CompareExchangePointer(void* volatile* p, void* value, void* comparand)
+{
+#if defined(__GNUC__) || \
+    defined(RECLS_UNIX_USE_ATOMIC_OPERATIONS)
+    __atomic_compare_exchange_n(p, &comparand, value, false, __ATOMIC_ACQ_REL, __ATOMIC_ACQUIRE);
+
+    return comparand;
+#else /* ? __GNUC__ */
+    ::stlsoft::lock_scope<mutex_t>        lock(s_mx);
+
+    void* const previous = *p;
+
+    if (previous == comparand)
+    {
+        *p = value;
+    }
+
+    return previous;
+#endif /* __GNUC__ */
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
@@ -79,6 +79,44 @@ RECLS_FNDECL(rc_atomic_t) RC_ReadValue(rc_atomic_t volatile *p)
 #endif /* RECLS_MT */
 }
 
+RECLS_FNDECL(void) RC_WriteValue(rc_atomic_t volatile *p, int value)
+{
+#if defined(RECLS_MT)
+    winstl::atomic_write(static_cast<winstl::atomic_int_t volatile*>(static_cast<void volatile*>(p)), value);
+#else /* ? RECLS_MT */
+    *p = value;
+#endif /* RECLS_MT */
+}
+
+RECLS_FNDECL(void*) RC_ExchangePointer(void* volatile* p, void* value)
+{
+#if defined(RECLS_MT)
+    return ::InterlockedExchangePointer(p, value);
+#else /* ? RECLS_MT */
+    void* const previous = *p;
+
+    *p = value;
+
+    return previous;
+#endif /* RECLS_MT */
+}
+
+RECLS_FNDECL(void*) RC_CompareExchangePointer(void* volatile* p, void* value, void* comparand)
+{
+#if defined(RECLS_MT)
+    return ::InterlockedCompareExchangePointer(p, value, comparand);
+#else /* ? RECLS_MT */
+    void* const previous = *p;
+
+    if (previous == comparand)
+    {
+        *p = value;
+    }
+
+    return previous;
+#endif /* RECLS_MT */
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * namespace
  */
@@ -0,0 +1,484 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.mkdir.linux.cpp
+ *
+ * Purpose: Creation of directories, with a minimum of system calls, for
+ *          Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+#include "impl.mkdir.linux.hpp"
+
+#include "impl.trace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * compatibility
+ */
+
+#ifndef O_PATH
+# define O_PATH                                             O_RDONLY
+#endif /* !O_PATH */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * constants
+ */
+
+namespace
+{
+
+    /// The mode with which directories are created, which is subject to
+    /// the process' umask
+    static mode_t const MKDIR_MODE_     =   S_IRWXU | S_IRWXG | S_IRWXO;
+
+    /// The flags with which (existing) directories are opened, for use
+    /// only as the base of mkdirat() and fstatat()
+    static int const    MKDIR_O_FLAGS_  =   O_PATH | O_DIRECTORY | O_CLOEXEC;
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* The length of the directory path[0, len) without any trailing
+     * separators, as is reported as the existing length by the portable
+     * implementation: 1 for the root
+     */
+    size_t
+    mkdir_existing_length_(
+        char const* path
+    ,   size_t      len
+    )
+    {
+        for (; len > 1 && '/' == path[len - 1]; --len)
+        {}
+
+        return (0 != len) ? len : 1;
+    }
+
+    recls_rc_t
+    mkdir_rc_from_errno_(
+        int e
+    )
+    {
+        switch (e)
+        {
+            case 0:
+                return RECLS_RC_OK;
+            case ENOMEM:
+                return RECLS_RC_OUT_OF_MEMORY;
+            case ENOTDIR:
+            case EEXIST:
+                return RECLS_RC_ENTRY_IS_NOT_DIRECTORY;
+            case EACCES:
+            case EPERM:
+            case EROFS:
+                return RECLS_RC_ACCESS_DENIED;
+            case ENAMETOOLONG:
+                return RECLS_RC_PATH_LIMIT_EXCEEDED;
+            default:
+                return RECLS_RC_FAIL;
+        }
+    }
+
+    /* Verifies that the entry \c name, relative to \c dirFd, which has been
+     * found to exist, is a directory (or a link to one).
+     */
+    recls_rc_t
+    mkdir_verify_directory_(
+        int         dirFd
+    ,   char const* name
+    )
+    {
+        struct stat st;
+
+        if (0 != ::fstatat(dirFd, name, &st, 0))
+        {
+            return mkdir_rc_from_errno_(errno);
+        }
+
+        return S_ISDIR(st.st_mode) ? RECLS_RC_OK : RECLS_RC_ENTRY_IS_NOT_DIRECTORY;
+    }
+
+    /* Creates the directory \c name, relative to \c dirFd, succeeding if
+     * it already exists (such as if created concurrently by another
+     * process) as a directory.
+     *
+     * \c *numCreated is incremented if the directory is created.
+     */
+    recls_rc_t
+    mkdir_make_directory_(
+        int         dirFd
+    ,   char const* name
+    ,   unsigned*   numCreated
+    )
+    {
+        if (0 == ::mkdirat(dirFd, name, MKDIR_MODE_))
+        {
+            ++*numCreated;
+
+            return RECLS_RC_OK;
+        }
+
+        int const e = errno;
+
+        if (EEXIST == e)
+        {
+            return mkdir_verify_directory_(dirFd, name);
+        }
+
+        recls_error_trace_printf_(RECLS_LITERAL("mkdirat(%d, %s) failed: %d"), dirFd, name, e);
+
+        return mkdir_rc_from_errno_(e);
+    }
+
+    /// Closes a descriptor, if open, on scope exit
+    struct mkdir_fd_closer_
+    {
+        int fd;
+
+    public:
+        explicit
+        mkdir_fd_closer_(int fd)
+            : fd(fd)
+        {}
+        ~mkdir_fd_closer_() STLSOFT_NOEXCEPT
+        {
+            if (-1 != fd)
+            {
+                ::close(fd);
+            }
+        }
+
+    private:
+        mkdir_fd_closer_(mkdir_fd_closer_ const&);
+        void operator =(mkdir_fd_closer_ const&);
+    };
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * mkdir_creator
+ */
+
+mkdir_creator::mkdir_creator(
+    bool shareParents
+)
+    : m_shareParents(shareParents)
+    , m_parentFd(-1)
+    , m_parent()
+{}
+
+mkdir_creator::~mkdir_creator() STLSOFT_NOEXCEPT
+{
+    release_parent_();
+}
+
+recls_rc_t
+mkdir_creator::create(
+    recls_char_t const*         path
+,   size_t                      pathLen
+,   recls_directoryResults_t*   results
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != path);
+    RECLS_ASSERT(0 != pathLen);
+    RECLS_ASSERT('/' == 0[path]);
+    RECLS_ASSERT(ss_nullptr_k != results);
+
+    // Trailing separators do not delimit an element, so the leaf is the
+    // last element before them (if any)
+
+    size_t end = pathLen;
+
+    for (; end > 1 && '/' == path[end - 1]; --end)
+    {}
+
+    size_t leaf = end;
+
+    for (; leaf > 0 && '/' != path[leaf - 1]; --leaf)
+    {}
+
+    // If the leaf lies within the retained parent, it is resolved relative
+    // to that
+
+    int     baseFd  =   AT_FDCWD;
+    size_t  baseLen =   0;
+
+    if (-1 != m_parentFd &&
+        leaf != end &&
+        m_parent.size() < leaf &&
+        '/' == path[m_parent.size()] &&
+        0 == m_parent.compare(0, m_parent.size(), path, m_parent.size()))
+    {
+        baseFd  =   m_parentFd;
+        baseLen =   m_parent.size() + 1;
+
+        for (; '/' == path[baseLen]; ++baseLen)
+        {}
+    }
+
+    recls_rc_t rc;
+
+    if (0 == ::mkdirat(baseFd, path + baseLen, MKDIR_MODE_))
+    {
+        results->existingLength     =   mkdir_existing_length_(path, leaf);
+        results->resultingLength    =   pathLen;
+        ++results->numResultingElements;
+
+        rc = RECLS_RC_OK;
+    }
+    else
+    {
+        int const e = errno;
+
+        switch (e)
+        {
+            case EEXIST:
+                rc = mkdir_verify_directory_(baseFd, path + baseLen);
+                if (RECLS_RC_OK == rc)
+                {
+                    results->existingLength     =   pathLen;
+                    results->resultingLength    =   pathLen;
+                }
+                break;
+            case ENOENT:
+                // An intermediate directory is missing
+                rc = create_missing_(path, pathLen, baseFd, baseLen, results);
+                break;
+            default:
+                recls_error_trace_printf_(RECLS_LITERAL("mkdir(%.*s) failed: %d"), int(pathLen), path, e);
+
+                rc = mkdir_rc_from_errno_(e);
+                break;
+        }
+    }
+
+    if (RECLS_RC_OK == rc &&
+        m_shareParents &&
+        leaf != end)
+    {
+        retain_parent_(path, leaf, baseFd, baseLen);
+    }
+
+    return rc;
+}
+
+recls_rc_t
+mkdir_creator::create_missing_(
+    recls_char_t const*         path
+,   size_t                      pathLen
+,   int                         baseFd
+,   size_t                      baseLen
+,   recls_directoryResults_t*   results
+)
+{
+    // A copy of the path is made, so that each of its ancestors may be
+    // nul-terminated in place
+
+    string_type_    buff(path, pathLen);
+    char* const     p       =   &buff[0];
+    size_t          end     =   pathLen;
+
+    for (; end > 1 && '/' == p[end - 1]; --end)
+    {}
+
+    // 1. Probe the ancestors, from the parent upwards, for the deepest that
+    //    exists (and which must be a directory). If none below the base
+    //    does, the base is it.
+
+    int     dirFd   =   baseFd;
+    size_t  dirLen  =   baseLen;
+    size_t  pos     =   end;
+
+    for (; pos > 0 && '/' != p[pos - 1]; --pos)
+    {}
+
+    for (;;)
+    {
+        size_t e = pos;
+
+        for (; e > baseLen && '/' == p[e - 1]; --e)
+        {}
+
+        if (e <= baseLen)
+        {
+            break;
+        }
+
+        char const c = p[e];
+
+        p[e] = '\0';
+
+        int const fd = ::openat(baseFd, p + baseLen, MKDIR_O_FLAGS_);
+
+        p[e] = c;
+
+        if (-1 != fd)
+        {
+            dirFd   =   fd;
+            dirLen  =   e + 1;
+
+            break;
+        }
+        else
+        {
+            int const err = errno;
+
+            if (ENOENT != err)
+            {
+                recls_error_trace_printf_(RECLS_LITERAL("open(%.*s) failed: %d"), int(e), p, err);
+
+                return mkdir_rc_from_errno_(err);
+            }
+        }
+
+        for (pos = e; pos > baseLen && '/' != p[pos - 1]; --pos)
+        {}
+    }
+
+    mkdir_fd_closer_ closer((dirFd != baseFd) ? dirFd : -1);
+
+    for (; '/' == p[dirLen]; ++dirLen)
+    {}
+
+    results->existingLength = mkdir_existing_length_(p, dirLen);
+
+    // 2. Create the missing directories, downwards, relative to the deepest
+    //    existing one
+
+    unsigned    numCreated  =   0;
+    recls_rc_t  rc          =   RECLS_RC_OK;
+
+    for (pos = dirLen; RECLS_RC_OK == rc && pos < end; )
+    {
+        // If the deepest existing directory is the root, and there is no
+        // base, its elements are absolute
+
+        size_t e = (0 == pos) ? 1 : pos;
+
+        for (; e < end && '/' != p[e]; ++e)
+        {}
+
+        char const c = p[e];
+
+        p[e] = '\0';
+
+        rc = mkdir_make_directory_(dirFd, p + dirLen, &numCreated);
+
+        p[e] = c;
+
+        for (pos = e; pos < end && '/' == p[pos]; ++pos)
+        {}
+    }
+
+    results->numResultingElements += numCreated;
+
+    if (RECLS_RC_OK == rc)
+    {
+        results->resultingLength = pathLen;
+    }
+
+    return rc;
+}
+
+void
+mkdir_creator::retain_parent_(
+    recls_char_t const* path
+,   size_t              pathLen
+,   int                 baseFd
+,   size_t              baseLen
+)
+{
+    size_t len = pathLen;
+
+    for (; len > 0 && '/' == path[len - 1]; --len)
+    {}
+
+    if (-1 != m_parentFd &&
+        0 == m_parent.compare(0, m_parent.size(), path, len))
+    {
+        return;
+    }
+
+    // The parent lies below the base, since otherwise it is the base, and
+    // so retained already, unless it is the root
+
+    string_type_        parent(path, len);
+    char const* const   name    =   parent.empty() ? "/" : parent.c_str() + baseLen;
+    int const           fd      =   ::openat(parent.empty() ? AT_FDCWD : baseFd, name, MKDIR_O_FLAGS_);
+
+    release_parent_();
+
+    if (-1 != fd)
+    {
+        m_parentFd = fd;
+        m_parent.swap(parent);
+    }
+}
+
+void
+mkdir_creator::release_parent_() STLSOFT_NOEXCEPT
+{
+    if (-1 != m_parentFd)
+    {
+        ::close(m_parentFd);
+
+        m_parentFd = -1;
+    }
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
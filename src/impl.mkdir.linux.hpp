@@ -0,0 +1,164 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.mkdir.linux.hpp
+ *
+ * Purpose: Creation of directories, with a minimum of system calls, for
+ *          Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_MKDIR_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_MKDIR_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include "impl.allocator.hpp"
+
+#include <string>
+
+#include <stddef.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class mkdir_creator
+/// Creates directories, along with any missing intermediate directories
+///
+/// The directory is first created directly, by a single mkdir(). Only if
+/// that fails because an intermediate directory is missing are the
+/// directory's ancestors probed, from the deepest upwards, for the deepest
+/// that exists, which is opened and the missing directories created,
+/// downwards, by mkdirat() relative to it.
+///
+/// When parents are to be shared, the parent of each directory created is
+/// retained, open, so that the creation of subsequent directories within
+/// it (such as its siblings) need resolve only their names relative to it.
+class mkdir_creator
+{
+public:
+    typedef mkdir_creator                                   class_type;
+
+public: // construction
+    /// Constructs an instance
+    ///
+    /// \param shareParents Whether the parent of each directory created is
+    ///   retained for the creation of subsequent directories
+    explicit
+    mkdir_creator(
+        bool shareParents
+    );
+    ~mkdir_creator() STLSOFT_NOEXCEPT;
+private:
+    mkdir_creator(class_type const&);       // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Creates the directory \c path, and any missing intermediate
+    /// directories
+    ///
+    /// \param path The absolute path of the directory
+    /// \param pathLen The length of \c path
+    /// \param results The results, whose \c existingLength (the length
+    ///   of the deepest existing directory, without a trailing separator)
+    ///   and \c resultingLength members are set, and whose
+    ///   \c numResultingElements member is incremented by the number of
+    ///   directories created
+    ///
+    /// \retval RECLS_RC_OK The directory was created, or already existed
+    /// \retval RECLS_RC_ENTRY_IS_NOT_DIRECTORY The path, or one of its
+    ///   ancestors, exists but is not a directory
+    /// \retval Any other status code indicates an error
+    ///
+    /// \note If the creation fails, those directories already created are
+    ///   not removed
+    recls_rc_t
+    create(
+        recls_char_t const*         path
+    ,   size_t                      pathLen
+    ,   recls_directoryResults_t*   results
+    );
+
+private: // implementation
+    typedef std::basic_string<
+        recls_char_t
+    ,   std::char_traits<recls_char_t>
+    ,   stl_allocator<recls_char_t>
+    >                                                       string_type_;
+
+    recls_rc_t
+    create_missing_(
+        recls_char_t const*         path
+    ,   size_t                      pathLen
+    ,   int                         baseFd
+    ,   size_t                      baseLen
+    ,   recls_directoryResults_t*   results
+    );
+
+    void
+    retain_parent_(
+        recls_char_t const* path
+    ,   size_t              pathLen
+    ,   int                 baseFd
+    ,   size_t              baseLen
+    );
+
+    void
+    release_parent_() STLSOFT_NOEXCEPT;
+
+private: // fields
+    bool const  m_shareParents;
+    /// The descriptor of the retained parent directory, or -1
+    int         m_parentFd;
+    /// The path of the retained parent directory, without a trailing
+    /// separator (and so empty for the root directory)
+    string_type_ m_parent;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_MKDIR_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
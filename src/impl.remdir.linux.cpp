@@ -0,0 +1,411 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.remdir.linux.cpp
+ *
+ * Purpose: Single-pass, post-order removal of directory trees, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+
+#include "impl.dirscan.linux.hpp"
+#include "impl.dirwalk.linux.hpp"
+#include "impl.remdir.linux.hpp"
+
+#include "impl.trace.h"
+
+#include <errno.h>
+#include <fcntl.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Removes the entry \c name from the directory \c dirFd, by unlinkat().
+     * If that is denied, and RECLS_REMDIR_F_REMOVE_READONLY is specified,
+     * the directory is made writable - since on UNIX it is the directory,
+     * rather than the entry, whose permissions govern removal - and the
+     * removal retried.
+     *
+     * Returns 0, or the errno value describing the failure.
+     */
+    int
+    remdir_unlink_(
+        int         dirFd
+    ,   char const* name
+    ,   int         atFlags
+    ,   int         flags
+    )
+    {
+        if (0 == ::unlinkat(dirFd, name, atFlags))
+        {
+            return 0;
+        }
+
+        int e = errno;
+
+        if ((   EACCES == e ||
+                EPERM == e) &&
+            0 != (RECLS_REMDIR_F_REMOVE_READONLY & flags) &&
+            AT_FDCWD != dirFd)
+        {
+            struct stat st;
+
+            if (0 == ::fstat(dirFd, &st) &&
+                S_IRWXU != (S_IRWXU & st.st_mode) &&
+                0 == ::fchmod(dirFd, st.st_mode | S_IRWXU))
+            {
+                if (0 == ::unlinkat(dirFd, name, atFlags))
+                {
+                    return 0;
+                }
+
+                e = errno;
+            }
+        }
+
+        return e;
+    }
+
+    /* Indicates whether a directory that could not be removed, because it
+     * is not empty, should be read again. That is the case only if entries
+     * were removed while it was being read, and none were kept, since a
+     * directory whose entries are removed while it is being read may (if
+     * rarely) not present all of its entries
+     */
+    inline
+    bool
+    remdir_should_reread_(
+        int         e
+    ,   unsigned    numRemoved
+    ,   unsigned    numKept
+    )
+    {
+        return  (   ENOTEMPTY == e ||
+                    EEXIST == e) &&
+                0 != numRemoved &&
+                0 == numKept;
+    }
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+namespace
+{
+
+// class remdir_visitor_
+/// Removes the entries of each directory visited by the walker: its files
+/// as it is read, and the directory itself once its sub-directories have
+/// been removed
+class remdir_visitor_
+{
+public:
+    typedef remdir_visitor_                                 class_type;
+
+    /// The state of each directory
+    struct directory_type
+    {
+        unsigned    numRemoved; // In the current read; incremented atomically by sub-directories
+        unsigned    numKept;
+
+        directory_type()
+            : numRemoved(0)
+            , numKept(0)
+        {}
+    };
+
+    /// The state of each worker
+    struct worker_type
+    {
+        unsigned    numDeletedFiles;
+        unsigned    maxDepth;
+        size_t      maxRelativeLength;
+
+        worker_type()
+            : numDeletedFiles(0)
+            , maxDepth(0)
+            , maxRelativeLength(0)
+        {}
+    };
+
+public: // construction
+    remdir_visitor_(
+        int                 flags
+    ,   remdir_results_t*   results
+    )
+        : m_flags(flags)
+        , m_results(results)
+    {}
+private:
+    remdir_visitor_(class_type const&);     // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // visitor
+    recls_uint32_t
+    open_flags() const
+    {
+        // Links are removed, rather than followed
+        return RECLS_F_NO_FOLLOW_LINKS;
+    }
+
+    bool
+    requires_path() const
+    {
+        return false;
+    }
+
+    /* Reads the directory open in \c reader, removing each entry that is
+     * not a directory (if RECLS_REMDIR_F_REMOVE_FILES is specified) as it
+     * is read, and recording the names of those that are
+     */
+    recls_rc_t
+    read(
+        dirscan_reader&     reader
+    ,   dirwalk_names_t&    names
+    ,   dirwalk_items_t&    items
+    ,   directory_type&     directory
+    ,   worker_type&        worker
+    )
+    {
+        names.clear();
+        items.clear();
+
+        dirscan_entry_t de;
+        int             r;
+
+        for (; 1 == (r = reader.read(&de)); )
+        {
+            unsigned char type;
+
+            if (dirscan_is_directory(reader.get_fd(), de, RECLS_F_NO_FOLLOW_LINKS, &type))
+            {
+                dirwalk_item_t item;
+
+                item.nameOffset =   names.size();
+                item.nameLen    =   de.nameLen;
+
+                names.insert(names.end(), de.name, de.name + (1 + de.nameLen));
+                items.push_back(item);
+            }
+            else if (0 == (RECLS_REMDIR_F_REMOVE_FILES & m_flags))
+            {
+                ++directory.numKept;
+            }
+            else
+            {
+                int const e = remdir_unlink_(reader.get_fd(), de.name, 0, m_flags);
+
+                if (0 == e)
+                {
+                    ++directory.numRemoved;
+                    ++worker.numDeletedFiles;
+                }
+                else if (ENOENT != e)
+                {
+                    recls_debug1_trace_printf_(RECLS_LITERAL("could not remove '%s': %d"), de.name, e);
+
+                    return RECLS_RC_ACCESS_DENIED;
+                }
+            }
+        }
+
+        if (r < 0)
+        {
+            return dirscan_rc_from_errno(errno);
+        }
+
+        return RECLS_RC_OK;
+    }
+
+    bool
+    is_skippable(
+        recls_rc_t rc
+    ) const
+    {
+        // The sub-directory has been removed since its parent was read
+        return RECLS_RC_DIRECTORY_NOT_FOUND == rc;
+    }
+
+    /* Removes the (emptied) directory, unless it instead is to be read
+     * again
+     */
+    recls_rc_t
+    leave(
+        dirwalk_directory_t<directory_type> const&  dir
+    ,   worker_type&                                worker
+    ,   bool*                                       reread
+    )
+    {
+        bool const isRoot = ss_nullptr_k == dir.parentData;
+
+        if (!isRoot &&
+            0 != (RECLS_REMDIR_F_NO_REMOVE_SUBDIRS & m_flags))
+        {
+            return RECLS_RC_OK;
+        }
+
+        int const e = remdir_unlink_(dir.parentFd, dir.name, AT_REMOVEDIR, m_flags);
+
+        if (0 == e)
+        {
+            if (!isRoot)
+            {
+                if (dir.concurrent)
+                {
+                    __atomic_add_fetch(&dir.parentData->numRemoved, 1u, __ATOMIC_RELAXED);
+                }
+                else
+                {
+                    ++dir.parentData->numRemoved;
+                }
+
+                if (worker.maxDepth < dir.depth)
+                {
+                    worker.maxDepth = static_cast<unsigned>(dir.depth);
+                }
+                if (worker.maxRelativeLength < dir.relLen)
+                {
+                    worker.maxRelativeLength = dir.relLen;
+                }
+            }
+        }
+        else if (remdir_should_reread_(e, dir.data->numRemoved, dir.data->numKept))
+        {
+            recls_debug2_trace_printf_(RECLS_LITERAL("reading directory '%s' again, since it is not empty"), dir.name);
+
+            *reread = true;
+        }
+        else if (ENOENT != e)
+        {
+            recls_debug1_trace_printf_(RECLS_LITERAL("could not remove directory '%s': %d"), dir.name, e);
+
+            return RECLS_RC_ACCESS_DENIED;
+        }
+
+        return RECLS_RC_OK;
+    }
+
+    void
+    collect(
+        worker_type const& worker
+    )
+    {
+        m_results->numDeletedFiles += worker.numDeletedFiles;
+
+        if (m_results->maxDepth < worker.maxDepth)
+        {
+            m_results->maxDepth = worker.maxDepth;
+        }
+        if (m_results->maxRelativeLength < worker.maxRelativeLength)
+        {
+            m_results->maxRelativeLength = worker.maxRelativeLength;
+        }
+    }
+
+private: // fields
+    int const                   m_flags;
+    remdir_results_t* const     m_results;
+};
+
+} /* anonymous namespace */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+recls_rc_t
+remdir_remove_tree(
+    recls_char_t const* path
+,   int                 flags
+,   remdir_results_t*   results
+)
+{
+    function_scope_trace("remdir_remove_tree");
+
+    RECLS_ASSERT(ss_nullptr_k != path);
+    RECLS_ASSERT(ss_nullptr_k != results);
+
+    results->numDeletedFiles    =   0;
+    results->maxDepth           =   0;
+    results->maxRelativeLength  =   0;
+
+    if (RECLS_REMDIR_F_NO_REMOVE_SUBDIRS == ((RECLS_REMDIR_F_NO_REMOVE_SUBDIRS | RECLS_REMDIR_F_REMOVE_FILES) & flags))
+    {
+        // Nothing within the directory is to be removed, so it need not be
+        // read
+
+        return (0 == ::rmdir(path)) ? RECLS_RC_OK : RECLS_RC_ACCESS_DENIED;
+    }
+
+    remdir_visitor_ visitor(flags, results);
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    if (0 != (RECLS_REMDIR_F_PARALLEL & flags))
+    {
+        size_t const numThreads = work_pool::default_thread_count();
+
+        recls_debug1_trace_printf_(RECLS_LITERAL("parallel removal of '%s' on %u threads"), path, unsigned(numThreads));
+
+        dirwalk_parallel_walker<remdir_visitor_> walker(path, visitor);
+
+        return walker.walk(numThreads);
+    }
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    dirwalk_walker<remdir_visitor_> walker(path, visitor);
+
+    return walker.walk();
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,114 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.remdir.linux.hpp
+ *
+ * Purpose: Single-pass, post-order removal of directory trees, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_REMDIR_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_REMDIR_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This file can only be included when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include <stddef.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+/** Describes what was removed by remdir_remove_tree() */
+struct remdir_results_t
+{
+    /** The number of files (and other non-directories) removed */
+    unsigned    numDeletedFiles;
+    /** The depth, below the removed directory, of the deepest sub-directory
+     * removed, or 0 if none were removed */
+    unsigned    maxDepth;
+    /** The length of the path, relative to the removed directory, of the
+     * longest sub-directory removed */
+    size_t      maxRelativeLength;
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+/** Removes the directory \c path, along with its contents, in a single
+ * post-order traversal
+ *
+ * Each directory is read once, via getdents64(), its files being removed
+ * (when RECLS_REMDIR_F_REMOVE_FILES is specified) as they are read, and
+ * is removed once its sub-directories have been. Entries are removed, and
+ * sub-directories opened, relative to the descriptor of their directory,
+ * so no paths are formed. Symbolic links are removed, not followed.
+ *
+ * \param path The absolute path of the directory
+ * \param flags A combination of RECLS_REMDIR_FLAG values. When
+ *   RECLS_REMDIR_F_PARALLEL is specified, and parallel searches are
+ *   supported, independent sub-trees are removed on a pool of threads
+ * \param results Receives the description of what was removed
+ *
+ * \retval RECLS_RC_OK The directory was removed
+ * \retval RECLS_RC_ACCESS_DENIED An entry could not be removed, including
+ *   because a directory is not empty, such as when its files are not to
+ *   be removed
+ * \retval Any other status code indicates an error
+ *
+ * \note If the removal fails, those entries already removed are not
+ *   restored, and the contents of \c *results are unspecified
+ */
+recls_rc_t
+remdir_remove_tree(
+    recls_char_t const* path
+,   int                 flags
+,   remdir_results_t*   results
+);
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_REMDIR_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
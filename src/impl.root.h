@@ -4,11 +4,11 @@
  * Purpose: Implementation root header.
  *
  * Created: 7th March 2005
- * Updated: 30th December 2023
+ * Updated: 17th October 2026
  *
  * Home:    https://github.com/synesissoftware/recls
  *
- * Copyright (c) 2019-2023, Matthew Wilson and Synesis Information Systems
+ * Copyright (c) 2019-2026, Matthew Wilson and Synesis Information Systems
  * Copyright (c) 2005-2019, Matthew Wilson and Synesis Software
  * All rights reserved.
  *
@@ -112,6 +112,21 @@
 # define RECLS_ENFORCING_CONTRACTS
 #endif /* RECLS_DEBUG || RECLS_ENFORCE_CONTRACTS */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * entry block counting
+ */
+
+/** \def RECLS_COUNTING_ENTRY_BLOCKS If defined, it indicates that the
+ * numbers of created and shared entry blocks are counted, for diagnostic
+ * purposes. Since the counts are process-wide, they are not maintained in
+ * release builds unless RECLS_COUNT_ENTRY_BLOCKS is defined
+ */
+
+#if defined(RECLS_DEBUG) || \
+    defined(RECLS_COUNT_ENTRY_BLOCKS)
+# define RECLS_COUNTING_ENTRY_BLOCKS
+#endif /* RECLS_DEBUG || RECLS_COUNT_ENTRY_BLOCKS */
+
 /* /////////////////////////////////////////////////////////////////////////
  * multithreading
  */
@@ -149,6 +164,64 @@
 # define RECLS_SUPPORTS_MULTIPATTERN_
 #endif /* compiler */
 
+/* /////////////////////////////////////////////////////////////////////////
+ * Single-pass traversal
+ */
+
+/** \def RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ If defined, file-system
+ * searches read each directory exactly once, via getdents64(), rather than
+ * once via glob() and again via readdir(). Only available on Linux, and
+ * may be suppressed by defining RECLS_NO_SINGLE_PASS_TRAVERSAL.
+ */
+
+#if 1 && \
+    defined(RECLS_PLATFORM_IS_UNIX) && \
+    !defined(RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS) && \
+    defined(__linux__) && \
+    !defined(RECLS_NO_SINGLE_PASS_TRAVERSAL) && \
+    1
+
+# define RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+#endif /* OS */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Parallel search
+ */
+
+/** \def RECLS_SUPPORTS_PARALLEL_SEARCH_ If defined, Recls_SearchParallel()
+ * and Recls_SearchProcessParallel() traverse the directory tree on a pool
+ * of threads. Requires a multithreaded build and the single-pass
+ * traversal, and may be suppressed by defining RECLS_NO_PARALLEL_SEARCH;
+ * otherwise the functions perform a (single-threaded) search.
+ */
+
+#if 1 && \
+    defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_) && \
+    defined(RECLS_MT) && \
+    !defined(RECLS_NO_PARALLEL_SEARCH) && \
+    1
+
+# define RECLS_SUPPORTS_PARALLEL_SEARCH_
+#endif /* OS */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * File times
+ */
+
+/** \def RECLS_STAT_HAS_NANOSECOND_TIMES_ If defined, struct stat provides
+ * the (POSIX.1-2008) st_atim, st_mtim, and st_ctim members, from which the
+ * nanosecond parts of the entry times are obtained.
+ */
+
+#if 1 && \
+    defined(RECLS_PLATFORM_IS_UNIX) && \
+    !defined(RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS) && \
+    defined(__linux__) && \
+    1
+
+# define RECLS_STAT_HAS_NANOSECOND_TIMES_
+#endif /* OS */
+
 /* /////////////////////////////////////////////////////////////////////////
  * inclusion control
  */
@@ -0,0 +1,165 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.statx.linux.cpp
+ *
+ * Purpose: Flag-directed statx() metadata retrieval, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+#include "impl.statx.linux.hpp"
+
+#ifdef RECLS_USE_STATX_
+
+#include "impl.trace.h"
+
+#include <errno.h>
+#include <string.h>
+#include <sys/sysmacros.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+unsigned int
+statx_mask_from_flags(
+    recls_uint32_t flags
+)
+{
+    unsigned int mask = STATX_TYPE | STATX_MODE;
+
+    if (0 == (RECLS_F_DETAILS_LATER & flags))
+    {
+        mask |= STATX_SIZE | STATX_ATIME | STATX_MTIME | STATX_CTIME;
+    }
+    if (0 != (RECLS_F_LINK_COUNT & flags))
+    {
+        mask |= STATX_NLINK;
+    }
+    if (0 != (RECLS_F_NODE_INDEX & flags))
+    {
+        mask |= STATX_INO;
+    }
+
+    return mask;
+}
+
+int
+statx_stat(
+    int                 dirFd
+,   recls_char_t const* path
+,   int                 atFlags
+,   recls_uint32_t      flags
+,   struct stat*        st
+)
+{
+    return statx_stat_mask(dirFd, path, atFlags, statx_mask_from_flags(flags), st);
+}
+
+int
+statx_stat_mask(
+    int                 dirFd
+,   recls_char_t const* path
+,   int                 atFlags
+,   unsigned int        mask
+,   struct stat*        st
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != path);
+    RECLS_ASSERT(0 == (atFlags & ~AT_SYMLINK_NOFOLLOW));
+    RECLS_ASSERT(ss_nullptr_k != st);
+
+    struct statx    stx;
+
+    if (0 != ::statx(dirFd, path, atFlags | AT_STATX_DONT_SYNC, mask, &stx))
+    {
+        recls_debug2_trace_printf_(RECLS_LITERAL("statx() failed on '%s': %d"), path, errno);
+
+        return -1;
+    }
+
+    // Only those fields that were both requested and provided are used
+    mask &= stx.stx_mask;
+
+    ::memset(st, 0, sizeof(*st));
+
+    st->st_mode     =   static_cast<mode_t>(stx.stx_mode);
+    st->st_dev      =   makedev(stx.stx_dev_major, stx.stx_dev_minor);
+
+    if (0 != (STATX_NLINK & mask))
+    {
+        st->st_nlink    =   static_cast<nlink_t>(stx.stx_nlink);
+    }
+    if (0 != (STATX_INO & mask))
+    {
+        st->st_ino      =   static_cast<ino_t>(stx.stx_ino);
+    }
+    if (0 != (STATX_SIZE & mask))
+    {
+        st->st_size     =   static_cast<off_t>(stx.stx_size);
+    }
+    if (0 != (STATX_BLOCKS & mask))
+    {
+        st->st_blocks   =   static_cast<blkcnt_t>(stx.stx_blocks);
+    }
+    if (0 != (STATX_ATIME & mask))
+    {
+        st->st_atim.tv_sec  =   static_cast<time_t>(stx.stx_atime.tv_sec);
+        st->st_atim.tv_nsec =   static_cast<long>(stx.stx_atime.tv_nsec);
+    }
+    if (0 != (STATX_MTIME & mask))
+    {
+        st->st_mtim.tv_sec  =   static_cast<time_t>(stx.stx_mtime.tv_sec);
+        st->st_mtim.tv_nsec =   static_cast<long>(stx.stx_mtime.tv_nsec);
+    }
+    if (0 != (STATX_CTIME & mask))
+    {
+        st->st_ctim.tv_sec  =   static_cast<time_t>(stx.stx_ctime.tv_sec);
+        st->st_ctim.tv_nsec =   static_cast<long>(stx.stx_ctime.tv_nsec);
+    }
+
+    return 0;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_USE_STATX_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,140 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.statx.linux.hpp
+ *
+ * Purpose: Flag-directed statx() metadata retrieval, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_STATX_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_STATX_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#include <fcntl.h>
+#include <sys/stat.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * compatibility
+ */
+
+/** \def RECLS_USE_STATX_ If defined, entry metadata is obtained via
+ * statx(), requesting only those fields implied by the search flags. This
+ * requires Linux and GLIBC 2.28 or later, and may be suppressed by
+ * defining RECLS_NO_STATX.
+ */
+
+#if 1 && \
+    defined(RECLS_PLATFORM_IS_UNIX) && \
+    !defined(RECLS_PLATFORM_IS_UNIX_EMULATED_ON_WINDOWS) && \
+    defined(__linux__) && \
+    defined(STATX_BASIC_STATS) && \
+    !defined(RECLS_NO_STATX) && \
+    1
+
+# define RECLS_USE_STATX_
+#endif /* OS */
+
+#ifdef RECLS_USE_STATX_
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * functions
+ */
+
+/** Derives the statx() field mask from the given recls flags
+ *
+ * The type and mode are always requested. The size and times are
+ * requested unless RECLS_F_DETAILS_LATER is specified; the link count and
+ * node index only if RECLS_F_LINK_COUNT and RECLS_F_NODE_INDEX,
+ * respectively, are specified.
+ */
+unsigned int
+statx_mask_from_flags(
+    recls_uint32_t flags
+);
+
+/** Obtains the metadata of an entry, via statx(), into a struct stat
+ *
+ * \param dirFd The descriptor of the directory in which \c path is to be
+ *   resolved, or AT_FDCWD
+ * \param path The name, or path, of the entry
+ * \param atFlags Either 0 or AT_SYMLINK_NOFOLLOW
+ * \param flags The recls flags, from which the field mask is derived
+ * \param st The instance to receive the metadata. Members corresponding
+ *   to fields not requested, or not provided by the file-system, are 0
+ *
+ * \retval 0 The metadata was obtained
+ * \retval -1 The metadata could not be obtained, and errno indicates the
+ *   reason
+ *
+ * \note The call does not force synchronisation with a remote file-system
+ *   (AT_STATX_DONT_SYNC)
+ */
+int
+statx_stat(
+    int                 dirFd
+,   recls_char_t const* path
+,   int                 atFlags
+,   recls_uint32_t      flags
+,   struct stat*        st
+);
+
+/** Obtains the metadata of an entry, via statx(), into a struct stat, as
+ * statx_stat(), but with the field mask specified explicitly
+ *
+ * \param mask The statx() field mask, which may include STATX_BLOCKS
+ */
+int
+statx_stat_mask(
+    int                 dirFd
+,   recls_char_t const* path
+,   int                 atFlags
+,   unsigned int        mask
+,   struct stat*        st
+);
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_USE_STATX_ */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_STATX_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
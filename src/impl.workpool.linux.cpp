@@ -0,0 +1,358 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.workpool.linux.cpp
+ *
+ * Purpose: Work-stealing thread pool, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include <recls/assert.h>
+#include "impl.root.h"
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+#include "impl.workpool.linux.hpp"
+
+#include "impl.trace.h"
+
+#include <errno.h>
+#include <unistd.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+struct work_pool::worker_type
+    : public allocated_object
+{
+    typedef std::deque<task*, stl_allocator<task*> >        tasks_type;
+
+    work_pool*      pool;
+    size_t          index;
+    pthread_t       thread;
+    pthread_mutex_t mx;
+    tasks_type      tasks;
+
+    worker_type(
+        work_pool*  pool
+    ,   size_t      index
+    )
+        : pool(pool)
+        , index(index)
+        , thread()
+        , tasks()
+    {
+        ::pthread_mutex_init(&mx, ss_nullptr_k);
+    }
+    ~worker_type() STLSOFT_NOEXCEPT
+    {
+        ::pthread_mutex_destroy(&mx);
+    }
+private:
+    worker_type(worker_type const&);        // copy-construction proscribed
+    void operator =(worker_type const&);    // copy-assignment proscribed
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * work_pool
+ */
+
+work_pool::work_pool()
+    : m_workers()
+    , m_queued(0)
+    , m_sleepers(0)
+    , m_stopping(0)
+    , m_nextExternal(0)
+{
+    ::pthread_mutex_init(&m_mx, ss_nullptr_k);
+    ::pthread_cond_init(&m_cv, ss_nullptr_k);
+}
+
+work_pool::~work_pool() STLSOFT_NOEXCEPT
+{
+    function_scope_trace("work_pool::~work_pool");
+
+    stop();
+    join();
+
+    ::pthread_cond_destroy(&m_cv);
+    ::pthread_mutex_destroy(&m_mx);
+}
+
+int
+work_pool::start(
+    size_t numThreads
+)
+{
+    function_scope_trace("work_pool::start");
+
+    RECLS_ASSERT(0 != numThreads);
+    RECLS_ASSERT(m_workers.empty());
+
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        // All workers must exist before any starts, since each may steal
+        // from any other
+        m_workers.reserve(numThreads);
+
+        for (size_t i = 0; i != numThreads; ++i)
+        {
+            m_workers.push_back(new worker_type(this, i));
+        }
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(std::bad_alloc&)
+    {
+        recls_error_trace_printf_(RECLS_LITERAL("out of memory"));
+
+        // None of the workers has been started
+        for (size_t i = 0; i != m_workers.size(); ++i)
+        {
+            delete m_workers[i];
+        }
+        m_workers.clear();
+
+        return ENOMEM;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+
+    for (size_t i = 0; i != numThreads; ++i)
+    {
+        worker_type* const  w = m_workers[i];
+        int const           e = ::pthread_create(&w->thread, ss_nullptr_k, worker_proc_, w);
+
+        if (0 != e)
+        {
+            recls_error_trace_printf_(RECLS_LITERAL("could not create worker thread: %d"), e);
+
+            // Discard the workers that were not started, and stop those
+            // that were
+            for (size_t j = i; j != numThreads; ++j)
+            {
+                delete m_workers[j];
+            }
+            m_workers.resize(i);
+
+            stop();
+            join();
+
+            return e;
+        }
+    }
+
+    return 0;
+}
+
+void
+work_pool::submit(
+    task*   t
+,   size_t  workerIndex
+)
+{
+    RECLS_ASSERT(ss_nullptr_k != t);
+    RECLS_ASSERT(!m_workers.empty());
+
+    if (workerIndex >= m_workers.size())
+    {
+        workerIndex = __atomic_fetch_add(&m_nextExternal, 1, __ATOMIC_RELAXED) % m_workers.size();
+    }
+
+    worker_type* const w = m_workers[workerIndex];
+
+    ::pthread_mutex_lock(&w->mx);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    try
+    {
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+        w->tasks.push_back(t);
+#ifdef RECLS_EXCEPTION_SUPPORT_
+    }
+    catch(...)
+    {
+        ::pthread_mutex_unlock(&w->mx);
+
+        throw;
+    }
+#endif /* RECLS_EXCEPTION_SUPPORT_ */
+    ::pthread_mutex_unlock(&w->mx);
+
+    // The count is incremented before the sleepers are inspected, and a
+    // sleeper is counted before it inspects the count, so at least one of
+    // the two sees the other
+    __atomic_fetch_add(&m_queued, 1, __ATOMIC_SEQ_CST);
+
+    if (0 != __atomic_load_n(&m_sleepers, __ATOMIC_SEQ_CST))
+    {
+        ::pthread_mutex_lock(&m_mx);
+        ::pthread_cond_signal(&m_cv);
+        ::pthread_mutex_unlock(&m_mx);
+    }
+}
+
+void
+work_pool::stop() STLSOFT_NOEXCEPT
+{
+    ::pthread_mutex_lock(&m_mx);
+    __atomic_store_n(&m_stopping, 1, __ATOMIC_SEQ_CST);
+    ::pthread_cond_broadcast(&m_cv);
+    ::pthread_mutex_unlock(&m_mx);
+}
+
+size_t
+work_pool::size() const STLSOFT_NOEXCEPT
+{
+    return m_workers.size();
+}
+
+/* static */ size_t
+work_pool::default_thread_count() STLSOFT_NOEXCEPT
+{
+    long const n = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+    return (n < 1) ? 1u : static_cast<size_t>(n);
+}
+
+/* static */ void*
+work_pool::worker_proc_(
+    void* arg
+)
+{
+    worker_type* const w = static_cast<worker_type*>(arg);
+
+    w->pool->run_worker_(w->index);
+
+    return ss_nullptr_k;
+}
+
+void
+work_pool::run_worker_(
+    size_t workerIndex
+)
+{
+    function_scope_trace("work_pool::run_worker_");
+
+    for (; 0 == __atomic_load_n(&m_stopping, __ATOMIC_SEQ_CST); )
+    {
+        task* const t = take_(workerIndex);
+
+        if (ss_nullptr_k != t)
+        {
+            t->run(*this, workerIndex);
+        }
+        else
+        {
+            ::pthread_mutex_lock(&m_mx);
+            __atomic_fetch_add(&m_sleepers, 1, __ATOMIC_SEQ_CST);
+            for (;  0 == __atomic_load_n(&m_queued, __ATOMIC_SEQ_CST) &&
+                    0 == __atomic_load_n(&m_stopping, __ATOMIC_SEQ_CST); )
+            {
+                ::pthread_cond_wait(&m_cv, &m_mx);
+            }
+            __atomic_fetch_sub(&m_sleepers, 1, __ATOMIC_SEQ_CST);
+            ::pthread_mutex_unlock(&m_mx);
+        }
+    }
+}
+
+work_pool::task*
+work_pool::take_(
+    size_t workerIndex
+)
+{
+    size_t const    n   =   m_workers.size();
+    task*           t   =   ss_nullptr_k;
+
+    // First, the most recent of this worker's own tasks ...
+    {
+        worker_type* const w = m_workers[workerIndex];
+
+        ::pthread_mutex_lock(&w->mx);
+        if (!w->tasks.empty())
+        {
+            t = w->tasks.back();
+            w->tasks.pop_back();
+        }
+        ::pthread_mutex_unlock(&w->mx);
+    }
+
+    // ... then the oldest of another's
+    for (size_t i = 1; ss_nullptr_k == t && i != n; ++i)
+    {
+        worker_type* const w = m_workers[(workerIndex + i) % n];
+
+        ::pthread_mutex_lock(&w->mx);
+        if (!w->tasks.empty())
+        {
+            t = w->tasks.front();
+            w->tasks.pop_front();
+        }
+        ::pthread_mutex_unlock(&w->mx);
+    }
+
+    if (ss_nullptr_k != t)
+    {
+        __atomic_fetch_sub(&m_queued, 1, __ATOMIC_SEQ_CST);
+    }
+
+    return t;
+}
+
+void
+work_pool::join() STLSOFT_NOEXCEPT
+{
+    workers_type::iterator b = m_workers.begin();
+    workers_type::iterator e = m_workers.end();
+
+    for (; b != e; ++b)
+    {
+        ::pthread_join((*b)->thread, ss_nullptr_k);
+
+        delete *b;
+    }
+
+    m_workers.clear();
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,185 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    src/impl.workpool.linux.hpp
+ *
+ * Purpose: Work-stealing thread pool, for Linux.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * Home:    https://github.com/synesissoftware/recls
+ *
+ * Copyright (c) 2026, Matthew Wilson and Synesis Information Systems
+ * All rights reserved.
+ *
+ * Redistribution and use in source and binary forms, with or without
+ * modification, are permitted in accordance with the license and warranty
+ * information described in recls.h (included in this distribution, or
+ * available from https://github.com/synesissoftware/recls).
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_SRC_HPP_IMPL_WORKPOOL_LINUX
+#define RECLS_INCL_SRC_HPP_IMPL_WORKPOOL_LINUX
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.allocator.hpp"
+
+#ifndef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# error This file can only be included when RECLS_SUPPORTS_PARALLEL_SEARCH_ is defined
+#endif /* !RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+#include <deque>
+#include <vector>
+
+#include <pthread.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+namespace recls
+{
+namespace impl
+{
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * classes
+ */
+
+// class work_pool
+/// A fixed-size pool of threads, each of which has its own queue of tasks
+///
+/// A worker takes the most recently submitted task from its own queue
+/// (so that a depth-first traversal keeps its working set small) and, when
+/// that is empty, steals the least recently submitted task from the queue
+/// of another worker (so that it takes the largest remaining sub-tree).
+///
+/// \note The pool does not own its tasks
+class work_pool
+{
+public:
+    typedef work_pool                                       class_type;
+
+    /// A unit of work
+    struct task
+    {
+        /// Performs the work
+        ///
+        /// \param pool The pool on which the task is executing
+        /// \param workerIndex The index, in [0, pool.size()), of the
+        ///   executing worker, which may be passed to submit() and used to
+        ///   index per-worker resources
+        ///
+        /// \note Must not throw
+        virtual void run(work_pool& pool, size_t workerIndex) = 0;
+
+    protected:
+        virtual ~task() {}
+    };
+
+private:
+    struct worker_type;
+    typedef std::vector<worker_type*, stl_allocator<worker_type*> > workers_type;
+
+public: // construction
+    work_pool();
+    /// Stops the pool, and waits for its workers to exit
+    ~work_pool() STLSOFT_NOEXCEPT;
+private:
+    work_pool(class_type const&);           // copy-construction proscribed
+    void operator =(class_type const&);     // copy-assignment proscribed
+
+public: // operations
+    /// Starts the given number of workers
+    ///
+    /// \retval 0 The workers were started
+    /// \retval !0 The errno value describing the failure, in which case no
+    ///   workers are running
+    int
+    start(
+        size_t numThreads
+    );
+
+    /// Submits a task for execution
+    ///
+    /// \param t The task
+    /// \param workerIndex The index of the calling worker, or any value
+    ///   not less than size() if called from another thread
+    ///
+    /// \note May throw std::bad_alloc
+    void
+    submit(
+        task*   t
+    ,   size_t  workerIndex
+    );
+
+    /// Causes the workers to exit once their current tasks are complete.
+    /// Tasks not yet started are abandoned
+    void
+    stop() STLSOFT_NOEXCEPT;
+
+    /// Waits for the workers to exit, which they do only once stop() has
+    /// been called
+    void
+    join() STLSOFT_NOEXCEPT;
+
+public: // attributes
+    /// The number of workers
+    size_t
+    size() const STLSOFT_NOEXCEPT;
+
+    /// The number of workers used when the caller specifies 0, which is
+    /// the number of online processors
+    static
+    size_t
+    default_thread_count() STLSOFT_NOEXCEPT;
+
+private: // implementation
+    static
+    void*
+    worker_proc_(
+        void* arg
+    );
+
+    void
+    run_worker_(
+        size_t workerIndex
+    );
+
+    task*
+    take_(
+        size_t workerIndex
+    );
+
+private: // fields
+    workers_type    m_workers;
+    pthread_mutex_t m_mx;
+    pthread_cond_t  m_cv;
+    size_t          m_queued;       // Accessed atomically
+    size_t          m_sleepers;     // Accessed atomically
+    int             m_stopping;     // Accessed atomically
+    size_t          m_nextExternal; // Accessed atomically
+};
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+#if !defined(RECLS_NO_NAMESPACE)
+} /* namespace impl */
+} /* namespace recls */
+#endif /* !RECLS_NO_NAMESPACE */
+
+/* ////////////////////////////////////////////////////////////////////// */
+
+#endif /* !RECLS_INCL_SRC_HPP_IMPL_WORKPOOL_LINUX */
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,16 @@
+
+/* recls header files */
+#include <recls/implicit_link.h>
+
+/* xTests header files */
+#include <xtests/implicit_link.h>
+
+/* UNIXem header files */
+#include <platformstl/platformstl.h>
+#if defined(PLATFORMSTL_OS_IS_UNIX) && \
+    defined(_WIN32)
+# include <unixem/implicit_link.h>
+#endif /* OS */
+
+/* ///////////////////////////// end of file //////////////////////////// */
+
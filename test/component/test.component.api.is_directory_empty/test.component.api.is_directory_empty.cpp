@@ -0,0 +1,371 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.is_directory_empty/test.component.api.is_directory_empty.cpp
+ *
+ * Purpose: Test assessment of the emptiness of directories (via recls C
+ *          API functions `Recls_IsDirectoryEmpty()` and
+ *          `Recls_AreDirectoriesEmpty()`).
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+    static void test_1_8(void);
+    static void test_1_9(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_bool_t;
+    using recls::recls_char_t;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.is_directory_empty", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+        XTESTS_RUN_CASE(test_1_8);
+        XTESTS_RUN_CASE(test_1_9);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Whether entries whose names begin with '.' are counted: on UNIX
+     * they are not, by any implementation, since they are not matched by
+     * Recls_GetWildcardsAll()
+     */
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+    bool const  s_dotEntriesAreCounted  =   false;
+#else /* ? OS */
+    bool const  s_dotEntriesAreCounted  =   true;
+#endif /* OS */
+
+    /* Creates the (empty) directory of the given name within the
+     * temporary directory
+     */
+    path_t
+    create_directory_(
+        recls_char_t const* name
+    )
+    {
+        return recls_test::create_tree(temp_dir, name, NULL, 0);
+    }
+
+    /* Creates the directory of the given name within the temporary
+     * directory, containing only the file of the given name
+     */
+    path_t
+    create_directory_with_file_(
+        recls_char_t const* name
+    ,   recls_char_t const* fileName
+    )
+    {
+        return recls_test::create_tree(temp_dir, name, &fileName, 1);
+    }
+
+    bool
+    is_empty_(
+        path_t const& dir
+    )
+    {
+        return 0 != recls::Recls_IsDirectoryEmpty(dir.c_str());
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // an empty directory
+
+    path_t const dir = create_directory_(RECLS_LITERAL("test_1_0"));
+
+    XTESTS_TEST_BOOLEAN_TRUE(is_empty_(dir));
+}
+
+static void test_1_1()
+{
+    // a directory containing only a file
+
+    path_t const dir = create_directory_with_file_(RECLS_LITERAL("test_1_1"), RECLS_LITERAL("f.txt"));
+
+    XTESTS_TEST_BOOLEAN_FALSE(is_empty_(dir));
+}
+
+static void test_1_2()
+{
+    // a directory containing only a file whose name begins with '.'
+
+    path_t const dir = create_directory_with_file_(RECLS_LITERAL("test_1_2"), RECLS_LITERAL(".hidden"));
+
+    XTESTS_TEST_BOOLEAN_EQUAL(!s_dotEntriesAreCounted, is_empty_(dir));
+}
+
+static void test_1_3()
+{
+    // a directory containing only an (empty) sub-directory
+
+    path_t const dir = create_directory_(RECLS_LITERAL("test_1_3"));
+
+    create_directory_(RECLS_LITERAL("test_1_3/sub"));
+
+    XTESTS_TEST_BOOLEAN_FALSE(is_empty_(dir));
+}
+
+static void test_1_4()
+{
+    // a non-existent path is reported as empty
+
+    path_t missing(temp_dir);
+
+    missing.push(RECLS_LITERAL("test_1_4_missing"));
+
+    XTESTS_TEST_BOOLEAN_TRUE(is_empty_(missing));
+}
+
+static void test_1_5()
+{
+    // a directory is empty again once its only entry is removed
+
+    path_t const    dir     =   create_directory_with_file_(RECLS_LITERAL("test_1_5"), RECLS_LITERAL("f.txt"));
+    path_t          file(dir);
+
+    file.push(RECLS_LITERAL("f.txt"));
+
+    XTESTS_TEST_BOOLEAN_FALSE(is_empty_(dir));
+
+    XTESTS_REQUIRE(XTESTS_TEST_BOOLEAN_TRUE(traits_t::delete_file(file.c_str())));
+
+    XTESTS_TEST_BOOLEAN_TRUE(is_empty_(dir));
+}
+
+static void test_1_6()
+{
+    // a mixed batch: the count is that of the empty directories, and each
+    // result is that of Recls_IsDirectoryEmpty()
+
+    path_t const    empty1  =   create_directory_(RECLS_LITERAL("test_1_6_empty1"));
+    path_t const    file    =   create_directory_with_file_(RECLS_LITERAL("test_1_6_file"), RECLS_LITERAL("f.txt"));
+    path_t const    dot     =   create_directory_with_file_(RECLS_LITERAL("test_1_6_dot"), RECLS_LITERAL(".hidden"));
+    path_t const    sub     =   create_directory_(RECLS_LITERAL("test_1_6_sub"));
+    path_t const    empty2  =   create_directory_(RECLS_LITERAL("test_1_6_empty2"));
+    path_t          missing(temp_dir);
+
+    missing.push(RECLS_LITERAL("test_1_6_missing"));
+
+    create_directory_(RECLS_LITERAL("test_1_6_sub/sub"));
+
+    recls_char_t const*     dirs[] =
+    {
+            empty1.c_str()
+        ,   file.c_str()
+        ,   dot.c_str()
+        ,   sub.c_str()
+        ,   missing.c_str()
+        ,   empty2.c_str()
+    };
+    bool const              expected[] =
+    {
+            true
+        ,   false
+        ,   !s_dotEntriesAreCounted
+        ,   false
+        ,   true
+        ,   true
+    };
+    size_t const            numDirs = STLSOFT_NUM_ELEMENTS(dirs);
+    recls_bool_t            results[STLSOFT_NUM_ELEMENTS(dirs)];
+
+    { for (size_t i = 0; i != numDirs; ++i)
+    {
+        results[i] = 99;
+    }}
+
+    size_t const numEmpty = recls::Recls_AreDirectoriesEmpty(dirs, numDirs, results);
+
+    XTESTS_TEST_INTEGER_EQUAL(s_dotEntriesAreCounted ? size_t(3) : size_t(4), numEmpty);
+
+    { for (size_t i = 0; i != numDirs; ++i)
+    {
+        XTESTS_TEST_BOOLEAN_EQUAL(expected[i], 0 != results[i]);
+        XTESTS_TEST_BOOLEAN_EQUAL(0 != recls::Recls_IsDirectoryEmpty(dirs[i]), 0 != results[i]);
+    }}
+}
+
+static void test_1_7()
+{
+    // an empty batch
+
+    recls_bool_t result = 99;
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), recls::Recls_AreDirectoriesEmpty(NULL, 0, NULL));
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), recls::Recls_AreDirectoriesEmpty(NULL, 0, &result));
+    XTESTS_TEST_INTEGER_EQUAL(99u, result);
+}
+
+
+static void test_1_8()
+{
+    // a directory containing only a sub-directory whose name begins with
+    // '.', which is treated as is a file whose name does
+
+    static recls_char_t const* const entries[] =
+    {
+            RECLS_LITERAL(".hidden/")
+        ,   RECLS_LITERAL(".hidden/f.txt")
+    };
+
+    path_t const dir = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_8"), entries);
+
+    XTESTS_TEST_BOOLEAN_EQUAL(!s_dotEntriesAreCounted, is_empty_(dir));
+}
+
+static void test_1_9()
+{
+    // a directory containing files whose names begin with '.', followed
+    // by one whose name does not, is not empty, however many of the former
+    // precede the latter
+
+    path_t const dir = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_9"), NULL, 0);
+
+    for (size_t i = 0; i != 200; ++i)
+    {
+        recls_char_t name[] = RECLS_LITERAL(".h000");
+
+        name[2] = static_cast<recls_char_t>('0' + (i / 100) % 10);
+        name[3] = static_cast<recls_char_t>('0' + (i / 10) % 10);
+        name[4] = static_cast<recls_char_t>('0' + i % 10);
+
+        recls_test::create_file(path_t(dir).push(name));
+    }
+
+    XTESTS_TEST_BOOLEAN_EQUAL(!s_dotEntriesAreCounted, is_empty_(dir));
+
+    recls_test::create_file(path_t(dir).push(RECLS_LITERAL("f.txt")));
+
+    XTESTS_TEST_BOOLEAN_FALSE(is_empty_(dir));
+}
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
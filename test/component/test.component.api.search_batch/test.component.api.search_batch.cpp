@@ -0,0 +1,563 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_batch/test.component.api.search_batch.cpp
+ *
+ * Purpose: Test retrieval of entries in batches (via recls C API function
+ *          `Recls_GetNextDetailsBatch()`), and the prefetching of entries
+ *          by the C++ class `recls::search_sequence`.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.hpp>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+    static void test_1_7(void);
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+    static void test_1_8(void);
+    static void test_1_9(void);
+    static void test_1_10(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_batch", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+        XTESTS_RUN_CASE(test_1_7);
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+        XTESTS_RUN_CASE(test_1_8);
+        XTESTS_RUN_CASE(test_1_9);
+        XTESTS_RUN_CASE(test_1_10);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates the directory of the given name within the temporary
+     * directory, containing numFiles files named "f00.txt", "f01.txt", ...,
+     * and, if numSubdirFiles is non-0, a sub-directory "sub" containing
+     * numSubdirFiles files named likewise
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    ,   size_t              numFiles
+    ,   size_t              numSubdirFiles
+    )
+    {
+        path_t const root = recls_test::create_numbered_files(temp_dir, name, numFiles);
+
+        if (0 != numSubdirFiles)
+        {
+            recls_test::create_numbered_files(root, RECLS_LITERAL("sub"), numSubdirFiles);
+        }
+
+        return root;
+    }
+
+    /* Appends the paths of the given entries, and releases them */
+    void
+    take_entries_(
+        recls_entry_t const*    entries
+    ,   size_t                  count
+    ,   strings_t*              paths
+    )
+    {
+        for (size_t i = 0; i != count; ++i)
+        {
+            paths->push_back(recls_test::path_of(entries[i]));
+
+            recls::Recls_CloseDetails(entries[i]);
+        }
+    }
+
+    /* Cancels the search at any directory other than the search root,
+     * which is the first reported
+     */
+    int RECLS_CALLCONV_DEFAULT
+    cancel_below_root_fn_(
+        recls_char_t const*         /* dir */
+    ,   size_t                      /* dirLen */
+    ,   recls::recls_process_fn_param_t param
+    ,   void*                       /* reserved0 */
+    ,   recls_uint32_t              /* reserved1 */
+    )
+    {
+        int* const numDirectories = static_cast<int*>(param);
+
+        return (0 == (*numDirectories)++) ? recls::RECLS_PROGRESS_CONTINUE : recls::RECLS_PROGRESS_CANCEL;
+    }
+
+    /* Counts the directories reported */
+    int RECLS_CALLCONV_DEFAULT
+    count_directories_fn_(
+        recls_char_t const*         /* dir */
+    ,   size_t                      /* dirLen */
+    ,   recls::recls_process_fn_param_t param
+    ,   void*                       /* reserved0 */
+    ,   recls_uint32_t              /* reserved1 */
+    )
+    {
+        ++*static_cast<int*>(param);
+
+        return recls::RECLS_PROGRESS_CONTINUE;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // max == 0: nothing is retrieved, and the position is unchanged
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_0"), 10, 0);
+    strings_t const all     =   recls_test::search_paths(root, RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES);
+    hrecls_t        hSrch;
+    recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    size_t count = 99;
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, NULL, 0, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), count);
+
+    recls_entry_t entry;
+
+    rc = recls::Recls_GetDetails(hSrch, &entry);
+
+    if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+    {
+        XTESTS_TEST_BOOLEAN_TRUE(all[0] == recls_test::path_of(entry));
+
+        recls::Recls_CloseDetails(entry);
+    }
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_1()
+{
+    // batches smaller than the remaining entries
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_1"), 10, 0);
+    hrecls_t        hSrch;
+    recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    // The search is positioned on the first entry, so 9 remain
+    recls_entry_t   entries[4];
+    size_t          count;
+    strings_t       paths;
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 4, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(4), count);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetLastError(hSrch));
+    take_entries_(entries, count, &paths);
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 4, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(4), count);
+    take_entries_(entries, count, &paths);
+
+    // a short batch, whose reason is returned along with its entries
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 4, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(1), count);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls::Recls_GetLastError(hSrch));
+    take_entries_(entries, count, &paths);
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 4, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), count);
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(9), paths.size());
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_2()
+{
+    // a batch equal to the remaining entries
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_2"), 10, 0);
+    hrecls_t        hSrch;
+    recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    recls_entry_t   entries[9];
+    size_t          count;
+    strings_t       paths;
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 9, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(9), count);
+    take_entries_(entries, count, &paths);
+
+    // the end is discovered only by the next batch, which gets nothing
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 9, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), count);
+
+    // as does each thereafter
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], 9, &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), count);
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_3()
+{
+    // a batch larger than the remaining entries
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_3"), 10, 0);
+    hrecls_t        hSrch;
+    recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    recls_entry_t   entries[20];
+    size_t          count;
+    strings_t       paths;
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], STLSOFT_NUM_ELEMENTS(entries), &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(9), count);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls::Recls_GetLastError(hSrch));
+    take_entries_(entries, count, &paths);
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], STLSOFT_NUM_ELEMENTS(entries), &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), count);
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_4()
+{
+    // the batches yield the entries in the order of Recls_GetNextDetails()
+
+    recls_uint32_t const    flags   =   recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE;
+    path_t const            root    =   create_tree_(RECLS_LITERAL("test_1_4"), 25, 15);
+    strings_t const         all     =   recls_test::search_paths(root, RECLS_LITERAL("*.txt"), flags);
+    hrecls_t                hSrch;
+    recls_rc_t              rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), flags, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    strings_t       paths;
+    recls_entry_t   entries[7];
+    size_t          count;
+
+    rc = recls::Recls_GetDetails(hSrch, &entries[0]);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    take_entries_(entries, 1, &paths);
+
+    do
+    {
+        rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], STLSOFT_NUM_ELEMENTS(entries), &count);
+
+        take_entries_(entries, count, &paths);
+
+    } while (RECLS_RC_OK == rc);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(40), all.size());
+    XTESTS_TEST_INTEGER_EQUAL(all.size(), paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(all == paths);
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_5()
+{
+    // an error after a partial batch: the entries before it are retrieved,
+    // and the error is returned with them
+
+    path_t const    root            =   create_tree_(RECLS_LITERAL("test_1_5"), 3, 3);
+    int             numDirectories  =   0;
+    hrecls_t        hSrch;
+    recls_rc_t      rc              =   recls::Recls_SearchFeedback(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, cancel_below_root_fn_, &numDirectories, &hSrch);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+    recls_entry_t   entries[10];
+    size_t          count;
+    strings_t       paths;
+
+    rc = recls::Recls_GetNextDetailsBatch(hSrch, &entries[0], STLSOFT_NUM_ELEMENTS(entries), &count);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, rc);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(2), count);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, recls::Recls_GetLastError(hSrch));
+    XTESTS_TEST_INTEGER_EQUAL(2, numDirectories);
+    take_entries_(entries, count, &paths);
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_6()
+{
+    // search_sequence, whose entries are prefetched in batches, yields the
+    // entries in the order of Recls_GetNextDetails()
+
+    recls_uint32_t const    flags   =   recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE;
+    path_t const            root    =   create_tree_(RECLS_LITERAL("test_1_6"), 50, 30);
+    strings_t const         all     =   recls_test::search_paths(root, RECLS_LITERAL("*.txt"), flags);
+    recls::search_sequence  files(root.c_str(), RECLS_LITERAL("*.txt"), flags);
+    strings_t               paths;
+
+    for (recls::search_sequence::const_iterator b = files.begin(); files.end() != b; ++b)
+    {
+        recls::entry const entry = *b;
+
+        paths.push_back(entry.get_path());
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(80), all.size());
+    XTESTS_TEST_INTEGER_EQUAL(all.size(), paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(all == paths);
+}
+
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+static void test_1_7()
+{
+    // search_sequence reports an error after a partial batch only once the
+    // entries before it have been consumed
+
+    path_t const            root            =   create_tree_(RECLS_LITERAL("test_1_7"), 3, 3);
+    int                     numDirectories  =   0;
+    recls::search_sequence  files(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, cancel_below_root_fn_, &numDirectories);
+    size_t                  n               =   0;
+
+    try
+    {
+        for (recls::search_sequence::const_iterator b = files.begin(); files.end() != b; ++b)
+        {
+            recls::entry const entry = *b;
+
+            XTESTS_TEST_BOOLEAN_FALSE(entry.get_path().empty());
+
+            ++n;
+        }
+
+        XTESTS_TEST_FAIL("the search should have been cancelled");
+    }
+    catch(recls::recls_exception& x)
+    {
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, x.get_rc());
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(3), n);
+}
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+
+static void test_1_8()
+{
+    // search_sequence yields entries that remain valid after the iterator
+    // has moved past them (and their batch has been released)
+
+    path_t const            root    =   create_tree_(RECLS_LITERAL("test_1_8"), 40, 0);
+    recls::search_sequence  files(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES);
+    std::vector<recls::entry> entries;
+
+    for (recls::search_sequence::const_iterator b = files.begin(); files.end() != b; ++b)
+    {
+        entries.push_back(*b);
+    }
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(size_t(40), entries.size()));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(entries[i].get_path().c_str()));
+    }
+}
+
+static void test_1_9()
+{
+    // search_sequence over a directory with no matching entries
+
+    path_t const            root    =   create_tree_(RECLS_LITERAL("test_1_9"), 0, 0);
+    recls::search_sequence  files(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES);
+
+    XTESTS_TEST_BOOLEAN_TRUE(files.begin() == files.end());
+    XTESTS_TEST_BOOLEAN_TRUE(files.empty());
+}
+
+static void test_1_10()
+{
+    // search_sequence does not prefetch when given a progress function, so
+    // the search does not run ahead of the iteration into directories the
+    // caller has not yet reached
+
+    path_t const            root            =   create_tree_(RECLS_LITERAL("test_1_10"), 3, 3);
+    int                     numDirectories  =   0;
+    recls::search_sequence  files(root.c_str(), RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, count_directories_fn_, &numDirectories);
+    size_t                  n               =   0;
+
+    for (recls::search_sequence::const_iterator b = files.begin(); files.end() != b; ++b, ++n)
+    {
+        recls::entry const  entry   =   *b;
+        int const           numDirs =   (n < 3) ? 1 : 2;
+
+        XTESTS_TEST_INTEGER_EQUAL(numDirs, numDirectories);
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(6), n);
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,429 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_deep_trees/test.component.api.search_deep_trees.cpp
+ *
+ * Purpose: Test that searches of deep and wide trees, which repeatedly
+ *          descend into and ascend from directories, find every entry,
+ *          present the entries of each directory together, and release
+ *          the resources of each directory.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <map>
+#include <string>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::hrecls_t;
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+    using recls_test::traits_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The names of the sub-directories of each directory of a wide tree,
+     * which are of different lengths, so that a directory is followed by
+     * one whose path is longer, or shorter, at the same depth
+     */
+    recls_char_t const* const   s_branches[] =
+    {
+            RECLS_LITERAL("a")
+        ,   RECLS_LITERAL("bbbbbbbbbbbbbbbb")
+        ,   RECLS_LITERAL("cc")
+        ,   RECLS_LITERAL("ddddddddd")
+    };
+
+    /* The files of each directory of a wide tree */
+    recls_char_t const* const   s_files[] =
+    {
+            RECLS_LITERAL("z.txt")
+        ,   RECLS_LITERAL("f.txt")
+        ,   RECLS_LITERAL("m.dat")
+    };
+
+    size_t const                s_wideDepth     =   3;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_deep_trees", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, within the given directory, the files of s_files and, if
+     * depth is not 0, the sub-directories of s_branches, each of which is
+     * populated likewise to the given depth
+     */
+    void
+    create_branches_(
+        path_t const&   dir
+    ,   size_t          depth
+    )
+    {
+        recls_test::create_directory(dir);
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            recls_test::create_file(path_t(dir).push(s_files[i]));
+        }
+
+        if (0 != depth)
+        {
+            for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_branches); ++i)
+            {
+                create_branches_(path_t(dir).push(s_branches[i]), depth - 1);
+            }
+        }
+    }
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, a wide tree of s_wideDepth levels, returning its path
+     */
+    path_t
+    create_wide_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t const root = path_t(temp_dir).push(name);
+
+        create_branches_(root, s_wideDepth);
+
+        return root;
+    }
+
+    /* The number of directories in a wide tree, excluding its root */
+    size_t
+    num_wide_directories_()
+    {
+        size_t  n       =   0;
+        size_t  level   =   1;
+
+        for (size_t i = 0; i != s_wideDepth; ++i)
+        {
+            level *= STLSOFT_NUM_ELEMENTS(s_branches);
+            n += level;
+        }
+
+        return n;
+    }
+
+    /* Searches the given root with both traversals, verifying that each
+     * runs to completion and that they find the same entries, returning
+     * those found by the single-pass traversal, in order
+     */
+    strings_t
+    compare_searches_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    )
+    {
+        strings_t const singlePass  =   recls_test::search_paths(root, pattern, flags);
+        strings_t       portable    =   recls_test::search_paths(root, pattern, flags | recls::RECLS_F_PORTABLE_TRAVERSAL);
+        strings_t       sorted(singlePass);
+
+        // The order in which the traversals present the contents of a
+        // directory, relative to those of its sub-directories, is not
+        // compared
+        std::sort(portable.begin(), portable.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        XTESTS_TEST_INTEGER_EQUAL(portable.size(), sorted.size());
+        XTESTS_TEST_BOOLEAN_TRUE(portable == sorted);
+
+        return singlePass;
+    }
+
+    /* The directory of the given path, including its trailing path-name
+     * separator
+     */
+    string_t
+    directory_of_(
+        string_t const& path
+    )
+    {
+        for (size_t n = path.size(); 0 != n; --n)
+        {
+            if (traits_t::is_path_name_separator(path[n - 1]))
+            {
+                return path.substr(0, n);
+            }
+        }
+
+        return string_t();
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // every level of a deep tree is searched, to the deepest
+
+    size_t const    depth   =   128;
+    path_t const    root    =   recls_test::create_deep_tree(temp_dir, RECLS_LITERAL("test_1_0"), depth);
+    path_t          deepest(root);
+
+    for (size_t i = 0; i != depth; ++i)
+    {
+        deepest.push(RECLS_LITERAL("d"));
+    }
+
+    strings_t const paths = compare_searches_(root, RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_INTEGER_EQUAL(2 * depth, paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(paths.end() != std::find(paths.begin(), paths.end(), string_t(deepest.c_str())));
+    XTESTS_TEST_BOOLEAN_TRUE(paths.end() != std::find(paths.begin(), paths.end(), string_t(deepest.push(RECLS_LITERAL("f.txt")).c_str())));
+}
+
+static void test_1_1()
+{
+    // every directory of a wide tree is searched, each being followed by
+    // directories at the same depth whose paths are longer, and shorter
+
+    path_t const    root    =   create_wide_tree_(RECLS_LITERAL("test_1_1"));
+    size_t const    numDirs =   num_wide_directories_();
+
+    strings_t const all     =   compare_searches_(root, RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+    strings_t const dirs    =   compare_searches_(root, RECLS_LITERAL("*"), recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+    strings_t const files   =   compare_searches_(root, RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_INTEGER_EQUAL(numDirs + (1 + numDirs) * STLSOFT_NUM_ELEMENTS(s_files), all.size());
+    XTESTS_TEST_INTEGER_EQUAL(numDirs, dirs.size());
+    XTESTS_TEST_INTEGER_EQUAL((1 + numDirs) * 2u, files.size());
+}
+
+static void test_1_2()
+{
+    // the entries of each directory are presented together, in name
+    // order
+
+    path_t const    root    =   create_wide_tree_(RECLS_LITERAL("test_1_2"));
+    strings_t const paths   =   recls_test::search_paths(root, RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL((1 + num_wide_directories_()) * STLSOFT_NUM_ELEMENTS(s_files), paths.size()));
+
+    std::map<string_t, size_t>  counts;
+
+    for (size_t i = 0; i != paths.size(); )
+    {
+        string_t const  dir =   directory_of_(paths[i]);
+        size_t          n   =   1;
+
+        for (; i + n != paths.size() && dir == directory_of_(paths[i + n]); ++n)
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(paths[i + n - 1] < paths[i + n]);
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), counts[dir]);
+
+        counts[dir] = n;
+        i += n;
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(1 + num_wide_directories_(), counts.size());
+
+    for (std::map<string_t, size_t>::const_iterator b = counts.begin(); b != counts.end(); ++b)
+    {
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files), b->second);
+    }
+}
+
+static void test_1_3()
+{
+    // a tree whose path is too long for a small path buffer is searched,
+    // to the deepest
+
+    size_t const    depth   =   24;
+    string_t const  name(120, RECLS_LITERAL('n'));
+    path_t const    root    =   path_t(temp_dir).push(RECLS_LITERAL("test_1_3"));
+    path_t          deepest(root);
+
+    for (size_t i = 0; i != depth; ++i)
+    {
+        deepest.push(name.c_str());
+    }
+
+    recls_test::create_directory(deepest);
+    recls_test::create_file(path_t(deepest).push(RECLS_LITERAL("f.txt")));
+
+    strings_t const paths = compare_searches_(root, RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_INTEGER_EQUAL(depth + 1, paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(paths.end() != std::find(paths.begin(), paths.end(), string_t(deepest.push(RECLS_LITERAL("f.txt")).c_str())));
+}
+
+static void test_1_4()
+{
+    // the resources of the directories are released as the search ascends
+    // from them, and when the search is closed before it has ascended
+
+#if defined(__linux__)
+    path_t const    root    =   create_wide_tree_(RECLS_LITERAL("test_1_4"));
+    size_t const    fd      =   recls_test::lowest_free_descriptor();
+
+    recls_test::search_paths(root, RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_INTEGER_EQUAL(fd, recls_test::lowest_free_descriptor());
+
+    // the search is closed at a number of points before it ends
+    for (size_t n = 1; n < (1 + num_wide_directories_()) * STLSOFT_NUM_ELEMENTS(s_files); n += 23)
+    {
+        hrecls_t        hSrch;
+        recls_entry_t   entry;
+        recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, &hSrch);
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+        size_t i = 0;
+
+        for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc && i != n; rc = recls::Recls_GetNextDetails(hSrch, &entry), ++i)
+        {
+            recls::Recls_CloseDetails(entry);
+        }
+
+        if (RECLS_RC_OK == rc)
+        {
+            recls::Recls_CloseDetails(entry);
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(n, i);
+
+        recls::Recls_SearchClose(hSrch);
+
+        XTESTS_TEST_INTEGER_EQUAL(fd, recls_test::lowest_free_descriptor());
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
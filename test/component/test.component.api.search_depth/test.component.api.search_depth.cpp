@@ -0,0 +1,470 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_depth/test.component.api.search_depth.cpp
+ *
+ * Purpose: Test that searches limited in depth (`Recls_SearchDepth()`
+ *          and `Recls_SearchProcessDepth()`) find only the entries within
+ *          the limits, and do not open the directories beyond them.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <string>
+
+/* Standard C header files */
+#include <stdlib.h>
+#if defined(__linux__)
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::hrecls_t;
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+    using recls_test::traits_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The tree, each of whose entries is of the depth given by the digit
+     * in its name
+     */
+    recls_char_t const* const   s_entries[] =
+    {
+            RECLS_LITERAL("f0.txt")
+        ,   RECLS_LITERAL("d0/f1.txt")
+        ,   RECLS_LITERAL("d0/d1/f2.txt")
+        ,   RECLS_LITERAL("d0/d1/d2/f3.txt")
+        ,   RECLS_LITERAL("d0/d1/d2/d3/")
+        ,   RECLS_LITERAL("e0/g1.txt")
+        ,   RECLS_LITERAL("e0/e1/")
+    };
+
+    /* The number of entries of each depth */
+    static size_t const         s_numEntries[] =
+    {
+            3   /* f0.txt, d0, e0 */
+        ,   4   /* d0/f1.txt, d0/d1, e0/g1.txt, e0/e1 */
+        ,   2   /* d0/d1/f2.txt, d0/d1/d2 */
+        ,   2   /* d0/d1/d2/f3.txt, d0/d1/d2/d3 */
+    };
+
+    /* Each case is performed by the default traversal (which is the
+     * single-pass traversal, where available), and by the portable
+     * traversal
+     */
+    static recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+    static recls_uint32_t const s_searchFlags = recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_depth", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Searches the given root, within the given depths, returning the
+     * paths of the entries found, in order, and the status code that ended
+     * the search: RECLS_RC_NO_MORE_DATA if it ran to completion
+     */
+    recls_rc_t
+    search_paths_depth_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    ,   recls_uint32_t  minDepth
+    ,   recls_uint32_t  maxDepth
+    ,   strings_t*      paths
+    )
+    {
+        hrecls_t    hSrch;
+        recls_rc_t  rc      =   recls::Recls_SearchDepth(root.c_str(), RECLS_LITERAL("*"), flags, minDepth, maxDepth, &hSrch);
+
+        if (RECLS_RC_OK == rc)
+        {
+            rc = recls_test::enumerate_paths(hSrch, paths);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return rc;
+    }
+
+    /* Searches the given root, within the given depths, returning the
+     * paths of the entries found, in order, and verifying that the search
+     * runs to completion
+     */
+    strings_t
+    search_paths_depth_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    ,   recls_uint32_t  minDepth
+    ,   recls_uint32_t  maxDepth
+    )
+    {
+        strings_t paths;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, search_paths_depth_(root, flags, minDepth, maxDepth, &paths));
+
+        return paths;
+    }
+
+    /* The depth of the entry of the given path below the given root */
+    size_t
+    depth_of_(
+        path_t const&   root
+    ,   string_t const& path
+    )
+    {
+        size_t const    rootLen =   traits_t::str_len(root.c_str());
+        size_t          depth   =   0;
+
+        for (size_t i = rootLen + 1; i < path.size(); ++i)
+        {
+            if (traits_t::is_path_name_separator(path[i]))
+            {
+                ++depth;
+            }
+        }
+
+        return depth;
+    }
+
+    /* Verifies that the given paths are those of all the entries of the
+     * tree within the given depths
+     */
+    void
+    verify_depths_(
+        path_t const&       root
+    ,   strings_t const&    paths
+    ,   size_t              minDepth
+    ,   size_t              maxDepth
+    )
+    {
+        size_t numExpected = 0;
+
+        for (size_t d = minDepth; d <= maxDepth && d < STLSOFT_NUM_ELEMENTS(s_numEntries); ++d)
+        {
+            numExpected += s_numEntries[d];
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(numExpected, paths.size());
+
+        for (size_t i = 0; i != paths.size(); ++i)
+        {
+            size_t const depth = depth_of_(root, paths[i]);
+
+            XTESTS_TEST_BOOLEAN_TRUE(depth >= minDepth);
+            XTESTS_TEST_BOOLEAN_TRUE(depth <= maxDepth);
+        }
+    }
+
+    /* Appends the path of the given entry to the strings_t instance given
+     * as the parameter
+     */
+    int RECLS_CALLCONV_DEFAULT
+    collect_path_fn_(
+        recls_entry_t                   entry
+    ,   recls::recls_process_fn_param_t param
+    )
+    {
+        static_cast<strings_t*>(param)->push_back(recls_test::path_of(entry));
+
+        return 1;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // without limits, the entries are those of an unlimited search, in the
+    // same order
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths       =   search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 0, RECLS_DEPTH_UNLIMITED);
+        strings_t const expected    =   recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags);
+
+        verify_depths_(root, paths, 0, RECLS_DEPTH_UNLIMITED);
+        XTESTS_TEST_BOOLEAN_TRUE(expected == paths);
+    }
+}
+
+static void test_1_1()
+{
+    // a maximum depth of 0 finds the entries of the search directory only,
+    // as does a search that is not recursive
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths       =   search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 0, 0);
+        strings_t const expected    =   recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES);
+
+        verify_depths_(root, paths, 0, 0);
+        XTESTS_TEST_BOOLEAN_TRUE(expected == paths);
+    }
+}
+
+static void test_1_2()
+{
+    // a maximum depth finds the entries no deeper than it
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        for (recls_uint32_t maxDepth = 1; maxDepth != 5; ++maxDepth)
+        {
+            verify_depths_(root, search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 0, maxDepth), 0, maxDepth);
+        }
+    }
+}
+
+static void test_1_3()
+{
+    // a minimum depth finds the entries no shallower than it
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        for (recls_uint32_t minDepth = 1; minDepth != 5; ++minDepth)
+        {
+            verify_depths_(root, search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, minDepth, RECLS_DEPTH_UNLIMITED), minDepth, RECLS_DEPTH_UNLIMITED);
+        }
+    }
+}
+
+static void test_1_4()
+{
+    // equal minimum and maximum depths find the entries of that depth
+    // only, and files or directories only as requested
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_4"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        for (recls_uint32_t depth = 0; depth != STLSOFT_NUM_ELEMENTS(s_numEntries); ++depth)
+        {
+            verify_depths_(root, search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, depth, depth), depth, depth);
+        }
+
+        strings_t const files   =   search_paths_depth_(root, s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, 1, 1);
+        strings_t const dirs    =   search_paths_depth_(root, s_traversalFlags[t] | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE, 1, 1);
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2), files.size());
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2), dirs.size());
+    }
+}
+
+static void test_1_5()
+{
+    // a minimum depth greater than the maximum, or than the depth of the
+    // tree, finds no entries
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_5"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t paths;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 2, 1, &paths));
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 4, RECLS_DEPTH_UNLIMITED, &paths));
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), paths.size());
+    }
+}
+
+static void test_1_6()
+{
+    // a search that processes the entries finds those of a search within
+    // the same limits
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_6"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t paths;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_SearchProcessDepth(root.c_str(), RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags, 1, 2, collect_path_fn_, &paths));
+
+        verify_depths_(root, paths, 1, 2);
+        XTESTS_TEST_BOOLEAN_TRUE(search_paths_depth_(root, s_traversalFlags[t] | s_searchFlags, 1, 2) == paths);
+    }
+}
+
+static void test_1_7()
+{
+    // directories whose entries would be deeper than the maximum depth are
+    // not opened, so that they cannot fail the search
+
+#if defined(__linux__)
+    if (0 == ::geteuid())
+    {
+        // the denial of access is not enforced
+
+        XTESTS_TEST_PASSED();
+
+        return;
+    }
+
+    path_t const root   =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_7"), s_entries);
+    path_t const denied =   path_t(root).push(RECLS_LITERAL("d0/d1/d2"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::chmod(denied.c_str(), 0)));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        recls_uint32_t const    flags   =   s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_STOP_ON_ACCESS_FAILURE;
+        strings_t               paths;
+
+        verify_depths_(root, search_paths_depth_(root, flags, 0, 2), 0, 2);
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_ACCESS_DENIED, search_paths_depth_(root, flags, 0, 3, &paths));
+    }
+
+    ::chmod(denied.c_str(), S_IRWXU);
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
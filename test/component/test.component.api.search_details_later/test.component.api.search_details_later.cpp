@@ -0,0 +1,488 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_details_later/test.component.api.search_details_later.cpp
+ *
+ * Purpose: Test the entries of searches that defer their details
+ *          (`RECLS_F_DETAILS_LATER`), which, for the single-pass traversal
+ *          (on Linux), are not stat()-ed where the directory provides
+ *          their type.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+#if defined(__linux__)
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * macros
+ */
+
+#ifdef RECLS_CHAR_TYPE_IS_WCHAR
+# define XTESTS_TEST_STRING_EQUAL                           XTESTS_TEST_WIDE_STRING_EQUAL
+#else
+# define XTESTS_TEST_STRING_EQUAL                           XTESTS_TEST_MULTIBYTE_STRING_EQUAL
+#endif
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+
+    typedef std::vector<recls_entry_t>                      entries_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The files of the tree, and their sizes */
+    struct file_t
+    {
+        recls_char_t const* path;
+        size_t              size;
+    };
+
+    file_t const s_files[] =
+    {
+            { RECLS_LITERAL("a.txt"),               100 }
+        ,   { RECLS_LITERAL("sub/b.txt"),           200 }
+        ,   { RECLS_LITERAL("sub/deeper/c.txt"),    300 }
+    };
+
+    /* The directories of the tree */
+    recls_char_t const* const s_directories[] =
+    {
+            RECLS_LITERAL("empty")
+        ,   RECLS_LITERAL("sub/deeper")
+    };
+
+    /* The number of directories in the tree */
+    static size_t const s_numDirectories = 3;
+
+    static recls_uint32_t const s_searchFlags = recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_details_later", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, the files of s_files and the directories of
+     * s_directories, returning the path of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_directories); ++i)
+        {
+            recls_test::create_directory(path_t(root).push(s_directories[i]));
+        }
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            recls_test::create_file(path_t(root).push(s_files[i].path), s_files[i].size);
+        }
+
+        return root;
+    }
+
+    entries_t
+    search_entries_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    )
+    {
+        entries_t       entries;
+        hrecls_t        hSrch;
+        recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), flags, &hSrch);
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+        {
+            recls_entry_t entry;
+
+            for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+            {
+                entries.push_back(entry);
+            }
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return entries;
+    }
+
+    void
+    release_entries_(
+        entries_t const& entries
+    )
+    {
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            recls::Recls_CloseDetails(entries[i]);
+        }
+    }
+
+    /* The number of the given entries that are directories */
+    size_t
+    count_directories_(
+        entries_t const& entries
+    )
+    {
+        size_t n = 0;
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            if (recls::Recls_IsFileDirectory(entries[i]))
+            {
+                ++n;
+            }
+        }
+
+        return n;
+    }
+
+    /* The size, in s_files, of the file of the given entry, relative to
+     * root
+     */
+    recls::recls_filesize_t
+    size_of_(
+        path_t const&   root
+    ,   recls_entry_t   entry
+    )
+    {
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            if (path_t(root).push(s_files[i].path).c_str() == recls_test::path_of(entry))
+            {
+                return s_files[i].size;
+            }
+        }
+
+        XTESTS_TEST_FAIL_WITH_QUALIFIER("entry not found", recls_test::path_of(entry));
+
+        return 0;
+    }
+
+#if defined(__linux__)
+
+    /* Creates, at the given path, a symbolic link to the given target */
+    void
+    create_link_(
+        path_t const&       path
+    ,   recls_char_t const* target
+    )
+    {
+        if (0 != ::symlink(target, path.c_str()))
+        {
+            XTESTS_TEST_FAIL_WITH_QUALIFIER("failed to create link", path);
+        }
+    }
+#endif /* __linux__ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // without RECLS_F_DETAILS_LATER, every entry has its details
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_0"));
+    entries_t const entries =   search_entries_(root, s_searchFlags);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size()));
+    XTESTS_TEST_INTEGER_EQUAL(s_numDirectories, count_directories_(entries));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        XTESTS_TEST_BOOLEAN_TRUE(recls::Recls_EntryHasDetails(entries[i]));
+        XTESTS_TEST_BOOLEAN_TRUE(0 != entries[i]->modificationTime);
+
+        if (!recls::Recls_IsFileDirectory(entries[i]))
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_of_(root, entries[i]), entries[i]->size);
+        }
+    }
+
+    release_entries_(entries);
+}
+
+static void test_1_1()
+{
+    // with RECLS_F_DETAILS_LATER, the same entries are found, with the
+    // same types, but (with the single-pass traversal) without their
+    // details
+
+    path_t const    root        =   create_tree_(RECLS_LITERAL("test_1_1"));
+    entries_t const expected    =   search_entries_(root, s_searchFlags);
+    entries_t const entries     =   search_entries_(root, s_searchFlags | recls::RECLS_F_DETAILS_LATER);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(expected.size(), entries.size()));
+    XTESTS_TEST_INTEGER_EQUAL(s_numDirectories, count_directories_(entries));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        XTESTS_TEST_STRING_EQUAL(recls_test::path_of(expected[i]), recls_test::path_of(entries[i]));
+        XTESTS_TEST_BOOLEAN_EQUAL(recls::Recls_IsFileDirectory(expected[i]), recls::Recls_IsFileDirectory(entries[i]));
+#if defined(__linux__)
+        XTESTS_TEST_BOOLEAN_FALSE(recls::Recls_EntryHasDetails(entries[i]));
+        XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(0), entries[i]->size);
+        XTESTS_TEST_BOOLEAN_TRUE(0 == entries[i]->modificationTime);
+        XTESTS_TEST_INTEGER_EQUAL(recls::recls_uint32_t(0), recls::Recls_GetModificationTimeNsec(entries[i]));
+#endif /* __linux__ */
+    }
+
+    release_entries_(entries);
+    release_entries_(expected);
+}
+
+static void test_1_2()
+{
+    // with RECLS_F_DETAILS_LATER, the directories are marked by
+    // RECLS_F_MARK_DIRS, their type being known
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_2"));
+    entries_t const entries =   search_entries_(root, s_searchFlags | recls::RECLS_F_DETAILS_LATER | recls::RECLS_F_MARK_DIRS);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size()));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        string_t const path = recls_test::path_of(entries[i]);
+
+        XTESTS_REQUIRE(XTESTS_TEST_BOOLEAN_FALSE(path.empty()));
+        XTESTS_TEST_BOOLEAN_EQUAL(recls::Recls_IsFileDirectory(entries[i]), traits_t::is_path_name_separator(path[path.size() - 1]));
+    }
+
+    release_entries_(entries);
+}
+
+static void test_1_3()
+{
+    // with RECLS_F_DETAILS_LATER and RECLS_F_LINK_COUNT, the entries are
+    // stat()-ed for their link counts, but are still without their other
+    // details
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_3"));
+    entries_t const entries =   search_entries_(root, s_searchFlags | recls::RECLS_F_DETAILS_LATER | recls::RECLS_F_LINK_COUNT);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size()));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        if (recls::Recls_IsFileDirectory(entries[i]))
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(entries[i]->numLinks >= 2);
+        }
+        else
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_t(1), entries[i]->numLinks);
+        }
+#if defined(__linux__)
+        XTESTS_TEST_BOOLEAN_FALSE(recls::Recls_EntryHasDetails(entries[i]));
+        XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(0), entries[i]->size);
+#endif /* __linux__ */
+    }
+
+    release_entries_(entries);
+}
+
+static void test_1_4()
+{
+    // with RECLS_F_DETAILS_LATER and RECLS_F_NODE_INDEX, the entries have
+    // their node indexes
+
+#if defined(__linux__)
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_4"));
+    entries_t const entries =   search_entries_(root, s_searchFlags | recls::RECLS_F_DETAILS_LATER | recls::RECLS_F_NODE_INDEX);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size()));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        struct stat st;
+
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::stat(recls_test::path_of(entries[i]).c_str(), &st)));
+
+        XTESTS_TEST_INTEGER_EQUAL(recls::recls_uint64_t(st.st_ino), entries[i]->nodeIndex);
+        XTESTS_TEST_BOOLEAN_FALSE(recls::Recls_EntryHasDetails(entries[i]));
+    }
+
+    release_entries_(entries);
+#endif /* __linux__ */
+}
+
+static void test_1_5()
+{
+    // with RECLS_F_DETAILS_LATER, links are followed to determine their
+    // types, as they are without it
+
+#if defined(__linux__)
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_5"));
+    path_t          links(root);
+
+    links.push(RECLS_LITERAL("links"));
+
+    recls_test::create_directory(links);
+
+    create_link_(path_t(links).push(RECLS_LITERAL("to_file")), RECLS_LITERAL("../a.txt"));
+    create_link_(path_t(links).push(RECLS_LITERAL("to_dir")), RECLS_LITERAL("../empty"));
+
+    recls_uint32_t const    flags       =   recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES;
+    entries_t const         expected    =   search_entries_(links, flags);
+    entries_t const         entries     =   search_entries_(links, flags | recls::RECLS_F_DETAILS_LATER);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(size_t(2), expected.size()));
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(expected.size(), entries.size()));
+    XTESTS_TEST_INTEGER_EQUAL(size_t(1), count_directories_(entries));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        XTESTS_TEST_STRING_EQUAL(recls_test::path_of(expected[i]), recls_test::path_of(entries[i]));
+        XTESTS_TEST_BOOLEAN_EQUAL(recls::Recls_IsFileDirectory(expected[i]), recls::Recls_IsFileDirectory(entries[i]));
+    }
+
+    release_entries_(entries);
+    release_entries_(expected);
+#endif /* __linux__ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
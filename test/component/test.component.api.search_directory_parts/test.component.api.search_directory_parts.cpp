@@ -0,0 +1,445 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_directory_parts/test.component.api.search_directory_parts.cpp
+ *
+ * Purpose: Test the directory parts of the entries of a search
+ *          (`RECLS_F_DIRECTORY_PARTS`), which are shared between the
+ *          entries of a directory.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+    typedef std::vector<recls_entry_t>                      entries_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    recls_char_t const* const s_entries[] =
+    {
+            RECLS_LITERAL("a/b/f1.txt")
+        ,   RECLS_LITERAL("a/b/f2.txt")
+        ,   RECLS_LITERAL("a/b/f3.txt")
+        ,   RECLS_LITERAL("a/c/g1.txt")
+        ,   RECLS_LITERAL("a/c/g2.txt")
+        ,   RECLS_LITERAL("h1.txt")
+        ,   RECLS_LITERAL("h2.txt")
+    };
+
+    /* The traversals, each of which shares the directory parts */
+    recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_directory_parts", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Searches the given root, returning its entries, which are to be
+     * released by release_entries_()
+     */
+    entries_t
+    search_entries_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    )
+    {
+        entries_t       entries;
+        hrecls_t        hSrch;
+        recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), flags, &hSrch);
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+        {
+            recls_entry_t entry;
+
+            for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+            {
+                entries.push_back(entry);
+            }
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return entries;
+    }
+
+    void
+    release_entries_(
+        entries_t const& entries
+    )
+    {
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            recls::Recls_CloseDetails(entries[i]);
+        }
+    }
+
+    /* The directory of the given entry */
+    string_t
+    directory_of_(
+        recls_entry_t entry
+    )
+    {
+        return string_t(entry->directory.begin, entry->directory.end);
+    }
+
+    /* The directory parts of the given entry */
+    strings_t
+    directory_parts_of_(
+        recls_entry_t entry
+    )
+    {
+        strings_t parts;
+
+        for (recls::recls_strptrs_t const* part = entry->directoryParts.begin; entry->directoryParts.end != part; ++part)
+        {
+            parts.push_back(string_t(part->begin, part->end));
+        }
+
+        return parts;
+    }
+
+    /* The parts of the given directory, each including its trailing
+     * separator
+     */
+    strings_t
+    split_directory_(
+        string_t const& dir
+    )
+    {
+        strings_t   parts;
+        size_t      from    =   0;
+
+        for (size_t i = 0; i != dir.size(); ++i)
+        {
+            if (traits_t::is_path_name_separator(dir[i]))
+            {
+                parts.push_back(dir.substr(from, i + 1 - from));
+
+                from = i + 1;
+            }
+        }
+
+        return parts;
+    }
+
+    /* Verifies that the directory parts of each entry are those of its
+     * directory
+     */
+    void
+    verify_parts_(
+        entries_t const& entries
+    )
+    {
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(split_directory_(directory_of_(entries[i])) == directory_parts_of_(entries[i]));
+        }
+    }
+
+    /* Verifies that the entries of each directory share their directory
+     * parts, and that those of different directories do not
+     */
+    void
+    verify_shared_(
+        entries_t const& entries
+    )
+    {
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            for (size_t j = 0; j != i; ++j)
+            {
+                bool const sameDirectory = directory_of_(entries[i]) == directory_of_(entries[j]);
+
+                XTESTS_TEST_BOOLEAN_EQUAL(sameDirectory, entries[i]->directoryParts.begin == entries[j]->directoryParts.begin);
+            }
+        }
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // the entries of a directory share their directory parts, which are
+    // those of the directory
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[i] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_entries), entries.size());
+
+        verify_parts_(entries);
+        verify_shared_(entries);
+
+        release_entries_(entries);
+    }
+}
+
+static void test_1_1()
+{
+    // the shared directory parts outlive the search, and the release of
+    // the other entries that share them
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        entries_t   entries = search_entries_(root, s_traversalFlags[i] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS);
+        entries_t   kept;
+
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_entries), entries.size()));
+
+        // keep the last entry of each directory, and a copy of each
+        for (size_t j = 0; j != entries.size(); ++j)
+        {
+            if (entries.size() == j + 1 ||
+                directory_of_(entries[j]) != directory_of_(entries[j + 1]))
+            {
+                recls_entry_t copy;
+
+                XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CopyDetails(entries[j], &copy));
+
+                kept.push_back(entries[j]);
+                kept.push_back(copy);
+            }
+            else
+            {
+                recls::Recls_CloseDetails(entries[j]);
+            }
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2 * 3), kept.size());
+
+        verify_parts_(kept);
+
+        // release the originals, and then verify the copies
+        for (size_t j = 0; j != kept.size(); j += 2)
+        {
+            recls::Recls_CloseDetails(kept[j]);
+
+            XTESTS_TEST_BOOLEAN_TRUE(split_directory_(directory_of_(kept[j + 1])) == directory_parts_of_(kept[j + 1]));
+
+            recls::Recls_CloseDetails(kept[j + 1]);
+        }
+    }
+}
+
+static void test_1_2()
+{
+    // the number of relative directory parts is that of each entry
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[i] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_entries), entries.size());
+
+        for (size_t j = 0; j != entries.size(); ++j)
+        {
+            string_t const  name            =   recls_test::file_name_of(entries[j]);
+            size_t const    numRelParts     =   ('h' == name[0]) ? 0 : 2;
+
+            XTESTS_TEST_INTEGER_EQUAL(numRelParts, entries[j]->numRelativeDirectoryParts);
+        }
+
+        release_entries_(entries);
+    }
+}
+
+static void test_1_3()
+{
+    // without RECLS_F_DIRECTORY_PARTS, there are no directory parts
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[i] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_entries), entries.size());
+
+        for (size_t j = 0; j != entries.size(); ++j)
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(entries[j]->directoryParts.begin == entries[j]->directoryParts.end);
+            XTESTS_TEST_BOOLEAN_FALSE(recls_test::path_of(entries[j]).empty());
+        }
+
+        release_entries_(entries);
+    }
+}
+
+static void test_1_4()
+{
+    // recycled entries (which have their own directory parts) have the
+    // directory parts of their directories
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_4"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        recls_uint32_t const    flags   =   s_traversalFlags[i] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS | recls::RECLS_F_RECYCLE_ENTRIES;
+        hrecls_t                hSrch;
+        recls_rc_t              rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), flags, &hSrch);
+        size_t                  n       =   0;
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+        recls_entry_t entry;
+
+        for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry), ++n)
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(split_directory_(directory_of_(entry)) == directory_parts_of_(entry));
+
+            recls::Recls_CloseDetails(entry);
+        }
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_entries), n);
+
+        recls::Recls_SearchClose(hSrch);
+    }
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
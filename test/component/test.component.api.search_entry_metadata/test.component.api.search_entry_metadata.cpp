@@ -0,0 +1,508 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_entry_metadata/test.component.api.search_entry_metadata.cpp
+ *
+ * Purpose: Test that the metadata of the entries of searches - which, on
+ *          Linux, is obtained via statx(), requesting only the fields
+ *          implied by the search flags - is that of the files.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+#if defined(__linux__)
+# include <fcntl.h>
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+
+    typedef std::vector<recls_entry_t>                      entries_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The files of the tree, and their sizes */
+    struct file_t
+    {
+        recls_char_t const* path;
+        size_t              size;
+    };
+
+    file_t const s_files[] =
+    {
+            { RECLS_LITERAL("a.bin"),       1 }
+        ,   { RECLS_LITERAL("b.bin"),       1000 }
+        ,   { RECLS_LITERAL("sub/c.bin"),   0 }
+        ,   { RECLS_LITERAL("sub/d.bin"),   65537 }
+    };
+
+    /* The number of directories in the tree */
+    static size_t const s_numDirectories = 1;
+
+    /* Each case is performed by the default traversal (which is the
+     * single-pass traversal, where available), and by the portable
+     * traversal
+     */
+    static recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+    static recls_uint32_t const s_searchFlags = recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_entry_metadata", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, the files of s_files, returning the path of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("sub")));
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            recls_test::create_file(path_t(root).push(s_files[i].path), s_files[i].size);
+        }
+
+        return root;
+    }
+
+    /* The entries of a search of the given directory, in order */
+    entries_t
+    search_entries_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    )
+    {
+        entries_t       entries;
+        hrecls_t        hSrch;
+        recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), flags, &hSrch);
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+        {
+            recls_entry_t entry;
+
+            for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+            {
+                entries.push_back(entry);
+            }
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return entries;
+    }
+
+    /* Releases each of the given entries */
+    void
+    release_entries_(
+        entries_t const& entries
+    )
+    {
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            recls::Recls_CloseDetails(entries[i]);
+        }
+    }
+
+#if defined(__linux__)
+
+    /* Obtains the status of the file of the given entry */
+    bool
+    stat_entry_(
+        recls_entry_t   entry
+    ,   struct stat*    st
+    )
+    {
+        return XTESTS_TEST_INTEGER_EQUAL(0, ::stat(recls_test::path_of(entry).c_str(), st));
+    }
+#endif /* __linux__ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // the sizes, times and types of the entries are those of the files
+
+#if defined(__linux__)
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_0"));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[t] | s_searchFlags);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size());
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            struct stat st;
+
+            if (stat_entry_(entries[i], &st))
+            {
+                XTESTS_TEST_BOOLEAN_EQUAL(S_ISDIR(st.st_mode), recls::Recls_IsFileDirectory(entries[i]));
+                XTESTS_TEST_BOOLEAN_TRUE(st.st_mtime == entries[i]->modificationTime);
+                XTESTS_TEST_BOOLEAN_TRUE(st.st_ctime == entries[i]->lastStatusChangeTime);
+
+                // the search itself accesses the directories
+                if (!S_ISDIR(st.st_mode))
+                {
+                    XTESTS_TEST_BOOLEAN_TRUE(st.st_atime == entries[i]->lastAccessTime);
+                    XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(st.st_size), entries[i]->size);
+                }
+            }
+        }
+
+        release_entries_(entries);
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_1()
+{
+    // the nanosecond parts of the times of the entries are those of the
+    // files
+
+#if defined(__linux__)
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_1"));
+    path_t const    file    =   path_t(root).push(s_files[0].path);
+    struct timespec times[2];
+
+    times[0].tv_sec     =   1000000000;
+    times[0].tv_nsec    =   123456789;
+    times[1].tv_sec     =   1000000001;
+    times[1].tv_nsec    =   987654321;
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::utimensat(AT_FDCWD, file.c_str(), times, 0)));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[t] | s_searchFlags);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size());
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            struct stat st;
+
+            if (stat_entry_(entries[i], &st))
+            {
+                XTESTS_TEST_INTEGER_EQUAL(recls_uint32_t(st.st_mtim.tv_nsec), recls::Recls_GetModificationTimeNsec(entries[i]));
+                XTESTS_TEST_INTEGER_EQUAL(recls_uint32_t(st.st_ctim.tv_nsec), recls::Recls_GetLastStatusChangeTimeNsec(entries[i]));
+
+                if (!S_ISDIR(st.st_mode))
+                {
+                    XTESTS_TEST_INTEGER_EQUAL(recls_uint32_t(st.st_atim.tv_nsec), recls::Recls_GetLastAccessTimeNsec(entries[i]));
+                }
+            }
+        }
+
+        release_entries_(entries);
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_2()
+{
+    // without RECLS_F_LINK_COUNT and RECLS_F_NODE_INDEX, the link counts
+    // and node indexes are not provided
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_2"));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[t] | s_searchFlags);
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories, entries.size());
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_t(0), entries[i]->numLinks);
+            XTESTS_TEST_INTEGER_EQUAL(recls::recls_uint64_t(0), entries[i]->nodeIndex);
+        }
+
+        release_entries_(entries);
+    }
+}
+
+static void test_1_3()
+{
+    // with RECLS_F_LINK_COUNT, the link counts are those of the files,
+    // including of a file with two (hard) links
+
+#if defined(__linux__)
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_3"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::link(path_t(root).push(s_files[0].path).c_str(), path_t(root).push(RECLS_LITERAL("sub/link.bin")).c_str())));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        entries_t const entries     =   search_entries_(root, s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_LINK_COUNT);
+        size_t          numLinked   =   0;
+
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories + 1u, entries.size());
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            struct stat st;
+
+            if (stat_entry_(entries[i], &st))
+            {
+                XTESTS_TEST_INTEGER_EQUAL(size_t(st.st_nlink), entries[i]->numLinks);
+
+                if (!S_ISDIR(st.st_mode) &&
+                    2 == entries[i]->numLinks)
+                {
+                    ++numLinked;
+                }
+            }
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2), numLinked);
+
+        release_entries_(entries);
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_4()
+{
+    // with RECLS_F_NODE_INDEX, the node indexes and device identifiers are
+    // those of the files, and the (hard) links of a file share its node
+    // index
+
+#if defined(__linux__)
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_4"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::link(path_t(root).push(s_files[0].path).c_str(), path_t(root).push(RECLS_LITERAL("sub/link.bin")).c_str())));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        entries_t const entries = search_entries_(root, s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_NODE_INDEX);
+        struct stat     linked;
+
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::stat(path_t(root).push(s_files[0].path).c_str(), &linked)));
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + s_numDirectories + 1u, entries.size());
+
+        size_t numLinked = 0;
+
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            struct stat st;
+
+            if (stat_entry_(entries[i], &st))
+            {
+                XTESTS_TEST_INTEGER_EQUAL(recls::recls_uint64_t(st.st_ino), entries[i]->nodeIndex);
+                XTESTS_TEST_INTEGER_EQUAL(size_t(st.st_dev), entries[i]->deviceId);
+
+                if (recls::recls_uint64_t(linked.st_ino) == entries[i]->nodeIndex)
+                {
+                    ++numLinked;
+                }
+            }
+        }
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2), numLinked);
+
+        release_entries_(entries);
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_5()
+{
+    // with RECLS_F_NO_FOLLOW_LINKS and RECLS_F_LINKS, the metadata of a
+    // (symbolic) link is that of the link, rather than of its target
+
+#if defined(__linux__)
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_5"));
+    path_t const link = path_t(root).push(RECLS_LITERAL("link"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(s_files[3].path, link.c_str())));
+
+    entries_t const entries = search_entries_(root, recls::RECLS_F_FILES | recls::RECLS_F_LINKS | recls::RECLS_F_NO_FOLLOW_LINKS);
+    struct stat     st;
+    size_t          index   =   entries.size();
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::lstat(link.c_str(), &st)));
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        if (RECLS_LITERAL("link") == recls_test::file_name_of(entries[i]))
+        {
+            index = i;
+        }
+    }
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_NOT_EQUAL(entries.size(), index));
+
+    XTESTS_TEST_BOOLEAN_TRUE(recls::Recls_IsFileLink(entries[index]));
+    XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(st.st_size), entries[index]->size);
+    XTESTS_TEST_BOOLEAN_TRUE(st.st_mtime == entries[index]->modificationTime);
+
+    release_entries_(entries);
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
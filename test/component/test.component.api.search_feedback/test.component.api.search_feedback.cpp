@@ -0,0 +1,510 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_feedback/test.component.api.search_feedback.cpp
+ *
+ * Purpose: Test skipping of directories, and cancellation of searches, by
+ *          the progress function (via recls C API function
+ *          `Recls_SearchFeedback()`), for each traversal.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+    static void test_1_8(void);
+    static void test_1_9(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+    /* The state of the progress function, which skips, or cancels the
+     * search at, the directory of the given name
+     */
+    struct progress_state_t
+    {
+        recls_char_t const* skipName;
+        recls_char_t const* cancelName;
+        strings_t           directories;    // Names of those reported
+        bool                cancelled;
+        int                 numAfterCancel; // Should always be 0
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    // The search is performed with each traversal: the default (which is
+    // the single-pass traversal, where available) and the portable
+    // traversal
+    recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_feedback", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+        XTESTS_RUN_CASE(test_1_8);
+        XTESTS_RUN_CASE(test_1_9);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, within the temporary directory, the tree:
+     *
+     *  <name>/a.txt
+     *  <name>/sub1/b.txt
+     *  <name>/sub2/c.txt
+     *  <name>/sub2/sub3/d.txt
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        static recls_char_t const* const entries[] =
+        {
+                RECLS_LITERAL("a.txt")
+            ,   RECLS_LITERAL("sub1/b.txt")
+            ,   RECLS_LITERAL("sub2/c.txt")
+            ,   RECLS_LITERAL("sub2/sub3/d.txt")
+        };
+
+        return recls_test::create_tree(temp_dir, name, entries);
+    }
+
+    /* Obtains the last part of the given directory path, which has a
+     * trailing path-name separator
+     */
+    string_t
+    directory_name_(
+        recls_char_t const* dir
+    ,   size_t              dirLen
+    )
+    {
+        recls_char_t const* const   end =   dir + (dirLen - 1);
+        recls_char_t const*         p   =   end;
+
+        for (; p != dir && !traits_t::is_path_name_separator(p[-1]); --p)
+        {}
+
+        return string_t(p, end);
+    }
+
+    int RECLS_CALLCONV_DEFAULT
+    progress_fn_(
+        recls_char_t const*         dir
+    ,   size_t                      dirLen
+    ,   recls::recls_process_fn_param_t param
+    ,   void*                       /* reserved0 */
+    ,   recls_uint32_t              /* reserved1 */
+    )
+    {
+        progress_state_t* const state   =   static_cast<progress_state_t*>(param);
+        string_t const          name    =   directory_name_(dir, dirLen);
+
+        if (state->cancelled)
+        {
+            ++state->numAfterCancel;
+        }
+
+        state->directories.push_back(name);
+
+        if (NULL != state->cancelName &&
+            name == state->cancelName)
+        {
+            state->cancelled = true;
+
+            return recls::RECLS_PROGRESS_CANCEL;
+        }
+
+        if (NULL != state->skipName &&
+            name == state->skipName)
+        {
+            return recls::RECLS_PROGRESS_SKIP_DIRECTORY;
+        }
+
+        return recls::RECLS_PROGRESS_CONTINUE;
+    }
+
+    /* Searches the given root for all files, recursively, recording the
+     * names of the files found, and returning the status code that ended
+     * the search: RECLS_RC_NO_MORE_DATA if it ran to completion
+     */
+    recls_rc_t
+    search_(
+        path_t const&       root
+    ,   recls_uint32_t      traversalFlags
+    ,   progress_state_t*   state
+    ,   strings_t*          files
+    )
+    {
+        recls_uint32_t const    flags   =   recls::RECLS_F_FILES
+                                        |   recls::RECLS_F_RECURSIVE
+                                        |   recls::RECLS_F_DIR_PROGRESS
+                                        |   traversalFlags
+                                        ;
+        hrecls_t                hSrch;
+        recls_rc_t              rc      =   recls::Recls_SearchFeedback(root.c_str(), RECLS_LITERAL("*.txt"), flags, progress_fn_, state, &hSrch);
+
+        if (RECLS_RC_OK == rc)
+        {
+            do
+            {
+                recls_entry_t entry;
+
+                rc = recls::Recls_GetDetails(hSrch, &entry);
+
+                if (RECLS_RC_OK == rc)
+                {
+                    files->push_back(string_t(entry->fileName.begin, entry->fileName.end));
+
+                    recls::Recls_CloseDetails(entry);
+
+                    rc = recls::Recls_GetNext(hSrch);
+                }
+
+            } while (RECLS_RC_OK == rc);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return rc;
+    }
+
+    bool
+    contains_(
+        strings_t const&    strings
+    ,   recls_char_t const* s
+    )
+    {
+        for (strings_t::const_iterator b = strings.begin(); b != strings.end(); ++b)
+        {
+            if (*b == s)
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    progress_state_t
+    make_state_(
+        recls_char_t const* skipName
+    ,   recls_char_t const* cancelName
+    )
+    {
+        progress_state_t state;
+
+        state.skipName          =   skipName;
+        state.cancelName        =   cancelName;
+        state.cancelled         =   false;
+        state.numAfterCancel    =   0;
+
+        return state;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // continue: all directories are reported, and all files found
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_0"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(NULL, NULL);
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(4), state.directories.size());
+        XTESTS_TEST_INTEGER_EQUAL(size_t(4), files.size());
+    }
+}
+
+static void test_1_1()
+{
+    // skip a sub-directory: neither its files nor its sub-directories are
+    // searched
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_1"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(RECLS_LITERAL("sub2"), NULL);
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(3), state.directories.size());
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(state.directories, RECLS_LITERAL("sub3")));
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2), files.size());
+        XTESTS_TEST_BOOLEAN_TRUE(contains_(files, RECLS_LITERAL("a.txt")));
+        XTESTS_TEST_BOOLEAN_TRUE(contains_(files, RECLS_LITERAL("b.txt")));
+    }
+}
+
+static void test_1_2()
+{
+    // skip a leaf sub-directory
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_2"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(RECLS_LITERAL("sub3"), NULL);
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(4), state.directories.size());
+        XTESTS_TEST_INTEGER_EQUAL(size_t(3), files.size());
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("d.txt")));
+    }
+}
+
+static void test_1_3()
+{
+    // skip the search root: the search finds no entries
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_3"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(RECLS_LITERAL("test_1_3"), NULL);
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(1), state.directories.size());
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), files.size());
+    }
+}
+
+static void test_1_4()
+{
+    // cancel at the search root
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_4"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(NULL, RECLS_LITERAL("test_1_4"));
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(1), state.directories.size());
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), files.size());
+    }
+}
+
+static void test_1_5()
+{
+    // cancel at a sub-directory: the search ends, rather than continuing
+    // with the remaining directories
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_5"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(NULL, RECLS_LITERAL("sub2"));
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, rc);
+        XTESTS_TEST_BOOLEAN_TRUE(state.cancelled);
+        XTESTS_TEST_INTEGER_EQUAL(0, state.numAfterCancel);
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(state.directories, RECLS_LITERAL("sub3")));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("c.txt")));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("d.txt")));
+    }
+}
+
+static void test_1_6()
+{
+    // cancel at a leaf sub-directory
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_6"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(NULL, RECLS_LITERAL("sub3"));
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, rc);
+        XTESTS_TEST_BOOLEAN_TRUE(state.cancelled);
+        XTESTS_TEST_INTEGER_EQUAL(0, state.numAfterCancel);
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("d.txt")));
+    }
+}
+
+static void test_1_7()
+{
+    // skip one sub-directory and cancel at another
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_7"));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++i)
+    {
+        progress_state_t    state   =   make_state_(RECLS_LITERAL("sub2"), RECLS_LITERAL("sub1"));
+        strings_t           files;
+        recls_rc_t const    rc      =   search_(root, s_traversalFlags[i], &state, &files);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_USER_CANCELLED_SEARCH, rc);
+        XTESTS_TEST_INTEGER_EQUAL(0, state.numAfterCancel);
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(state.directories, RECLS_LITERAL("sub3")));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("b.txt")));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("c.txt")));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_(files, RECLS_LITERAL("d.txt")));
+    }
+}
+
+static void test_1_8()
+{
+}
+
+static void test_1_9()
+{
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
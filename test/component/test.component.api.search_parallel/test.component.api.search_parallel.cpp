@@ -0,0 +1,443 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_parallel/test.component.api.search_parallel.cpp
+ *
+ * Purpose: Test that a parallel search (`Recls_SearchParallel()`) finds
+ *          the same entries as a sequential search (`Recls_Search()`), in
+ *          the same order when deterministic, with and without
+ *          `RECLS_F_UNSORTED`.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <set>
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_parallel", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    recls_char_t const* const   s_entries[] =
+    {
+            RECLS_LITERAL("a.txt")
+        ,   RECLS_LITERAL("b.dat")
+        ,   RECLS_LITERAL("c")
+        ,   RECLS_LITERAL("empty/")
+        ,   RECLS_LITERAL("sub1/d.txt")
+        ,   RECLS_LITERAL("sub1/e.dat")
+        ,   RECLS_LITERAL("sub1/deeper/f.txt")
+        ,   RECLS_LITERAL("sub1/deeper/g.txt")
+        ,   RECLS_LITERAL("sub1/deeper/deepest/h.txt")
+        ,   RECLS_LITERAL("sub2/i.txt")
+        ,   RECLS_LITERAL("sub2/j/k.dat")
+        ,   RECLS_LITERAL("sub2/j/l.txt")
+        ,   RECLS_LITERAL("sub2/m/")
+        ,   RECLS_LITERAL("sub3/n.txt")
+    };
+
+    recls_uint32_t const        s_flags[] =
+    {
+            recls::RECLS_F_FILES
+        ,   recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE
+        ,   recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE
+        ,   recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE
+    };
+
+    recls_uint32_t const        s_numThreads[] =
+    {
+            1
+        ,   2
+        ,   8
+    };
+
+    /* Searches the given root in parallel, appending the paths of the
+     * entries found, in the order presented, to \c paths, and returning
+     * the status code that ended the search
+     */
+    recls_rc_t
+    search_parallel_paths_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    ,   recls_uint32_t      numThreads
+    ,   recls_uint32_t      parallelFlags
+    ,   strings_t*          paths
+    )
+    {
+        recls::hrecls_t hSrch;
+        recls_rc_t      rc      =   recls::Recls_SearchParallel(root.c_str(), pattern, flags, numThreads, parallelFlags, &hSrch);
+
+        if (RECLS_RC_OK == rc)
+        {
+            rc = recls_test::enumerate_paths(hSrch, paths);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return rc;
+    }
+
+    /* The directory containing the entry with the given path */
+    string_t
+    directory_of_(
+        string_t const& path
+    )
+    {
+        string_t::size_type n = path.size();
+
+        // A directory entry may have a trailing separator
+        if (0 != n &&
+            recls_test::traits_t::is_path_name_separator(path[n - 1]))
+        {
+            --n;
+        }
+
+        for (; 0 != n && !recls_test::traits_t::is_path_name_separator(path[n - 1]); --n)
+        {}
+
+        return path.substr(0, n);
+    }
+
+    /* Verifies that the entries of each directory are presented together
+     * and, if \c sorted, in name order
+     */
+    void
+    verify_grouped_(
+        strings_t const&    paths
+    ,   bool                sorted
+    )
+    {
+        std::set<string_t>  finished;
+        string_t            current;
+
+        for (size_t i = 0; i != paths.size(); ++i)
+        {
+            string_t const dir = directory_of_(paths[i]);
+
+            if (0 == i ||
+                dir != current)
+            {
+                XTESTS_TEST_BOOLEAN_TRUE(finished.insert(dir).second);
+
+                current = dir;
+            }
+            else if (sorted)
+            {
+                XTESTS_TEST_BOOLEAN_TRUE(paths[i - 1] < paths[i]);
+            }
+        }
+    }
+
+    /* Searches the given root sequentially and in parallel, with the given
+     * parallel flags and each of a number of thread counts, verifying that
+     * each search runs to completion and finds the same entries as the
+     * sequential search, in the same order if deterministic
+     */
+    void
+    compare_searches_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    ,   recls_uint32_t      parallelFlags
+    )
+    {
+        bool const  deterministic   =   0 != (recls::RECLS_PARALLEL_F_DETERMINISTIC & parallelFlags);
+        bool const  sorted          =   0 == (recls::RECLS_F_UNSORTED & flags);
+        strings_t   sequential      =   recls_test::search_paths(root, pattern, flags);
+        strings_t   sequentialSet(sequential);
+
+        std::sort(sequentialSet.begin(), sequentialSet.end());
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_numThreads); ++i)
+        {
+            strings_t parallel;
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, search_parallel_paths_(root, pattern, flags, s_numThreads[i], parallelFlags, &parallel));
+
+            XTESTS_TEST_INTEGER_EQUAL(sequential.size(), parallel.size());
+
+            if (deterministic)
+            {
+                // A directory is read in the same order by both, so the
+                // order is the same even when unsorted
+                XTESTS_TEST_BOOLEAN_TRUE(sequential == parallel);
+            }
+            else
+            {
+                verify_grouped_(parallel, sorted);
+
+                std::sort(parallel.begin(), parallel.end());
+
+                XTESTS_TEST_BOOLEAN_TRUE(sequentialSet == parallel);
+            }
+        }
+    }
+
+    /* Creates, within the directory \c parent, the directory \c name
+     * containing \c n directories, each of which contains \c n
+     * directories, each containing a single file, returning its path
+     */
+    path_t
+    create_wide_tree_(
+        path_t const&       parent
+    ,   recls_char_t const* name
+    ,   size_t              n
+    )
+    {
+        path_t root(parent);
+
+        root.push(name);
+
+        for (size_t i = 0; i != n; ++i)
+        {
+            recls_char_t dir[] = RECLS_LITERAL("d00");
+
+            dir[1] = static_cast<recls_char_t>('0' + (i / 10) % 10);
+            dir[2] = static_cast<recls_char_t>('0' + i % 10);
+
+            path_t const d = path_t(root).push(dir);
+
+            for (size_t j = 0; j != n; ++j)
+            {
+                recls_char_t sub[] = RECLS_LITERAL("e00");
+
+                sub[1] = static_cast<recls_char_t>('0' + (j / 10) % 10);
+                sub[2] = static_cast<recls_char_t>('0' + j % 10);
+
+                recls_test::create_numbered_files(d, sub, 1);
+            }
+        }
+
+        return root;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // deterministic, sorted
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_flags); ++i)
+    {
+        compare_searches_(root, RECLS_LITERAL("*"), s_flags[i], recls::RECLS_PARALLEL_F_DETERMINISTIC);
+        compare_searches_(root, RECLS_LITERAL("*.txt"), s_flags[i], recls::RECLS_PARALLEL_F_DETERMINISTIC);
+    }
+}
+
+static void test_1_1()
+{
+    // deterministic, unsorted
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_flags); ++i)
+    {
+        compare_searches_(root, RECLS_LITERAL("*"), s_flags[i] | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_DETERMINISTIC);
+        compare_searches_(root, RECLS_LITERAL("*.txt"), s_flags[i] | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_DETERMINISTIC);
+    }
+}
+
+static void test_1_2()
+{
+    // unordered, sorted
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_flags); ++i)
+    {
+        compare_searches_(root, RECLS_LITERAL("*"), s_flags[i], recls::RECLS_PARALLEL_F_UNORDERED);
+        compare_searches_(root, RECLS_LITERAL("*.txt"), s_flags[i], recls::RECLS_PARALLEL_F_UNORDERED);
+    }
+}
+
+static void test_1_3()
+{
+    // unordered, unsorted
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_flags); ++i)
+    {
+        compare_searches_(root, RECLS_LITERAL("*"), s_flags[i] | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_UNORDERED);
+        compare_searches_(root, RECLS_LITERAL("*.txt"), s_flags[i] | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_UNORDERED);
+    }
+}
+
+static void test_1_4()
+{
+    // more directories than are held ahead of presentation
+
+    path_t const    root    =   create_wide_tree_(temp_dir, RECLS_LITERAL("test_1_4"), 24);
+    recls_uint32_t  flags   =   recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+    compare_searches_(root, RECLS_LITERAL("*"), flags, recls::RECLS_PARALLEL_F_DETERMINISTIC);
+    compare_searches_(root, RECLS_LITERAL("*"), flags, recls::RECLS_PARALLEL_F_UNORDERED);
+    compare_searches_(root, RECLS_LITERAL("*"), flags | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_DETERMINISTIC);
+    compare_searches_(root, RECLS_LITERAL("*"), flags | recls::RECLS_F_UNSORTED, recls::RECLS_PARALLEL_F_UNORDERED);
+}
+
+static void test_1_5()
+{
+    // more directories than are held ahead of presentation, the search
+    // being abandoned part-way
+
+    path_t const    root    =   create_wide_tree_(temp_dir, RECLS_LITERAL("test_1_5"), 24);
+    recls_uint32_t  flags   =   recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE;
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_numThreads); ++i)
+    {
+        recls::hrecls_t hSrch;
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_SearchParallel(root.c_str(), RECLS_LITERAL("*"), flags, s_numThreads[i], recls::RECLS_PARALLEL_F_DETERMINISTIC, &hSrch)));
+
+        for (size_t n = 0; n != 10; ++n)
+        {
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetNext(hSrch));
+        }
+
+        recls::Recls_SearchClose(hSrch);
+    }
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,393 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_reset/test.component.api.search_reset.cpp
+ *
+ * Purpose: Test restarting of searches (via recls C API function
+ *          `Recls_SearchReset()`) part way through their enumeration.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_reset", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    recls_uint32_t const    s_flags =   recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE;
+
+    /* Creates the directory of the given name within the temporary
+     * directory, containing numFiles files named "f0.txt", "f1.txt", ...,
+     * half of them (rounded down) in a sub-directory "sub"
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    ,   size_t              numFiles
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        path_t sub(root);
+
+        sub.push(RECLS_LITERAL("sub"));
+
+        recls_test::create_directory(sub);
+
+        for (size_t i = 0; i != numFiles; ++i)
+        {
+            recls_char_t file[] = RECLS_LITERAL("f0.txt");
+
+            file[1] = static_cast<recls_char_t>('0' + i % 10);
+
+            recls_test::create_file(path_t(0 == i % 2 ? root : sub).push(file));
+        }
+
+        return root;
+    }
+
+    /* Enumerates the remaining entries of the given search, which is
+     * positioned on an entry, returning their paths
+     */
+    strings_t
+    enumerate_(
+        hrecls_t hSrch
+    )
+    {
+        strings_t paths;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls_test::enumerate_paths(hSrch, &paths));
+
+        return paths;
+    }
+
+    /* Commences a search of the given root, and advances it by the given
+     * number of entries
+     */
+    hrecls_t
+    search_part_way_(
+        path_t const&   root
+    ,   size_t          numEntries
+    )
+    {
+        hrecls_t    hSrch   =   NULL;
+        recls_rc_t  rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*.txt"), s_flags, &hSrch);
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+        {
+            for (size_t i = 0; i != numEntries; ++i)
+            {
+                XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetNext(hSrch));
+            }
+        }
+
+        return hSrch;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // reset to the same root and pattern, mid-enumeration
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_0"), 6);
+    strings_t const all     =   recls_test::search_paths(root, RECLS_LITERAL("*.txt"), s_flags);
+    hrecls_t const  hSrch   =   search_part_way_(root, 2);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, NULL, NULL);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetLastError(hSrch));
+
+    if (RECLS_RC_OK == rc)
+    {
+        strings_t const paths = enumerate_(hSrch);
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(6), all.size());
+        XTESTS_TEST_BOOLEAN_TRUE(all == paths);
+    }
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_1()
+{
+    // reset to a different, valid, root, mid-enumeration
+
+    path_t const    root1   =   create_tree_(RECLS_LITERAL("test_1_1_a"), 6);
+    path_t const    root2   =   create_tree_(RECLS_LITERAL("test_1_1_b"), 3);
+    strings_t const all2    =   recls_test::search_paths(root2, RECLS_LITERAL("*.txt"), s_flags);
+    hrecls_t const  hSrch   =   search_part_way_(root1, 3);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, root2.c_str(), NULL);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetLastError(hSrch));
+
+    if (RECLS_RC_OK == rc)
+    {
+        strings_t const paths = enumerate_(hSrch);
+
+        XTESTS_TEST_INTEGER_EQUAL(size_t(3), all2.size());
+        XTESTS_TEST_BOOLEAN_TRUE(all2 == paths);
+    }
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_2()
+{
+    // reset to a non-existent root, mid-enumeration
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_2"), 6);
+    path_t          missing(temp_dir);
+    hrecls_t const  hSrch   =   search_part_way_(root, 2);
+
+    missing.push(RECLS_LITERAL("test_1_2_missing"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, missing.c_str(), NULL);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_DIRECTORY_NOT_FOUND, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_DIRECTORY_NOT_FOUND, recls::Recls_GetLastError(hSrch));
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_3()
+{
+    // reset to a root that is a file, mid-enumeration
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_3"), 6);
+    path_t          file(root);
+    hrecls_t const  hSrch   =   search_part_way_(root, 2);
+
+    file.push(RECLS_LITERAL("f0.txt"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, file.c_str(), NULL);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_PATH_IS_NOT_DIRECTORY, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_PATH_IS_NOT_DIRECTORY, recls::Recls_GetLastError(hSrch));
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_4()
+{
+    // reset with a pattern rejected before the search is restarted,
+    // mid-enumeration: the enumeration is ended, and the last error is
+    // that of the reset
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_4"), 6);
+    hrecls_t const  hSrch   =   search_part_way_(root, 2);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, NULL, RECLS_LITERAL(""));
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls::Recls_GetLastError(hSrch));
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_5()
+{
+    // a search that fails to reset may be reset again
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_5"), 6);
+    strings_t const all     =   recls_test::search_paths(root, RECLS_LITERAL("*.txt"), s_flags);
+    path_t          missing(temp_dir);
+    hrecls_t const  hSrch   =   search_part_way_(root, 4);
+
+    missing.push(RECLS_LITERAL("test_1_5_missing"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_DIRECTORY_NOT_FOUND, recls::Recls_SearchReset(hSrch, missing.c_str(), NULL));
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls::Recls_SearchReset(hSrch, NULL, RECLS_LITERAL("")));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, root.c_str(), RECLS_LITERAL("*.txt"));
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_GetLastError(hSrch));
+
+    if (RECLS_RC_OK == rc)
+    {
+        strings_t const paths = enumerate_(hSrch);
+
+        XTESTS_TEST_BOOLEAN_TRUE(all == paths);
+    }
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+static void test_1_6()
+{
+    // reset to a valid root with no matching entries, mid-enumeration
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_6"), 6);
+    path_t const    empty   =   create_tree_(RECLS_LITERAL("test_1_6_empty"), 0);
+    hrecls_t const  hSrch   =   search_part_way_(root, 2);
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, hSrch));
+
+    recls_rc_t const rc = recls::Recls_SearchReset(hSrch, empty.c_str(), NULL);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls::Recls_GetLastError(hSrch));
+
+    recls::Recls_SearchClose(hSrch);
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,373 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_same_device/test.component.api.search_same_device.cpp
+ *
+ * Purpose: Test that searches confined to the device of the search
+ *          directory (`RECLS_F_SAME_DEVICE`) find the same entries as
+ *          those that are not within a single device, and report, but do
+ *          not descend into, directories on another device.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <string>
+
+/* Standard C header files */
+#include <stdlib.h>
+#if defined(__linux__)
+# include <sys/stat.h>
+# include <unistd.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::hrecls_t;
+    using recls::recls_char_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    recls_char_t const* const   s_entries[] =
+    {
+            RECLS_LITERAL("a.txt")
+        ,   RECLS_LITERAL("b.dat")
+        ,   RECLS_LITERAL("empty/")
+        ,   RECLS_LITERAL("sub/c.txt")
+        ,   RECLS_LITERAL("sub/deeper/d.txt")
+        ,   RECLS_LITERAL("other/e.txt")
+    };
+
+    /* The number of entries of the tree: its five files, and the
+     * directories "empty", "sub", "sub/deeper", and "other"
+     */
+    static size_t const         s_numEntries = 9;
+
+    /* Each case is performed by the default traversal (which is the
+     * single-pass traversal, where available), and by the portable
+     * traversal
+     */
+    static recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+    static recls_uint32_t const s_searchFlags = recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_same_device", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Searches the given root in parallel, returning the paths of the
+     * entries found, in order
+     */
+    strings_t
+    search_paths_parallel_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    )
+    {
+        strings_t   paths;
+        hrecls_t    hSrch;
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_SearchParallel(root.c_str(), RECLS_LITERAL("*"), flags, 4, recls::RECLS_PARALLEL_F_DETERMINISTIC, &hSrch)))
+        {
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls_test::enumerate_paths(hSrch, &paths));
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return paths;
+    }
+
+    /* Indicates whether the given paths include one that begins with the
+     * given prefix, and is longer than it
+     */
+    bool
+    contains_below_(
+        strings_t const&    paths
+    ,   string_t const&     prefix
+    )
+    {
+        for (strings_t::const_iterator b = paths.begin(); b != paths.end(); ++b)
+        {
+            string_t const& path = *b;
+
+            if (path.size() > prefix.size() &&
+                0 == path.compare(0, prefix.size(), prefix))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+#if defined(__linux__)
+
+    /* Finds a directory that is on a different device from the temporary
+     * directory, and that has entries, returning the empty string if there
+     * is none
+     */
+    string_t
+    find_other_device_directory_()
+    {
+        recls_char_t const* const candidates[] =
+        {
+                RECLS_LITERAL("/dev/pts")
+            ,   RECLS_LITERAL("/dev/shm")
+            ,   RECLS_LITERAL("/dev")
+        };
+
+        struct stat st;
+
+        if (0 != ::stat(temp_dir.c_str(), &st))
+        {
+            return string_t();
+        }
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(candidates); ++i)
+        {
+            struct stat stCandidate;
+            strings_t   paths;
+
+            if (0 == ::stat(candidates[i], &stCandidate) &&
+                S_ISDIR(stCandidate.st_mode) &&
+                stCandidate.st_dev != st.st_dev &&
+                RECLS_RC_NO_MORE_DATA == recls_test::search_paths(path_t(candidates[i]), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES, &paths) &&
+                !paths.empty())
+            {
+                return candidates[i];
+            }
+        }
+
+        return string_t();
+    }
+#endif /* __linux__ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // within a single device, the entries are those found without the
+    // flag, in the same order
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths       =   recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_SAME_DEVICE);
+        strings_t const expected    =   recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags);
+
+        XTESTS_TEST_INTEGER_EQUAL(s_numEntries, paths.size());
+        XTESTS_TEST_BOOLEAN_TRUE(expected == paths);
+    }
+}
+
+static void test_1_1()
+{
+    // within a single device, a parallel search finds the entries found
+    // without the flag
+
+    path_t const    root        =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+    strings_t const paths       =   search_paths_parallel_(root, s_searchFlags | recls::RECLS_F_SAME_DEVICE);
+    strings_t const expected    =   search_paths_parallel_(root, s_searchFlags);
+
+    XTESTS_TEST_INTEGER_EQUAL(s_numEntries, paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(expected == paths);
+}
+
+static void test_1_2()
+{
+    // a directory on the same device, reached by a link, is descended
+
+#if defined(__linux__)
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+    path_t const link = path_t(root).push(RECLS_LITERAL("link"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(path_t(root).push(RECLS_LITERAL("sub")).c_str(), link.c_str())));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths = recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_SAME_DEVICE);
+
+        // link, link/c.txt, link/deeper, and link/deeper/d.txt
+        XTESTS_TEST_INTEGER_EQUAL(s_numEntries + 4u, paths.size());
+        XTESTS_TEST_BOOLEAN_TRUE(paths.end() != std::find(paths.begin(), paths.end(), string_t(path_t(link).push(RECLS_LITERAL("deeper/d.txt")).c_str())));
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_3()
+{
+    // a directory on another device, reached by a link, is reported, but
+    // is not descended
+
+#if defined(__linux__)
+    string_t const other = find_other_device_directory_();
+
+    if (other.empty())
+    {
+        // there is no directory on another device
+
+        XTESTS_TEST_PASSED();
+
+        return;
+    }
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+    path_t const    link    =   path_t(root).push(RECLS_LITERAL("mount"));
+    string_t const  prefix  =   string_t(link.c_str()) + RECLS_LITERAL("/");
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(other.c_str(), link.c_str())));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths = recls_test::search_paths(root, RECLS_LITERAL("*"), s_traversalFlags[t] | s_searchFlags | recls::RECLS_F_SAME_DEVICE);
+
+        XTESTS_TEST_INTEGER_EQUAL(s_numEntries + 1u, paths.size());
+        XTESTS_TEST_BOOLEAN_TRUE(paths.end() != std::find(paths.begin(), paths.end(), string_t(link.c_str())));
+        XTESTS_TEST_BOOLEAN_FALSE(contains_below_(paths, prefix));
+    }
+
+    strings_t const paths = search_paths_parallel_(root, s_searchFlags | recls::RECLS_F_SAME_DEVICE);
+
+    XTESTS_TEST_INTEGER_EQUAL(s_numEntries + 1u, paths.size());
+    XTESTS_TEST_BOOLEAN_FALSE(contains_below_(paths, prefix));
+
+    // the link is removed, so that the removal of the temporary directory
+    // cannot reach the other device
+    ::unlink(link.c_str());
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -0,0 +1,390 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_traversal/test.component.api.search_traversal.cpp
+ *
+ * Purpose: Test that the single-pass traversal (on Linux) finds the same
+ *          entries, and fails in the same way, as the portable traversal
+ *          (selected by `RECLS_F_PORTABLE_TRAVERSAL`).
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+#if defined(__linux__)
+# include <unistd.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_FAIL;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_traversal", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    recls_char_t const* const   s_entries[] =
+    {
+            RECLS_LITERAL("a.txt")
+        ,   RECLS_LITERAL("b.dat")
+        ,   RECLS_LITERAL("c")
+        ,   RECLS_LITERAL(".hidden.txt")
+        ,   RECLS_LITERAL("empty/")
+        ,   RECLS_LITERAL("sub/d.txt")
+        ,   RECLS_LITERAL("sub/e.dat")
+        ,   RECLS_LITERAL("sub/.f.txt")
+        ,   RECLS_LITERAL("sub/deeper/g.txt")
+        ,   RECLS_LITERAL(".dot/h.txt")
+        ,   RECLS_LITERAL(".dot/.i.txt")
+        ,   RECLS_LITERAL(".dot/j/k.dat")
+    };
+
+    /* Searches the given root with both traversals, verifying that each
+     * ends with the same status code and that they find the same entries,
+     * returning those found by the single-pass traversal
+     */
+    strings_t
+    compare_searches_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    )
+    {
+        strings_t           portable;
+        strings_t           singlePass;
+        recls_rc_t const    rcPortable      =   recls_test::search_paths(root, pattern, flags | recls::RECLS_F_PORTABLE_TRAVERSAL, &portable);
+        recls_rc_t const    rcSinglePass    =   recls_test::search_paths(root, pattern, flags, &singlePass);
+
+        XTESTS_TEST_POINTER_EQUAL(rcPortable, rcSinglePass);
+
+        // The order in which the traversals present the contents of a
+        // directory, relative to those of its sub-directories, is not
+        // compared
+        std::sort(portable.begin(), portable.end());
+        std::sort(singlePass.begin(), singlePass.end());
+
+        XTESTS_TEST_INTEGER_EQUAL(portable.size(), singlePass.size());
+        XTESTS_TEST_BOOLEAN_TRUE(portable == singlePass);
+
+        return singlePass;
+    }
+
+    /* Indicates whether the given paths include one ending in the given
+     * name
+     */
+    bool
+    contains_name_(
+        strings_t const&    paths
+    ,   recls_char_t const* name
+    )
+    {
+        string_t const  suffix(name);
+
+        for (strings_t::const_iterator b = paths.begin(); b != paths.end(); ++b)
+        {
+            string_t const& path = *b;
+
+            if (path.size() > suffix.size() &&
+                0 == path.compare(path.size() - suffix.size(), suffix.size(), suffix) &&
+                recls_test::traits_t::is_path_name_separator(path[path.size() - suffix.size() - 1]))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+#if defined(__linux__)
+
+    /* Creates, at the given path, a symbolic link to the given target */
+    void
+    create_link_(
+        path_t const&       path
+    ,   recls_char_t const* target
+    )
+    {
+        if (0 != ::symlink(target, path.c_str()))
+        {
+            XTESTS_TEST_FAIL_WITH_QUALIFIER("failed to create link", path);
+        }
+    }
+#endif /* __linux__ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // files, with a single pattern
+
+    path_t const root = recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+
+    compare_searches_(root, RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES);
+    compare_searches_(root, RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+    compare_searches_(root, RECLS_LITERAL("?.dat"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+}
+
+static void test_1_1()
+{
+    // files and directories, with multiple patterns
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+    string_t        pattern(RECLS_LITERAL("*.txt"));
+
+    pattern += recls::Recls_GetPathSeparator();
+    pattern += RECLS_LITERAL("c");
+    pattern += recls::Recls_GetPathSeparator();
+    pattern += RECLS_LITERAL("sub");
+
+    compare_searches_(root, pattern.c_str(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES);
+    compare_searches_(root, pattern.c_str(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+    compare_searches_(root, pattern.c_str(), recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+}
+
+static void test_1_2()
+{
+    // the wildcard matches no entry whose name begins with '.', in any
+    // directory
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+    strings_t const paths   =   compare_searches_(root, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(paths, RECLS_LITERAL("a.txt")));
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(paths, RECLS_LITERAL("g.txt")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(paths, RECLS_LITERAL(".hidden.txt")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(paths, RECLS_LITERAL(".f.txt")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(paths, RECLS_LITERAL(".dot")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(paths, RECLS_LITERAL(".i.txt")));
+}
+
+static void test_1_3()
+{
+    // files whose names begin with '.' are matched by patterns that begin
+    // with '.'
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+    strings_t const paths   =   compare_searches_(root, RECLS_LITERAL(".*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(paths, RECLS_LITERAL(".hidden.txt")));
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(paths, RECLS_LITERAL(".f.txt")));
+}
+
+static void test_1_4()
+{
+    // the root does not exist, or is not a directory
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_4"), s_entries);
+    path_t          missing(root);
+    path_t          file(root);
+
+    missing.push(RECLS_LITERAL("missing"));
+    file.push(RECLS_LITERAL("a.txt"));
+
+    compare_searches_(missing, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+    compare_searches_(file, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+}
+
+static void test_1_5()
+{
+    // links to a file and to a directory, followed and not followed
+
+#if defined(__linux__)
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_5"), s_entries);
+    path_t          linkDir(root);
+    path_t          linkFile(root);
+
+    create_link_(linkDir.push(RECLS_LITERAL("link-sub")), RECLS_LITERAL("sub"));
+    create_link_(linkFile.push(RECLS_LITERAL("link-a.txt")), RECLS_LITERAL("a.txt"));
+
+    strings_t const followed    =   compare_searches_(root, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+    strings_t const notFollowed =   compare_searches_(root, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_NO_FOLLOW_LINKS);
+
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(followed, RECLS_LITERAL("link-sub/d.txt")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(notFollowed, RECLS_LITERAL("link-sub/d.txt")));
+#endif /* __linux__ */
+}
+
+static void test_1_6()
+{
+    // a link to an ancestor is not descended, so that the search ends
+
+#if defined(__linux__)
+    recls_char_t const* const   entries[] =
+    {
+            RECLS_LITERAL("a/f.txt")
+        ,   RECLS_LITERAL("a/b/g.txt")
+    };
+    path_t const                root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_6"), entries);
+    path_t                      loop(root);
+
+    create_link_(loop.push(RECLS_LITERAL("a/b/loop")), RECLS_LITERAL("../.."));
+
+    strings_t const paths = recls_test::search_paths(root, recls::Recls_GetWildcardsAll(), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+
+    // a, a/f.txt, a/b, a/b/g.txt, and a/b/loop itself
+    XTESTS_TEST_INTEGER_EQUAL(size_t(5), paths.size());
+    XTESTS_TEST_BOOLEAN_TRUE(contains_name_(paths, RECLS_LITERAL("loop")));
+    XTESTS_TEST_BOOLEAN_FALSE(contains_name_(paths, RECLS_LITERAL("loop/a")));
+#endif /* __linux__ */
+}
+
+static void test_1_7()
+{
+    // the exhaustion of descriptors fails the search, rather than being
+    // skipped as the denial of access to the directories that could not be
+    // opened
+
+#if defined(__linux__)
+    path_t const    root    =   recls_test::create_deep_tree(temp_dir, RECLS_LITERAL("test_1_7"), 64);
+    strings_t       paths;
+    recls_rc_t      rc;
+
+    {
+        recls_test::descriptor_limit_scope scope(recls_test::lowest_free_descriptor() + 16);
+
+        rc = recls_test::search_paths(root, RECLS_LITERAL("*.txt"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE, &paths);
+    }
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_FAIL, rc);
+#endif /* __linux__ */
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
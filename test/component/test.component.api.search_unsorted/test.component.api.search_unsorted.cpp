@@ -0,0 +1,495 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.api.search_unsorted/test.component.api.search_unsorted.cpp
+ *
+ * Purpose: Test that searches that present the entries of each directory
+ *          in the order in which they are read (`RECLS_F_UNSORTED`) find
+ *          the same entries as those that present them in name order.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <map>
+#include <string>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::hrecls_t;
+    using recls::recls_char_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+    using recls_test::traits_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The files of the tree, and their sizes */
+    struct file_t
+    {
+        recls_char_t const* path;
+        size_t              size;
+    };
+
+    file_t const s_files[] =
+    {
+            { RECLS_LITERAL("m.txt"),               10 }
+        ,   { RECLS_LITERAL("b.dat"),               200 }
+        ,   { RECLS_LITERAL("z.txt"),               0 }
+        ,   { RECLS_LITERAL("a.txt"),               7 }
+        ,   { RECLS_LITERAL("sub/d.txt"),           3000 }
+        ,   { RECLS_LITERAL("sub/c.dat"),           40 }
+        ,   { RECLS_LITERAL("sub/deeper/f.txt"),    5 }
+        ,   { RECLS_LITERAL("other/g.txt"),         600 }
+    };
+
+    /* The number of files in the directory "big" of the tree */
+    static size_t const s_numBigFiles = 100;
+
+    /* The number of directories in the tree: "sub", "sub/deeper",
+     * "other", "big", and "empty"
+     */
+    static size_t const s_numDirectories = 5;
+
+    /* Each case is performed by the default traversal (which is the
+     * single-pass traversal, where available), and by the portable
+     * traversal
+     */
+    static recls_uint32_t const s_traversalFlags[] =
+    {
+            0
+        ,   recls::RECLS_F_PORTABLE_TRAVERSAL
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.api.search_unsorted", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, the files of s_files, the directory "big", of
+     * s_numBigFiles files, and the directory "empty", returning the path
+     * of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t const root = path_t(temp_dir).push(name);
+
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("sub/deeper")));
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("other")));
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("empty")));
+        recls_test::create_numbered_files(root, RECLS_LITERAL("big"), s_numBigFiles);
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            recls_test::create_file(path_t(root).push(s_files[i].path), s_files[i].size);
+        }
+
+        return root;
+    }
+
+    /* Searches the given root both with and without RECLS_F_UNSORTED,
+     * verifying that the searches find the same entries, and that those
+     * of the search without the flag are in name order within each
+     * directory, returning those found by the search with the flag, in
+     * order
+     */
+    strings_t
+    compare_searches_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    )
+    {
+        strings_t const unsorted    =   recls_test::search_paths(root, pattern, flags | recls::RECLS_F_UNSORTED);
+        strings_t       sorted      =   recls_test::search_paths(root, pattern, flags);
+        strings_t       expected(unsorted);
+
+        if (0 == (recls::RECLS_F_RECURSIVE & flags))
+        {
+            XTESTS_TEST_BOOLEAN_TRUE(std::is_sorted(sorted.begin(), sorted.end()));
+        }
+
+        std::sort(expected.begin(), expected.end());
+        std::sort(sorted.begin(), sorted.end());
+
+        XTESTS_TEST_INTEGER_EQUAL(sorted.size(), expected.size());
+        XTESTS_TEST_BOOLEAN_TRUE(sorted == expected);
+
+        return unsorted;
+    }
+
+    /* Searches the given root in parallel, with RECLS_F_UNSORTED,
+     * returning the paths of the entries found, in order
+     */
+    strings_t
+    search_paths_parallel_(
+        path_t const&       root
+    ,   recls_char_t const* pattern
+    ,   recls_uint32_t      flags
+    ,   recls_uint32_t      parallelFlags
+    )
+    {
+        strings_t   paths;
+        hrecls_t    hSrch;
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_SearchParallel(root.c_str(), pattern, flags | recls::RECLS_F_UNSORTED, 4, parallelFlags, &hSrch)))
+        {
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, recls_test::enumerate_paths(hSrch, &paths));
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return paths;
+    }
+
+    /* The directory of the given path, including its trailing path-name
+     * separator
+     */
+    string_t
+    directory_of_(
+        string_t const& path
+    )
+    {
+        for (size_t n = path.size(); 0 != n; --n)
+        {
+            if (traits_t::is_path_name_separator(path[n - 1]))
+            {
+                return path.substr(0, n);
+            }
+        }
+
+        return string_t();
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // the files of a large directory
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_0"));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths = compare_searches_(path_t(root).push(RECLS_LITERAL("big")), RECLS_LITERAL("*"), s_traversalFlags[t] | recls::RECLS_F_FILES);
+
+        XTESTS_TEST_INTEGER_EQUAL(s_numBigFiles, paths.size());
+    }
+}
+
+static void test_1_1()
+{
+    // the files and directories of a tree, including by parallel searches
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_1"));
+    recls_uint32_t  flags   =   recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+    size_t const    total   =   STLSOFT_NUM_ELEMENTS(s_files) + s_numBigFiles + s_numDirectories;
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths = compare_searches_(root, RECLS_LITERAL("*"), s_traversalFlags[t] | flags);
+
+        XTESTS_TEST_INTEGER_EQUAL(total, paths.size());
+    }
+
+    strings_t           expected    =   recls_test::search_paths(root, RECLS_LITERAL("*"), flags);
+    recls_uint32_t const parallelFlags[] =
+    {
+            recls::RECLS_PARALLEL_F_UNORDERED
+        ,   recls::RECLS_PARALLEL_F_DETERMINISTIC
+    };
+
+    std::sort(expected.begin(), expected.end());
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(parallelFlags); ++i)
+    {
+        strings_t paths = search_paths_parallel_(root, RECLS_LITERAL("*"), flags, parallelFlags[i]);
+
+        std::sort(paths.begin(), paths.end());
+
+        XTESTS_TEST_INTEGER_EQUAL(total, paths.size());
+        XTESTS_TEST_BOOLEAN_TRUE(expected == paths);
+    }
+}
+
+static void test_1_2()
+{
+    // the files and directories of a tree, with multiple patterns
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_2"));
+    string_t        pattern(RECLS_LITERAL("*.dat"));
+
+    pattern += recls::Recls_GetPathSeparator();
+    pattern += RECLS_LITERAL("f0*");
+    pattern += recls::Recls_GetPathSeparator();
+    pattern += RECLS_LITERAL("sub");
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const paths = compare_searches_(root, pattern.c_str(), s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE);
+
+        // "b.dat", "sub/c.dat", "big/f00.txt" - "big/f09.txt", and "sub"
+        XTESTS_TEST_INTEGER_EQUAL(size_t(2 + 10 + 1), paths.size());
+    }
+}
+
+static void test_1_3()
+{
+    // the entries of each directory are presented together
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_3"));
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        strings_t const             paths   =   compare_searches_(root, RECLS_LITERAL("*"), s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+        std::map<string_t, size_t>  counts;
+
+        for (size_t i = 0; i != paths.size(); )
+        {
+            string_t const  dir =   directory_of_(paths[i]);
+            size_t          n   =   1;
+
+            for (; i + n != paths.size() && dir == directory_of_(paths[i + n]); ++n)
+            {}
+
+            XTESTS_TEST_INTEGER_EQUAL(size_t(0), counts[dir]);
+
+            counts[dir] = n;
+            i += n;
+        }
+
+        // the root, "sub", "sub/deeper", "other", and "big"
+        XTESTS_TEST_INTEGER_EQUAL(size_t(5), counts.size());
+    }
+}
+
+static void test_1_4()
+{
+    // a search that is closed before it ends, including while it is
+    // reading a directory, releases its resources
+
+#if defined(__linux__)
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_4"));
+    size_t const    fd      =   recls_test::lowest_free_descriptor();
+    size_t const    total   =   STLSOFT_NUM_ELEMENTS(s_files) + s_numBigFiles;
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        for (size_t n = 1; n < total; n += 11)
+        {
+            hrecls_t        hSrch;
+            recls_entry_t   entry;
+            recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_UNSORTED, &hSrch);
+
+            XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+            size_t i = 0;
+
+            for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc && i != n; rc = recls::Recls_GetNextDetails(hSrch, &entry), ++i)
+            {
+                recls::Recls_CloseDetails(entry);
+            }
+
+            if (RECLS_RC_OK == rc)
+            {
+                recls::Recls_CloseDetails(entry);
+            }
+
+            XTESTS_TEST_INTEGER_EQUAL(n, i);
+
+            recls::Recls_SearchClose(hSrch);
+
+            XTESTS_TEST_INTEGER_EQUAL(fd, recls_test::lowest_free_descriptor());
+        }
+    }
+#else /* ? __linux__ */
+
+    XTESTS_TEST_PASSED();
+#endif /* __linux__ */
+}
+
+static void test_1_5()
+{
+    // the details of the entries are those of the files
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_5"));
+    string_t        pattern(RECLS_LITERAL("*.txt"));
+
+    pattern += recls::Recls_GetPathSeparator();
+    pattern += RECLS_LITERAL("*.dat");
+
+    std::map<string_t, size_t> sizes;
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+    {
+        sizes[path_t(root).push(s_files[i].path).c_str()] = s_files[i].size;
+    }
+
+    for (size_t t = 0; t != STLSOFT_NUM_ELEMENTS(s_traversalFlags); ++t)
+    {
+        hrecls_t        hSrch;
+        recls_entry_t   entry;
+        recls_rc_t      rc      =   recls::Recls_Search(root.c_str(), pattern.c_str(), s_traversalFlags[t] | recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_UNSORTED, &hSrch);
+        size_t          n       =   0;
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+        for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+        {
+            std::map<string_t, size_t>::const_iterator it = sizes.find(recls_test::path_of(entry));
+
+            if (sizes.end() != it)
+            {
+                XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(it->second), entry->size);
+                XTESTS_TEST_BOOLEAN_TRUE(0 != entry->modificationTime);
+
+                ++n;
+            }
+            else
+            {
+                XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(0), entry->size);
+            }
+
+            recls::Recls_CloseDetails(entry);
+        }
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files), n);
+
+        recls::Recls_SearchClose(hSrch);
+    }
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
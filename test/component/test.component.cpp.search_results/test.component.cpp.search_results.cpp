@@ -0,0 +1,335 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.cpp.search_results/test.component.cpp.search_results.cpp
+ *
+ * Purpose: Test the collection of the results of a search into columns
+ *          (via recls C++ API class `recls::search_results`).
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#if defined(__FUNCTION__) && \
+    defined(__COUNTER__)
+# include <recls/recls.h>
+#endif
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.hpp>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <algorithm>
+#include <string>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+    static void test_1_5(void);
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_uint32_t;
+    using recls::search_results;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+    using recls_test::strings_t;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The files of the tree, and their sizes */
+    struct file_t
+    {
+        recls_char_t const* path;
+        size_t              size;
+    };
+
+    file_t const s_files[] =
+    {
+            { RECLS_LITERAL("a.bin"),       100 }
+        ,   { RECLS_LITERAL("b/c.bin"),     2000 }
+        ,   { RECLS_LITERAL("b/d.bin"),     0 }
+        ,   { RECLS_LITERAL("b/e/f.bin"),   30000 }
+        ,   { RECLS_LITERAL("g/h.bin"),     4 }
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.cpp.search_results", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+        XTESTS_RUN_CASE_THAT_THROWS(test_1_5, recls::recls_exception);
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, the files of s_files, returning the path of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("b/e")));
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("g")));
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+        {
+            recls_test::create_file(path_t(root).push(s_files[i].path), s_files[i].size);
+        }
+
+        return root;
+    }
+
+    /* The paths of the given results, in order */
+    strings_t
+    paths_of_(
+        search_results const& results
+    )
+    {
+        strings_t paths;
+
+        for (size_t i = 0; i != results.size(); ++i)
+        {
+            paths.push_back(string_t(results.path(i), results.path_length(i)));
+        }
+
+        return paths;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // the results of a search of an empty directory are empty, and have
+    // no columns
+
+    path_t const    root    =   path_t(temp_dir).push(RECLS_LITERAL("test_1_0"));
+
+    recls_test::create_directory(root);
+
+    search_results const results(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_TEST_BOOLEAN_TRUE(results.empty());
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), results.size());
+    XTESTS_TEST_BOOLEAN_TRUE(recls::is_empty(results));
+    XTESTS_TEST_POINTER_EQUAL(static_cast<recls::recls_filesize_t const*>(NULL), results.sizes());
+    XTESTS_TEST_POINTER_EQUAL(static_cast<recls_char_t const*>(NULL), results.paths());
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), results.path_offsets()[0]);
+}
+
+static void test_1_1()
+{
+    // the results have the paths of the entries of the search, in the
+    // order in which it finds them
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_1"));
+    recls_uint32_t  flags   =   recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE;
+
+    search_results const    results(root.c_str(), RECLS_LITERAL("*"), flags);
+    strings_t const         expected    =   recls_test::search_paths(root, RECLS_LITERAL("*"), flags);
+
+    XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files) + 3u, results.size());
+    XTESTS_TEST_BOOLEAN_FALSE(results.empty());
+    XTESTS_TEST_BOOLEAN_TRUE(expected == paths_of_(results));
+}
+
+static void test_1_2()
+{
+    // the paths are contiguous, each nul-terminated, and the offsets
+    // delimit them
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_2"));
+
+    search_results const results(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files), results.size()));
+
+    for (size_t i = 0; i != results.size(); ++i)
+    {
+        size_t const length = results.path_length(i);
+
+        XTESTS_TEST_POINTER_EQUAL(results.paths() + results.path_offsets()[i], results.path(i));
+        XTESTS_TEST_INTEGER_EQUAL(length, traits_t::str_len(results.path(i)));
+        XTESTS_TEST_INTEGER_EQUAL(results.path_offsets()[i] + length + 1u, results.path_offsets()[i + 1]);
+    }
+}
+
+static void test_1_3()
+{
+    // the sizes and modification times are those of the entries at the
+    // same index
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_3"));
+
+    search_results const    results(root.c_str(), RECLS_LITERAL("*.bin"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+    strings_t const         paths   =   paths_of_(results);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files), results.size()));
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_files); ++i)
+    {
+        string_t const  path    =   path_t(root).push(s_files[i].path).c_str();
+        size_t const    index   =   static_cast<size_t>(std::find(paths.begin(), paths.end(), path) - paths.begin());
+
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_NOT_EQUAL(paths.size(), index));
+
+        XTESTS_TEST_INTEGER_EQUAL(recls::recls_filesize_t(s_files[i].size), results.sizes()[index]);
+        XTESTS_TEST_BOOLEAN_TRUE(0 != results.modification_times()[index]);
+    }
+}
+
+static void test_1_4()
+{
+    // swap() exchanges the contents of two results
+
+    path_t const    root1   =   create_tree_(RECLS_LITERAL("test_1_4"));
+    path_t const    root2   =   path_t(temp_dir).push(RECLS_LITERAL("test_1_4_empty"));
+
+    recls_test::create_directory(root2);
+
+    search_results  results1(root1.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+    search_results  results2(root2.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_RECURSIVE);
+    strings_t const paths1  =   paths_of_(results1);
+
+    results1.swap(results2);
+
+    XTESTS_TEST_BOOLEAN_TRUE(results1.empty());
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), results1.path_offsets()[0]);
+    XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(s_files), results2.size());
+    XTESTS_TEST_BOOLEAN_TRUE(paths1 == paths_of_(results2));
+}
+
+#ifdef STLSOFT_CF_EXCEPTION_SUPPORT
+static void test_1_5()
+{
+    // a search that fails throws
+
+    path_t const    root    =   path_t(temp_dir).push(RECLS_LITERAL("test_1_5_does_not_exist"));
+
+    search_results const results(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES);
+
+    XTESTS_TEST_FAIL("should not get here");
+}
+#endif /* STLSOFT_CF_EXCEPTION_SUPPORT */
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
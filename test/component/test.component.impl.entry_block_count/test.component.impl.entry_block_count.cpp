@@ -0,0 +1,509 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/component/test.component.impl.entry_block_count/test.component.impl.entry_block_count.cpp
+ *
+ * Purpose: Test the counts of created and shared entry blocks
+ *          (`Entry_BlockCount()`), which are maintained only when
+ *          `RECLS_COUNTING_ENTRY_BLOCKS` is defined, and are otherwise 0,
+ *          including when entries are copied and released on several
+ *          threads.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.entryfunctions.h"
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+#include <string.h>
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include <pthread.h>
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::hrecls_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    using recls::impl::entry_arena_t;
+    using recls::impl::rc_atomic_t;
+    using recls::impl::Entry_Allocate;
+    using recls::impl::Entry_AllocateFromArena;
+    using recls::impl::Entry_BlockCount;
+    using recls::impl::Entry_Copy;
+    using recls::impl::Entry_CreateArena;
+    using recls::impl::Entry_Release;
+    using recls::impl::Entry_ReleaseArena;
+    using recls::impl::Entry_ReleaseOwned;
+    using recls_test::path_t;
+
+    typedef std::vector<recls_entry_t>                      entries_t;
+
+    /* The counts of created and shared entry blocks */
+    struct block_counts_t
+    {
+        long    created;
+        long    shared;
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* Whether the blocks are counted */
+#ifdef RECLS_COUNTING_ENTRY_BLOCKS
+    static bool const           s_counting      =   true;
+#else /* ? RECLS_COUNTING_ENTRY_BLOCKS */
+    static bool const           s_counting      =   false;
+#endif /* RECLS_COUNTING_ENTRY_BLOCKS */
+
+    /* The size of an entry, including its strings */
+    static size_t const         s_entrySize     =   sizeof(struct recls::recls_entryinfo_t) + 100;
+
+    /* The number of entries allocated in each test */
+    static size_t const         s_numEntries    =   100;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.component.impl.entry_block_count", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* The current counts */
+    block_counts_t
+    block_counts_()
+    {
+        rc_atomic_t     created;
+        rc_atomic_t     shared;
+        block_counts_t  counts;
+
+        Entry_BlockCount(&created, &shared);
+
+        counts.created  =   static_cast<long>(rc_atomic_value(created));
+        counts.shared   =   static_cast<long>(rc_atomic_value(shared));
+
+        return counts;
+    }
+
+    /* The given change in a count, if the blocks are counted, or 0 */
+    long
+    counted_(
+        size_t n
+    )
+    {
+        return s_counting ? static_cast<long>(n) : 0;
+    }
+
+    /* Verifies that the counts are those given, changed by the given
+     * numbers of created and shared blocks if the blocks are counted
+     */
+    void
+    verify_counts_(
+        block_counts_t const&   base
+    ,   size_t                  numCreated
+    ,   size_t                  numShared
+    )
+    {
+        block_counts_t const counts = block_counts_();
+
+        XTESTS_TEST_INTEGER_EQUAL(base.created + counted_(numCreated), counts.created);
+        XTESTS_TEST_INTEGER_EQUAL(base.shared + counted_(numShared), counts.shared);
+    }
+
+    /* Allocates an entry, clearing its information as a search would */
+    recls_entry_t
+    allocate_entry_()
+    {
+        recls_entry_t const entry = Entry_Allocate(s_entrySize);
+
+        if (NULL != entry)
+        {
+            ::memset(const_cast<recls::recls_entryinfo_t*>(entry), 0, sizeof(*entry));
+        }
+
+        return entry;
+    }
+
+    /* Searches the given root, returning copies of the entries found */
+    entries_t
+    search_entries_(
+        path_t const&   root
+    ,   recls_uint32_t  flags
+    )
+    {
+        entries_t   entries;
+        hrecls_t    hSrch;
+        recls_rc_t  rc      =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), flags, &hSrch);
+
+        if (XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc))
+        {
+            recls_entry_t entry;
+
+            for (rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+            {
+                entries.push_back(entry);
+            }
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, rc);
+
+            recls::Recls_SearchClose(hSrch);
+        }
+
+        return entries;
+    }
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+    /* Releases, on another thread, the entries given to it */
+    class entry_releaser
+    {
+    public:
+        explicit entry_releaser(entries_t& entries)
+            : m_entries(entries)
+        {
+            ::pthread_create(&m_thread, NULL, &run_, this);
+        }
+        ~entry_releaser()
+        {
+            ::pthread_join(m_thread, NULL);
+        }
+    private:
+        entry_releaser(entry_releaser const&);
+        void operator =(entry_releaser const&);
+
+    private:
+        static void* run_(void* arg)
+        {
+            entries_t& entries = static_cast<entry_releaser*>(arg)->m_entries;
+
+            for (size_t i = 0; i != entries.size(); ++i)
+            {
+                Entry_Release(entries[i]);
+            }
+
+            return NULL;
+        }
+
+    private:
+        entries_t&  m_entries;
+        pthread_t   m_thread;
+    };
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // the counts are 0 unless the blocks are counted
+
+    block_counts_t const counts = block_counts_();
+
+    if (!s_counting)
+    {
+        XTESTS_TEST_INTEGER_EQUAL(0L, counts.created);
+        XTESTS_TEST_INTEGER_EQUAL(0L, counts.shared);
+    }
+    else
+    {
+        XTESTS_TEST_BOOLEAN_TRUE(counts.created >= 0);
+        XTESTS_TEST_BOOLEAN_TRUE(counts.shared >= 0);
+    }
+}
+
+static void test_1_1()
+{
+    // each entry allocated is counted as created, and each copy as shared,
+    // until released
+
+    block_counts_t const    base    =   block_counts_();
+    entries_t               entries;
+    entries_t               copies;
+
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        recls_entry_t const entry = allocate_entry_();
+        recls_entry_t       copy;
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(static_cast<recls_entry_t>(NULL), entry));
+
+        entries.push_back(entry);
+
+        Entry_Copy(entry, &copy);
+
+        copies.push_back(copy);
+    }
+
+    verify_counts_(base, s_numEntries, s_numEntries);
+
+    // the release of a copy releases the share, and the release of the
+    // last reference releases the block, whichever is released first
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        Entry_Release(0 == i % 2 ? copies[i] : entries[i]);
+    }
+
+    verify_counts_(base, s_numEntries, 0);
+
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        Entry_Release(0 == i % 2 ? entries[i] : copies[i]);
+    }
+
+    verify_counts_(base, 0, 0);
+}
+
+static void test_1_2()
+{
+    // the entries of an arena are not counted as created, but their
+    // copies are counted as shared, until released
+
+    static recls_uint32_t const arenaFlags[] =
+    {
+            0
+        ,   RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_
+    };
+
+    for (size_t f = 0; f != STLSOFT_NUM_ELEMENTS(arenaFlags); ++f)
+    {
+        block_counts_t const    base    =   block_counts_();
+        entry_arena_t* const    arena   =   Entry_CreateArena(arenaFlags[f]);
+        entries_t               entries;
+        entries_t               copies;
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(static_cast<entry_arena_t*>(NULL), arena));
+
+        for (size_t i = 0; i != s_numEntries; ++i)
+        {
+            recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+
+            XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(static_cast<recls_entry_t>(NULL), entry));
+
+            entries.push_back(entry);
+
+            if (0 == i % 2)
+            {
+                recls_entry_t copy;
+
+                Entry_Copy(entry, &copy);
+
+                copies.push_back(copy);
+            }
+        }
+
+        verify_counts_(base, 0, copies.size());
+
+        // the release of the entries leaves the copies as the last
+        // references, which are returned to the arena uncounted
+        for (size_t i = 0; i != entries.size(); ++i)
+        {
+            Entry_ReleaseOwned(entries[i]);
+        }
+
+        verify_counts_(base, 0, 0);
+
+        for (size_t i = 0; i != copies.size(); ++i)
+        {
+            Entry_Release(copies[i]);
+        }
+
+        Entry_ReleaseArena(arena);
+
+        verify_counts_(base, 0, 0);
+    }
+}
+
+static void test_1_3()
+{
+    // the entries of a search held by the caller are counted as created,
+    // until released
+
+    path_t const            root    =   recls_test::create_numbered_files(temp_dir, RECLS_LITERAL("test_1_3"), 20);
+    block_counts_t const    base    =   block_counts_();
+    entries_t const         entries =   search_entries_(root, recls::RECLS_F_FILES);
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(20), entries.size());
+
+    verify_counts_(base, entries.size(), 0);
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        recls::Recls_CloseDetails(entries[i]);
+    }
+
+    verify_counts_(base, 0, 0);
+}
+
+static void test_1_4()
+{
+    // the entries of a search that recycles its entries are not counted
+    // as created, and the counts are unchanged once they are released
+
+    path_t const            root    =   recls_test::create_numbered_files(temp_dir, RECLS_LITERAL("test_1_4"), 20);
+    block_counts_t const    base    =   block_counts_();
+    entries_t const         entries =   search_entries_(root, recls::RECLS_F_FILES | recls::RECLS_F_RECYCLE_ENTRIES);
+
+    XTESTS_TEST_INTEGER_EQUAL(size_t(20), entries.size());
+    XTESTS_TEST_INTEGER_EQUAL(base.created, block_counts_().created);
+
+    for (size_t i = 0; i != entries.size(); ++i)
+    {
+        recls::Recls_CloseDetails(entries[i]);
+    }
+
+    verify_counts_(base, 0, 0);
+}
+
+static void test_1_5()
+{
+    // the counts are correct once entries and their copies have been
+    // released concurrently, on different threads
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    block_counts_t const base = block_counts_();
+
+    for (size_t n = 0; n != 100; ++n)
+    {
+        entries_t entries;
+        entries_t copies;
+
+        for (size_t i = 0; i != s_numEntries; ++i)
+        {
+            recls_entry_t const entry = allocate_entry_();
+            recls_entry_t       copy;
+
+            XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(static_cast<recls_entry_t>(NULL), entry));
+
+            Entry_Copy(entry, &copy);
+
+            entries.push_back(entry);
+            copies.push_back(copy);
+        }
+
+        {
+            entry_releaser  releaser1(entries);
+            entry_releaser  releaser2(copies);
+        }
+
+        verify_counts_(base, 0, 0);
+    }
+#else /* ? RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    XTESTS_TEST_PASSED();
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -5,7 +5,7 @@
  *          `recls::remove_directory()`).
  *
  * Created: 30th January 2010
- * Updated: 3rd January 2024
+ * Updated: 17th October 2026
  *
  * ////////////////////////////////////////////////////////////////////// */
 
@@ -48,8 +48,15 @@
 # define CONVERTER_m2t(s)   (s)
 #endif
 
+/* test header files */
+#include "test.util.fixtures.hpp"
+
 /* Standard C header files */
 #include <stdlib.h>
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+# include <sys/stat.h>
+# include <unistd.h>
+#endif /* OS */
 
 #include <xtests/test/util/compiler_warnings_suppression.last_include.h>
 
@@ -116,7 +123,10 @@ namespace
 {
 
     using recls::recls_char_t;
-    typedef platformstl::basic_path<recls_char_t>   path_t;
+    using recls::recls_rc_t;
+    using recls::RECLS_RC_OK;
+    typedef platformstl::basic_path<recls_char_t>           path_t;
+    using recls_test::traits_t;
 
 } // anonymous namespace
 
@@ -195,6 +205,102 @@ int main(int argc, char **argv)
     return retCode;
 }
 
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, within the directory of the given name within the temporary
+     * directory, the tree:
+     *
+     *  <name>/f1.txt
+     *  <name>/d/f2.txt
+     *  <name>/d/e/
+     *  <name>/d/e/f/f3.txt
+     *  <name>/d/e/f/f4.txt
+     *  <name>/a_long_sub_directory_name/f5.txt
+     *
+     * whose deepest sub-directory ("d/e/f") is not its longest (in which
+     * the removal results differ), returning the path of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        static recls_char_t const* const entries[] =
+        {
+                RECLS_LITERAL("f1.txt")
+            ,   RECLS_LITERAL("d/f2.txt")
+            ,   RECLS_LITERAL("d/e/f/f3.txt")
+            ,   RECLS_LITERAL("d/e/f/f4.txt")
+            ,   RECLS_LITERAL("a_long_sub_directory_name/f5.txt")
+        };
+
+        return recls_test::create_tree(temp_dir, name, entries);
+    }
+
+    /* Verifies the results of the removal of a tree created by
+     * create_tree_(): the longest sub-directory removed is
+     * "<name>/a_long_sub_directory_name", and the deepest "<name>/d/e/f"
+     */
+    void
+    verify_tree_results_(
+        recls::directoryResults_t const&    results
+    ,   size_t                              nameLen
+    )
+    {
+        XTESTS_TEST_INTEGER_EQUAL(results.numExistingElements - 4u, results.numResultingElements);
+        XTESTS_TEST_INTEGER_EQUAL(results.existingLength - (1u + nameLen + 1u + 25u), results.resultingLength);
+    }
+
+#if defined(__linux__)
+
+    /* The number of descriptors to which the process is limited when
+     * removing a deep tree: more than the removal holds open (64 by
+     * default, along with those used by each worker, when parallel), but
+     * fewer than the depth of the tree
+     */
+    size_t
+    deep_tree_descriptor_limit_()
+    {
+        long const numProcessors = ::sysconf(_SC_NPROCESSORS_ONLN);
+
+        return 64 + 32 + 4 * static_cast<size_t>((numProcessors > 0) ? numProcessors : 1);
+    }
+
+    /* Removes a deep tree, created by recls_test::create_deep_tree(),
+     * with the given flags, verifying that it is removed entirely
+     */
+    void
+    remove_deep_tree_(
+        recls_char_t const* name
+    ,   int                 flags
+    )
+    {
+        size_t const                limit   =   deep_tree_descriptor_limit_();
+        unsigned const              depth   =   static_cast<unsigned>(2 * limit);
+        path_t const                root    =   recls_test::create_deep_tree(temp_dir, name, depth);
+        recls::directoryResults_t   results;
+        recls_rc_t                  rc;
+
+        {
+            recls_test::descriptor_limit_scope scope(limit);
+
+            rc = recls::Recls_RemoveDirectory(root.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES | flags, &results);
+        }
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(root.c_str()));
+        XTESTS_TEST_INTEGER_EQUAL(depth, results.numDeletedFiles);
+        XTESTS_TEST_INTEGER_EQUAL(results.numExistingElements - (1u + depth), results.numResultingElements);
+    }
+#endif /* __linux__ */
+
+} // anonymous namespace
+
 /* /////////////////////////////////////////////////////////////////////////
  * test function implementations
  */
@@ -330,62 +436,314 @@ static void test_1_5()
 
 static void test_1_6()
 {
+    // RECLS_REMDIR_F_REMOVE_FILES removes the files throughout the tree
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_6"));
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(root.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(root.c_str()));
+    XTESTS_TEST_INTEGER_EQUAL(5u, results.numDeletedFiles);
 }
 
 static void test_1_7()
 {
+    // without RECLS_REMDIR_F_REMOVE_FILES a tree containing files is not
+    // removed, and its files are retained
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_7"));
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(root.c_str(), 0, &results);
+
+    XTESTS_TEST_POINTER_NOT_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(path_t(root).push(RECLS_LITERAL("f1.txt")).c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(path_t(root).push(RECLS_LITERAL("d/e/f/f3.txt")).c_str()));
 }
 
 static void test_1_8()
 {
+    // RECLS_REMDIR_F_NO_REMOVE_SUBDIRS retains the sub-directories, so a
+    // directory that has them is not removed
+
+    path_t          path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_8"));
+
+    path_t const    sub     =   path_t(path).push(RECLS_LITERAL("def"));
+
+    recls_test::create_directory(sub);
+
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(path.c_str(), recls::RECLS_REMDIR_F_NO_REMOVE_SUBDIRS, &results);
+
+    XTESTS_TEST_POINTER_NOT_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::is_directory(sub.c_str()));
 }
 
 static void test_1_9()
 {
+    // RECLS_REMDIR_F_NO_REMOVE_SUBDIRS with RECLS_REMDIR_F_REMOVE_FILES
+    // removes the files throughout the tree, but retains the
+    // sub-directories
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_9"));
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(root.c_str(), recls::RECLS_REMDIR_F_NO_REMOVE_SUBDIRS | recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+    XTESTS_TEST_POINTER_NOT_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path_t(root).push(RECLS_LITERAL("f1.txt")).c_str()));
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path_t(root).push(RECLS_LITERAL("d/e/f/f3.txt")).c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::is_directory(path_t(root).push(RECLS_LITERAL("d/e/f")).c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::is_directory(path_t(root).push(RECLS_LITERAL("a_long_sub_directory_name")).c_str()));
 }
 
 static void test_1_10()
 {
+    // RECLS_REMDIR_F_NO_REMOVE_SUBDIRS does not prevent the removal of a
+    // directory that has no sub-directories
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_10"));
+
+    recls_test::create_directory(path);
+    recls_test::create_file(path_t(path).push(RECLS_LITERAL("f.txt")));
+
+    recls::directoryResults_t   results;
+
+    recls::remove_directory(path, recls::RECLS_REMDIR_F_NO_REMOVE_SUBDIRS | recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path.c_str()));
+    XTESTS_TEST_INTEGER_EQUAL(1u, results.numDeletedFiles);
+    XTESTS_TEST_INTEGER_EQUAL(results.numExistingElements - 1u, results.numResultingElements);
 }
 
 static void test_1_11()
 {
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // RECLS_REMDIR_F_REMOVE_READONLY removes the contents of a read-only
+    // directory, which (on UNIX) otherwise cannot be removed
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_11"));
+
+    path_t const    ro      =   path_t(path).push(RECLS_LITERAL("ro"));
+    path_t const    file    =   path_t(ro).push(RECLS_LITERAL("f.txt"));
+
+    recls_test::create_directory(ro);
+    recls_test::create_file(file);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::chmod(ro.c_str(), S_IRUSR | S_IXUSR)));
+
+    recls::directoryResults_t   results;
+    recls_rc_t                  rc;
+
+    // permissions do not constrain the super-user
+    if (0 != ::geteuid())
+    {
+        rc = recls::Recls_RemoveDirectory(path.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+        XTESTS_TEST_POINTER_NOT_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(file.c_str()));
+    }
+
+    rc = recls::Recls_RemoveDirectory(path.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES | recls::RECLS_REMDIR_F_REMOVE_READONLY, &results);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path.c_str()));
+
+    if (traits_t::file_exists(ro.c_str()))
+    {
+        ::chmod(ro.c_str(), S_IRWXU);
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
 }
 
 static void test_1_12()
 {
+    // RECLS_REMDIR_F_PARALLEL removes the tree, with the same results as
+    // a sequential removal
+
+    path_t const                root1   =   create_tree_(RECLS_LITERAL("test_1_12_a"));
+    path_t const                root2   =   create_tree_(RECLS_LITERAL("test_1_12_b"));
+    recls::directoryResults_t   results1;
+    recls::directoryResults_t   results2;
+
+    recls::remove_directory(root1, recls::RECLS_REMDIR_F_REMOVE_FILES, &results1);
+    recls::remove_directory(root2, recls::RECLS_REMDIR_F_REMOVE_FILES | recls::RECLS_REMDIR_F_PARALLEL, &results2);
+
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(root1.c_str()));
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(root2.c_str()));
+
+    XTESTS_TEST_INTEGER_EQUAL(results1.numDeletedFiles, results2.numDeletedFiles);
+    XTESTS_TEST_INTEGER_EQUAL(results1.numExistingElements, results2.numExistingElements);
+    XTESTS_TEST_INTEGER_EQUAL(results1.numResultingElements, results2.numResultingElements);
+    XTESTS_TEST_INTEGER_EQUAL(results1.existingLength, results2.existingLength);
+    XTESTS_TEST_INTEGER_EQUAL(results1.resultingLength, results2.resultingLength);
 }
 
 static void test_1_13()
 {
+    // RECLS_REMDIR_F_PARALLEL without RECLS_REMDIR_F_REMOVE_FILES does not
+    // remove a tree containing files
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_13"));
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(root.c_str(), recls::RECLS_REMDIR_F_PARALLEL, &results);
+
+    XTESTS_TEST_POINTER_NOT_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(path_t(root).push(RECLS_LITERAL("d/e/f/f4.txt")).c_str()));
 }
 
 static void test_1_14()
 {
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // a link inside the tree is removed, rather than followed
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_14"));
+
+    path_t const    target  =   path_t(temp_dir).push(RECLS_LITERAL("test_1_14_target"));
+    path_t const    kept    =   path_t(target).push(RECLS_LITERAL("keep.txt"));
+    path_t const    link    =   path_t(path).push(RECLS_LITERAL("link"));
+
+    recls_test::create_directory(path);
+    recls_test::create_directory(target);
+    recls_test::create_file(kept);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(target.c_str(), link.c_str())));
+
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(path.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path.c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::is_directory(target.c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(kept.c_str()));
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
 }
 
 static void test_1_15()
 {
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // a link inside the tree is removed, rather than followed, by a
+    // parallel removal
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_15"));
+
+    path_t const    target  =   path_t(temp_dir).push(RECLS_LITERAL("test_1_15_target"));
+    path_t const    kept    =   path_t(target).push(RECLS_LITERAL("keep.txt"));
+    path_t const    sub     =   path_t(path).push(RECLS_LITERAL("sub"));
+    path_t const    link    =   path_t(sub).push(RECLS_LITERAL("link"));
+
+    recls_test::create_directory(sub);
+    recls_test::create_directory(target);
+    recls_test::create_file(kept);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(target.c_str(), link.c_str())));
+
+    recls::directoryResults_t   results;
+    recls_rc_t const            rc      =   recls::Recls_RemoveDirectory(path.c_str(), recls::RECLS_REMDIR_F_REMOVE_FILES | recls::RECLS_REMDIR_F_PARALLEL, &results);
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+    XTESTS_TEST_BOOLEAN_FALSE(traits_t::file_exists(path.c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::is_directory(target.c_str()));
+    XTESTS_TEST_BOOLEAN_TRUE(traits_t::file_exists(kept.c_str()));
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
 }
 
 static void test_1_16()
 {
+    // the longest sub-directory removed determines existingLength, and the
+    // deepest numExistingElements, as they did before the removal was
+    // performed in a single traversal
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_16"));
+    recls::directoryResults_t   results;
+
+    recls::remove_directory(root, recls::RECLS_REMDIR_F_REMOVE_FILES, &results);
+
+    verify_tree_results_(results, 9u);
 }
 
 static void test_1_17()
 {
+    // as test_1_16, for a parallel removal
+
+    path_t const                root    =   create_tree_(RECLS_LITERAL("test_1_17"));
+    recls::directoryResults_t   results;
+
+    recls::remove_directory(root, recls::RECLS_REMDIR_F_REMOVE_FILES | recls::RECLS_REMDIR_F_PARALLEL, &results);
+
+    verify_tree_results_(results, 9u);
 }
 
 static void test_1_18()
 {
+    // as test_1_4, for a parallel removal
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("abc"));
+
+    path_t path2remove(path);
+
+    path.push(RECLS_LITERAL("def"));
+    path.push(RECLS_LITERAL("ghi"));
+    path.push(RECLS_LITERAL("jkl"));
+
+    recls_test::create_directory(path);
+
+    recls::directoryResults_t   results;
+
+    recls::remove_directory(path2remove, recls::RECLS_REMDIR_F_PARALLEL, &results);
+
+    XTESTS_TEST_INTEGER_EQUAL(results.numExistingElements - 4u, results.numResultingElements);
+    XTESTS_TEST_INTEGER_EQUAL(results.existingLength - 16u, results.resultingLength);
 }
 
 static void test_1_19()
 {
+#if defined(__linux__)
+
+    // a tree deeper than the number of descriptors the process may open is
+    // removed, the removal not holding open a descriptor for each level
+
+    remove_deep_tree_(RECLS_LITERAL("test_1_19"), 0);
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
 }
 
 static void test_1_20()
 {
+#if defined(__linux__)
+
+    // as test_1_19, for a parallel removal
+
+    remove_deep_tree_(RECLS_LITERAL("test_1_20"), recls::RECLS_REMDIR_F_PARALLEL);
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
 }
 
 static void test_1_21()
@@ -0,0 +1,877 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/unit/test.unit.api.calc_directory_size/test.unit.api.calc_directory_size.cpp
+ *
+ * Purpose: Test calculation of the sizes of directory trees (via recls C
+ *          API functions `Recls_CalcDirectorySizeEx()` and
+ *          `Recls_CalcDirectorySizes()`).
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#ifdef __GNUC__
+# include <platformstl/filesystem/path.hpp>
+#endif
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdio.h>
+#include <stdlib.h>
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+# include <sys/stat.h>
+# include <unistd.h>
+#endif /* OS */
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+    static void test_1_8(void);
+    static void test_1_9(void);
+    static void test_1_10(void);
+    static void test_1_11(void);
+    static void test_1_12(void);
+    static void test_1_13(void);
+    static void test_1_14(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_directorySize_t;
+    using recls::recls_filesize_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::RECLS_RC_OK;
+    typedef recls::recls_uint64_t                                   uint64_type;
+    using recls_test::path_t;
+    using recls_test::traits_t;
+    using recls_test::string_t;
+
+    /* A directory, and its sizes, as reported by
+     * Recls_CalcDirectorySizes()
+     */
+    struct directory_sizes_t
+    {
+        string_t                path;
+        size_t                  depth;
+        recls_directorySize_t   size;
+    };
+    typedef std::vector<directory_sizes_t>                          directory_sizes_list_t;
+
+    /* The state of the function passed to Recls_CalcDirectorySizes() */
+    struct sizes_state_t
+    {
+        directory_sizes_list_t  directories;
+        size_t                  cancelAfter;    // 0 => never cancel
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* Each case is performed by the sequential, and by the parallel,
+     * calculator
+     */
+    static recls_uint32_t const s_modeFlags[] =
+    {
+            0
+        ,   recls::RECLS_DIRSIZE_F_PARALLEL
+    };
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.unit.api.calc_directory_size", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+        XTESTS_RUN_CASE(test_1_8);
+        XTESTS_RUN_CASE(test_1_9);
+        XTESTS_RUN_CASE(test_1_10);
+        XTESTS_RUN_CASE(test_1_11);
+        XTESTS_RUN_CASE(test_1_12);
+        XTESTS_RUN_CASE(test_1_13);
+        XTESTS_RUN_CASE(test_1_14);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Creates, as the directory of the given name within the temporary
+     * directory, the tree:
+     *
+     *  <name>/a.bin        (1000 bytes)
+     *  <name>/e/
+     *  <name>/s/b.bin      (5000 bytes)
+     *  <name>/s/u/c.bin    (0 bytes)
+     *
+     * returning the path of the directory
+     */
+    path_t
+    create_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("e")));
+        recls_test::create_directory(path_t(root).push(RECLS_LITERAL("s/u")));
+
+        recls_test::create_file(path_t(root).push(RECLS_LITERAL("a.bin")), 1000);
+        recls_test::create_file(path_t(root).push(RECLS_LITERAL("s/b.bin")), 5000);
+        recls_test::create_file(path_t(root).push(RECLS_LITERAL("s/u/c.bin")), 0);
+
+        return root;
+    }
+
+    /* Creates a wider and deeper tree than create_tree_(), in which the
+     * sizes of the files vary
+     */
+    path_t
+    create_large_tree_(
+        recls_char_t const* name
+    )
+    {
+        path_t root(temp_dir);
+
+        root.push(name);
+
+        for (int i = 0; i != 4; ++i)
+        {
+            path_t dir(root);
+
+            for (int j = 0; j != 3; ++j)
+            {
+                recls_char_t    sub[]   =   RECLS_LITERAL("d0");
+                recls_char_t    file[]  =   RECLS_LITERAL("f0.bin");
+
+                sub[1]  =   static_cast<recls_char_t>('0' + (0 == j ? i : j));
+                file[1] =   static_cast<recls_char_t>('0' + j);
+
+                dir.push(sub);
+
+                recls_test::create_directory(dir);
+                recls_test::create_file(path_t(dir).push(file), 100 * (1 + i) + 1000 * j);
+            }
+        }
+
+        return root;
+    }
+
+    /* The storage allocated to the given file, as is counted by
+     * Recls_CalcDirectorySizeEx(), or its size where that is not available
+     */
+    recls_filesize_t
+    allocated_size_of_(
+        path_t const&   path
+    ,   size_t          size
+    )
+    {
+#if defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_)
+        struct stat st;
+
+        STLSOFT_SUPPRESS_UNUSED(size);
+
+        if (0 != ::stat(path.c_str(), &st))
+        {
+            XTESTS_TEST_FAIL_WITH_QUALIFIER("failed to stat file", path);
+
+            return 0;
+        }
+
+        return static_cast<recls_filesize_t>(st.st_blocks) * 512u;
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+        STLSOFT_SUPPRESS_UNUSED(path);
+
+        return size;
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+    }
+
+    void
+    verify_sizes_equal_(
+        recls_directorySize_t const&    expected
+    ,   recls_directorySize_t const&    actual
+    )
+    {
+        XTESTS_TEST_INTEGER_EQUAL(expected.numFiles, actual.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(expected.numDirectories, actual.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(expected.apparentSize, actual.apparentSize);
+        XTESTS_TEST_INTEGER_EQUAL(expected.allocatedSize, actual.allocatedSize);
+    }
+
+    int RECLS_CALLCONV_DEFAULT
+    sizes_fn_(
+        recls_char_t const*             dir
+    ,   size_t                          dirLen
+    ,   size_t                          depth
+    ,   recls_directorySize_t const*    size
+    ,   recls::recls_process_fn_param_t param
+    )
+    {
+        sizes_state_t* const    state   =   static_cast<sizes_state_t*>(param);
+        directory_sizes_t       directory;
+
+        directory.path.assign(dir, dirLen);
+        directory.depth =   depth;
+        directory.size  =   *size;
+
+        state->directories.push_back(directory);
+
+        return (state->cancelAfter == state->directories.size()) ? 0 : 1;
+    }
+
+    /* Finds the directory of the given path, relative to root, in the
+     * given list, returning its index, or the size of the list if not found
+     */
+    size_t
+    find_directory_(
+        directory_sizes_list_t const&   directories
+    ,   path_t const&                   root
+    ,   recls_char_t const*             relativePath
+    )
+    {
+        path_t const    path(path_t(root).push(relativePath));
+        string_t const  s(path.c_str());
+
+        for (size_t i = 0; i != directories.size(); ++i)
+        {
+            if (s == directories[i].path)
+            {
+                return i;
+            }
+        }
+
+        return directories.size();
+    }
+
+    /* Verifies that each directory is reported after all of its
+     * sub-directories
+     */
+    void
+    verify_post_order_(
+        directory_sizes_list_t const& directories
+    )
+    {
+        for (size_t i = 0; i != directories.size(); ++i)
+        {
+            string_t const& parent = directories[i].path;
+
+            for (size_t j = i + 1; j < directories.size(); ++j)
+            {
+                string_t const& later = directories[j].path;
+
+                if (later.size() > parent.size() &&
+                    0 == later.compare(0, parent.size(), parent) &&
+                    traits_t::is_path_name_separator(later[parent.size()]))
+                {
+                    XTESTS_TEST_FAIL_WITH_QUALIFIER("sub-directory reported after its parent", later);
+                }
+            }
+        }
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+static void test_1_0()
+{
+    // a directory that does not exist
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_0"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(path.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_DIRECTORY_NOT_FOUND, rc);
+    }
+}
+
+static void test_1_1()
+{
+    // an empty directory
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_1"));
+
+    recls_test::create_directory(path);
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(path.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), size.apparentSize);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), size.allocatedSize);
+    }
+}
+
+static void test_1_2()
+{
+    // the numbers of files and directories, and the apparent size
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_2"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(6000), size.apparentSize);
+    }
+}
+
+static void test_1_3()
+{
+    // the allocated size is the total of the storage allocated to the
+    // files, rather than of their sizes
+
+    path_t const            root        =   create_tree_(RECLS_LITERAL("test_1_3"));
+    recls_filesize_t const  allocated   =   allocated_size_of_(path_t(root).push(RECLS_LITERAL("a.bin")), 1000)
+                                        +   allocated_size_of_(path_t(root).push(RECLS_LITERAL("s/b.bin")), 5000)
+                                        +   allocated_size_of_(path_t(root).push(RECLS_LITERAL("s/u/c.bin")), 0);
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(6000), size.apparentSize);
+        XTESTS_TEST_INTEGER_EQUAL(allocated, size.allocatedSize);
+    }
+}
+
+static void test_1_4()
+{
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // the allocated size of a sparse file is less than its apparent size
+
+    path_t path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_4"));
+
+    recls_test::create_directory(path);
+
+    path_t const    file    =   path_t(path).push(RECLS_LITERAL("sparse.bin"));
+    FILE* const     stm     =   ::fopen(file.c_str(), "wb");
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_NOT_EQUAL(NULL, stm));
+
+    ::fseek(stm, 1024 * 1024, SEEK_SET);
+    ::fputc('x', stm);
+    ::fclose(stm);
+
+    recls_filesize_t const allocated = allocated_size_of_(file, 1024 * 1024 + 1);
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(path.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(1), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(1024 * 1024 + 1), size.apparentSize);
+        XTESTS_TEST_INTEGER_EQUAL(allocated, size.allocatedSize);
+# if defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_)
+        XTESTS_TEST_INTEGER_LESS(size.apparentSize, size.allocatedSize);
+# endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
+}
+
+static void test_1_5()
+{
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // a file with two (hard) links is counted twice, unless
+    // RECLS_DIRSIZE_F_COUNT_LINKS_ONCE is specified
+
+    path_t const    root    =   create_tree_(RECLS_LITERAL("test_1_5"));
+    path_t const    file    =   path_t(root).push(RECLS_LITERAL("x.bin"));
+    path_t const    link    =   path_t(root).push(RECLS_LITERAL("s/y.bin"));
+
+    recls_test::create_file(file, 3000);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::link(file.c_str(), link.c_str())));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t              rc      =   recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(5), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(12000), size.apparentSize);
+
+        rc = recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m] | recls::RECLS_DIRSIZE_F_COUNT_LINKS_ONCE, &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+# if defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_)
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(4), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(9000), size.apparentSize);
+# endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numDirectories);
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
+}
+
+static void test_1_6()
+{
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // symbolic links are followed, unless RECLS_DIRSIZE_F_NO_FOLLOW_LINKS
+    // is specified, in which case they are counted as themselves
+
+    path_t              path(temp_dir);
+
+    path.push(RECLS_LITERAL("test_1_6"));
+
+    path_t const        target      =   path_t(temp_dir).push(RECLS_LITERAL("test_1_6_target"));
+    path_t const        targetFile  =   path_t(target).push(RECLS_LITERAL("big.bin"));
+
+    recls_test::create_directory(path);
+    recls_test::create_directory(target);
+    recls_test::create_file(path_t(path).push(RECLS_LITERAL("f.bin")), 2000);
+    recls_test::create_file(targetFile, 7000);
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(target.c_str(), path_t(path).push(RECLS_LITERAL("ld")).c_str())));
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink(targetFile.c_str(), path_t(path).push(RECLS_LITERAL("lf")).c_str())));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t              rc      =   recls::Recls_CalcDirectorySizeEx(path.c_str(), s_modeFlags[m], &size);
+
+        // f.bin, lf (-> big.bin), and ld/big.bin
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(1), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(16000), size.apparentSize);
+
+        rc = recls::Recls_CalcDirectorySizeEx(path.c_str(), s_modeFlags[m] | recls::RECLS_DIRSIZE_F_NO_FOLLOW_LINKS, &size);
+
+        // f.bin, lf, and ld, the size of each link being that of its target
+        // path
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(2000 + target.size() + targetFile.size()), size.apparentSize);
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
+}
+
+static void test_1_7()
+{
+    // the parallel calculator obtains the same sizes as the sequential
+
+    path_t const root = create_large_tree_(RECLS_LITERAL("test_1_7"));
+
+    static recls_uint32_t const flags[] =
+    {
+            0
+        ,   recls::RECLS_DIRSIZE_F_COUNT_LINKS_ONCE
+        ,   recls::RECLS_DIRSIZE_F_NO_FOLLOW_LINKS
+        ,   recls::RECLS_DIRSIZE_F_COUNT_LINKS_ONCE | recls::RECLS_DIRSIZE_F_NO_FOLLOW_LINKS
+    };
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(flags); ++i)
+    {
+        recls_directorySize_t   sequential;
+        recls_directorySize_t   parallel;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CalcDirectorySizeEx(root.c_str(), flags[i], &sequential));
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CalcDirectorySizeEx(root.c_str(), flags[i] | recls::RECLS_DIRSIZE_F_PARALLEL, &parallel));
+
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(12), sequential.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(12), sequential.numDirectories);
+        verify_sizes_equal_(sequential, parallel);
+    }
+}
+
+static void test_1_8()
+{
+    // Recls_CalcDirectorySizes() reports each directory after all of its
+    // sub-directories, with its depth and its sizes
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_8"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        sizes_state_t state;
+
+        state.cancelAfter = 0;
+
+        recls_rc_t const rc = recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(size_t(4), state.directories.size()));
+
+        verify_post_order_(state.directories);
+
+        // the search root is last, and is as passed
+        directory_sizes_t const& last = state.directories.back();
+
+        XTESTS_TEST_BOOLEAN_TRUE(string_t(root.c_str()) == last.path);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), last.depth);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), last.size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), last.size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(6000), last.size.apparentSize);
+
+        size_t const e  =   find_directory_(state.directories, root, RECLS_LITERAL("e"));
+        size_t const s  =   find_directory_(state.directories, root, RECLS_LITERAL("s"));
+        size_t const u  =   find_directory_(state.directories, root, RECLS_LITERAL("s/u"));
+
+        if (XTESTS_TEST_INTEGER_NOT_EQUAL(state.directories.size(), e))
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_t(1), state.directories[e].depth);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), state.directories[e].size.numFiles);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), state.directories[e].size.numDirectories);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), state.directories[e].size.apparentSize);
+        }
+        if (XTESTS_TEST_INTEGER_NOT_EQUAL(state.directories.size(), s))
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_t(1), state.directories[s].depth);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(2), state.directories[s].size.numFiles);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(1), state.directories[s].size.numDirectories);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(5000), state.directories[s].size.apparentSize);
+        }
+        if (XTESTS_TEST_INTEGER_NOT_EQUAL(state.directories.size(), u))
+        {
+            XTESTS_TEST_INTEGER_EQUAL(size_t(2), state.directories[u].depth);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(1), state.directories[u].size.numFiles);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), state.directories[u].size.numDirectories);
+            XTESTS_TEST_INTEGER_EQUAL(uint64_type(0), state.directories[u].size.apparentSize);
+        }
+    }
+}
+
+static void test_1_9()
+{
+    // the sizes of each directory reported by Recls_CalcDirectorySizes()
+    // are those calculated for it by Recls_CalcDirectorySizeEx()
+
+    path_t const root = create_large_tree_(RECLS_LITERAL("test_1_9"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        sizes_state_t state;
+
+        state.cancelAfter = 0;
+
+        recls_rc_t const rc = recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(size_t(13), state.directories.size());
+
+        verify_post_order_(state.directories);
+
+        for (size_t i = 0; i != state.directories.size(); ++i)
+        {
+            recls_directorySize_t size;
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CalcDirectorySizeEx(state.directories[i].path.c_str(), 0, &size));
+
+            verify_sizes_equal_(size, state.directories[i].size);
+        }
+    }
+}
+
+static void test_1_10()
+{
+    // Recls_CalcDirectorySizes() is cancelled when the function returns 0,
+    // and the function is not invoked again
+
+    path_t const root = create_large_tree_(RECLS_LITERAL("test_1_10"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        for (size_t cancelAfter = 1; cancelAfter != 4; ++cancelAfter)
+        {
+            sizes_state_t state;
+
+            state.cancelAfter = cancelAfter;
+
+            recls_rc_t const rc = recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state);
+
+            XTESTS_TEST_POINTER_EQUAL(RECLS_RC_SEARCH_CANCELLED, rc);
+            XTESTS_TEST_INTEGER_EQUAL(cancelAfter, state.directories.size());
+        }
+    }
+}
+
+static void test_1_11()
+{
+    // Recls_CalcDirectorySizes() is cancelled when the function returns 0
+    // for the search root, which is reported last
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_11"));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        sizes_state_t state;
+
+        state.cancelAfter = 4;
+
+        recls_rc_t const rc = recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_SEARCH_CANCELLED, rc);
+        XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(size_t(4), state.directories.size()));
+        XTESTS_TEST_INTEGER_EQUAL(size_t(0), state.directories.back().depth);
+    }
+}
+
+
+static void test_1_12()
+{
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // as for a search of the wildcard, files and directories whose names
+    // begin with '.' are not counted, although the contents of such
+    // directories are
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_12"));
+
+    recls_test::create_directory(path_t(root).push(RECLS_LITERAL(".d/s")));
+    recls_test::create_file(path_t(root).push(RECLS_LITERAL(".a.bin")), 100);
+    recls_test::create_file(path_t(root).push(RECLS_LITERAL(".d/b.bin")), 200);
+    recls_test::create_file(path_t(root).push(RECLS_LITERAL(".d/.c.bin")), 400);
+    recls_test::create_file(path_t(root).push(RECLS_LITERAL(".d/s/d.bin")), 800);
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t const        rc      =   recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+
+        // a.bin, s/b.bin, s/u/c.bin, .d/b.bin, and .d/s/d.bin; e, s, s/u,
+        // and .d/s
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(5), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(4), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(7000), size.apparentSize);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(7000), uint64_type(recls::Recls_CalcDirectorySize(root.c_str())));
+
+        sizes_state_t state;
+
+        state.cancelAfter = 0;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state));
+
+        if (XTESTS_TEST_BOOLEAN_FALSE(state.directories.empty()))
+        {
+            verify_sizes_equal_(size, state.directories.back().size);
+        }
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
+}
+
+static void test_1_13()
+{
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+
+    // a link to a directory that contains it is not followed, so that the
+    // calculation ends, each file being counted once
+
+    path_t const root = create_tree_(RECLS_LITERAL("test_1_13"));
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(0, ::symlink("../..", path_t(root).push(RECLS_LITERAL("s/u/loop")).c_str())));
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t              rc;
+
+# if defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_)
+        rc = recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(6000), size.apparentSize);
+
+        sizes_state_t state;
+
+        state.cancelAfter = 0;
+
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, recls::Recls_CalcDirectorySizes(root.c_str(), s_modeFlags[m], sizes_fn_, &state));
+        XTESTS_TEST_INTEGER_EQUAL(size_t(4), state.directories.size());
+# endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+        rc = recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m] | recls::RECLS_DIRSIZE_F_NO_FOLLOW_LINKS, &size);
+
+        // the link is counted as itself
+        XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(4), size.numFiles);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(3), size.numDirectories);
+        XTESTS_TEST_INTEGER_EQUAL(uint64_type(6005), size.apparentSize);
+    }
+#else /* ? OS */
+
+    XTESTS_TEST_PASSED();
+#endif /* OS */
+}
+
+static void test_1_14()
+{
+#if defined(RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_)
+
+    // the exhaustion of descriptors fails the calculation, rather than the
+    // directories that could not be opened being skipped as inaccessible
+
+    path_t const root = recls_test::create_deep_tree(temp_dir, RECLS_LITERAL("test_1_14"), 64);
+
+    for (size_t m = 0; m != STLSOFT_NUM_ELEMENTS(s_modeFlags); ++m)
+    {
+        recls_directorySize_t   size;
+        recls_rc_t              rc;
+
+        {
+            recls_test::descriptor_limit_scope scope(recls_test::lowest_free_descriptor() + 16);
+
+            rc = recls::Recls_CalcDirectorySizeEx(root.c_str(), s_modeFlags[m], &size);
+        }
+
+        XTESTS_TEST_POINTER_EQUAL(recls::RECLS_RC_FAIL, rc);
+    }
+#else /* ? RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+    XTESTS_TEST_PASSED();
+#endif /* RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
@@ -1,11 +1,11 @@
 /* /////////////////////////////////////////////////////////////////////////
  * File:    test.unit.api.createdirectory.c
  *
- * Purpose: Test creation of directories (via recls C API function
- *          `Recls_CreateDirectory()`).
+ * Purpose: Test creation of directories (via recls C API functions
+ *          `Recls_CreateDirectory()` and `Recls_CreateDirectories()`).
  *
  * Created: 29th January 2009
- * Updated: 3rd January 2024
+ * Updated: 17th October 2026
  *
  * ////////////////////////////////////////////////////////////////////// */
 
@@ -28,6 +28,7 @@
 #include <platformstl/platformstl.h>
 
 /* Standard C header files */
+#include <stdio.h>
 #include <stdlib.h>
 #if 0
 #elif defined(STLSOFT_COMPILER_IS_MSVC) && \
@@ -214,6 +215,49 @@ int main(int argc, char **argv)
     return retCode;
 }
 
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+static int create_file_(recls_char_t const* path)
+{
+#if defined(RECLS_CHAR_TYPE_IS_WCHAR)
+    FILE* const stm = _wfopen(path, L"w");
+#else /* ? RECLS_CHAR_TYPE_IS_WCHAR */
+    FILE* const stm = fopen(path, "w");
+#endif /* RECLS_CHAR_TYPE_IS_WCHAR */
+
+    if (NULL == stm)
+    {
+        return 0;
+    }
+    else
+    {
+        fclose(stm);
+
+        return 1;
+    }
+}
+
+static int directory_exists_(recls_char_t const* path)
+{
+    recls_entry_t   entry;
+    recls_rc_t      rc  =   Recls_Stat(path, RECLS_F_DIRECTORIES, &entry);
+
+    if (RECLS_FAILED(rc))
+    {
+        return 0;
+    }
+    else
+    {
+        int const isDir = 0 != Recls_IsFileDirectory(entry);
+
+        Recls_CloseDetails(entry);
+
+        return isDir;
+    }
+}
+
 /* /////////////////////////////////////////////////////////////////////////
  * test function implementations
  */
@@ -225,6 +269,12 @@ int main(int argc, char **argv)
 #else
 # define RECLS_TEST_DIR_ROOT_LEN                            RECLS_TEST_DIR_ROOT_LEN_
 #endif
+#if defined(PLATFORMSTL_OS_IS_UNIX) && \
+    defined(_WIN32)
+# define RECLS_TEST_DIR_ROOT_RESULTING_LEN                  (RECLS_TEST_DIR_ROOT_LEN + 2)
+#else
+# define RECLS_TEST_DIR_ROOT_RESULTING_LEN                  RECLS_TEST_DIR_ROOT_LEN
+#endif
 
 
 static void test_1_0()
@@ -320,42 +370,316 @@ static void test_1_3()
 
 static void test_1_4()
 {
+    /* results when no level is missing */
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_directoryResults_t    results;
+        recls_rc_t                  rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, &results);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(results.numExistingElements, results.numResultingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN, results.existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN, results.resultingLength);
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_5()
 {
+    /* results when one level is missing */
+
+#define TEST_1_5_SUBDIR                                     RECLS_LITERAL("/abc")
+#define TEST_1_5_SUBDIR_LEN                                 (STLSOFT_NUM_ELEMENTS(TEST_1_5_SUBDIR) - 1)
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_directoryResults_t    results;
+        recls_rc_t                  rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT TEST_1_5_SUBDIR, &results);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(1u, results.numResultingElements - results.numExistingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN, results.existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + TEST_1_5_SUBDIR_LEN, results.resultingLength);
+        XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(RECLS_TEST_DIR_ROOT TEST_1_5_SUBDIR));
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_6()
 {
+    /* results when several levels are missing */
+
+#define TEST_1_6_SUBDIR                                     RECLS_LITERAL("/abc/def/ghi")
+#define TEST_1_6_SUBDIR_LEN                                 (STLSOFT_NUM_ELEMENTS(TEST_1_6_SUBDIR) - 1)
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_directoryResults_t    results;
+        recls_rc_t                  rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT TEST_1_6_SUBDIR, &results);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(3u, results.numResultingElements - results.numExistingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN, results.existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + TEST_1_6_SUBDIR_LEN, results.resultingLength);
+        XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(RECLS_TEST_DIR_ROOT TEST_1_6_SUBDIR));
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_7()
 {
+    /* a path that is, or is below, a file */
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+    XTESTS_REQUIRE(XTESTS_TEST_BOOLEAN_TRUE(create_file_(RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file"))));
+
+    {
+        recls_rc_t rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file"), NULL);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_ENTRY_IS_NOT_DIRECTORY, rc);
+    }
+
+    {
+        recls_rc_t rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file/abc"), NULL);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_ENTRY_IS_NOT_DIRECTORY, rc);
+    }
+
+    {
+        recls_rc_t rc = Recls_CreateDirectory(RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file/abc/def"), NULL);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_ENTRY_IS_NOT_DIRECTORY, rc);
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_8()
 {
+    /* an empty batch */
+
+    {
+        size_t      numCompleted    =   99;
+        recls_rc_t  rc              =   Recls_CreateDirectories(NULL, 0, NULL, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(0u, numCompleted);
+    }
+
+    {
+        recls_rc_t  rc  =   Recls_CreateDirectories(NULL, 0, NULL, NULL);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+    }
 }
 
 static void test_1_9()
 {
+    /* a batch of siblings, sharing the parent retained from the first */
+
+    recls_char_t const* const   paths[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s3")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s4")
+    };
+    unsigned const              numCreated[] = { 2, 1, 1, 1 };
+    size_t const                existingLen[] = { 0, 4, 4, 4 };
+    recls_directoryResults_t    results[STLSOFT_NUM_ELEMENTS(paths)];
+    size_t                      numCompleted    =   99;
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_rc_t rc = Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), results, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(paths), numCompleted);
+    }
+
+    { size_t i; for (i = 0; i != STLSOFT_NUM_ELEMENTS(paths); ++i)
+    {
+        XTESTS_TEST_INTEGER_EQUAL(numCreated[i], results[i].numResultingElements - results[i].numExistingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + existingLen[i], results[i].existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + 7, results[i].resultingLength);
+        XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(paths[i]));
+    }}
+
+    /* creating them again creates nothing */
+    {
+        recls_rc_t rc = Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), results, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(paths), numCompleted);
+    }
+
+    { size_t i; for (i = 0; i != STLSOFT_NUM_ELEMENTS(paths); ++i)
+    {
+        XTESTS_TEST_INTEGER_EQUAL(results[i].numExistingElements, results[i].numResultingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + 7, results[i].existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + 7, results[i].resultingLength);
+    }}
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_10()
 {
+    /* a batch whose siblings are interleaved with those of other parents,
+     * and with their descendants
+     */
+
+    recls_char_t const* const   paths[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/def/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s2/t1/u1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s2/t1/u2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s3")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s3")
+    };
+    unsigned const              numCreated[] = { 2, 2, 1, 2, 1, 1, 0 };
+    size_t const                existingLen[] = { 0, 0, 4, 7, 10, 4, 7 };
+    recls_directoryResults_t    results[STLSOFT_NUM_ELEMENTS(paths)];
+    size_t                      numCompleted    =   99;
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_rc_t rc = Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), results, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(STLSOFT_NUM_ELEMENTS(paths), numCompleted);
+    }
+
+    { size_t i; for (i = 0; i != STLSOFT_NUM_ELEMENTS(paths); ++i)
+    {
+        XTESTS_TEST_INTEGER_EQUAL(numCreated[i], results[i].numResultingElements - results[i].numExistingElements);
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_TEST_DIR_ROOT_RESULTING_LEN + existingLen[i], results[i].existingLength);
+        XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(paths[i]));
+    }}
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_11()
 {
+    /* a batch in which a path fails: those before it are created, and
+     * those after it are not attempted
+     */
+
+    recls_char_t const* const   paths[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file/s3")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/s4")
+    };
+    recls_directoryResults_t    results[STLSOFT_NUM_ELEMENTS(paths)];
+    size_t                      numCompleted    =   99;
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+    XTESTS_REQUIRE(XTESTS_TEST_BOOLEAN_TRUE(create_file_(RECLS_TEST_DIR_ROOT RECLS_LITERAL("/file"))));
+
+    {
+        recls_rc_t rc = Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), results, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_ENTRY_IS_NOT_DIRECTORY, rc);
+        XTESTS_TEST_INTEGER_EQUAL(2u, numCompleted);
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(2u, results[0].numResultingElements - results[0].numExistingElements);
+    XTESTS_TEST_INTEGER_EQUAL(1u, results[1].numResultingElements - results[1].numExistingElements);
+    XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(paths[0]));
+    XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(paths[1]));
+    XTESTS_TEST_BOOLEAN_FALSE(directory_exists_(paths[3]));
+
+    /* the count is also obtained without results */
+    {
+        recls_rc_t rc;
+
+        numCompleted = 99;
+
+        rc = Recls_CreateDirectories(paths + 2, STLSOFT_NUM_ELEMENTS(paths) - 2, NULL, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_ENTRY_IS_NOT_DIRECTORY, rc);
+        XTESTS_TEST_INTEGER_EQUAL(0u, numCompleted);
+        XTESTS_TEST_BOOLEAN_FALSE(directory_exists_(paths[3]));
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_12()
 {
+    /* a batch in which a path is empty */
+
+    recls_char_t const* const   paths[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc")
+        ,   RECLS_LITERAL("")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/def")
+    };
+    size_t                      numCompleted    =   99;
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    {
+        recls_rc_t rc = Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), NULL, &numCompleted);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_INVALID_NAME, rc);
+        XTESTS_TEST_INTEGER_EQUAL(1u, numCompleted);
+        XTESTS_TEST_BOOLEAN_TRUE(directory_exists_(paths[0]));
+        XTESTS_TEST_BOOLEAN_FALSE(directory_exists_(paths[2]));
+    }
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_13()
 {
+    /* a batch whose results are each those of Recls_CreateDirectory() */
+
+    recls_char_t const* const   paths[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/def/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/def/s2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/abc/ghi")
+    };
+    recls_char_t const* const   paths2[] =
+    {
+            RECLS_TEST_DIR_ROOT RECLS_LITERAL("/jkl/def/s1")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/jkl/def/s2")
+        ,   RECLS_TEST_DIR_ROOT RECLS_LITERAL("/jkl/ghi")
+    };
+    recls_directoryResults_t    results[STLSOFT_NUM_ELEMENTS(paths)];
+
+    XTESTS_REQUIRE(XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectory(RECLS_TEST_DIR_ROOT, NULL)));
+
+    XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, Recls_CreateDirectories(paths, STLSOFT_NUM_ELEMENTS(paths), results, NULL));
+
+    { size_t i; for (i = 0; i != STLSOFT_NUM_ELEMENTS(paths); ++i)
+    {
+        recls_directoryResults_t    results2;
+        recls_rc_t                  rc = Recls_CreateDirectory(paths2[i], &results2);
+
+        XTESTS_TEST_INTEGER_EQUAL(RECLS_RC_OK, rc);
+        XTESTS_TEST_INTEGER_EQUAL(results2.numExistingElements, results[i].numExistingElements);
+        XTESTS_TEST_INTEGER_EQUAL(results2.numResultingElements, results[i].numResultingElements);
+        XTESTS_TEST_INTEGER_EQUAL(results2.existingLength, results[i].existingLength);
+        XTESTS_TEST_INTEGER_EQUAL(results2.resultingLength, results[i].resultingLength);
+    }}
+
+    Recls_RemoveDirectory(RECLS_TEST_DIR_ROOT, RECLS_REMDIR_F_REMOVE_FILES, NULL);
 }
 
 static void test_1_14()
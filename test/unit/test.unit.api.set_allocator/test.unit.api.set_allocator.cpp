@@ -0,0 +1,429 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/unit/test.unit.api.set_allocator/test.unit.api.set_allocator.cpp
+ *
+ * Purpose: Test that all the memory allocated by searches, and by the
+ *          calculation of directory sizes, is allocated, and freed, via the
+ *          allocator set by `Recls_SetAllocator()`.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <xtests/test/util/compiler_warnings_suppression.first_include.h>
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#if _XTESTS_VER < 0x001204ff
+# error Requires xTests 0.18.4 or later
+#endif
+
+/* test header files */
+#include "test.util.fixtures.hpp"
+
+/* Standard C++ header files */
+#include <atomic>
+#include <new>
+
+/* Standard C header files */
+#include <stdlib.h>
+
+#include <xtests/test/util/compiler_warnings_suppression.last_include.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+
+    static int setup(void*);
+    static int teardown(void*);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+namespace
+{
+
+    using recls::recls_char_t;
+    using recls::recls_directorySize_t;
+    using recls::recls_entry_t;
+    using recls::recls_rc_t;
+    using recls::recls_uint32_t;
+    using recls::hrecls_t;
+    using recls::RECLS_RC_OK;
+    using recls_test::path_t;
+
+    /* Counts the allocations and deallocations made by the library, while
+     * it is in scope. The counts are atomic, since the allocator is called
+     * on the threads of parallel searches and calculations
+     */
+    class counting_allocator_scope
+    {
+    public:
+        counting_allocator_scope()
+        {
+            ::recls::recls_allocator_t allocator;
+
+            allocator.pfnAlloc  =   &alloc_;
+            allocator.pfnFree   =   &free_;
+            allocator.context   =   NULL;
+
+            s_numAllocs =   0;
+            s_numFrees  =   0;
+
+            ::recls::Recls_SetAllocator(&allocator);
+        }
+        ~counting_allocator_scope()
+        {
+            ::recls::Recls_SetAllocator(NULL);
+        }
+    private:
+        counting_allocator_scope(counting_allocator_scope const&);
+        void operator =(counting_allocator_scope const&);
+
+    public:
+        size_t num_allocs() const
+        {
+            return s_numAllocs;
+        }
+        size_t num_frees() const
+        {
+            return s_numFrees;
+        }
+
+    private:
+        static void* RECLS_CALLCONV_DEFAULT alloc_(size_t cb, void*)
+        {
+            ++s_numAllocs;
+
+            return ::malloc(cb);
+        }
+        static void RECLS_CALLCONV_DEFAULT free_(void* pv, void*)
+        {
+            ++s_numFrees;
+
+            ::free(pv);
+        }
+
+    private:
+        static std::atomic<size_t>  s_numAllocs;
+        static std::atomic<size_t>  s_numFrees;
+    };
+
+    std::atomic<size_t> counting_allocator_scope::s_numAllocs;
+    std::atomic<size_t> counting_allocator_scope::s_numFrees;
+
+    /* Counts the calls to the global operator new, on any thread, while
+     * it is in scope. Nothing that allocates via operator new (including
+     * the test macros) may be used while it is
+     */
+    class counting_new_scope
+    {
+    public:
+        counting_new_scope()
+        {
+            s_numNews   =   0;
+            s_counting  =   true;
+        }
+        ~counting_new_scope()
+        {
+            s_counting  =   false;
+        }
+    private:
+        counting_new_scope(counting_new_scope const&);
+        void operator =(counting_new_scope const&);
+
+    public:
+        static size_t num_news()
+        {
+            return s_numNews;
+        }
+
+        static void on_new()
+        {
+            if (s_counting)
+            {
+                ++s_numNews;
+            }
+        }
+
+    private:
+        static std::atomic<bool>    s_counting;
+        static std::atomic<size_t>  s_numNews;
+    };
+
+    std::atomic<bool>   counting_new_scope::s_counting;
+    std::atomic<size_t> counting_new_scope::s_numNews;
+
+} // anonymous namespace
+
+void* operator new(size_t cb)
+{
+    counting_new_scope::on_new();
+
+    void* const pv = ::malloc(0 == cb ? 1 : cb);
+
+    if (NULL == pv)
+    {
+        throw std::bad_alloc();
+    }
+
+    return pv;
+}
+
+void operator delete(void* pv) noexcept
+{
+    ::free(pv);
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * Non-local static variables
+ */
+
+namespace
+{
+
+    path_t   temp_dir;
+
+    /* The names are longer than any string holds without allocating */
+    recls_char_t const* const s_entries[] =
+    {
+            RECLS_LITERAL("directory_with_a_long_name_1/directory_with_a_long_name_2/file_with_a_long_name_1.txt")
+        ,   RECLS_LITERAL("directory_with_a_long_name_1/directory_with_a_long_name_2/file_with_a_long_name_2.txt")
+        ,   RECLS_LITERAL("directory_with_a_long_name_1/directory_with_a_long_name_3/file_with_a_long_name_3.txt")
+        ,   RECLS_LITERAL("directory_with_a_long_name_1/directory_with_a_long_name_3/directory_with_a_long_name_4/")
+        ,   RECLS_LITERAL("directory_with_a_long_name_5/file_with_a_long_name_4.txt")
+        ,   RECLS_LITERAL("file_with_a_long_name_5.txt")
+    };
+
+    /* The number of files and directories in the tree */
+    static size_t const s_numEntries = 5 + 5;
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER_WITH_SETUP_FNS("test.unit.api.set_allocator", verbosity, setup, teardown, NULL))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    /* Enumerates, and closes, the given search, returning the number of
+     * entries enumerated, without allocating via operator new
+     */
+    size_t
+    count_entries_(
+        hrecls_t hSrch
+    )
+    {
+        recls_entry_t   entry;
+        size_t          n   =   0;
+
+        for (recls_rc_t rc = recls::Recls_GetDetails(hSrch, &entry); RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+        {
+            ++n;
+
+            recls::Recls_CloseDetails(entry);
+        }
+
+        recls::Recls_SearchClose(hSrch);
+
+        return n;
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+
+static void test_1_0()
+{
+    // a search allocates via the allocator, and frees all it allocates
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_0"), s_entries);
+    size_t          n       =   0;
+
+    counting_allocator_scope    scope;
+
+    {
+        hrecls_t            hSrch;
+        recls_rc_t const    rc  =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS, &hSrch);
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+        n = count_entries_(hSrch);
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(s_numEntries, n);
+    XTESTS_TEST_BOOLEAN_TRUE(0 != scope.num_allocs());
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_1()
+{
+    // a recycling search frees all it allocates, including the arena of
+    // its entries
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_1"), s_entries);
+    size_t          n       =   0;
+
+    counting_allocator_scope    scope;
+
+    {
+        hrecls_t            hSrch;
+        recls_rc_t const    rc  =   recls::Recls_Search(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_RECYCLE_ENTRIES, &hSrch);
+
+        XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+
+        n = count_entries_(hSrch);
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(s_numEntries, n);
+    XTESTS_TEST_BOOLEAN_TRUE(0 != scope.num_allocs());
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_2()
+{
+    // a parallel search allocates only via the allocator, on all its
+    // threads, and frees all it allocates
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+    path_t const    root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_2"), s_entries);
+    size_t          n       =   0;
+    size_t          news    =   0;
+    recls_rc_t      rc;
+
+    counting_allocator_scope    scope;
+
+    {
+        hrecls_t            hSrch;
+        counting_new_scope  newScope;
+
+        rc = recls::Recls_SearchParallel(root.c_str(), RECLS_LITERAL("*"), recls::RECLS_F_FILES | recls::RECLS_F_DIRECTORIES | recls::RECLS_F_RECURSIVE | recls::RECLS_F_DIRECTORY_PARTS, 4, 0, &hSrch);
+
+        if (RECLS_RC_OK == rc)
+        {
+            n = count_entries_(hSrch);
+        }
+
+        news = newScope.num_news();
+    }
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+    XTESTS_TEST_INTEGER_EQUAL(s_numEntries, n);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), news);
+    XTESTS_TEST_BOOLEAN_TRUE(0 != scope.num_allocs());
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+#else /* ? RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    XTESTS_TEST_PASSED();
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+}
+
+static void test_1_3()
+{
+    // a parallel calculation of a directory's size allocates only via the
+    // allocator, on all its threads, and frees all it allocates
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+    path_t const            root    =   recls_test::create_tree(temp_dir, RECLS_LITERAL("test_1_3"), s_entries);
+    recls_directorySize_t   size;
+    size_t                  news    =   0;
+    recls_rc_t              rc;
+
+    counting_allocator_scope    scope;
+
+    {
+        counting_new_scope  newScope;
+
+        rc = recls::Recls_CalcDirectorySizeEx(root.c_str(), recls::RECLS_DIRSIZE_F_PARALLEL, &size);
+
+        news = newScope.num_news();
+    }
+
+    XTESTS_REQUIRE(XTESTS_TEST_POINTER_EQUAL(RECLS_RC_OK, rc));
+    XTESTS_TEST_INTEGER_EQUAL(recls::recls_uint64_t(5), size.numFiles);
+    XTESTS_TEST_INTEGER_EQUAL(size_t(0), news);
+    XTESTS_TEST_BOOLEAN_TRUE(0 != scope.num_allocs());
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+#else /* ? RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+    XTESTS_TEST_PASSED();
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+}
+
+
+static int setup(void*)
+{
+    temp_dir = recls_test::create_temp_directory();
+
+    return 0;
+}
+
+static int teardown(void*)
+{
+    recls_test::remove_temp_directory(temp_dir);
+
+    return 0;
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
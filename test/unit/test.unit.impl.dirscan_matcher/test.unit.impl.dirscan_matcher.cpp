@@ -0,0 +1,401 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/unit/test.unit.impl.dirscan_matcher/test.unit.impl.dirscan_matcher.cpp
+ *
+ * Purpose: Test matching of entry names against compiled search patterns
+ *          (via recls implementation class `dirscan_matcher`), by
+ *          comparison with `fnmatch(FNM_PERIOD)`.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+
+#ifndef RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_
+# error This test can only be built when RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ is defined
+#endif /* !RECLS_SUPPORTS_SINGLE_PASS_TRAVERSAL_ */
+
+#include "impl.dirscan.linux.hpp"
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+
+/* STLSoft header files */
+#include <stlsoft/stlsoft.h>
+
+/* Standard C++ header files */
+#include <string>
+
+/* Standard C header files */
+#include <fnmatch.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+    static void test_1_8(void);
+    static void test_1_9(void);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER("test.unit.impl.dirscan_matcher", verbosity))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+        XTESTS_RUN_CASE(test_1_8);
+        XTESTS_RUN_CASE(test_1_9);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    using ::recls::impl::dirscan_matcher;
+    using ::recls::impl::types;
+
+    static char const* const    s_names[] =
+    {
+            "a"
+        ,   "abc"
+        ,   "abc.cpp"
+        ,   "abc.cpp.bak"
+        ,   "abc.h"
+        ,   "abc.hpp"
+        ,   "abc.c"
+        ,   "ABC.CPP"
+        ,   "cpp"
+        ,   ".cpp"
+        ,   "x.cpp"
+        ,   "xcpp"
+        ,   "makefile"
+        ,   "Makefile"
+        ,   "makefile.unix"
+        ,   "CMakeLists.txt"
+        ,   "README.md"
+        ,   "readme"
+        ,   ".profile"
+        ,   ".bashrc"
+        ,   ".git"
+        ,   ".hidden.cpp"
+        ,   "..."
+        ,   "a.b.c"
+        ,   "test1.c"
+        ,   "test12.c"
+        ,   "testa.c"
+        ,   "t.c"
+        ,   "file[1].txt"
+        ,   "file1.txt"
+        ,   "-dash"
+        ,   "with space.txt"
+        ,   "ends.with.dot."
+        ,   "*"
+        ,   "?"
+    };
+
+    /* Joins the given patterns into a single pattern string, delimited by
+     * the path separator, as they are presented to the matcher by a
+     * search.
+     */
+    std::string
+    join_patterns_(
+        char const* const*  patterns
+    ,   size_t              numPatterns
+    )
+    {
+        std::string joined;
+
+        for (size_t i = 0; i != numPatterns; ++i)
+        {
+            if (0 != i)
+            {
+                joined += types::traits_type::path_separator();
+            }
+
+            joined += patterns[i];
+        }
+
+        return joined;
+    }
+
+    /* Indicates whether any of the given patterns matches the given name,
+     * according to fnmatch(FNM_PERIOD), which is the reference behaviour.
+     */
+    bool
+    fnmatch_any_(
+        char const* const*  patterns
+    ,   size_t              numPatterns
+    ,   char const*         name
+    )
+    {
+        for (size_t i = 0; i != numPatterns; ++i)
+        {
+            if ('\0' != patterns[i][0] &&
+                0 == ::fnmatch(patterns[i], name, FNM_PERIOD))
+            {
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+    /* Compiles the given patterns into a matcher, and verifies that it
+     * gives the same result as fnmatch(FNM_PERIOD) for every name in the
+     * table of names.
+     */
+    void
+    verify_against_fnmatch_(
+        char const* const*  patterns
+    ,   size_t              numPatterns
+    )
+    {
+        std::string const   joined  =   join_patterns_(patterns, numPatterns);
+        dirscan_matcher     matcher;
+
+        matcher.init(joined.data(), joined.size());
+
+        for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(s_names); ++i)
+        {
+            char const* const   name        =   s_names[i];
+            bool const          expected    =   fnmatch_any_(patterns, numPatterns, name);
+            bool const          actual      =   matcher.match(name, ::strlen(name));
+
+            if (expected != actual)
+            {
+                std::string qualifier;
+
+                qualifier += "patterns='";
+                qualifier += joined;
+                qualifier += "', name='";
+                qualifier += name;
+                qualifier += expected ? "', expected match" : "', expected no match";
+
+                XTESTS_TEST_FAIL_WITH_QUALIFIER("dirscan_matcher differs from fnmatch(FNM_PERIOD)", qualifier);
+            }
+            else
+            {
+                XTESTS_TEST_PASSED();
+            }
+        }
+    }
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+static void test_1_0()
+{
+    // match-all
+    static char const* const patterns[] =
+    {
+        "*"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_1()
+{
+    // literal
+    static char const* const patterns[] =
+    {
+        "makefile"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_2()
+{
+    // several literals, including dot-files
+    static char const* const patterns[] =
+    {
+            "makefile"
+        ,   "CMakeLists.txt"
+        ,   ".profile"
+        ,   "..."
+        ,   "a"
+        ,   "readme"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_3()
+{
+    // suffix
+    static char const* const patterns[] =
+    {
+        "*.cpp"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_4()
+{
+    // several suffixes, of the same and of different lengths
+    static char const* const patterns[] =
+    {
+            "*.c"
+        ,   "*.h"
+        ,   "*.cpp"
+        ,   "*.hpp"
+        ,   "*cpp"
+        ,   "*.txt"
+        ,   "*."
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_5()
+{
+    // patterns requiring fnmatch()
+    static char const* const patterns[] =
+    {
+            "test?.c"
+        ,   "abc.*"
+        ,   "*.c*"
+        ,   "file[0-9].txt"
+        ,   "[Mm]akefile"
+        ,   "a*c"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_6()
+{
+    // patterns that begin with '.', which alone match dot-files
+    static char const* const patterns[] =
+    {
+            ".*"
+        ,   ".b*"
+        ,   ".*.cpp"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_7()
+{
+    // a mixture of all classes, including duplicates and empty patterns
+    static char const* const patterns[] =
+    {
+            "*.cpp"
+        ,   ""
+        ,   "makefile"
+        ,   "*.cpp"
+        ,   "test??.c"
+        ,   ""
+        ,   "makefile"
+        ,   ".git"
+        ,   "*.md"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_8()
+{
+    // more literals and suffixes than the smallest hash table holds
+    static char const* const patterns[] =
+    {
+            "a"
+        ,   "b"
+        ,   "c"
+        ,   "d"
+        ,   "abc"
+        ,   "xcpp"
+        ,   "t.c"
+        ,   "-dash"
+        ,   "*.bak"
+        ,   "*.unix"
+        ,   "*.CPP"
+        ,   "*.md"
+        ,   "*.o"
+        ,   "*.obj"
+        ,   "*.a"
+        ,   "*.so"
+        ,   "*.dll"
+        ,   "*.exe"
+        ,   "*1.txt"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+static void test_1_9()
+{
+    // patterns with wildcard characters in the names that are matched
+    static char const* const patterns[] =
+    {
+            "file\\[1\\].txt"
+        ,   "\\*"
+        ,   "?"
+    };
+
+    verify_against_fnmatch_(patterns, STLSOFT_NUM_ELEMENTS(patterns));
+}
+
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
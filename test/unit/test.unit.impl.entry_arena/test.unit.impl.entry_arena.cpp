@@ -0,0 +1,542 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/unit/test.unit.impl.entry_arena/test.unit.impl.entry_arena.cpp
+ *
+ * Purpose: Test the recycling of entries by the entry arena of a search
+ *          (`RECLS_F_RECYCLE_ENTRIES`), including of entries whose last
+ *          reference is that of a copy, by counting the allocations made
+ *          via the allocator set by `Recls_SetAllocator()`, and the switch
+ *          of a local arena to atomic reference counts once a copy is
+ *          made.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test component header file include(s)
+ */
+
+#include <recls/recls.h>
+#include "impl.root.h"
+#include "impl.entryfunctions.h"
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+/* xTests header files */
+#include <xtests/xtests.h>
+
+/* STLSoft header files */
+#include <stlsoft/stlsoft.h>
+
+/* Standard C++ header files */
+#include <vector>
+
+/* Standard C header files */
+#include <stdlib.h>
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+# include <pthread.h>
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+/* /////////////////////////////////////////////////////////////////////////
+ * forward declarations
+ */
+
+namespace
+{
+
+    static void test_1_0(void);
+    static void test_1_1(void);
+    static void test_1_2(void);
+    static void test_1_3(void);
+    static void test_1_4(void);
+    static void test_1_5(void);
+    static void test_1_6(void);
+    static void test_1_7(void);
+    static void test_1_8(void);
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * main
+ */
+
+int main(int argc, char **argv)
+{
+    int retCode = EXIT_SUCCESS;
+    int verbosity = 2;
+
+    XTESTS_COMMANDLINE_PARSEVERBOSITY(argc, argv, &verbosity);
+
+    if (XTESTS_START_RUNNER("test.unit.impl.entry_arena", verbosity))
+    {
+        XTESTS_RUN_CASE(test_1_0);
+        XTESTS_RUN_CASE(test_1_1);
+        XTESTS_RUN_CASE(test_1_2);
+        XTESTS_RUN_CASE(test_1_3);
+        XTESTS_RUN_CASE(test_1_4);
+        XTESTS_RUN_CASE(test_1_5);
+        XTESTS_RUN_CASE(test_1_6);
+        XTESTS_RUN_CASE(test_1_7);
+        XTESTS_RUN_CASE(test_1_8);
+
+        XTESTS_PRINT_RESULTS();
+
+        XTESTS_END_RUNNER_UPDATE_EXITCODE(&retCode);
+    }
+
+    return retCode;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * helpers
+ */
+
+namespace
+{
+
+    using ::recls::recls_entry_t;
+    using ::recls::impl::entry_arena_t;
+    using ::recls::impl::Entry_AllocateFromArena;
+    using ::recls::impl::Entry_Copy;
+    using ::recls::impl::Entry_CreateArena;
+    using ::recls::impl::Entry_Release;
+    using ::recls::impl::Entry_ReleaseArena;
+    using ::recls::impl::Entry_ReleaseOwned;
+
+    /* The flags of a local arena, and of one that is not */
+    static ::recls::recls_uint32_t const    s_arenaFlags[] =
+    {
+            0
+        ,   RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_
+    };
+
+    /* The size of an entry, including its strings, that is recycled */
+    static size_t const         s_entrySize     =   sizeof(struct ::recls::recls_entryinfo_t) + 100;
+
+    /* The number of entries allocated in each test, which is such that,
+     * were they not recycled, many chunks would be allocated
+     */
+    static size_t const         s_numEntries    =   10000;
+
+    /* The most allocations an arena may make, for itself and for the
+     * chunks from which its entries are allocated, when a single entry is
+     * live at any one time
+     */
+    static size_t const         s_maxAllocs     =   1 + 1;
+
+    /* Counts the allocations and deallocations made by the library, while
+     * it is in scope. (Copies released on other threads return their
+     * entries to the arena, rather than freeing them, so the counts need
+     * not be synchronised.)
+     */
+    class counting_allocator_scope
+    {
+    public:
+        counting_allocator_scope()
+        {
+            ::recls::recls_allocator_t allocator;
+
+            allocator.pfnAlloc  =   &alloc_;
+            allocator.pfnFree   =   &free_;
+            allocator.context   =   NULL;
+
+            s_numAllocs =   0;
+            s_numFrees  =   0;
+
+            ::recls::Recls_SetAllocator(&allocator);
+        }
+        ~counting_allocator_scope()
+        {
+            ::recls::Recls_SetAllocator(NULL);
+        }
+    private:
+        counting_allocator_scope(counting_allocator_scope const&);
+        void operator =(counting_allocator_scope const&);
+
+    public:
+        size_t num_allocs() const
+        {
+            return s_numAllocs;
+        }
+        size_t num_frees() const
+        {
+            return s_numFrees;
+        }
+
+    private:
+        static void* RECLS_CALLCONV_DEFAULT alloc_(size_t cb, void*)
+        {
+            ++s_numAllocs;
+
+            return ::malloc(cb);
+        }
+        static void RECLS_CALLCONV_DEFAULT free_(void* pv, void*)
+        {
+            ++s_numFrees;
+
+            ::free(pv);
+        }
+
+    private:
+        static size_t   s_numAllocs;
+        static size_t   s_numFrees;
+    };
+
+    size_t counting_allocator_scope::s_numAllocs;
+    size_t counting_allocator_scope::s_numFrees;
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+
+    /* Releases, on another thread, the copies given to it */
+    class copy_releaser
+    {
+    public:
+        typedef std::vector<recls_entry_t>  entries_type;
+
+    public:
+        explicit copy_releaser(entries_type& copies)
+            : m_copies(copies)
+        {
+            ::pthread_create(&m_thread, NULL, &run_, this);
+        }
+        ~copy_releaser()
+        {
+            ::pthread_join(m_thread, NULL);
+        }
+    private:
+        copy_releaser(copy_releaser const&);
+        void operator =(copy_releaser const&);
+
+    private:
+        static void* run_(void* arg)
+        {
+            entries_type& copies = static_cast<copy_releaser*>(arg)->m_copies;
+
+            for (size_t i = 0; i != copies.size(); ++i)
+            {
+                Entry_Release(copies[i]);
+            }
+
+            return NULL;
+        }
+
+    private:
+        entries_type&   m_copies;
+        pthread_t       m_thread;
+    };
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+
+} // anonymous namespace
+
+/* /////////////////////////////////////////////////////////////////////////
+ * test function implementations
+ */
+
+namespace
+{
+
+static void test_1_0()
+{
+    // an entry released by the search is reused
+
+    entry_arena_t* const arena = Entry_CreateArena(0);
+
+    XTESTS_TEST_POINTER_NOT_EQUAL(NULL, arena);
+
+    recls_entry_t const entry1 = Entry_AllocateFromArena(arena, s_entrySize);
+
+    Entry_ReleaseOwned(entry1);
+
+    recls_entry_t const entry2 = Entry_AllocateFromArena(arena, s_entrySize);
+
+    XTESTS_TEST_POINTER_EQUAL(entry1, entry2);
+
+    Entry_ReleaseOwned(entry2);
+    Entry_ReleaseArena(arena);
+}
+
+static void test_1_1()
+{
+    // an entry whose last reference is that of a copy is reused
+
+    entry_arena_t* const    arena   =   Entry_CreateArena(0);
+    recls_entry_t const     entry1  =   Entry_AllocateFromArena(arena, s_entrySize);
+    recls_entry_t           copy;
+
+    XTESTS_TEST_POINTER_EQUAL(recls::RECLS_RC_OK, Entry_Copy(entry1, &copy));
+    XTESTS_TEST_POINTER_EQUAL(entry1, copy);
+
+    Entry_ReleaseOwned(entry1);
+    Entry_Release(copy);
+
+    recls_entry_t const entry2 = Entry_AllocateFromArena(arena, s_entrySize);
+
+    XTESTS_TEST_POINTER_EQUAL(entry1, entry2);
+
+    Entry_ReleaseOwned(entry2);
+    Entry_ReleaseArena(arena);
+}
+
+static void test_1_2()
+{
+    // the arena is bounded when the search releases its entries first
+
+    counting_allocator_scope    scope;
+    entry_arena_t* const        arena   =   Entry_CreateArena(0);
+
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+
+        Entry_ReleaseOwned(entry);
+    }
+
+    XTESTS_TEST_INTEGER_LESS_OR_EQUAL(s_maxAllocs, scope.num_allocs());
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_3()
+{
+    // the arena is bounded when copies hold the last references
+
+    counting_allocator_scope    scope;
+    entry_arena_t* const        arena   =   Entry_CreateArena(0);
+
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+        recls_entry_t       copy;
+
+        Entry_Copy(entry, &copy);
+        Entry_ReleaseOwned(entry);
+        Entry_Release(copy);
+    }
+
+    XTESTS_TEST_INTEGER_LESS_OR_EQUAL(s_maxAllocs, scope.num_allocs());
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_4()
+{
+    // copies outlive the arena's search
+
+    counting_allocator_scope    scope;
+    entry_arena_t* const        arena   =   Entry_CreateArena(0);
+    recls_entry_t               copies[10];
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(copies); ++i)
+    {
+        recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+
+        Entry_Copy(entry, &copies[i]);
+        Entry_ReleaseOwned(entry);
+    }
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_NOT_EQUAL(scope.num_allocs(), scope.num_frees());
+
+    for (size_t i = 0; i != STLSOFT_NUM_ELEMENTS(copies); ++i)
+    {
+        Entry_Release(copies[i]);
+    }
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_5()
+{
+    // the arena is bounded when copies hold the last references, and are
+    // released on another thread while the search continues
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    counting_allocator_scope        scope;
+    entry_arena_t* const            arena       =   Entry_CreateArena(0);
+    size_t const                    batchSize   =   100;
+    copy_releaser::entries_type     batches[2];
+    copy_releaser*                  releaser    =   NULL;
+
+    for (size_t n = 0; n != s_numEntries / batchSize; ++n)
+    {
+        // Each batch is created while the copies of the previous batch are
+        // being released
+        copy_releaser::entries_type& batch = batches[n % 2];
+
+        batch.clear();
+
+        for (size_t i = 0; i != batchSize; ++i)
+        {
+            recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+            recls_entry_t       copy;
+
+            Entry_Copy(entry, &copy);
+            Entry_ReleaseOwned(entry);
+
+            batch.push_back(copy);
+        }
+
+        delete releaser;
+
+        releaser = new copy_releaser(batch);
+    }
+
+    delete releaser;
+
+    // No more than two batches are live at any one time, which occupy no
+    // more than two chunks, but the remainder of each chunk may be
+    // abandoned
+    size_t const maxAllocs = 1 + 2 * 2;
+
+    XTESTS_TEST_INTEGER_LESS_OR_EQUAL(maxAllocs, scope.num_allocs());
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+}
+
+static void test_1_6()
+{
+    // a local arena recycles the entries released by the search, which
+    // has made no copies
+
+    counting_allocator_scope    scope;
+    entry_arena_t* const        arena   =   Entry_CreateArena(RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_);
+    recls_entry_t const         first   =   Entry_AllocateFromArena(arena, s_entrySize);
+
+    Entry_ReleaseOwned(first);
+
+    for (size_t i = 0; i != s_numEntries; ++i)
+    {
+        recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+
+        XTESTS_TEST_POINTER_EQUAL(first, entry);
+
+        Entry_ReleaseOwned(entry);
+    }
+
+    XTESTS_TEST_INTEGER_LESS_OR_EQUAL(s_maxAllocs, scope.num_allocs());
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+}
+
+static void test_1_7()
+{
+    // the counts of entries made before, and after, an arena switches to
+    // atomic counts, on the first copy, are maintained, whether the arena
+    // was local or not
+
+    for (size_t n = 0; n != STLSOFT_NUM_ELEMENTS(s_arenaFlags); ++n)
+    {
+        counting_allocator_scope    scope;
+        entry_arena_t* const        arena   =   Entry_CreateArena(s_arenaFlags[n]);
+        recls_entry_t const         before  =   Entry_AllocateFromArena(arena, s_entrySize);
+        recls_entry_t               copy1;
+        recls_entry_t               copy2;
+
+        // The entry is held by the search, and by two copies, the first of
+        // which is the first made
+        Entry_Copy(before, &copy1);
+
+        recls_entry_t const after = Entry_AllocateFromArena(arena, s_entrySize);
+
+        Entry_Copy(before, &copy2);
+
+        XTESTS_TEST_POINTER_NOT_EQUAL(before, after);
+
+        // The entry is not recycled until the last reference is released
+        Entry_ReleaseOwned(before);
+        Entry_Release(copy1);
+
+        recls_entry_t const other = Entry_AllocateFromArena(arena, s_entrySize);
+
+        XTESTS_TEST_POINTER_NOT_EQUAL(before, other);
+
+        Entry_Release(copy2);
+
+        recls_entry_t const recycled = Entry_AllocateFromArena(arena, s_entrySize);
+
+        XTESTS_TEST_POINTER_EQUAL(before, recycled);
+
+        Entry_ReleaseOwned(after);
+        Entry_ReleaseOwned(other);
+        Entry_ReleaseOwned(recycled);
+        Entry_ReleaseArena(arena);
+
+        XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+    }
+}
+
+static void test_1_8()
+{
+    // copies of the entries of a local arena are released on another
+    // thread while the search continues, which is bounded and balanced
+    // only if the counts are atomic once the first copy is made
+
+#ifdef RECLS_SUPPORTS_PARALLEL_SEARCH_
+    counting_allocator_scope        scope;
+    entry_arena_t* const            arena       =   Entry_CreateArena(RECLS_ENTRY_ARENA_F_LOCAL_REFCOUNTS_);
+    size_t const                    batchSize   =   100;
+    copy_releaser::entries_type     batches[2];
+    copy_releaser*                  releaser    =   NULL;
+
+    // Some entries are recycled before any copy is made
+    for (size_t i = 0; i != batchSize; ++i)
+    {
+        Entry_ReleaseOwned(Entry_AllocateFromArena(arena, s_entrySize));
+    }
+
+    for (size_t n = 0; n != s_numEntries / batchSize; ++n)
+    {
+        copy_releaser::entries_type& batch = batches[n % 2];
+
+        batch.clear();
+
+        for (size_t i = 0; i != batchSize; ++i)
+        {
+            recls_entry_t const entry = Entry_AllocateFromArena(arena, s_entrySize);
+            recls_entry_t       copy;
+
+            // Each entry is copied twice, and one copy released by the
+            // search, so that the count of each is manipulated by both
+            // threads
+            Entry_Copy(entry, &copy);
+            Entry_Release(copy);
+            Entry_Copy(entry, &copy);
+            Entry_ReleaseOwned(entry);
+
+            batch.push_back(copy);
+        }
+
+        delete releaser;
+
+        releaser = new copy_releaser(batch);
+    }
+
+    delete releaser;
+
+    size_t const maxAllocs = 1 + 2 * 2;
+
+    XTESTS_TEST_INTEGER_LESS_OR_EQUAL(maxAllocs, scope.num_allocs());
+
+    Entry_ReleaseArena(arena);
+
+    XTESTS_TEST_INTEGER_EQUAL(scope.num_allocs(), scope.num_frees());
+#endif /* RECLS_SUPPORTS_PARALLEL_SEARCH_ */
+}
+
+} // anonymous namespace
+
+/* ///////////////////////////// end of file //////////////////////////// */
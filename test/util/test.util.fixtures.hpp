@@ -0,0 +1,443 @@
+/* /////////////////////////////////////////////////////////////////////////
+ * File:    test/util/test.util.fixtures.hpp
+ *
+ * Purpose: Fixtures shared by the test suites: creation of files and of
+ *          directory trees within a temporary directory, and enumeration
+ *          of the results of searches.
+ *
+ * Created: 17th October 2026
+ * Updated: 17th October 2026
+ *
+ * ////////////////////////////////////////////////////////////////////// */
+
+
+#ifndef RECLS_INCL_TEST_UTIL_HPP_FIXTURES
+#define RECLS_INCL_TEST_UTIL_HPP_FIXTURES
+
+/* /////////////////////////////////////////////////////////////////////////
+ * includes
+ */
+
+#include <recls/recls.h>
+
+/* xTests header files */
+#include <xtests/xtests.h>
+#include <xtests/util/temp_directory.hpp>
+
+/* STLSoft header files */
+#include <platformstl/filesystem/directory_functions.hpp>
+#include <platformstl/filesystem/filesystem_traits.hpp>
+#include <platformstl/filesystem/path.hpp>
+#if defined(PLATFORMSTL_OS_IS_WINDOWS)
+# include <winstl/conversion/char_conversions.hpp>
+#endif
+
+/* Standard C++ header files */
+#include <string>
+#include <vector>
+
+/* Standard C header files */
+#include <stdio.h>
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+# include <fcntl.h>
+# include <sys/resource.h>
+# include <unistd.h>
+#endif
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+namespace recls_test
+{
+
+/* /////////////////////////////////////////////////////////////////////////
+ * types
+ */
+
+typedef platformstl::basic_path<recls::recls_char_t>                path_t;
+typedef platformstl::filesystem_traits<recls::recls_char_t>         traits_t;
+typedef std::basic_string<recls::recls_char_t>                      string_t;
+typedef std::vector<string_t>                                       strings_t;
+
+/* /////////////////////////////////////////////////////////////////////////
+ * temporary directory
+ */
+
+/** Creates an empty temporary directory, returning its path */
+inline
+path_t
+create_temp_directory()
+{
+    using ::xtests::cpp::util::temp_directory;
+
+    temp_directory td(temp_directory::EmptyOnOpen);
+
+#if defined(PLATFORMSTL_OS_IS_WINDOWS)
+    return path_t(winstl::m2t(td.c_str()));
+#else
+    return path_t(td.c_str());
+#endif
+}
+
+/** Removes the given temporary directory, and anything within it */
+inline
+void
+remove_temp_directory(
+    path_t const& dir
+)
+{
+    if (!traits_t::remove_directory(dir.c_str()))
+    {
+        platformstl::remove_directory_recurse(dir);
+    }
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * files and directories
+ */
+
+/** Creates a file of the given size (0 by default), whose contents do not
+ * compress, so that the storage allocated to it is not less than its
+ * size
+ */
+inline
+void
+create_file(
+    path_t const&   path
+,   size_t          size = 0
+)
+{
+#if defined(RECLS_CHAR_TYPE_IS_WCHAR)
+    FILE* const stm = ::_wfopen(path.c_str(), L"wb");
+#else /* ? RECLS_CHAR_TYPE_IS_WCHAR */
+    FILE* const stm = ::fopen(path.c_str(), "wb");
+#endif /* RECLS_CHAR_TYPE_IS_WCHAR */
+
+    if (NULL == stm)
+    {
+        XTESTS_TEST_FAIL_WITH_QUALIFIER("failed to create file", path);
+    }
+    else
+    {
+        unsigned long r = static_cast<unsigned long>(size) + 1;
+
+        for (size_t i = 0; i != size; ++i)
+        {
+            r = r * 1103515245ul + 12345ul;
+
+            ::fputc(static_cast<int>((r >> 16) & 0xff), stm);
+        }
+
+        ::fclose(stm);
+    }
+}
+
+/** Creates the given directory, and any missing intermediate directories */
+inline
+void
+create_directory(
+    path_t const& path
+)
+{
+    if (!platformstl::create_directory_recurse(path))
+    {
+        XTESTS_TEST_FAIL_WITH_QUALIFIER("failed to create directory", path);
+    }
+}
+
+/** Creates, within the directory \c parent, the directory \c name
+ * containing the given entries, returning its path
+ *
+ * Each entry is a path relative to the directory: those ending in '/' are
+ * (empty) directories; the others are (empty) files, whose directories
+ * are created as needed
+ */
+inline
+path_t
+create_tree(
+    path_t const&                       parent
+,   recls::recls_char_t const*          name
+,   recls::recls_char_t const* const*   entries
+,   size_t                              numEntries
+)
+{
+    path_t root(parent);
+
+    root.push(name);
+
+    create_directory(root);
+
+    for (size_t i = 0; i != numEntries; ++i)
+    {
+        string_t const  entry(entries[i]);
+        path_t          path(root);
+
+        if (!entry.empty() &&
+            '/' == entry[entry.size() - 1])
+        {
+            create_directory(path.push(entry.substr(0, entry.size() - 1).c_str()));
+        }
+        else
+        {
+            path.push(entry.c_str());
+
+            path_t dir(path);
+
+            dir.pop();
+
+            if (!traits_t::is_directory(dir.c_str()))
+            {
+                create_directory(dir);
+            }
+
+            create_file(path);
+        }
+    }
+
+    return root;
+}
+
+template <size_t N>
+inline
+path_t
+create_tree(
+    path_t const&                       parent
+,   recls::recls_char_t const*          name
+,   recls::recls_char_t const* const    (&entries)[N]
+)
+{
+    return create_tree(parent, name, &entries[0], N);
+}
+
+/** Creates, within the directory \c parent, the directory \c name
+ * containing \c numFiles (empty) files, named "f00.txt", "f01.txt", ...,
+ * returning its path
+ */
+inline
+path_t
+create_numbered_files(
+    path_t const&               parent
+,   recls::recls_char_t const*  name
+,   size_t                      numFiles
+)
+{
+    path_t dir(parent);
+
+    dir.push(name);
+
+    create_directory(dir);
+
+    for (size_t i = 0; i != numFiles; ++i)
+    {
+        recls::recls_char_t file[] = RECLS_LITERAL("f00.txt");
+
+        file[1] = static_cast<recls::recls_char_t>('0' + (i / 10) % 10);
+        file[2] = static_cast<recls::recls_char_t>('0' + i % 10);
+
+        create_file(path_t(dir).push(file));
+    }
+
+    return dir;
+}
+
+/** Creates, within the directory \c parent, the directory \c name
+ * containing a chain of \c depth directories, each named "d", with a
+ * file "f.txt" in each of them, returning its path
+ */
+inline
+path_t
+create_deep_tree(
+    path_t const&               parent
+,   recls::recls_char_t const*  name
+,   size_t                      depth
+)
+{
+    path_t root(parent);
+
+    root.push(name);
+
+    path_t path(root);
+
+    for (size_t i = 0; i != depth; ++i)
+    {
+        path.push(RECLS_LITERAL("d"));
+    }
+
+    create_directory(path);
+
+    for (size_t i = 0; i != depth; ++i)
+    {
+        create_file(path_t(path).push(RECLS_LITERAL("f.txt")));
+
+        path.pop();
+    }
+
+    return root;
+}
+
+#if defined(PLATFORMSTL_OS_IS_UNIX)
+/* /////////////////////////////////////////////////////////////////////////
+ * resources
+ */
+
+/** The lowest descriptor not in use, which is the number of descriptors
+ * in use if they are contiguous
+ */
+inline
+size_t
+lowest_free_descriptor()
+{
+    int const fd = ::open("/", O_RDONLY);
+
+    if (fd < 0)
+    {
+        return 0;
+    }
+
+    ::close(fd);
+
+    return static_cast<size_t>(fd);
+}
+
+/** Limits the number of descriptors the process may open, for the
+ * lifetime of the instance
+ */
+class descriptor_limit_scope
+{
+public:
+    explicit descriptor_limit_scope(
+        size_t n
+    )
+        : m_changed(false)
+    {
+        if (0 == ::getrlimit(RLIMIT_NOFILE, &m_previous) &&
+            m_previous.rlim_cur > n)
+        {
+            struct rlimit rl = m_previous;
+
+            rl.rlim_cur = n;
+
+            m_changed = (0 == ::setrlimit(RLIMIT_NOFILE, &rl));
+        }
+    }
+    ~descriptor_limit_scope()
+    {
+        if (m_changed)
+        {
+            ::setrlimit(RLIMIT_NOFILE, &m_previous);
+        }
+    }
+private:
+    descriptor_limit_scope(descriptor_limit_scope const&);
+    void operator =(descriptor_limit_scope const&);
+
+private:
+    struct rlimit   m_previous;
+    bool            m_changed;
+};
+#endif
+
+/* /////////////////////////////////////////////////////////////////////////
+ * searches
+ */
+
+/** The full path of the given entry */
+inline
+string_t
+path_of(
+    recls::recls_entry_t entry
+)
+{
+    return string_t(entry->path.begin, entry->path.end);
+}
+
+/** The file name (including any extension) of the given entry */
+inline
+string_t
+file_name_of(
+    recls::recls_entry_t entry
+)
+{
+    return string_t(entry->fileName.begin, entry->fileName.end);
+}
+
+/** Enumerates the remaining entries of the given search, which is
+ * positioned on an entry, appending their paths, in order, to \c paths,
+ * and returning the status code that ended the enumeration:
+ * \c RECLS_RC_NO_MORE_DATA if it ran to completion
+ */
+inline
+recls::recls_rc_t
+enumerate_paths(
+    recls::hrecls_t hSrch
+,   strings_t*      paths
+)
+{
+    recls::recls_entry_t    entry;
+    recls::recls_rc_t       rc;
+
+    for (rc = recls::Recls_GetDetails(hSrch, &entry); recls::RECLS_RC_OK == rc; rc = recls::Recls_GetNextDetails(hSrch, &entry))
+    {
+        paths->push_back(path_of(entry));
+
+        recls::Recls_CloseDetails(entry);
+    }
+
+    return rc;
+}
+
+/** Searches the given root, appending the paths of the entries found, in
+ * order, to \c paths, and returning the status code that ended the
+ * search: \c RECLS_RC_NO_MORE_DATA if it ran to completion, including
+ * when there are no entries
+ */
+inline
+recls::recls_rc_t
+search_paths(
+    path_t const&               root
+,   recls::recls_char_t const*  pattern
+,   recls::recls_uint32_t       flags
+,   strings_t*                  paths
+)
+{
+    recls::hrecls_t     hSrch;
+    recls::recls_rc_t   rc      =   recls::Recls_Search(root.c_str(), pattern, flags, &hSrch);
+
+    if (recls::RECLS_RC_OK == rc)
+    {
+        rc = enumerate_paths(hSrch, paths);
+
+        recls::Recls_SearchClose(hSrch);
+    }
+
+    return rc;
+}
+
+/** Searches the given root, returning the paths of the entries found, in
+ * order, and verifying that the search runs to completion
+ */
+inline
+strings_t
+search_paths(
+    path_t const&               root
+,   recls::recls_char_t const*  pattern
+,   recls::recls_uint32_t       flags
+)
+{
+    strings_t paths;
+
+    XTESTS_TEST_POINTER_EQUAL(RECLS_RC_NO_MORE_DATA, search_paths(root, pattern, flags, &paths));
+
+    return paths;
+}
+
+/* /////////////////////////////////////////////////////////////////////////
+ * namespace
+ */
+
+} // namespace recls_test
+
+#endif /* !RECLS_INCL_TEST_UTIL_HPP_FIXTURES */
+
+/* ///////////////////////////// end of file //////////////////////////// */